@@ -0,0 +1,462 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_scd4x_coroutine.hpp
+ * @brief     driver scd4x coroutine header file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#ifndef DRIVER_SCD4X_COROUTINE_HPP
+#define DRIVER_SCD4X_COROUTINE_HPP
+
+#include "driver_scd4x.h"
+#include <coroutine>
+#include <cstdint>
+#include <exception>
+#include <type_traits>
+#include <utility>
+
+/**
+ * @defgroup scd4x_coroutine_driver scd4x coroutine driver function
+ * @brief    scd4x c++20 coroutine driver modules
+ * @ingroup  scd4x_driver
+ * @{
+ */
+
+namespace scd4x
+{
+
+/**
+ * @brief scd4x coroutine result structure definition
+ */
+template <typename T>
+struct Result
+{
+    uint8_t res;        /**< driver status code */
+    T value;            /**< value, valid when res is 0 */
+};
+
+template <typename T = void>
+class Task;
+
+namespace detail
+{
+
+/**
+ * @brief final awaiter, resumes the awaiting coroutine
+ */
+struct FinalAwaiter
+{
+    bool await_ready() const noexcept
+    {
+        return false;
+    }
+    
+    template <typename P>
+    std::coroutine_handle<> await_suspend(std::coroutine_handle<P> h) noexcept
+    {
+        std::coroutine_handle<> c = h.promise().continuation;
+        
+        return c ? c : std::noop_coroutine();
+    }
+    
+    void await_resume() const noexcept
+    {
+    }
+};
+
+/**
+ * @brief common task promise part
+ */
+struct PromiseBase
+{
+    std::coroutine_handle<> continuation;        /**< awaiting coroutine */
+    
+    std::suspend_always initial_suspend() noexcept
+    {
+        return {};
+    }
+    
+    FinalAwaiter final_suspend() noexcept
+    {
+        return {};
+    }
+    
+    void unhandled_exception() noexcept
+    {
+        std::terminate();
+    }
+};
+
+/**
+ * @brief common task part, owns the coroutine frame
+ */
+template <typename P>
+class TaskBase
+{
+  public:
+    TaskBase(TaskBase &&other) noexcept : m_handle(std::exchange(other.m_handle, nullptr))
+    {
+    }
+    
+    TaskBase(const TaskBase &) = delete;
+    TaskBase &operator=(const TaskBase &) = delete;
+    
+    ~TaskBase()
+    {
+        if (m_handle)
+        {
+            m_handle.destroy();
+        }
+    }
+    
+    bool await_ready() const noexcept
+    {
+        return false;
+    }
+    
+    std::coroutine_handle<> await_suspend(std::coroutine_handle<> c) noexcept
+    {
+        m_handle.promise().continuation = c;
+        
+        return m_handle;
+    }
+    
+  protected:
+    explicit TaskBase(std::coroutine_handle<P> h) noexcept : m_handle(h)
+    {
+    }
+    
+    std::coroutine_handle<P> m_handle;        /**< coroutine frame */
+};
+
+}
+
+namespace detail
+{
+
+/**
+ * @brief task promise with a value
+ */
+template <typename T>
+struct Promise : PromiseBase
+{
+    T value{};        /**< returned value */
+    
+    Task<T> get_return_object() noexcept;
+    
+    void return_value(T v) noexcept
+    {
+        value = std::move(v);
+    }
+};
+
+/**
+ * @brief task promise without a value
+ */
+template <>
+struct Promise<void> : PromiseBase
+{
+    Task<void> get_return_object() noexcept;
+    
+    void return_void() noexcept
+    {
+    }
+};
+
+}
+
+/**
+ * @brief lazily started task, runs when it is awaited
+ */
+template <typename T>
+class Task : public detail::TaskBase<detail::Promise<T>>
+{
+  public:
+    using promise_type = detail::Promise<T>;
+    
+    explicit Task(std::coroutine_handle<promise_type> h) noexcept : detail::TaskBase<promise_type>(h)
+    {
+    }
+    
+    T await_resume() noexcept
+    {
+        if constexpr (!std::is_void_v<T>)
+        {
+            return std::move(this->m_handle.promise().value);
+        }
+    }
+};
+
+template <typename T>
+inline Task<T> detail::Promise<T>::get_return_object() noexcept
+{
+    return Task<T>(std::coroutine_handle<Promise<T>>::from_promise(*this));
+}
+
+inline Task<void> detail::Promise<void>::get_return_object() noexcept
+{
+    return Task<void>(std::coroutine_handle<Promise<void>>::from_promise(*this));
+}
+
+/**
+ * @brief fire and forget coroutine, starts at once and frees itself
+ */
+struct Detached
+{
+    struct promise_type
+    {
+        Detached get_return_object() noexcept
+        {
+            return {};
+        }
+        
+        std::suspend_never initial_suspend() noexcept
+        {
+            return {};
+        }
+        
+        std::suspend_never final_suspend() noexcept
+        {
+            return {};
+        }
+        
+        void return_void() noexcept
+        {
+        }
+        
+        void unhandled_exception() noexcept
+        {
+            std::terminate();
+        }
+    };
+};
+
+/**
+ * @brief scd4x coroutine sensor
+ * @note  Executor must provide now_us() and sleep_for(us), the handle get_time_us
+ *        must be linked so the pending command times can be awaited, the reads are built
+ *        on scd4x_poll_sample and never delay in the driver
+ */
+template <typename Executor>
+class Sensor
+{
+  public:
+    /**
+     * @brief     sensor constructor
+     * @param[in] *handle pointer to an initialized scd4x handle structure
+     * @param[in] &executor reference to an executor
+     */
+    Sensor(scd4x_handle_t *handle, Executor &executor) noexcept : m_handle(handle), m_executor(executor)
+    {
+    }
+    
+    /**
+     * @brief  get the handle
+     * @return pointer to the scd4x handle structure
+     */
+    scd4x_handle_t *handle() const noexcept
+    {
+        return m_handle;
+    }
+    
+    /**
+     * @brief  start periodic measurement
+     * @return driver status code
+     */
+    Task<uint8_t> start_periodic()
+    {
+        co_await wait_pending();
+        m_period_ms = 5000;
+        
+        co_return scd4x_start_periodic_measurement(m_handle);
+    }
+    
+    /**
+     * @brief  start low power periodic measurement
+     * @return driver status code
+     */
+    Task<uint8_t> start_low_power_periodic()
+    {
+        co_await wait_pending();
+        m_period_ms = 30000;
+        
+        co_return scd4x_start_low_power_periodic_measurement(m_handle);
+    }
+    
+    /**
+     * @brief  stop periodic measurement
+     * @return driver status code
+     * @note   the 500ms stop time is awaited by the next command
+     */
+    Task<uint8_t> stop_periodic()
+    {
+        co_await wait_pending();
+        m_period_ms = 0;
+        
+        co_return scd4x_stop_periodic_measurement(m_handle);
+    }
+    
+    /**
+     * @brief     measure a single shot and read it
+     * @param[in] timeout max data ready polling time in ms
+     * @return    driver status code and the sample
+     */
+    Task<Result<scd4x_sample_t>> single_shot(uint32_t timeout = 30000)
+    {
+        Result<scd4x_sample_t> r{};
+        
+        co_await wait_pending();
+        r.res = scd4x_measure_single_shot(m_handle);
+        if (r.res != 0)
+        {
+            co_return r;
+        }
+        
+        co_return co_await poll(timeout);
+    }
+    
+    /**
+     * @brief     wait and read the next periodic sample
+     * @param[in] timeout max data ready polling time in ms
+     * @return    driver status code and the sample
+     * @note      the first probe is sent one period after the last data ready time
+     */
+    Task<Result<scd4x_sample_t>> next_periodic_sample(uint32_t timeout = 60000)
+    {
+        Result<scd4x_sample_t> r{};
+        uint64_t now;
+        uint64_t next;
+        
+        co_await wait_pending();
+        if ((m_period_ms != 0) && (m_last_ready_us != 0))
+        {
+            now = m_executor.now_us();
+            next = m_last_ready_us + (uint64_t)m_period_ms * 1000;
+            if (next > now)
+            {
+                co_await m_executor.sleep_for(next - now);
+            }
+        }
+        r = co_await poll(timeout);
+        if (r.res == 0)
+        {
+            m_last_ready_us = m_executor.now_us() - (r.value.read_time_us - r.value.ready_time_us);
+        }
+        
+        co_return r;
+    }
+    
+    /**
+     * @brief  perform self test
+     * @return driver status code and the malfunction detected flag
+     */
+    Task<Result<scd4x_bool_t>> self_test()
+    {
+        Result<scd4x_bool_t> r{};
+        
+        co_await wait_pending();
+        r.res = scd4x_start_self_test(m_handle);
+        if (r.res != 0)
+        {
+            co_return r;
+        }
+        co_await wait_pending();
+        r.res = scd4x_get_self_test_result(m_handle, &r.value);
+        
+        co_return r;
+    }
+    
+  private:
+    /**
+     * @brief suspend until the pending command execution time has elapsed
+     */
+    Task<> wait_pending()
+    {
+        uint32_t us;
+        
+        if ((scd4x_get_pending_time(m_handle, &us) == 0) && (us != 0))
+        {
+            co_await m_executor.sleep_for(us);
+        }
+    }
+    
+    /**
+     * @brief     run the split phase sample poll, suspend for each wait time it returns
+     * @param[in] timeout max data ready polling time in ms
+     * @return    driver status code and the sample, 5 means timeout
+     * @note      the data ready backoff is the one of scd4x_poll_sample
+     */
+    Task<Result<scd4x_sample_t>> poll(uint32_t timeout)
+    {
+        Result<scd4x_sample_t> r{};
+        uint32_t wait_us;
+        uint64_t start;
+        uint64_t elapsed;
+        uint64_t limit;
+        
+        limit = (uint64_t)timeout * 1000;
+        start = m_executor.now_us();
+        while (true)
+        {
+            r.res = scd4x_poll_sample(m_handle, &r.value, &wait_us);
+            if (r.res == 6)
+            {
+                co_await m_executor.sleep_for(wait_us);
+                
+                continue;
+            }
+            if (r.res != 5)
+            {
+                co_return r;
+            }
+            elapsed = m_executor.now_us() - start;
+            if (elapsed >= limit)
+            {
+                co_return r;
+            }
+            co_await m_executor.sleep_for(((uint64_t)wait_us < limit - elapsed) ? wait_us : limit - elapsed);
+        }
+    }
+    
+    scd4x_handle_t *m_handle;               /**< driver handle */
+    Executor &m_executor;                   /**< executor */
+    uint32_t m_period_ms = 0;               /**< periodic measurement interval */
+    uint64_t m_last_ready_us = 0;           /**< last data ready time in executor time */
+};
+
+}
+
+/**
+ * @}
+ */
+
+#endif
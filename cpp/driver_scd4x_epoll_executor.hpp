@@ -0,0 +1,269 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_scd4x_epoll_executor.hpp
+ * @brief     driver scd4x epoll executor header file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#ifndef DRIVER_SCD4X_EPOLL_EXECUTOR_HPP
+#define DRIVER_SCD4X_EPOLL_EXECUTOR_HPP
+
+#include <coroutine>
+#include <cstdint>
+#include <ctime>
+#include <deque>
+#include <functional>
+#include <queue>
+#include <vector>
+#include <sys/epoll.h>
+#include <sys/timerfd.h>
+#include <unistd.h>
+
+/**
+ * @addtogroup scd4x_coroutine_driver
+ * @{
+ */
+
+namespace scd4x
+{
+
+/**
+ * @brief single thread linux executor based on epoll and one timerfd
+ * @note  all timers share the timerfd, which is armed to the earliest deadline
+ */
+class EpollExecutor
+{
+  public:
+    /**
+     * @brief sleep awaiter
+     */
+    struct SleepAwaiter
+    {
+        EpollExecutor &executor;        /**< executor */
+        uint64_t deadline;              /**< wake up time in us */
+        
+        bool await_ready() const noexcept
+        {
+            return deadline <= executor.now_us();
+        }
+        
+        void await_suspend(std::coroutine_handle<> h)
+        {
+            executor.add_timer(deadline, h);
+        }
+        
+        void await_resume() const noexcept
+        {
+        }
+    };
+    
+    EpollExecutor()
+    {
+        struct epoll_event ev = {};
+        
+        m_epfd = epoll_create1(EPOLL_CLOEXEC);
+        m_tfd = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+        ev.events = EPOLLIN;
+        ev.data.fd = m_tfd;
+        if ((m_epfd >= 0) && (m_tfd >= 0))
+        {
+            (void)epoll_ctl(m_epfd, EPOLL_CTL_ADD, m_tfd, &ev);
+        }
+    }
+    
+    EpollExecutor(const EpollExecutor &) = delete;
+    EpollExecutor &operator=(const EpollExecutor &) = delete;
+    
+    ~EpollExecutor()
+    {
+        if (m_tfd >= 0)
+        {
+            (void)close(m_tfd);
+        }
+        if (m_epfd >= 0)
+        {
+            (void)close(m_epfd);
+        }
+    }
+    
+    /**
+     * @brief  check the executor
+     * @return true if epoll and timerfd are created
+     */
+    bool valid() const noexcept
+    {
+        return (m_epfd >= 0) && (m_tfd >= 0);
+    }
+    
+    /**
+     * @brief  get the monotonic time
+     * @return time in us
+     */
+    uint64_t now_us() const noexcept
+    {
+        struct timespec ts;
+        
+        (void)clock_gettime(CLOCK_MONOTONIC, &ts);
+        
+        return (uint64_t)ts.tv_sec * 1000000 + (uint64_t)ts.tv_nsec / 1000;
+    }
+    
+    /**
+     * @brief     suspend until an absolute time
+     * @param[in] deadline wake up time in us
+     * @return    awaiter
+     */
+    SleepAwaiter sleep_until(uint64_t deadline) noexcept
+    {
+        return SleepAwaiter{*this, deadline};
+    }
+    
+    /**
+     * @brief     suspend for a while
+     * @param[in] us sleep time in us
+     * @return    awaiter
+     */
+    SleepAwaiter sleep_for(uint64_t us) noexcept
+    {
+        return SleepAwaiter{*this, now_us() + us};
+    }
+    
+    /**
+     * @brief     resume a coroutine on the next loop
+     * @param[in] h coroutine handle
+     */
+    void post(std::coroutine_handle<> h)
+    {
+        m_ready.push_back(h);
+    }
+    
+    /**
+     * @brief run until stopped or no work is left
+     */
+    void run()
+    {
+        struct epoll_event ev;
+        uint64_t expirations;
+        
+        m_stop = false;
+        while (!m_stop)
+        {
+            while (!m_ready.empty())
+            {
+                std::coroutine_handle<> h = m_ready.front();
+                
+                m_ready.pop_front();
+                h.resume();
+            }
+            if (m_stop || m_timers.empty())
+            {
+                break;
+            }
+            if (m_timers.top().deadline <= now_us())
+            {
+                fire_timers();
+                
+                continue;
+            }
+            arm(m_timers.top().deadline);
+            if (epoll_wait(m_epfd, &ev, 1, -1) > 0)
+            {
+                (void)read(m_tfd, &expirations, sizeof(expirations));
+            }
+            fire_timers();
+        }
+    }
+    
+    /**
+     * @brief stop the run loop
+     */
+    void stop() noexcept
+    {
+        m_stop = true;
+    }
+    
+  private:
+    /**
+     * @brief timer entry
+     */
+    struct Timer
+    {
+        uint64_t deadline;                 /**< wake up time in us */
+        uint64_t seq;                      /**< insertion order */
+        std::coroutine_handle<> h;         /**< coroutine to resume */
+        
+        bool operator>(const Timer &t) const noexcept
+        {
+            return (deadline != t.deadline) ? (deadline > t.deadline) : (seq > t.seq);
+        }
+    };
+    
+    void add_timer(uint64_t deadline, std::coroutine_handle<> h)
+    {
+        m_timers.push(Timer{deadline, m_seq++, h});
+    }
+    
+    void arm(uint64_t deadline) noexcept
+    {
+        struct itimerspec its = {};
+        
+        its.it_value.tv_sec = (time_t)(deadline / 1000000);
+        its.it_value.tv_nsec = (long)((deadline % 1000000) * 1000);
+        (void)timerfd_settime(m_tfd, TFD_TIMER_ABSTIME, &its, nullptr);
+    }
+    
+    void fire_timers()
+    {
+        uint64_t now = now_us();
+        
+        while (!m_timers.empty() && (m_timers.top().deadline <= now))
+        {
+            m_ready.push_back(m_timers.top().h);
+            m_timers.pop();
+        }
+    }
+    
+    int m_epfd = -1;                                                                   /**< epoll fd */
+    int m_tfd = -1;                                                                    /**< timer fd */
+    bool m_stop = false;                                                               /**< stop flag */
+    uint64_t m_seq = 0;                                                                /**< timer sequence */
+    std::deque<std::coroutine_handle<>> m_ready;                                       /**< ready queue */
+    std::priority_queue<Timer, std::vector<Timer>, std::greater<Timer>> m_timers;      /**< timer min heap */
+};
+
+}
+
+/**
+ * @}
+ */
+
+#endif
@@ -0,0 +1,789 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_scd4x_variant.hpp
+ * @brief     driver scd4x variant header file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#ifndef DRIVER_SCD4X_VARIANT_HPP
+#define DRIVER_SCD4X_VARIANT_HPP
+
+#include "driver_scd4x_interface.h"
+#include <array>
+#include <concepts>
+#include <cstdint>
+
+/**
+ * @defgroup scd4x_variant_driver scd4x variant driver function
+ * @brief    scd4x compile time specialized c++ driver modules
+ * @ingroup  scd4x_driver
+ * @{
+ */
+
+namespace scd4x
+{
+
+/**
+ * @brief transport concept, the address is fixed by the transport
+ */
+template <typename T>
+concept Transport = requires(T &t, const uint8_t *in, uint8_t *out, uint16_t len, uint32_t ms)
+{
+    { t.write(in, len) } -> std::convertible_to<uint8_t>;
+    { t.read(out, len) } -> std::convertible_to<uint8_t>;
+    t.delay_ms(ms);
+};
+
+/**
+ * @brief transport with a monotonic us clock, only the rest of a command execution time is waited
+ */
+template <typename T>
+concept TimedTransport = Transport<T> && requires(T &t)
+{
+    { t.now_us() } -> std::convertible_to<uint64_t>;
+};
+
+namespace frame
+{
+
+/**
+ * @brief     generate the crc
+ * @param[in] msb first byte
+ * @param[in] lsb second byte
+ * @return    crc
+ * @note      polynomial 0x31, init 0xFF
+ */
+constexpr uint8_t crc(uint8_t msb, uint8_t lsb) noexcept
+{
+    uint8_t c = 0xFF;
+    
+    for (uint8_t byte : {msb, lsb})
+    {
+        c ^= byte;
+        for (int bit = 0; bit < 8; bit++)
+        {
+            c = ((c & 0x80) != 0) ? (uint8_t)((c << 1) ^ 0x31) : (uint8_t)(c << 1);
+        }
+    }
+    
+    return c;
+}
+
+static_assert(crc(0xBE, 0xEF) == 0x92, "scd4x crc is broken");
+
+/**
+ * @brief     make a command frame
+ * @param[in] cmd command
+ * @return    frame
+ */
+constexpr std::array<uint8_t, 2> command(uint16_t cmd) noexcept
+{
+    return {(uint8_t)(cmd >> 8), (uint8_t)(cmd & 0xFF)};
+}
+
+/**
+ * @brief     make a command frame with one argument word
+ * @param[in] cmd command
+ * @param[in] arg argument
+ * @return    frame
+ */
+constexpr std::array<uint8_t, 5> command(uint16_t cmd, uint16_t arg) noexcept
+{
+    return {(uint8_t)(cmd >> 8), (uint8_t)(cmd & 0xFF),
+            (uint8_t)(arg >> 8), (uint8_t)(arg & 0xFF),
+            crc((uint8_t)(arg >> 8), (uint8_t)(arg & 0xFF))};
+}
+
+/**
+ * @brief constant command frame
+ */
+template <uint16_t Cmd>
+inline constexpr std::array<uint8_t, 2> kCommand = command(Cmd);
+
+/**
+ * @brief constant command frame with one argument word
+ */
+template <uint16_t Cmd, uint16_t Arg>
+inline constexpr std::array<uint8_t, 5> kCommandArg = command(Cmd, Arg);
+
+}
+
+/**
+ * @brief transport calling the platform interface functions directly
+ */
+struct InterfaceTransport
+{
+    static constexpr uint8_t kAddress = 0x62 << 1;        /**< iic address */
+    
+    uint8_t write(const uint8_t *buf, uint16_t len) noexcept
+    {
+        return scd4x_interface_iic_write_cmd(kAddress, const_cast<uint8_t *>(buf), len);
+    }
+    
+    uint8_t read(uint8_t *buf, uint16_t len) noexcept
+    {
+        return scd4x_interface_iic_read_cmd(kAddress, buf, len);
+    }
+    
+    void delay_ms(uint32_t ms) noexcept
+    {
+        scd4x_interface_delay_ms(ms);
+    }
+    
+    uint64_t now_us() noexcept
+    {
+        return scd4x_interface_get_time_us();
+    }
+};
+
+/**
+ * @brief scd4x driver specialized for one chip variant and one transport
+ * @note  the return codes follow the c driver without the handle and type errors,
+ *        commands missing on the variant are not declared and fail to compile
+ */
+template <scd4x_t Variant, Transport T>
+class Scd4x
+{
+  public:
+    static constexpr scd4x_t kVariant = Variant;                  /**< chip variant */
+    static constexpr bool kHasShot = (Variant != SCD40);          /**< single shot, power down and asc periods */
+    
+    /**
+     * @brief     driver constructor
+     * @param[in] transport bus transport
+     */
+    explicit Scd4x(T transport = T{}) noexcept : m_transport(transport)
+    {
+    }
+    
+    /**
+     * @brief  get the transport
+     * @return reference to the transport
+     */
+    T &transport() noexcept
+    {
+        return m_transport;
+    }
+    
+    /**
+     * @brief  start periodic measurement
+     * @return status code
+     *         - 0 success
+     *         - 1 start periodic measurement failed
+     */
+    uint8_t start_periodic_measurement() noexcept
+    {
+        return write(frame::kCommand<0x21B1>, 0);
+    }
+    
+    /**
+     * @brief  start low power periodic measurement
+     * @return status code
+     *         - 0 success
+     *         - 1 start low power periodic measurement failed
+     */
+    uint8_t start_low_power_periodic_measurement() noexcept
+    {
+        return write(frame::kCommand<0x21AC>, 0);
+    }
+    
+    /**
+     * @brief  stop periodic measurement
+     * @return status code
+     *         - 0 success
+     *         - 1 stop periodic measurement failed
+     * @note   the next bus access waits 500ms
+     */
+    uint8_t stop_periodic_measurement() noexcept
+    {
+        return write(frame::kCommand<0x3F86>, 500);
+    }
+    
+    /**
+     * @brief      get data ready status
+     * @param[out] &enable data ready status
+     * @return     status code
+     *             - 0 success
+     *             - 1 get data ready status failed
+     *             - 4 crc is error
+     */
+    uint8_t get_data_ready_status(scd4x_bool_t &enable) noexcept
+    {
+        uint16_t word;
+        uint8_t res;
+        
+        res = read_words<0xE4B8>(&word, 1);
+        if (res != 0)
+        {
+            return res;
+        }
+        enable = ((word & 0x0FFF) != 0) ? SCD4X_BOOL_TRUE : SCD4X_BOOL_FALSE;
+        
+        return 0;
+    }
+    
+    /**
+     * @brief      read data
+     * @param[out] &sample measurement sample
+     * @return     status code
+     *             - 0 success
+     *             - 1 read failed
+     *             - 4 crc is error
+     *             - 5 data is not ready
+     * @note       the ready and read times are set when the transport has a clock
+     */
+    uint8_t read(scd4x_sample_t &sample) noexcept
+    {
+        scd4x_bool_t enable;
+        uint16_t word[3];
+        uint8_t res;
+        
+        res = get_data_ready_status(enable);
+        if (res != 0)
+        {
+            return res;
+        }
+        if (enable == SCD4X_BOOL_FALSE)
+        {
+            return 5;
+        }
+        sample.ready_time_us = now_us();
+        res = read_words<0xEC05>(word, 3);
+        if (res != 0)
+        {
+            return res;
+        }
+        sample.read_time_us = now_us();
+        sample.co2_raw = word[0];
+        sample.temperature_raw = word[1];
+        sample.humidity_raw = word[2];
+        sample.co2_ppm = word[0];
+        sample.temperature_s = -45.0f + 175.0f * (float)(word[1]) / 65535.0f;
+        sample.humidity_s = 100.0f * (float)(word[2]) / 65535.0f;
+        
+        return 0;
+    }
+    
+    /**
+     * @brief     set temperature offset
+     * @param[in] offset temperature offset raw data
+     * @return    status code
+     *            - 0 success
+     *            - 1 set temperature offset failed
+     */
+    uint8_t set_temperature_offset(uint16_t offset) noexcept
+    {
+        return write(frame::command(0x241D, offset), 1);
+    }
+    
+    /**
+     * @brief      get temperature offset
+     * @param[out] &offset temperature offset raw data
+     * @return     status code
+     *             - 0 success
+     *             - 1 get temperature offset failed
+     *             - 4 crc is error
+     */
+    uint8_t get_temperature_offset(uint16_t &offset) noexcept
+    {
+        return read_words<0x2318>(&offset, 1);
+    }
+    
+    /**
+     * @brief     set sensor altitude
+     * @param[in] altitude sensor altitude raw data
+     * @return    status code
+     *            - 0 success
+     *            - 1 set sensor altitude failed
+     */
+    uint8_t set_sensor_altitude(uint16_t altitude) noexcept
+    {
+        return write(frame::command(0x2427, altitude), 1);
+    }
+    
+    /**
+     * @brief      get sensor altitude
+     * @param[out] &altitude sensor altitude raw data
+     * @return     status code
+     *             - 0 success
+     *             - 1 get sensor altitude failed
+     *             - 4 crc is error
+     */
+    uint8_t get_sensor_altitude(uint16_t &altitude) noexcept
+    {
+        return read_words<0x2322>(&altitude, 1);
+    }
+    
+    /**
+     * @brief     set ambient pressure
+     * @param[in] pressure ambient pressure raw data
+     * @return    status code
+     *            - 0 success
+     *            - 1 set ambient pressure failed
+     */
+    uint8_t set_ambient_pressure(uint16_t pressure) noexcept
+    {
+        return write(frame::command(0xE000, pressure), 1);
+    }
+    
+    /**
+     * @brief      get ambient pressure
+     * @param[out] &pressure ambient pressure raw data
+     * @return     status code
+     *             - 0 success
+     *             - 1 get ambient pressure failed
+     *             - 4 crc is error
+     */
+    uint8_t get_ambient_pressure(uint16_t &pressure) noexcept
+    {
+        return read_words<0xE000>(&pressure, 1);
+    }
+    
+    /**
+     * @brief     start forced recalibration
+     * @param[in] co2_raw co2 raw data
+     * @return    status code
+     *            - 0 success
+     *            - 1 start forced recalibration failed
+     * @note      the next bus access waits 400ms
+     */
+    uint8_t start_forced_recalibration(uint16_t co2_raw) noexcept
+    {
+        return write(frame::command(0x362F, co2_raw), 400);
+    }
+    
+    /**
+     * @brief      get forced recalibration result
+     * @param[out] &frc frc correction raw data
+     * @return     status code
+     *             - 0 success
+     *             - 1 get forced recalibration result failed
+     *             - 4 crc is error
+     */
+    uint8_t get_forced_recalibration_result(uint16_t &frc) noexcept
+    {
+        return read_response(&frc, 1);
+    }
+    
+    /**
+     * @brief      perform forced recalibration
+     * @param[in]  co2_raw co2 raw data
+     * @param[out] &frc frc correction raw data
+     * @return     status code
+     *             - 0 success
+     *             - 1 perform forced recalibration failed
+     *             - 4 crc is error
+     */
+    uint8_t perform_forced_recalibration(uint16_t co2_raw, uint16_t &frc) noexcept
+    {
+        if (start_forced_recalibration(co2_raw) != 0)
+        {
+            return 1;
+        }
+        
+        return get_forced_recalibration_result(frc);
+    }
+    
+    /**
+     * @brief     enable or disable automatic self calibration
+     * @param[in] enable bool value
+     * @return    status code
+     *            - 0 success
+     *            - 1 set automatic self calibration failed
+     */
+    uint8_t set_automatic_self_calibration(scd4x_bool_t enable) noexcept
+    {
+        if (enable == SCD4X_BOOL_TRUE)
+        {
+            return write(frame::kCommandArg<0x2416, 1>, 1);
+        }
+        
+        return write(frame::kCommandArg<0x2416, 0>, 1);
+    }
+    
+    /**
+     * @brief      get automatic self calibration status
+     * @param[out] &enable bool value
+     * @return     status code
+     *             - 0 success
+     *             - 1 get automatic self calibration failed
+     *             - 4 crc is error
+     */
+    uint8_t get_automatic_self_calibration(scd4x_bool_t &enable) noexcept
+    {
+        uint16_t word;
+        uint8_t res;
+        
+        res = read_words<0x2313>(&word, 1);
+        if (res == 0)
+        {
+            enable = (scd4x_bool_t)(word & 0x01);
+        }
+        
+        return res;
+    }
+    
+    /**
+     * @brief  persist settings
+     * @return status code
+     *         - 0 success
+     *         - 1 persist settings failed
+     * @note   the next bus access waits 800ms
+     */
+    uint8_t persist_settings() noexcept
+    {
+        return write(frame::kCommand<0x3615>, 800);
+    }
+    
+    /**
+     * @brief      get serial number
+     * @param[out] number serial number
+     * @return     status code
+     *             - 0 success
+     *             - 1 get serial number failed
+     *             - 4 crc is error
+     */
+    uint8_t get_serial_number(uint16_t number[3]) noexcept
+    {
+        return read_words<0x3682>(number, 3);
+    }
+    
+    /**
+     * @brief  start self test
+     * @return status code
+     *         - 0 success
+     *         - 1 start self test failed
+     * @note   the next bus access waits 10000ms
+     */
+    uint8_t start_self_test() noexcept
+    {
+        return write(frame::kCommand<0x3639>, 10000);
+    }
+    
+    /**
+     * @brief      get self test result
+     * @param[out] &malfunction_detected malfunction detected flag
+     * @return     status code
+     *             - 0 success
+     *             - 1 get self test result failed
+     *             - 4 crc is error
+     */
+    uint8_t get_self_test_result(scd4x_bool_t &malfunction_detected) noexcept
+    {
+        uint16_t word;
+        uint8_t res;
+        
+        res = read_response(&word, 1);
+        if (res == 0)
+        {
+            malfunction_detected = (word != 0) ? SCD4X_BOOL_TRUE : SCD4X_BOOL_FALSE;
+        }
+        
+        return res;
+    }
+    
+    /**
+     * @brief      perform self test
+     * @param[out] &malfunction_detected malfunction detected flag
+     * @return     status code
+     *             - 0 success
+     *             - 1 perform self test failed
+     *             - 4 crc is error
+     */
+    uint8_t perform_self_test(scd4x_bool_t &malfunction_detected) noexcept
+    {
+        if (start_self_test() != 0)
+        {
+            return 1;
+        }
+        
+        return get_self_test_result(malfunction_detected);
+    }
+    
+    /**
+     * @brief  perform factory reset
+     * @return status code
+     *         - 0 success
+     *         - 1 perform factory reset failed
+     * @note   the next bus access waits 1200ms
+     */
+    uint8_t perform_factory_reset() noexcept
+    {
+        return write(frame::kCommand<0x3632>, 1200);
+    }
+    
+    /**
+     * @brief  reinit
+     * @return status code
+     *         - 0 success
+     *         - 1 reinit failed
+     * @note   the next bus access waits 30ms
+     */
+    uint8_t reinit() noexcept
+    {
+        return write(frame::kCommand<0x3646>, 30);
+    }
+    
+    /**
+     * @brief  measure single shot
+     * @return status code
+     *         - 0 success
+     *         - 1 measure single shot failed
+     * @note   the next bus access waits 5000ms
+     */
+    uint8_t measure_single_shot() noexcept requires kHasShot
+    {
+        return write(frame::kCommand<0x219D>, 5000);
+    }
+    
+    /**
+     * @brief  measure single shot rht only
+     * @return status code
+     *         - 0 success
+     *         - 1 measure single shot rht only failed
+     * @note   the next bus access waits 50ms
+     */
+    uint8_t measure_single_shot_rht_only() noexcept requires kHasShot
+    {
+        return write(frame::kCommand<0x2196>, 50);
+    }
+    
+    /**
+     * @brief  power down
+     * @return status code
+     *         - 0 success
+     *         - 1 power down failed
+     */
+    uint8_t power_down() noexcept requires kHasShot
+    {
+        return write(frame::kCommand<0x36E0>, 1);
+    }
+    
+    /**
+     * @brief  wake up
+     * @return status code
+     *         - 0 success
+     * @note   the sensor does not acknowledge wake up, the next bus access waits 30ms
+     */
+    uint8_t wake_up() noexcept requires kHasShot
+    {
+        (void)write(frame::kCommand<0x36F6>, 30);
+        set_pending(30);
+        
+        return 0;
+    }
+    
+    /**
+     * @brief     set automatic self calibration initial period
+     * @param[in] hour period in hours
+     * @return    status code
+     *            - 0 success
+     *            - 1 set automatic self calibration initial period failed
+     *            - 5 hour is not integer multiples of 4
+     */
+    uint8_t set_automatic_self_calibration_initial_period(uint16_t hour) noexcept requires kHasShot
+    {
+        if ((hour % 4) != 0)
+        {
+            return 5;
+        }
+        
+        return write(frame::command(0x2445, hour), 1);
+    }
+    
+    /**
+     * @brief      get automatic self calibration initial period
+     * @param[out] &hour period in hours
+     * @return     status code
+     *             - 0 success
+     *             - 1 get automatic self calibration initial period failed
+     *             - 5 crc is error
+     */
+    uint8_t get_automatic_self_calibration_initial_period(uint16_t &hour) noexcept requires kHasShot
+    {
+        uint8_t res = read_words<0x2340>(&hour, 1);
+        
+        return (res == 4) ? 5 : res;
+    }
+    
+    /**
+     * @brief     set automatic self calibration standard period
+     * @param[in] hour period in hours
+     * @return    status code
+     *            - 0 success
+     *            - 1 set automatic self calibration standard period failed
+     *            - 5 hour is not integer multiples of 4
+     */
+    uint8_t set_automatic_self_calibration_standard_period(uint16_t hour) noexcept requires kHasShot
+    {
+        if ((hour % 4) != 0)
+        {
+            return 5;
+        }
+        
+        return write(frame::command(0x244E, hour), 1);
+    }
+    
+    /**
+     * @brief      get automatic self calibration standard period
+     * @param[out] &hour period in hours
+     * @return     status code
+     *             - 0 success
+     *             - 1 get automatic self calibration standard period failed
+     *             - 5 crc is error
+     */
+    uint8_t get_automatic_self_calibration_standard_period(uint16_t &hour) noexcept requires kHasShot
+    {
+        uint8_t res = read_words<0x234B>(&hour, 1);
+        
+        return (res == 4) ? 5 : res;
+    }
+    
+    /**
+     * @brief  get the rest of the pending command execution time
+     * @return rest time in us
+     */
+    uint32_t pending_time_us() noexcept
+    {
+        uint64_t wait_us = (uint64_t)m_wait_ms * 1000;
+        
+        if constexpr (TimedTransport<T>)
+        {
+            uint64_t elapsed_us = m_transport.now_us() - m_cmd_time_us;
+            
+            wait_us = (elapsed_us < wait_us) ? (wait_us - elapsed_us) : 0;
+        }
+        
+        return (uint32_t)wait_us;
+    }
+    
+  private:
+    uint64_t now_us() noexcept
+    {
+        if constexpr (TimedTransport<T>)
+        {
+            return m_transport.now_us();
+        }
+        else
+        {
+            return 0;
+        }
+    }
+    
+    void set_pending(uint32_t ms) noexcept
+    {
+        m_wait_ms = ms;
+        if constexpr (TimedTransport<T>)
+        {
+            m_cmd_time_us = m_transport.now_us();
+        }
+    }
+    
+    void wait_pending() noexcept
+    {
+        if (m_wait_ms == 0)
+        {
+            return;
+        }
+        if constexpr (TimedTransport<T>)
+        {
+            uint32_t us = pending_time_us();
+            
+            if (us != 0)
+            {
+                m_transport.delay_ms((us + 999) / 1000);
+            }
+        }
+        else
+        {
+            m_transport.delay_ms(m_wait_ms);
+        }
+        m_wait_ms = 0;
+    }
+    
+    template <std::size_t N>
+    uint8_t write(const std::array<uint8_t, N> &buf, uint32_t exec_ms) noexcept
+    {
+        wait_pending();
+        if (m_transport.write(buf.data(), (uint16_t)N) != 0)
+        {
+            return 1;
+        }
+        set_pending(exec_ms);
+        
+        return 0;
+    }
+    
+    uint8_t read_response(uint16_t *word, std::size_t n) noexcept
+    {
+        uint8_t buf[9];
+        
+        wait_pending();
+        if (m_transport.read(buf, (uint16_t)(n * 3)) != 0)
+        {
+            return 1;
+        }
+        for (std::size_t i = 0; i < n; i++)
+        {
+            if (buf[i * 3 + 2] != frame::crc(buf[i * 3], buf[i * 3 + 1]))
+            {
+                return 4;
+            }
+            word[i] = (uint16_t)(((uint16_t)buf[i * 3]) << 8) | buf[i * 3 + 1];
+        }
+        
+        return 0;
+    }
+    
+    template <uint16_t Cmd>
+    uint8_t read_words(uint16_t *word, std::size_t n) noexcept
+    {
+        if (write(frame::kCommand<Cmd>, 1) != 0)
+        {
+            return 1;
+        }
+        
+        return read_response(word, n);
+    }
+    
+    T m_transport;                  /**< bus transport */
+    uint32_t m_wait_ms = 0;         /**< pending command execution time */
+    uint64_t m_cmd_time_us = 0;     /**< pending command issue time */
+};
+
+}
+
+/**
+ * @}
+ */
+
+#endif
@@ -0,0 +1,209 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_scd4x_variant_benchmark.cpp
+ * @brief     driver scd4x variant benchmark source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+/*
+ * build and run on the host:
+ *   gcc -O2 -c -I../src ../src/driver_scd4x.c -o driver_scd4x.o
+ *   g++ -O2 -std=c++20 -I../src -I../interface -I. driver_scd4x_variant_benchmark.cpp driver_scd4x.o -o scd4x_variant_benchmark
+ *   ./scd4x_variant_benchmark
+ */
+
+#include "driver_scd4x_variant.hpp"
+#include <chrono>
+#include <cstdarg>
+#include <cstdio>
+#include <cstdlib>
+
+namespace
+{
+
+/**
+ * @brief in memory sensor answering every command at once
+ */
+struct FakeBus
+{
+    uint16_t cmd = 0;
+    
+    static void put(uint8_t *buf, uint16_t value) noexcept
+    {
+        buf[0] = (uint8_t)(value >> 8);
+        buf[1] = (uint8_t)(value & 0xFF);
+        buf[2] = scd4x::frame::crc(buf[0], buf[1]);
+    }
+    
+    uint8_t write(const uint8_t *buf, uint16_t len) noexcept
+    {
+        (void)len;
+        cmd = (uint16_t)(((uint16_t)buf[0]) << 8) | buf[1];
+        
+        return 0;
+    }
+    
+    uint8_t read(uint8_t *buf, uint16_t len) noexcept
+    {
+        for (uint16_t i = 0; i + 2 < len; i += 3)
+        {
+            put(&buf[i], (cmd == 0xE4B8) ? 0x8006 : (uint16_t)(0x0258 + i));
+        }
+        
+        return 0;
+    }
+};
+
+FakeBus gs_bus;
+
+/**
+ * @brief transport of the template path
+ */
+struct FakeTransport
+{
+    uint8_t write(const uint8_t *buf, uint16_t len) noexcept
+    {
+        return gs_bus.write(buf, len);
+    }
+    
+    uint8_t read(uint8_t *buf, uint16_t len) noexcept
+    {
+        return gs_bus.read(buf, len);
+    }
+    
+    void delay_ms(uint32_t ms) noexcept
+    {
+        (void)ms;
+    }
+};
+
+uint8_t fake_init(void)
+{
+    return 0;
+}
+
+uint8_t fake_write(uint8_t addr, uint8_t *buf, uint16_t len)
+{
+    (void)addr;
+    
+    return gs_bus.write(buf, len);
+}
+
+uint8_t fake_read(uint8_t addr, uint8_t *buf, uint16_t len)
+{
+    (void)addr;
+    
+    return gs_bus.read(buf, len);
+}
+
+void fake_delay_ms(uint32_t ms)
+{
+    (void)ms;
+}
+
+void fake_print(const char *const fmt, ...)
+{
+    (void)fmt;
+}
+
+volatile uint32_t gs_sink;
+
+/**
+ * @brief     time a loop
+ * @param[in] name benchmark name
+ * @param[in] n iteration count
+ * @param[in] f body
+ * @return    ns per iteration
+ */
+template <typename F>
+double bench(const char *name, uint32_t n, F &&f)
+{
+    auto start = std::chrono::steady_clock::now();
+    
+    for (uint32_t i = 0; i < n; i++)
+    {
+        f(i);
+    }
+    double ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / n;
+    printf("%-40s %8.1f ns/op\n", name, ns);
+    
+    return ns;
+}
+
+}
+
+int main(int argc, char **argv)
+{
+    uint32_t n = 1000000;
+    scd4x_handle_t handle;
+    scd4x::Scd4x<SCD41, FakeTransport> dev;
+    scd4x_sample_t sample;
+    
+    if (argc > 1)
+    {
+        n = (uint32_t)strtoul(argv[1], nullptr, 10);
+    }
+    
+    DRIVER_SCD4X_LINK_INIT(&handle, scd4x_handle_t);
+    DRIVER_SCD4X_LINK_IIC_INIT(&handle, fake_init);
+    DRIVER_SCD4X_LINK_IIC_DEINIT(&handle, fake_init);
+    DRIVER_SCD4X_LINK_IIC_WRITE_COMMAND(&handle, fake_write);
+    DRIVER_SCD4X_LINK_IIC_READ_COMMAND(&handle, fake_read);
+    DRIVER_SCD4X_LINK_DELAY_MS(&handle, fake_delay_ms);
+    DRIVER_SCD4X_LINK_DEBUG_PRINT(&handle, fake_print);
+    (void)scd4x_set_type(&handle, SCD41);
+    if (scd4x_init(&handle) != 0)
+    {
+        return 1;
+    }
+    
+    bench("c handle read sample", n, [&](uint32_t) {
+        gs_sink = gs_sink + scd4x_read_sample(&handle, &sample) + sample.co2_raw;
+    });
+    bench("template read sample", n, [&](uint32_t) {
+        gs_sink = gs_sink + dev.read(sample) + sample.co2_raw;
+    });
+    bench("c handle set temperature offset", n, [&](uint32_t i) {
+        gs_sink = gs_sink + scd4x_set_temperature_offset(&handle, (uint16_t)i);
+    });
+    bench("template set temperature offset", n, [&](uint32_t i) {
+        gs_sink = gs_sink + dev.set_temperature_offset((uint16_t)i);
+    });
+    bench("c handle single shot and power down", n, [&](uint32_t) {
+        gs_sink = gs_sink + scd4x_measure_single_shot(&handle) + scd4x_power_down(&handle);
+    });
+    bench("template single shot and power down", n, [&](uint32_t) {
+        gs_sink = gs_sink + dev.measure_single_shot() + dev.power_down();
+    });
+    
+    return (gs_sink == 0) ? 1 : 0;
+}
@@ -0,0 +1,91 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_scd4x_variant_reject.cpp
+ * @brief     driver scd4x variant compile fail check source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+/*
+ * this file must not compile with the default SCD40, the single shot is missing on the scd40,
+ * it must compile with -DSCD4X_VARIANT_REJECT_TYPE=SCD41 so the check fails for no other reason:
+ *   g++ -std=c++20 -fsyntax-only -I../src -I../interface -I. -DSCD4X_VARIANT_REJECT_TYPE=SCD41 driver_scd4x_variant_reject.cpp
+ *   ! g++ -std=c++20 -fsyntax-only -I../src -I../interface -I. driver_scd4x_variant_reject.cpp
+ */
+
+#include "driver_scd4x_variant.hpp"
+
+#ifndef SCD4X_VARIANT_REJECT_TYPE
+    #define SCD4X_VARIANT_REJECT_TYPE SCD40
+#endif
+
+namespace
+{
+
+/**
+ * @brief transport without a bus
+ */
+struct NullTransport
+{
+    uint8_t write(const uint8_t *buf, uint16_t len) noexcept
+    {
+        (void)buf;
+        (void)len;
+        
+        return 0;
+    }
+    
+    uint8_t read(uint8_t *buf, uint16_t len) noexcept
+    {
+        (void)buf;
+        (void)len;
+        
+        return 0;
+    }
+    
+    void delay_ms(uint32_t ms) noexcept
+    {
+        (void)ms;
+    }
+};
+
+}
+
+/**
+ * @brief     run a single shot on the checked variant
+ * @param[in] &dev reference to a variant driver
+ * @return    status code
+ * @note      requires kHasShot rejects this call on the scd40
+ */
+uint8_t scd4x_variant_reject(scd4x::Scd4x<SCD4X_VARIANT_REJECT_TYPE, NullTransport> &dev)
+{
+    return dev.measure_single_shot();
+}
@@ -49,6 +49,9 @@ static scd4x_handle_t gs_handle;        /**< scd4x handle */
 uint8_t scd4x_basic_init(scd4x_t type)
 {
     uint8_t res;
+#if (SCD4X_CONFIG_ACCOUNTING != 0)
+    scd4x_energy_model_t model;
+#endif
     
     /* link functions */
     DRIVER_SCD4X_LINK_INIT(&gs_handle, scd4x_handle_t);
@@ -57,6 +60,7 @@ uint8_t scd4x_basic_init(scd4x_t type)
     DRIVER_SCD4X_LINK_IIC_WRITE_COMMAND(&gs_handle, scd4x_interface_iic_write_cmd);
     DRIVER_SCD4X_LINK_IIC_READ_COMMAND(&gs_handle, scd4x_interface_iic_read_cmd);
     DRIVER_SCD4X_LINK_DELAY_MS(&gs_handle, scd4x_interface_delay_ms);
+    DRIVER_SCD4X_LINK_GET_TIME_US(&gs_handle, scd4x_interface_get_time_us);
     DRIVER_SCD4X_LINK_DEBUG_PRINT(&gs_handle, scd4x_interface_debug_print);
 
     /* set chip type */
@@ -77,6 +81,19 @@ uint8_t scd4x_basic_init(scd4x_t type)
         return 1;
     }
     
+#if (SCD4X_CONFIG_ACCOUNTING != 0)
+    /* account the energy from the idle state */
+    (void)scd4x_energy_default_model(&model);
+    res = scd4x_account_start(&gs_handle, &model, SCD4X_ACCOUNT_IDLE);
+    if (res != 0)
+    {
+        scd4x_interface_debug_print("scd4x: account start failed.\n");
+        (void)scd4x_deinit(&gs_handle);
+        
+        return 1;
+    }
+#endif
+    
     /* start */
     res = scd4x_start_periodic_measurement(&gs_handle);
     if (res != 0)
@@ -143,6 +160,32 @@ uint8_t scd4x_basic_deinit(void)
     return 0;
 }
 
+#if (SCD4X_CONFIG_ACCOUNTING != 0)
+/**
+ * @brief      basic example get charge
+ * @param[out] *charge_uah pointer to a charge buffer
+ * @param[out] *average_ua pointer to an average current buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 get charge failed
+ * @note       estimated from the default energy model since the init
+ */
+uint8_t scd4x_basic_get_charge(float *charge_uah, float *average_ua)
+{
+    scd4x_account_stats_t stats;
+    
+    /* get account stats */
+    if (scd4x_get_account_stats(&gs_handle, &stats) != 0)
+    {
+        return 1;
+    }
+    *charge_uah = stats.charge_uah;
+    *average_ua = stats.average_ua;
+    
+    return 0;
+}
+#endif
+
 /**
  * @brief      basic example get serial number
  * @param[out] *num pointer to a number buffer
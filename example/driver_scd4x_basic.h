@@ -81,6 +81,19 @@ uint8_t scd4x_basic_deinit(void);
  */
 uint8_t scd4x_basic_read(uint16_t *co2_ppm, float *temperature, float *humidity);
 
+#if (SCD4X_CONFIG_ACCOUNTING != 0)
+/**
+ * @brief      basic example get charge
+ * @param[out] *charge_uah pointer to a charge buffer
+ * @param[out] *average_ua pointer to an average current buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 get charge failed
+ * @note       estimated from the default energy model since the init
+ */
+uint8_t scd4x_basic_get_charge(float *charge_uah, float *average_ua);
+#endif
+
 /**
  * @brief      basic example get serial number
  * @param[out] *num pointer to a number buffer
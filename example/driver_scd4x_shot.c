@@ -49,6 +49,9 @@ static scd4x_handle_t gs_handle;        /**< scd4x handle */
 uint8_t scd4x_shot_init(scd4x_t type)
 {
     uint8_t res;
+#if (SCD4X_CONFIG_ACCOUNTING != 0)
+    scd4x_energy_model_t model;
+#endif
     
     /* link functions */
     DRIVER_SCD4X_LINK_INIT(&gs_handle, scd4x_handle_t);
@@ -57,6 +60,7 @@ uint8_t scd4x_shot_init(scd4x_t type)
     DRIVER_SCD4X_LINK_IIC_WRITE_COMMAND(&gs_handle, scd4x_interface_iic_write_cmd);
     DRIVER_SCD4X_LINK_IIC_READ_COMMAND(&gs_handle, scd4x_interface_iic_read_cmd);
     DRIVER_SCD4X_LINK_DELAY_MS(&gs_handle, scd4x_interface_delay_ms);
+    DRIVER_SCD4X_LINK_GET_TIME_US(&gs_handle, scd4x_interface_get_time_us);
     DRIVER_SCD4X_LINK_DEBUG_PRINT(&gs_handle, scd4x_interface_debug_print);
 
     /* set chip type */
@@ -77,6 +81,19 @@ uint8_t scd4x_shot_init(scd4x_t type)
         return 1;
     }
     
+#if (SCD4X_CONFIG_ACCOUNTING != 0)
+    /* account the energy from the idle state */
+    (void)scd4x_energy_default_model(&model);
+    res = scd4x_account_start(&gs_handle, &model, SCD4X_ACCOUNT_IDLE);
+    if (res != 0)
+    {
+        scd4x_interface_debug_print("scd4x: account start failed.\n");
+        (void)scd4x_deinit(&gs_handle);
+        
+        return 1;
+    }
+#endif
+    
     return 0;
 }
 
@@ -94,8 +111,9 @@ uint8_t scd4x_shot_init(scd4x_t type)
 uint8_t scd4x_shot_read(uint16_t *co2_ppm, float *temperature, float *humidity)
 {
     uint8_t res;
-    uint32_t timeout;
-    scd4x_bool_t enable;
+    uint16_t co2_raw;
+    uint16_t temperature_raw;
+    uint16_t humidity_raw;
     
     /* measure single shot */
     res = scd4x_measure_single_shot(&gs_handle);
@@ -104,47 +122,70 @@ uint8_t scd4x_shot_read(uint16_t *co2_ppm, float *temperature, float *humidity)
         return 1;
     }
     
-    /* set 30s */
-    timeout = 30;
-    
-    /* check timeout */
-    while (timeout != 0)
+    /* wait data ready in 30s */
+    res = scd4x_wait_data_ready(&gs_handle, 30000);
+    if (res == 5)
+    {
+        return 2;
+    }
+    else if (res != 0)
+    {
+        return 1;
+    }
+    else
     {
-        /* delay 1000ms */
-        scd4x_interface_delay_ms(1000);
-        
-        /* timeout-- */
-        timeout--;
-        
         /* read data */
-        res = scd4x_get_data_ready_status(&gs_handle, &enable);
+        res = scd4x_read(&gs_handle, &co2_raw, co2_ppm,
+                         &temperature_raw, temperature,
+                         &humidity_raw, humidity);
         if (res != 0)
         {
             return 1;
         }
-        if (enable == SCD4X_BOOL_TRUE)
-        {
-            uint16_t co2_raw;
-            uint16_t temperature_raw;
-            uint16_t humidity_raw;
-            
-            /* read data */
-            res = scd4x_read(&gs_handle, &co2_raw, co2_ppm,
-                             &temperature_raw, temperature,
-                             &humidity_raw, humidity);
-            if (res != 0)
-            {
-                return 1;
-            }
-            
-            break;
-        }
     }
-    if (timeout == 0)
+    
+    return 0;
+}
+
+/**
+ * @brief      shot example sleepy read
+ * @param[out] *co2_ppm pointer to a converted co2 buffer
+ * @param[out] *temperature pointer to a converted temperature buffer
+ * @param[out] *humidity pointer to a converted humidity buffer
+ * @param[out] *charge_uc pointer to an estimated charge buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ * @note       the chip sleeps between the readings, each reading wakes it up,
+ *             drops the first shot, reads the second one and powers it down
+ */
+uint8_t scd4x_shot_sleepy_read(uint16_t *co2_ppm, float *temperature, float *humidity, float *charge_uc)
+{
+    uint8_t res;
+    scd4x_sample_t sample;
+    scd4x_energy_model_t model;
+    
+    /* power down between the readings */
+    res = scd4x_set_sleepy_shot(&gs_handle, SCD4X_BOOL_TRUE, SCD4X_BOOL_FALSE);
+    if (res != 0)
+    {
+        return 1;
+    }
+    
+    /* wake up, measure, read and power down */
+    res = scd4x_read_sleepy_shot(&gs_handle, &sample);
+    if (res != 0)
     {
-        return 2;
+        return 1;
     }
     
+    /* get the estimated charge */
+    (void)scd4x_energy_default_model(&model);
+    (void)scd4x_get_sleepy_shot_charge(&gs_handle, &model, charge_uc);
+    *co2_ppm = sample.co2_ppm;
+    *temperature = sample.temperature_s;
+    *humidity = sample.humidity_s;
+    
     return 0;
 }
 
@@ -166,6 +207,32 @@ uint8_t scd4x_shot_deinit(void)
     return 0;
 }
 
+#if (SCD4X_CONFIG_ACCOUNTING != 0)
+/**
+ * @brief      shot example get charge
+ * @param[out] *charge_uah pointer to a charge buffer
+ * @param[out] *average_ua pointer to an average current buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 get charge failed
+ * @note       estimated from the default energy model since the init
+ */
+uint8_t scd4x_shot_get_charge(float *charge_uah, float *average_ua)
+{
+    scd4x_account_stats_t stats;
+    
+    /* get account stats */
+    if (scd4x_get_account_stats(&gs_handle, &stats) != 0)
+    {
+        return 1;
+    }
+    *charge_uah = stats.charge_uah;
+    *average_ua = stats.average_ua;
+    
+    return 0;
+}
+#endif
+
 /**
  * @brief      shot example get serial number
  * @param[out] *num pointer to a number buffer
@@ -80,6 +80,33 @@ uint8_t scd4x_shot_deinit(void);
  */
 uint8_t scd4x_shot_read(uint16_t *co2_ppm, float *temperature, float *humidity);
 
+/**
+ * @brief      shot example sleepy read
+ * @param[out] *co2_ppm pointer to a converted co2 buffer
+ * @param[out] *temperature pointer to a converted temperature buffer
+ * @param[out] *humidity pointer to a converted humidity buffer
+ * @param[out] *charge_uc pointer to an estimated charge buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ * @note       the chip sleeps between the readings, each reading wakes it up,
+ *             drops the first shot, reads the second one and powers it down
+ */
+uint8_t scd4x_shot_sleepy_read(uint16_t *co2_ppm, float *temperature, float *humidity, float *charge_uc);
+
+#if (SCD4X_CONFIG_ACCOUNTING != 0)
+/**
+ * @brief      shot example get charge
+ * @param[out] *charge_uah pointer to a charge buffer
+ * @param[out] *average_ua pointer to an average current buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 get charge failed
+ * @note       estimated from the default energy model since the init
+ */
+uint8_t scd4x_shot_get_charge(float *charge_uah, float *average_ua);
+#endif
+
 /**
  * @brief      shot example get serial number
  * @param[out] *num pointer to a number buffer
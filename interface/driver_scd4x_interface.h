@@ -99,6 +99,14 @@ uint8_t scd4x_interface_iic_read_cmd(uint8_t addr, uint8_t *buf, uint16_t len);
  */
 void scd4x_interface_delay_ms(uint32_t ms);
 
+/**
+ * @brief  interface get time us
+ * @return monotonic time in us
+ * @note   the time must never stop or go back, don't link it with DRIVER_SCD4X_LINK_GET_TIME_US
+ *         if the platform has no such clock
+ */
+uint64_t scd4x_interface_get_time_us(void);
+
 /**
  * @brief     interface print format data
  * @param[in] fmt format data
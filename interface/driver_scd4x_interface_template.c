@@ -100,6 +100,17 @@ void scd4x_interface_delay_ms(uint32_t ms)
 
 }
 
+/**
+ * @brief  interface get time us
+ * @return monotonic time in us
+ * @note   the time must never stop or go back, don't link it with DRIVER_SCD4X_LINK_GET_TIME_US
+ *         if the platform has no such clock
+ */
+uint64_t scd4x_interface_get_time_us(void)
+{
+    return 0;
+}
+
 /**
  * @brief     interface print format data
  * @param[in] fmt format data
@@ -0,0 +1,62 @@
+#!/bin/sh
+#
+# Copyright (c) 2015 - present LibDriver All rights reserved
+#
+# The MIT License (MIT)
+#
+# Permission is hereby granted, free of charge, to any person obtaining a copy
+# of this software and associated documentation files (the "Software"), to deal
+# in the Software without restriction, including without limitation the rights
+# to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+# copies of the Software, and to permit persons to whom the Software is
+# furnished to do so, subject to the following conditions:
+#
+# The above copyright notice and this permission notice shall be included in all
+# copies or substantial portions of the Software.
+#
+# THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+# IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+# FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+# AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+# LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+# OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+# SOFTWARE.
+#
+
+# print the driver .text and .rodata size of each command configuration
+# usage: size.sh <src dir> [cc] [size]
+# e.g. size.sh ../../src arm-none-eabi-gcc arm-none-eabi-size
+
+SRC_DIR=${1:-../../src}
+CC=${2:-gcc}
+SIZE=${3:-size}
+CFLAGS=${SIZE_CFLAGS:--Os -ffunction-sections -fdata-sections}
+OUT=$(mktemp -d)
+
+# set the configurations, name:flags
+MIN="-DSCD4X_CONFIG_COMPENSATION=0 -DSCD4X_CONFIG_CONVERT=0 -DSCD4X_CONFIG_FRC=0 -DSCD4X_CONFIG_ASC=0 \
+-DSCD4X_CONFIG_PERSIST=0 -DSCD4X_CONFIG_SELF_TEST=0 -DSCD4X_CONFIG_FACTORY_RESET=0 -DSCD4X_CONFIG_REG=0 \
+-DSCD4X_CONFIG_ADAPTIVE=0 -DSCD4X_CONFIG_ACCOUNTING=0"
+
+report()
+{
+    if ! $CC $CFLAGS $2 -I "$SRC_DIR" -c "$SRC_DIR/driver_scd4x.c" -o "$OUT/$1.o"; then
+        rm -rf "$OUT"
+        exit 1
+    fi
+    $SIZE -A "$OUT/$1.o" | awk -v name="$1" '
+        $1 ~ /^\.text/ { text += $2 }
+        $1 ~ /^\.rodata/ || $1 ~ /^\.data\.rel\.ro/ { rodata += $2 }
+        END { printf "%-16s %8d %8d\n", name, text, rodata }'
+}
+
+printf "%-16s %8s %8s\n" "config" ".text" ".rodata"
+report full "-DSCD4X_CONFIG_ADAPTIVE=1 -DSCD4X_CONFIG_ACCOUNTING=1"
+report default ""
+report periodic "$MIN -DSCD4X_CONFIG_SINGLE_SHOT=0"
+report shot "$MIN"
+report no_maintenance "-DSCD4X_CONFIG_FRC=0 -DSCD4X_CONFIG_SELF_TEST=0 -DSCD4X_CONFIG_FACTORY_RESET=0 -DSCD4X_CONFIG_REG=0"
+if [ -n "$SCD4X_CONFIG_FILE" ]; then
+    report custom "-DSCD4X_CONFIG_FILE=\"$SCD4X_CONFIG_FILE\""
+fi
+rm -rf "$OUT"
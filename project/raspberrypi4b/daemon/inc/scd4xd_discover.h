@@ -0,0 +1,110 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      scd4xd_discover.h
+ * @brief     scd4xd discover header file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#ifndef SCD4XD_DISCOVER_H
+#define SCD4XD_DISCOVER_H
+
+#include "driver_scd4x.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @addtogroup scd4xd
+ * @{
+ */
+
+/**
+ * @brief scd4xd discover definition
+ */
+#define SCD4XD_DISCOVER_MAX          256        /**< max probed locations */
+#define SCD4XD_DISCOVER_NAME         32         /**< max location name length */
+
+/**
+ * @brief scd4xd device structure definition
+ */
+typedef struct scd4xd_device_s
+{
+    char bus[SCD4XD_DISCOVER_NAME];        /**< iic device like /dev/i2c-3, or sim-<adapter>-<channel> */
+    scd4x_t type;                          /**< chip variant */
+    uint64_t serial;                       /**< 48 bits serial number */
+} scd4xd_device_t;
+
+/**
+ * @brief      list the iic devices
+ * @param[out] bus pointer to a location name buffer
+ * @param[in]  max max location number
+ * @return     location number
+ * @note       every /dev/i2c-N, the channels of a kernel iic mux are iic devices too
+ */
+uint16_t scd4xd_discover_scan(char bus[][SCD4XD_DISCOVER_NAME], uint16_t max);
+
+/**
+ * @brief      get the root adapter of a location
+ * @param[in]  *bus pointer to a location name
+ * @param[out] *root pointer to a root name buffer
+ * @note       a mux channel is a child of its parent adapter in sysfs,
+ *             a sim-<adapter>-<channel> location belongs to sim-<adapter>
+ */
+void scd4xd_discover_root(const char *bus, char root[SCD4XD_DISCOVER_NAME]);
+
+/**
+ * @brief      probe the locations and find the sensors
+ * @param[in]  **bus pointer to a location name list
+ * @param[in]  num location number
+ * @param[out] *device pointer to a device buffer of num devices
+ * @param[out] *found pointer to a found device number buffer
+ * @param[out] *workers pointer to a worker number buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 discover failed
+ * @note       one worker runs the locations of each root adapter, the mux channels share their root adapter,
+ *             every command is sent to all locations of a worker before the next one,
+ *             so the execution times overlap and the time depends on the bus number instead of the sensor number,
+ *             the sensors are left stopped and idle
+ */
+uint8_t scd4xd_discover(const char *const *bus, uint16_t num, scd4xd_device_t *device, uint16_t *found, uint16_t *workers);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,162 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      scd4xd_health.h
+ * @brief     scd4xd health header file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#ifndef SCD4XD_HEALTH_H
+#define SCD4XD_HEALTH_H
+
+#include "driver_scd4x.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @addtogroup scd4xd
+ * @{
+ */
+
+/**
+ * @brief scd4xd health definition
+ */
+#define SCD4XD_HEALTH_RETRIES           3             /**< default consecutive failures of each rung */
+#define SCD4XD_HEALTH_POWER_UP_US       30000         /**< power up time after the power cycle hook */
+
+/**
+ * @brief scd4xd health rung enumeration definition
+ */
+typedef enum
+{
+    SCD4XD_HEALTH_RUNG_RETRY         = 0x00,        /**< retry the poll */
+    SCD4XD_HEALTH_RUNG_REINIT        = 0x01,        /**< stop, reinit and start */
+    SCD4XD_HEALTH_RUNG_RESTART       = 0x02,        /**< wake up, stop and start */
+    SCD4XD_HEALTH_RUNG_POWER_CYCLE   = 0x03,        /**< power cycle hook, stop and start */
+    SCD4XD_HEALTH_RUNG_FACTORY_RESET = 0x04,        /**< stop, factory reset and start */
+    SCD4XD_HEALTH_RUNGS              = 0x05,        /**< rung number */
+} scd4xd_health_rung_t;
+
+/**
+ * @brief scd4xd health config structure definition
+ */
+typedef struct scd4xd_health_config_s
+{
+    uint8_t retries;                       /**< consecutive failures before the next rung */
+    uint8_t low_power;                     /**< 1 to restart the low power periodic measurement */
+    uint8_t factory_reset;                 /**< 1 to allow one factory reset in each outage */
+    uint64_t stall_us;                     /**< time without a sample which escalates at once */
+    uint8_t (*power_cycle)(void *arg);     /**< power cycle hook, NULL to skip the rung */
+    void *arg;                             /**< hook argument */
+} scd4xd_health_config_t;
+
+/**
+ * @brief scd4xd health stats structure definition
+ */
+typedef struct scd4xd_health_stats_s
+{
+    uint32_t failures;                             /**< failed polls */
+    uint32_t stalls;                               /**< data ready stalls */
+    uint32_t attempts[SCD4XD_HEALTH_RUNGS];        /**< recoveries run on each rung */
+    uint32_t recovered[SCD4XD_HEALTH_RUNGS];       /**< outages ended on each rung */
+    uint32_t ladders;                              /**< times the ladder restarted from reinit */
+    uint64_t down_us;                              /**< downtime of the ended outages */
+    uint64_t recover_max_us;                       /**< longest time to recover */
+} scd4xd_health_stats_t;
+
+/**
+ * @brief scd4xd health structure definition
+ */
+typedef struct scd4xd_health_s
+{
+    const scd4xd_health_config_t *config;  /**< config */
+    uint8_t rung;                          /**< current rung */
+    uint8_t op;                            /**< next command of the rung, 0 if no recovery runs */
+    uint8_t reset_done;                    /**< 1 if the factory reset ran in this outage */
+    uint32_t failures;                     /**< consecutive failures */
+    uint64_t watch_us;                     /**< last sample or recovery end time */
+    uint64_t down_us;                      /**< outage start time, 0 if healthy */
+    scd4xd_health_stats_t stats;           /**< stats */
+} scd4xd_health_t;
+
+/**
+ * @brief     init the health of a sensor
+ * @param[in] *health pointer to a health structure
+ * @param[in] *config pointer to a config shared by the sensors
+ * @param[in] now_us current time
+ * @note      the sensor is healthy and the stall timer starts now
+ */
+void scd4xd_health_init(scd4xd_health_t *health, const scd4xd_health_config_t *config, uint64_t now_us);
+
+/**
+ * @brief     report a scd4x_poll_sample result
+ * @param[in] *health pointer to a health structure
+ * @param[in] res scd4x_poll_sample status code
+ * @param[in] now_us current time
+ * @return    1 if a recovery is started, then call scd4xd_health_run until op is 0
+ * @note      every retries consecutive failures, or a stall, climb one rung,
+ *            the ladder restarts from reinit after the last enabled rung
+ */
+uint8_t scd4xd_health_report(scd4xd_health_t *health, uint8_t res, uint64_t now_us);
+
+/**
+ * @brief      run the next command of the recovery
+ * @param[in]  *health pointer to a health structure
+ * @param[in]  *handle pointer to an scd4x handle structure
+ * @param[in]  now_us current time
+ * @param[out] *wait_us pointer to the time before the next call
+ * @return     status code
+ *             - 0 success, the recovery runs until op is 0
+ *             - 1 command failed and the recovery ended
+ * @note       one command each call and its execution time is returned instead of waited,
+ *             so an event loop is never blocked, the power cycle hook is called synchronously
+ */
+uint8_t scd4xd_health_run(scd4xd_health_t *health, scd4x_handle_t *handle, uint64_t now_us, uint32_t *wait_us);
+
+/**
+ * @brief     add the stats of a sensor to a total
+ * @param[in] *total pointer to a total stats
+ * @param[in] *stats pointer to the stats of a sensor
+ * @note      none
+ */
+void scd4xd_health_add_stats(scd4xd_health_stats_t *total, const scd4xd_health_stats_t *stats);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
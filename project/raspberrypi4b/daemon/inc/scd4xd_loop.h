@@ -0,0 +1,225 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      scd4xd_loop.h
+ * @brief     scd4xd event loop header file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#ifndef SCD4XD_LOOP_H
+#define SCD4XD_LOOP_H
+
+#include <stdint.h>
+#include <sys/epoll.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @addtogroup scd4xd
+ * @{
+ */
+
+/**
+ * @brief scd4xd loop definition
+ */
+#define SCD4XD_LOOP_EVENTS        64                 /**< max events of one epoll_wait */
+#define SCD4XD_LOOP_IDLE          0xFFFFFFFFU        /**< heap index of a stopped timer */
+#define SCD4XD_LOOP_BUCKETS       24                 /**< lateness histogram buckets */
+
+/**
+ * @brief scd4xd loop fd callback definition
+ */
+typedef void (*scd4xd_loop_fd_cb_t)(void *arg, uint32_t events);
+
+/**
+ * @brief scd4xd loop timer callback definition
+ */
+typedef void (*scd4xd_loop_timer_cb_t)(void *arg);
+
+/**
+ * @brief scd4xd loop watch structure definition
+ */
+typedef struct scd4xd_loop_watch_s
+{
+    int fd;                          /**< watched fd */
+    scd4xd_loop_fd_cb_t cb;          /**< callback */
+    void *arg;                       /**< callback argument */
+} scd4xd_loop_watch_t;
+
+/**
+ * @brief scd4xd loop timer structure definition
+ */
+typedef struct scd4xd_loop_timer_s
+{
+    uint64_t deadline_us;            /**< expiry time of CLOCK_MONOTONIC in us */
+    uint32_t index;                  /**< heap index, SCD4XD_LOOP_IDLE if stopped */
+    scd4xd_loop_timer_cb_t cb;       /**< callback */
+    void *arg;                       /**< callback argument */
+} scd4xd_loop_timer_t;
+
+/**
+ * @brief scd4xd loop structure definition
+ * @note  all timers share one timerfd, which is armed to the earliest deadline of a min heap
+ */
+typedef struct scd4xd_loop_s
+{
+    int epoll_fd;                    /**< epoll fd */
+    int timer_fd;                    /**< timerfd */
+    scd4xd_loop_timer_t **heap;      /**< timer min heap */
+    uint32_t heap_len;               /**< armed timer number */
+    uint32_t heap_size;              /**< heap capacity */
+    uint64_t armed_us;               /**< timerfd deadline, 0 if disarmed */
+    uint8_t stop;                    /**< stop flag */
+    uint8_t expiring;                /**< 1 while the timers run, the timerfd is armed once after them */
+    uint8_t sleeping;                /**< 1 if the timers are run by scd4xd_loop_run_sleep */
+    uint64_t wakeups;                /**< epoll_wait returns */
+    uint64_t fired;                  /**< fired timers */
+    uint64_t late_sum_us;            /**< sum of the timer lateness */
+    uint64_t late_max_us;            /**< max timer lateness */
+    uint32_t late_hist[SCD4XD_LOOP_BUCKETS];        /**< lateness histogram, bucket 0 counts 0 us and bucket n counts [2^(n-1), 2^n) us */
+} scd4xd_loop_t;
+
+/**
+ * @brief     init the loop
+ * @param[in] *loop pointer to a loop structure
+ * @param[in] timers max armed timers
+ * @return    status code
+ *            - 0 success
+ *            - 1 init failed
+ * @note      none
+ */
+uint8_t scd4xd_loop_init(scd4xd_loop_t *loop, uint32_t timers);
+
+/**
+ * @brief     close the loop
+ * @param[in] *loop pointer to a loop structure
+ * @note      the watched fds are not closed
+ */
+void scd4xd_loop_deinit(scd4xd_loop_t *loop);
+
+/**
+ * @brief  get the loop time
+ * @return CLOCK_MONOTONIC in us
+ * @note   none
+ */
+uint64_t scd4xd_loop_now_us(void);
+
+/**
+ * @brief     watch a fd
+ * @param[in] *loop pointer to a loop structure
+ * @param[in] *watch pointer to a watch structure, it must live until removed
+ * @param[in] fd watched fd
+ * @param[in] events epoll events
+ * @param[in] cb callback
+ * @param[in] *arg callback argument
+ * @return    status code
+ *            - 0 success
+ *            - 1 add failed
+ * @note      none
+ */
+uint8_t scd4xd_loop_add_fd(scd4xd_loop_t *loop, scd4xd_loop_watch_t *watch, int fd, uint32_t events,
+                           scd4xd_loop_fd_cb_t cb, void *arg);
+
+/**
+ * @brief     remove a watched fd
+ * @param[in] *loop pointer to a loop structure
+ * @param[in] *watch pointer to a watch structure
+ * @note      call it before closing the fd
+ */
+void scd4xd_loop_del_fd(scd4xd_loop_t *loop, scd4xd_loop_watch_t *watch);
+
+/**
+ * @brief     init a timer
+ * @param[in] *timer pointer to a timer structure
+ * @param[in] cb callback
+ * @param[in] *arg callback argument
+ * @note      none
+ */
+void scd4xd_loop_timer_init(scd4xd_loop_timer_t *timer, scd4xd_loop_timer_cb_t cb, void *arg);
+
+/**
+ * @brief     start or move a one shot timer
+ * @param[in] *loop pointer to a loop structure
+ * @param[in] *timer pointer to a timer structure
+ * @param[in] deadline_us expiry time of CLOCK_MONOTONIC in us
+ * @return    status code
+ *            - 0 success
+ *            - 1 too many timers
+ * @note      O(log n)
+ */
+uint8_t scd4xd_loop_timer_start(scd4xd_loop_t *loop, scd4xd_loop_timer_t *timer, uint64_t deadline_us);
+
+/**
+ * @brief     stop a timer
+ * @param[in] *loop pointer to a loop structure
+ * @param[in] *timer pointer to a timer structure
+ * @note      O(log n)
+ */
+void scd4xd_loop_timer_stop(scd4xd_loop_t *loop, scd4xd_loop_timer_t *timer);
+
+/**
+ * @brief     run the loop until scd4xd_loop_stop
+ * @param[in] *loop pointer to a loop structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 epoll failed
+ * @note      none
+ */
+uint8_t scd4xd_loop_run(scd4xd_loop_t *loop);
+
+/**
+ * @brief     run only the timers with absolute deadline sleeps until scd4xd_loop_stop
+ * @param[in] *loop pointer to a loop structure
+ * @param[in] max_sleep_us max sleep, the stop flag is checked after each sleep
+ * @return    status code
+ *            - 0 success
+ * @note      for a dedicated real time thread, the fds are not watched and the timerfd is not used
+ */
+uint8_t scd4xd_loop_run_sleep(scd4xd_loop_t *loop, uint32_t max_sleep_us);
+
+/**
+ * @brief     stop the loop
+ * @param[in] *loop pointer to a loop structure
+ * @note      the loop returns after the current callbacks, it can be called from another thread
+ */
+void scd4xd_loop_stop(scd4xd_loop_t *loop);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
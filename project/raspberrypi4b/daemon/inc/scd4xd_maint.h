@@ -0,0 +1,215 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      scd4xd_maint.h
+ * @brief     scd4xd maint header file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#ifndef SCD4XD_MAINT_H
+#define SCD4XD_MAINT_H
+
+#include "driver_scd4x.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @addtogroup scd4xd
+ * @{
+ */
+
+/**
+ * @brief scd4xd maint definition
+ */
+#define SCD4XD_MAINT_MAX_JOBS           256           /**< max sensors of one run */
+#define SCD4XD_MAINT_MAX_BUSES          256           /**< max bus groups of one run */
+#define SCD4XD_MAINT_MAX_STEPS          5             /**< stop, two commands of the operation and restore */
+#define SCD4XD_MAINT_FRC_FAILED         0xFFFFU       /**< forced recalibration result of a failed recalibration */
+
+/**
+ * @brief scd4xd maint operation enumeration definition
+ */
+typedef enum
+{
+    SCD4XD_MAINT_OP_SELF_TEST = 0x01,        /**< perform self test, 10000 ms */
+    SCD4XD_MAINT_OP_FRC       = 0x02,        /**< perform forced recalibration, 400 ms */
+    SCD4XD_MAINT_OP_PERSIST   = 0x03,        /**< persist settings, 800 ms */
+} scd4xd_maint_op_t;
+
+/**
+ * @brief scd4xd maint mode enumeration definition
+ */
+typedef enum
+{
+    SCD4XD_MAINT_MODE_IDLE      = 0x00,        /**< idle, nothing to stop or restore */
+    SCD4XD_MAINT_MODE_PERIODIC  = 0x01,        /**< periodic measurement */
+    SCD4XD_MAINT_MODE_LOW_POWER = 0x02,        /**< low power periodic measurement */
+} scd4xd_maint_mode_t;
+
+/**
+ * @brief scd4xd maint state enumeration definition
+ */
+typedef enum
+{
+    SCD4XD_MAINT_STATE_QUEUED  = 0x00,        /**< waiting for a slot of its bus */
+    SCD4XD_MAINT_STATE_ACTIVE  = 0x01,        /**< running */
+    SCD4XD_MAINT_STATE_DONE    = 0x02,        /**< the operation ran and the mode is restored */
+    SCD4XD_MAINT_STATE_FAILED  = 0x03,        /**< a command or the recalibration failed, the mode is restored if possible */
+    SCD4XD_MAINT_STATE_SKIPPED = 0x04,        /**< out of the bus budget or the sensor is down */
+} scd4xd_maint_state_t;
+
+/**
+ * @brief scd4xd maint config structure definition
+ */
+typedef struct scd4xd_maint_config_s
+{
+    uint8_t op;                    /**< operation */
+    uint8_t per_bus;               /**< sensors of one bus running at once, 0 for 1 */
+    uint16_t target_ppm;           /**< forced recalibration reference */
+    uint64_t budget_us;            /**< estimated job time of each bus, 0 for no limit */
+} scd4xd_maint_config_t;
+
+/**
+ * @brief scd4xd maint job structure definition
+ */
+typedef struct scd4xd_maint_job_s
+{
+    uint16_t bus;                                  /**< bus group */
+    uint8_t mode;                                  /**< mode to restore */
+    uint8_t state;                                 /**< job state */
+    uint8_t step;                                  /**< next step */
+    uint8_t steps;                                 /**< step number */
+    uint8_t seq[SCD4XD_MAINT_MAX_STEPS];           /**< steps */
+    uint8_t res;                                   /**< status code of the failed command, 0 if none */
+    uint16_t result;                               /**< 1 if a malfunction is detected or the forced recalibration correction */
+    uint64_t start_us;                             /**< start time */
+    uint64_t end_us;                               /**< end time */
+} scd4xd_maint_job_t;
+
+/**
+ * @brief scd4xd maint structure definition
+ */
+typedef struct scd4xd_maint_s
+{
+    scd4xd_maint_config_t config;                      /**< config */
+    uint16_t jobs;                                     /**< job number */
+    uint16_t buses;                                    /**< bus group number */
+    uint16_t queued;                                   /**< queued jobs */
+    uint16_t active;                                   /**< running jobs */
+    uint16_t done;                                     /**< done jobs */
+    uint16_t failed;                                   /**< failed jobs */
+    uint16_t skipped;                                  /**< skipped jobs */
+    uint64_t start_us;                                 /**< run start time */
+    uint64_t end_us;                                   /**< run end time, 0 while running */
+    uint64_t serial_us;                                /**< summed job time, the window of a one by one run */
+    uint8_t bus_active[SCD4XD_MAINT_MAX_BUSES];        /**< running jobs of each bus */
+    uint64_t bus_used_us[SCD4XD_MAINT_MAX_BUSES];      /**< admitted estimated time of each bus */
+    scd4xd_maint_job_t job[SCD4XD_MAINT_MAX_JOBS];     /**< jobs */
+} scd4xd_maint_t;
+
+/**
+ * @brief     init a maintenance run
+ * @param[in] *maint pointer to a maint structure
+ * @param[in] *config pointer to a config
+ * @param[in] now_us current time
+ * @note      the config is copied, then add a job for each sensor
+ */
+void scd4xd_maint_init(scd4xd_maint_t *maint, const scd4xd_maint_config_t *config, uint64_t now_us);
+
+/**
+ * @brief     add a job
+ * @param[in] *maint pointer to a maint structure
+ * @param[in] bus bus group of the sensor
+ * @param[in] mode measurement mode of the sensor
+ * @return    status code
+ *            - 0 success
+ *            - 1 add failed
+ * @note      the job index is the add order
+ */
+uint8_t scd4xd_maint_add(scd4xd_maint_t *maint, uint16_t bus, uint8_t mode);
+
+/**
+ * @brief      admit the next queued job
+ * @param[in]  *maint pointer to a maint structure
+ * @param[in]  now_us current time
+ * @param[out] *job pointer to a job index buffer
+ * @return     status code
+ *             - 0 success, call scd4xd_maint_run until its state is not active
+ *             - 1 no job can start now
+ * @note       a bus runs at most per_bus jobs at once, a job which doesn't fit
+ *             the rest of its bus budget is skipped and the sensor keeps measuring
+ */
+uint8_t scd4xd_maint_next(scd4xd_maint_t *maint, uint64_t now_us, uint16_t *job);
+
+/**
+ * @brief     skip an admitted job
+ * @param[in] *maint pointer to a maint structure
+ * @param[in] job job index
+ * @param[in] now_us current time
+ * @note      for a sensor which is down, its slot and budget are given back
+ */
+void scd4xd_maint_skip(scd4xd_maint_t *maint, uint16_t job, uint64_t now_us);
+
+/**
+ * @brief      run the next step of a job
+ * @param[in]  *maint pointer to a maint structure
+ * @param[in]  job job index
+ * @param[in]  *handle pointer to an scd4x handle structure
+ * @param[in]  now_us current time
+ * @param[out] *wait_us pointer to the time before the next call
+ * @return     status code
+ *             - 0 success, the job runs until its state is not active
+ *             - 1 command failed
+ * @note       one command each call and its execution time is returned instead of waited,
+ *             a failed command still restores the measurement mode
+ */
+uint8_t scd4xd_maint_run(scd4xd_maint_t *maint, uint16_t job, scd4x_handle_t *handle, uint64_t now_us, uint32_t *wait_us);
+
+/**
+ * @brief     estimate the time of a job
+ * @param[in] op operation
+ * @param[in] mode measurement mode of the sensor
+ * @return    estimated time in us
+ * @note      the execution times of the commands
+ */
+uint64_t scd4xd_maint_estimate_us(uint8_t op, uint8_t mode);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
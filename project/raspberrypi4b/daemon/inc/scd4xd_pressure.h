@@ -0,0 +1,175 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      scd4xd_pressure.h
+ * @brief     scd4xd pressure header file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#ifndef SCD4XD_PRESSURE_H
+#define SCD4XD_PRESSURE_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @addtogroup scd4xd
+ * @{
+ */
+
+/**
+ * @brief scd4xd pressure definition
+ */
+#define SCD4XD_PRESSURE_MAX_SENSORS        256          /**< max sensors of one feed */
+#define SCD4XD_PRESSURE_MIN_PA             70000.0f     /**< lowest ambient pressure of the sensor */
+#define SCD4XD_PRESSURE_MAX_PA             120000.0f    /**< highest ambient pressure of the sensor */
+
+/**
+ * @brief      pressure source type definition
+ * @param[in]  *arg pointer to the source argument
+ * @param[out] *pa pointer to a pressure buffer in pa
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ */
+typedef uint8_t (*scd4xd_pressure_source_t)(void *arg, float *pa);
+
+/**
+ * @brief scd4xd pressure config structure definition
+ */
+typedef struct scd4xd_pressure_config_s
+{
+    uint32_t threshold_pa;         /**< change from the pushed pressure which starts a round */
+    uint64_t max_age_us;           /**< max time between the pushes of a sensor, 0 for no limit */
+    uint64_t batch_us;             /**< a round also refreshes the sensors within this time of max_age_us */
+} scd4xd_pressure_config_t;
+
+/**
+ * @brief scd4xd pressure sensor structure definition
+ */
+typedef struct scd4xd_pressure_sensor_s
+{
+    uint16_t reg;                  /**< pushed register in hpa, 0 until the first push */
+    uint16_t pending;              /**< register to push, 0 if none */
+    uint64_t pushed_us;            /**< last push time */
+} scd4xd_pressure_sensor_t;
+
+/**
+ * @brief scd4xd pressure structure definition
+ */
+typedef struct scd4xd_pressure_s
+{
+    scd4xd_pressure_config_t config;                                 /**< config */
+    scd4xd_pressure_source_t source;                                 /**< pressure source */
+    void *arg;                                                       /**< source argument */
+    uint16_t sensors;                                                /**< sensor number */
+    uint16_t reg;                                                    /**< latest register, 0 before the first read */
+    float pa;                                                        /**< latest pressure */
+    uint32_t reads;                                                  /**< valid source reads */
+    uint32_t read_failed;                                            /**< failed or out of range source reads */
+    uint32_t rounds;                                                 /**< reads which queued pushes */
+    uint32_t pushes;                                                 /**< sent pushes */
+    uint32_t failed;                                                 /**< failed pushes */
+    uint32_t avoided;                                                /**< pushes of a send every read feed which are not sent */
+    scd4xd_pressure_sensor_t sensor[SCD4XD_PRESSURE_MAX_SENSORS];    /**< sensors */
+} scd4xd_pressure_t;
+
+/**
+ * @brief     init a pressure feed
+ * @param[in] *pressure pointer to a pressure structure
+ * @param[in] *config pointer to a config
+ * @param[in] source pressure source
+ * @param[in] *arg pointer to the source argument
+ * @param[in] sensors sensor number
+ * @return    status code
+ *            - 0 success
+ *            - 1 init failed
+ * @note      the config is copied, every sensor is pushed after the first read
+ */
+uint8_t scd4xd_pressure_init(scd4xd_pressure_t *pressure, const scd4xd_pressure_config_t *config, 
+                             scd4xd_pressure_source_t source, void *arg, uint16_t sensors);
+
+/**
+ * @brief      read the source and queue the pushes
+ * @param[in]  *pressure pointer to a pressure structure
+ * @param[in]  now_us current time
+ * @param[out] *queued pointer to a queued push number buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed or the pressure is out of range
+ * @note       a round starts if a sensor is off by threshold_pa, over max_age_us or never pushed,
+ *             then every sensor with another register or near its max age is queued at once,
+ *             a queued register which is not sent yet is replaced and counted as avoided
+ */
+uint8_t scd4xd_pressure_update(scd4xd_pressure_t *pressure, uint64_t now_us, uint16_t *queued);
+
+/**
+ * @brief      take the queued push of a sensor
+ * @param[in]  *pressure pointer to a pressure structure
+ * @param[in]  index sensor index
+ * @param[out] *reg pointer to a register buffer in hpa
+ * @return     status code
+ *             - 0 success, send it and call scd4xd_pressure_done
+ *             - 1 nothing to push
+ * @note       none
+ */
+uint8_t scd4xd_pressure_take(scd4xd_pressure_t *pressure, uint16_t index, uint16_t *reg);
+
+/**
+ * @brief     end the push of a sensor
+ * @param[in] *pressure pointer to a pressure structure
+ * @param[in] index sensor index
+ * @param[in] res status code of the set ambient pressure command
+ * @param[in] now_us current time
+ * @note      a failed push keeps the old register, so the next read queues it again
+ */
+void scd4xd_pressure_done(scd4xd_pressure_t *pressure, uint16_t index, uint8_t res, uint64_t now_us);
+
+/**
+ * @brief     forget the pushed register of a sensor
+ * @param[in] *pressure pointer to a pressure structure
+ * @param[in] index sensor index
+ * @note      call it after a reinit or power cycle cleared the sensor settings, the next read pushes it
+ */
+void scd4xd_pressure_reset(scd4xd_pressure_t *pressure, uint16_t index);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,241 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      scd4xd_protocol.h
+ * @brief     scd4xd protocol header file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#ifndef SCD4XD_PROTOCOL_H
+#define SCD4XD_PROTOCOL_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @defgroup scd4xd scd4xd function
+ * @brief    scd4xd acquisition daemon modules
+ * @{
+ */
+
+/**
+ * @brief scd4xd protocol definition
+ */
+#define SCD4XD_DEFAULT_SOCKET        "/run/scd4xd.sock"        /**< default unix socket path */
+#define SCD4XD_PROTOCOL_VERSION      1                         /**< protocol version */
+#define SCD4XD_MAX_RECORDS           256                       /**< max records of one response */
+#define SCD4XD_JITTER_BUCKETS        24                        /**< jitter histogram buckets */
+#define SCD4XD_RUNGS                 5                         /**< retry, reinit, restart, power cycle and factory reset */
+
+/**
+ * @brief scd4xd message type enumeration definition
+ */
+typedef enum
+{
+    SCD4XD_MSG_LATEST       = 0x01,        /**< request the latest sample of each sensor */
+    SCD4XD_MSG_HISTORY      = 0x02,        /**< request the last count samples */
+    SCD4XD_MSG_SUBSCRIBE    = 0x03,        /**< request every new sample */
+    SCD4XD_MSG_UNSUBSCRIBE  = 0x04,        /**< stop the new samples */
+    SCD4XD_MSG_INFO         = 0x05,        /**< request the daemon information */
+    SCD4XD_MSG_JITTER       = 0x06,        /**< request the read jitter histogram */
+    SCD4XD_MSG_HEALTH       = 0x07,        /**< request the recovery stats */
+    SCD4XD_MSG_MAINT        = 0x08,        /**< start a maintenance run, a maint request follows the header */
+    SCD4XD_MSG_MAINT_STATUS = 0x09,        /**< request the maintenance progress and results */
+    SCD4XD_MSG_PRESSURE     = 0x0A,        /**< request the pressure compensation stats */
+    SCD4XD_MSG_SAMPLE       = 0x80,        /**< pushed sample of a subscription */
+} scd4xd_msg_t;
+
+/**
+ * @brief scd4xd status enumeration definition
+ */
+typedef enum
+{
+    SCD4XD_STATUS_OK          = 0x00,        /**< ok */
+    SCD4XD_STATUS_NO_DATA     = 0x01,        /**< no sample yet */
+    SCD4XD_STATUS_INVALID     = 0x02,        /**< invalid request */
+    SCD4XD_STATUS_BUSY        = 0x03,        /**< a maintenance run is active */
+} scd4xd_status_t;
+
+/**
+ * @brief scd4xd record flag definition
+ */
+#define SCD4XD_FLAG_LOW_POWER        (1 << 0)        /**< sample of the low power periodic measurement */
+#define SCD4XD_FLAG_SIM              (1 << 1)        /**< sample of the simulated sensor */
+
+/**
+ * @brief scd4xd header structure definition
+ * @note  every request and response starts with this header, the records follow the response header
+ */
+typedef struct scd4xd_header_s
+{
+    uint8_t type;          /**< message type */
+    uint8_t status;        /**< status of a response, 0 in a request */
+    uint16_t count;        /**< history count of a request or record number of a response */
+} scd4xd_header_t;
+
+/**
+ * @brief scd4xd record structure definition
+ * @note  24 bytes without padding in the host byte order, the socket is local
+ */
+typedef struct scd4xd_record_s
+{
+    uint64_t time_us;              /**< read time of CLOCK_MONOTONIC in us */
+    uint32_t seq;                  /**< sample sequence of the daemon */
+    uint32_t latency_us;           /**< time from data ready seen to read */
+    uint16_t co2_ppm;              /**< co2 in ppm */
+    uint16_t temperature_raw;      /**< temperature raw, -45 + 175 * raw / 65535 degrees */
+    uint16_t humidity_raw;         /**< humidity raw, 100 * raw / 65535 % */
+    uint8_t sensor;                /**< sensor index */
+    uint8_t flags;                 /**< record flags */
+} scd4xd_record_t;
+
+/**
+ * @brief scd4xd info structure definition
+ */
+typedef struct scd4xd_info_s
+{
+    uint32_t version;              /**< protocol version */
+    uint32_t samples;              /**< sample number since start */
+    uint32_t errors;               /**< acquisition error number */
+    uint32_t clients;              /**< connected clients */
+    uint32_t history;              /**< history depth */
+    uint32_t sensors;              /**< sensor number */
+} scd4xd_info_t;
+
+/**
+ * @brief scd4xd jitter structure definition
+ * @note  jitter is the actual minus the scheduled read time
+ */
+typedef struct scd4xd_jitter_s
+{
+    uint32_t realtime;                               /**< 1 if the reads run on a SCHED_FIFO thread */
+    uint32_t count;                                  /**< scheduled read number */
+    uint32_t avg_us;                                 /**< average jitter */
+    uint32_t max_us;                                 /**< max jitter */
+    uint32_t bucket[SCD4XD_JITTER_BUCKETS];          /**< bucket 0 counts 0 us, bucket n counts [2^(n-1), 2^n) us */
+} scd4xd_jitter_t;
+
+/**
+ * @brief scd4xd health structure definition
+ * @note  an outage starts at the first failure or the last sample before a stall and ends at the next sample
+ */
+typedef struct scd4xd_health_info_s
+{
+    uint32_t sensors;                                /**< sensor number */
+    uint32_t down;                                   /**< sensors in an outage now */
+    uint32_t failures;                               /**< failed polls */
+    uint32_t stalls;                                 /**< data ready stalls */
+    uint32_t ladders;                                /**< times a ladder restarted from reinit */
+    uint32_t attempts[SCD4XD_RUNGS];                 /**< recoveries run on each rung */
+    uint32_t recovered[SCD4XD_RUNGS];                /**< outages ended on each rung */
+    uint32_t down_ms;                                /**< downtime of the ended outages */
+    uint32_t recover_max_ms;                         /**< longest time to recover */
+} scd4xd_health_info_t;
+
+/**
+ * @brief scd4xd maint request structure definition
+ * @note  op is 1 for the self test, 2 for the forced recalibration and 3 to persist the settings
+ */
+typedef struct scd4xd_maint_request_s
+{
+    uint8_t op;                    /**< operation */
+    uint8_t per_bus;               /**< sensors of one bus running at once, 0 for 1 */
+    uint16_t target_ppm;           /**< forced recalibration reference */
+    uint32_t budget_ms;            /**< estimated maintenance time of each bus, 0 for no limit */
+} scd4xd_maint_request_t;
+
+/**
+ * @brief scd4xd maint status structure definition
+ * @note  the response has count maint results after it
+ */
+typedef struct scd4xd_maint_status_s
+{
+    uint8_t op;                    /**< operation, 0 if no run is started */
+    uint8_t per_bus;               /**< sensors of one bus running at once */
+    uint16_t target_ppm;           /**< forced recalibration reference */
+    uint32_t budget_ms;            /**< estimated maintenance time of each bus */
+    uint32_t buses;                /**< bus groups */
+    uint32_t queued;               /**< jobs waiting for a slot */
+    uint32_t active;               /**< running jobs */
+    uint32_t done;                 /**< done jobs */
+    uint32_t failed;               /**< failed jobs */
+    uint32_t skipped;              /**< skipped jobs */
+    uint32_t elapsed_ms;           /**< run time, the window of a finished run */
+    uint32_t serial_ms;            /**< summed job time, the window of a one by one run */
+} scd4xd_maint_status_t;
+
+/**
+ * @brief scd4xd maint result structure definition
+ * @note  state is 0 queued, 1 active, 2 done, 3 failed and 4 skipped
+ */
+typedef struct scd4xd_maint_result_s
+{
+    uint8_t sensor;                /**< sensor index */
+    uint8_t state;                 /**< job state */
+    uint8_t step;                  /**< finished steps */
+    uint8_t steps;                 /**< step number */
+    uint16_t bus;                  /**< bus group */
+    uint16_t result;               /**< 1 if a malfunction is detected or the forced recalibration correction */
+    uint32_t start_ms;             /**< start time from the run start */
+    uint32_t time_ms;              /**< run time of the job */
+} scd4xd_maint_result_t;
+
+/**
+ * @brief scd4xd pressure info structure definition
+ * @note  avoided is the pushes of a feed sending every read to every sensor which are not sent
+ */
+typedef struct scd4xd_pressure_info_s
+{
+    uint32_t sensors;              /**< sensor number */
+    uint32_t pa;                   /**< latest pressure, 0 before the first read */
+    uint32_t threshold_pa;         /**< change which starts a round */
+    uint32_t max_age_ms;           /**< max time between the pushes of a sensor, 0 for no limit */
+    uint32_t reads;                /**< valid source reads */
+    uint32_t read_failed;          /**< failed or out of range source reads */
+    uint32_t rounds;               /**< reads which queued pushes */
+    uint32_t pushes;               /**< sent pushes */
+    uint32_t failed;               /**< failed pushes */
+    uint32_t avoided;              /**< pushes which are not needed */
+    uint32_t pending;              /**< queued pushes */
+} scd4xd_pressure_info_t;
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
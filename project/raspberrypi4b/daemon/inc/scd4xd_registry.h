@@ -0,0 +1,196 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      scd4xd_registry.h
+ * @brief     scd4xd registry header file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#ifndef SCD4XD_REGISTRY_H
+#define SCD4XD_REGISTRY_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @addtogroup scd4xd
+ * @{
+ */
+
+/**
+ * @brief scd4xd registry definition
+ */
+#define SCD4XD_REGISTRY_MAGIC          0x52443453U        /**< "S4DR" */
+#define SCD4XD_REGISTRY_VERSION        1                  /**< file layout version */
+#define SCD4XD_REGISTRY_CAPACITY       1024               /**< default slots of a new file, must be a power of 2 */
+#define SCD4XD_REGISTRY_FRC            4                  /**< frc history depth */
+#define SCD4XD_REGISTRY_LOCATION       32                 /**< max location length */
+
+/**
+ * @brief scd4xd registry entry flag definition
+ */
+#define SCD4XD_REGISTRY_FLAG_KNOWN     (1 << 0)           /**< power_offset and power_altitude are the power up settings of the sensor */
+#define SCD4XD_REGISTRY_FLAG_PERSIST   (1 << 1)           /**< persist the applied settings to the eeprom */
+
+/**
+ * @brief scd4xd registry state enumeration definition
+ */
+typedef enum
+{
+    SCD4XD_REGISTRY_STATE_IDLE      = 0x00,        /**< stopped */
+    SCD4XD_REGISTRY_STATE_PERIODIC  = 0x01,        /**< periodic measurement */
+    SCD4XD_REGISTRY_STATE_LOW_POWER = 0x02,        /**< low power periodic measurement */
+} scd4xd_registry_state_t;
+
+/**
+ * @brief scd4xd registry frc structure definition
+ */
+typedef struct scd4xd_registry_frc_s
+{
+    uint32_t time_s;                   /**< unix time */
+    uint16_t target_ppm;               /**< reference co2 */
+    uint16_t correction;               /**< frc correction register, 0xFFFF if failed */
+} scd4xd_registry_frc_t;
+
+/**
+ * @brief scd4xd registry entry structure definition
+ * @note  128 bytes, a free slot has serial 0
+ */
+typedef struct scd4xd_registry_entry_s
+{
+    uint64_t serial;                                   /**< 48 bits serial number */
+    uint64_t first_seen_s;                             /**< unix time of the first connect */
+    uint64_t last_seen_s;                              /**< unix time of the last connect or stop */
+    char location[SCD4XD_REGISTRY_LOCATION];           /**< last location */
+    uint32_t connects;                                 /**< connect number */
+    uint16_t offset;                                   /**< temperature offset register to apply */
+    uint16_t altitude;                                 /**< sensor altitude register to apply */
+    uint16_t power_offset;                             /**< temperature offset register the sensor loads at power up */
+    uint16_t power_altitude;                           /**< sensor altitude register the sensor loads at power up */
+    uint8_t type;                                      /**< chip type */
+    uint8_t flags;                                     /**< registry entry flags */
+    uint8_t state;                                     /**< last state */
+    uint8_t frc_num;                                   /**< frc number saturated to 252 - 255, the last SCD4XD_REGISTRY_FRC are kept */
+    uint8_t reserved[24];                              /**< reserved */
+    scd4xd_registry_frc_t frc[SCD4XD_REGISTRY_FRC];    /**< frc ring */
+} scd4xd_registry_entry_t;
+
+/**
+ * @brief scd4xd registry file structure definition
+ */
+typedef struct scd4xd_registry_file_s
+{
+    uint32_t magic;                            /**< magic */
+    uint32_t version;                          /**< layout version */
+    uint32_t capacity;                         /**< slot number, a power of 2 */
+    uint32_t entry_size;                       /**< entry size */
+    uint32_t count;                            /**< used slots */
+    uint32_t reserved[11];                     /**< reserved */
+    scd4xd_registry_entry_t entry[];           /**< open addressing slots */
+} scd4xd_registry_file_t;
+
+/**
+ * @brief scd4xd registry handle structure definition
+ */
+typedef struct scd4xd_registry_s
+{
+    scd4xd_registry_file_t *file;      /**< mapped file */
+    uint64_t size;                     /**< mapped size */
+} scd4xd_registry_t;
+
+/**
+ * @brief     open or create a registry file
+ * @param[in] *reg pointer to a registry handle structure
+ * @param[in] *path pointer to a file path
+ * @param[in] capacity slot number of a new file, a power of 2, 0 to open an existing file only
+ * @return    status code
+ *            - 0 success
+ *            - 1 open failed
+ *            - 4 layout is different
+ * @note      an existing file keeps its capacity, the file is mapped shared so
+ *            the edits of another process are seen at the next lookup
+ */
+uint8_t scd4xd_registry_open(scd4xd_registry_t *reg, const char *path, uint32_t capacity);
+
+/**
+ * @brief     write back and close a registry
+ * @param[in] *reg pointer to a registry handle structure
+ * @note      none
+ */
+void scd4xd_registry_close(scd4xd_registry_t *reg);
+
+/**
+ * @brief     start writing back the dirty pages
+ * @param[in] *reg pointer to a registry handle structure
+ * @note      does not wait for the disk
+ */
+void scd4xd_registry_sync(scd4xd_registry_t *reg);
+
+/**
+ * @brief     find a sensor
+ * @param[in] *reg pointer to a registry handle structure
+ * @param[in] serial 48 bits serial number
+ * @return    pointer to the mapped entry, NULL if not found
+ * @note      the load factor is kept under 3/4, so the probe is short
+ */
+scd4xd_registry_entry_t *scd4xd_registry_find(scd4xd_registry_t *reg, uint64_t serial);
+
+/**
+ * @brief     find or add a sensor
+ * @param[in] *reg pointer to a registry handle structure
+ * @param[in] serial 48 bits serial number
+ * @return    pointer to the mapped entry, NULL if the serial is 0 or the registry is full
+ * @note      a new entry is zero except the serial, its connects is 0
+ */
+scd4xd_registry_entry_t *scd4xd_registry_add(scd4xd_registry_t *reg, uint64_t serial);
+
+/**
+ * @brief     record a forced recalibration
+ * @param[in] *entry pointer to a registry entry
+ * @param[in] time_s unix time
+ * @param[in] target_ppm reference co2
+ * @param[in] correction frc correction register, 0xFFFF if failed
+ * @note      the oldest record is overwritten
+ */
+void scd4xd_registry_add_frc(scd4xd_registry_entry_t *entry, uint32_t time_s, uint16_t target_ppm, uint16_t correction);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,174 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      scd4xd_shm.h
+ * @brief     scd4xd shared memory feed header file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#ifndef SCD4XD_SHM_H
+#define SCD4XD_SHM_H
+
+#include "driver_scd4x.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @addtogroup scd4xd
+ * @{
+ */
+
+/**
+ * @brief scd4xd shared memory definition
+ */
+#define SCD4XD_SHM_DEFAULT_NAME        "/scd4xd"          /**< default shared memory name */
+#define SCD4XD_SHM_MAGIC               0x53434434U        /**< "SCD4" */
+#define SCD4XD_SHM_VERSION             1                  /**< ring layout version */
+#define SCD4XD_SHM_SLOTS               256                /**< ring slots, must be a power of 2 */
+
+/**
+ * @brief scd4xd shared memory sample structure definition
+ */
+typedef struct scd4xd_shm_sample_s
+{
+    uint64_t index;                /**< sample index since the ring creation */
+    uint64_t time_ns;              /**< publish time of CLOCK_MONOTONIC in ns */
+    uint8_t sensor;                /**< sensor index */
+    uint8_t flags;                 /**< scd4xd record flags */
+    scd4x_sample_t sample;         /**< sample filled by the driver */
+} scd4xd_shm_sample_t;
+
+/**
+ * @brief scd4xd shared memory slot structure definition
+ * @note  seq is 2 * index + 1 while the slot is written and 2 * index + 2 when it is stable
+ */
+typedef struct scd4xd_shm_slot_s
+{
+    uint64_t seq;                  /**< slot sequence */
+    scd4xd_shm_sample_t data;      /**< slot data */
+} __attribute__((aligned(64))) scd4xd_shm_slot_t;
+
+/**
+ * @brief scd4xd shared memory ring structure definition
+ */
+typedef struct scd4xd_shm_ring_s
+{
+    uint32_t magic;                                          /**< magic */
+    uint32_t version;                                        /**< layout version */
+    uint32_t slots;                                          /**< slot number */
+    uint32_t slot_size;                                      /**< slot size */
+    uint64_t head __attribute__((aligned(64)));              /**< written sample number */
+    scd4xd_shm_slot_t slot[SCD4XD_SHM_SLOTS];                /**< slots */
+} scd4xd_shm_ring_t;
+
+/**
+ * @brief scd4xd shared memory handle structure definition
+ */
+typedef struct scd4xd_shm_s
+{
+    scd4xd_shm_ring_t *ring;       /**< mapped ring */
+    uint8_t writer;                /**< 1 if created by the writer */
+    char name[64];                 /**< shared memory name */
+} scd4xd_shm_t;
+
+/**
+ * @brief     create the ring as the only writer
+ * @param[in] *shm pointer to a shm handle structure
+ * @param[in] *name pointer to a shared memory name
+ * @return    status code
+ *            - 0 success
+ *            - 1 create failed
+ * @note      an old ring of the same name is replaced
+ */
+uint8_t scd4xd_shm_create(scd4xd_shm_t *shm, const char *name);
+
+/**
+ * @brief     open the ring as a reader
+ * @param[in] *shm pointer to a shm handle structure
+ * @param[in] *name pointer to a shared memory name
+ * @return    status code
+ *            - 0 success
+ *            - 1 open failed
+ *            - 4 layout is different
+ * @note      the ring is mapped read only
+ */
+uint8_t scd4xd_shm_open(scd4xd_shm_t *shm, const char *name);
+
+/**
+ * @brief     close the ring
+ * @param[in] *shm pointer to a shm handle structure
+ * @note      the writer removes the name
+ */
+void scd4xd_shm_close(scd4xd_shm_t *shm);
+
+/**
+ * @brief     publish a sample
+ * @param[in] *shm pointer to a shm handle structure
+ * @param[in] sensor sensor index
+ * @param[in] flags scd4xd record flags
+ * @param[in] *sample pointer to a sample filled by the driver
+ * @note      no syscall, lock free and never waits for the readers
+ */
+void scd4xd_shm_write(scd4xd_shm_t *shm, uint8_t sensor, uint8_t flags, const scd4x_sample_t *sample);
+
+/**
+ * @brief     get the next sample index to be written
+ * @param[in] *shm pointer to a shm handle structure
+ * @return    head index
+ * @note      start a cursor here to read only the new samples, or at 0 to replay the ring
+ */
+uint64_t scd4xd_shm_head(scd4xd_shm_t *shm);
+
+/**
+ * @brief         read the sample at the cursor
+ * @param[in]     *shm pointer to a shm handle structure
+ * @param[in,out] *cursor pointer to a reader cursor
+ * @param[out]    *out pointer to a sample buffer
+ * @param[in,out] *lost pointer to a lost sample counter
+ * @return        status code
+ *                - 0 success
+ *                - 1 no new sample
+ * @note          no syscall and never blocks the writer, the samples overwritten before
+ *                they are read are skipped and added to lost
+ */
+uint8_t scd4xd_shm_read(scd4xd_shm_t *shm, uint64_t *cursor, scd4xd_shm_sample_t *out, uint64_t *lost);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
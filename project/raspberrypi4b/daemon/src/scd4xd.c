@@ -0,0 +1,2055 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      scd4xd.c
+ * @brief     scd4xd source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#define _GNU_SOURCE
+
+#include "driver_scd4x_interface.h"
+#ifdef SCD4XD_SIM
+#include "driver_scd4x_sim.h"
+#endif
+#include "iic.h"
+#include "scd4xd_discover.h"
+#include "scd4xd_health.h"
+#include "scd4xd_loop.h"
+#include "scd4xd_maint.h"
+#include "scd4xd_pressure.h"
+#include "scd4xd_protocol.h"
+#include "scd4xd_registry.h"
+#include "scd4xd_shm.h"
+#include <errno.h>
+#include <getopt.h>
+#include <pthread.h>
+#include <sched.h>
+#include <signal.h>
+#include <stdlib.h>
+#include <sys/eventfd.h>
+#include <sys/mman.h>
+#include <sys/resource.h>
+#include <sys/signalfd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <time.h>
+#include <unistd.h>
+
+/**
+ * @brief scd4xd definition
+ */
+#define SCD4XD_MAX_SENSORS        256            /**< max sensors of one daemon */
+#define SCD4XD_MAX_CLIENTS        64             /**< max connected clients */
+#define SCD4XD_HISTORY            16384          /**< history depth of all sensors */
+#define SCD4XD_RETRY_US           20000          /**< data ready retry interval, also the early wake up */
+#define SCD4XD_ERROR_US           1000000        /**< retry interval after a bus error */
+#define SCD4XD_RT_PRIORITY        50             /**< default SCHED_FIFO priority */
+#define SCD4XD_RT_SLEEP_US        100000         /**< max sleep of the real time thread, bounds the stop time */
+#define SCD4XD_RT_STACK           65536          /**< prefaulted stack of the real time thread */
+#define SCD4XD_PRESSURE_PERIOD    10000          /**< default pressure read interval in ms */
+#define SCD4XD_PRESSURE_THRESHOLD 100            /**< default pressure change of a push in pa */
+#define SCD4XD_PRESSURE_AGE       3600000        /**< default max time between the pressure pushes in ms */
+
+/**
+ * @brief scd4xd sensor structure definition
+ */
+typedef struct scd4xd_sensor_s
+{
+    scd4x_handle_t handle;           /**< scd4x handle */
+#ifdef SCD4XD_SIM
+    scd4x_sim_t sim;                 /**< simulated sensor */
+#endif
+    scd4xd_loop_timer_t timer;       /**< poll timer */
+    const char *bus;                 /**< iic device, NULL if simulated */
+    scd4x_t type;                    /**< chip type */
+    int fd;                          /**< iic fd */
+    iic_device_t dev;                /**< read and write transport, addr 0 until the first frame */
+    uint64_t serial;                 /**< 48 bits serial number, 0 until it is read */
+    scd4xd_registry_entry_t *entry;  /**< registry entry, NULL without a registry */
+    scd4xd_health_t health;          /**< failure tracking and recovery */
+    uint8_t maint;                   /**< 1 while a maintenance job runs instead of the polls */
+    uint8_t idle;                    /**< 1 if no poll sequence is in flight, a pressure push can go first */
+    uint8_t index;                   /**< sensor index */
+    uint8_t has_latest;              /**< 1 if latest is valid */
+    scd4xd_record_t latest;          /**< latest record */
+} scd4xd_sensor_t;
+
+/**
+ * @brief scd4xd client structure definition
+ */
+typedef struct scd4xd_client_s
+{
+    scd4xd_loop_watch_t watch;       /**< socket watch, fd -1 if unused */
+    uint8_t subscribed;              /**< 1 if every new sample is pushed */
+    uint32_t next_seq;               /**< next pushed sample sequence */
+} scd4xd_client_t;
+
+static scd4xd_loop_t gs_loop;                                   /**< event loop */
+static scd4xd_loop_t gs_rt_loop;                                /**< timer loop of the real time thread */
+static scd4xd_loop_t *gs_acq;                                   /**< loop running the sensor timers */
+static uint8_t gs_realtime;                                     /**< 1 if the sensor timers run on a SCHED_FIFO thread */
+static uint8_t gs_iic_rw;                                       /**< 1 to use read and write instead of I2C_RDWR */
+static scd4xd_device_t gs_device[SCD4XD_MAX_SENSORS];           /**< discovered sensors */
+static pthread_mutex_t gs_mutex;                                /**< history and latest lock, priority inheritance */
+static scd4xd_sensor_t gs_sensor[SCD4XD_MAX_SENSORS];           /**< sensors */
+static scd4xd_sensor_t *gs_current;                             /**< sensor of the running driver call */
+static uint16_t gs_sensors;                                     /**< sensor number */
+static uint8_t gs_flags;                                        /**< record flags */
+static uint64_t gs_period_us;                                   /**< measurement interval */
+static scd4xd_record_t gs_history[SCD4XD_HISTORY];              /**< history ring */
+static scd4xd_info_t gs_info;                                   /**< daemon information */
+static scd4xd_client_t gs_client[SCD4XD_MAX_CLIENTS];           /**< clients */
+static scd4xd_loop_watch_t gs_listen_watch;                     /**< listen socket watch */
+static scd4xd_loop_watch_t gs_signal_watch;                     /**< signalfd watch */
+static scd4xd_loop_watch_t gs_notify_watch;                     /**< new sample eventfd watch */
+static scd4xd_shm_t gs_shm;                                     /**< shared memory feed */
+static scd4xd_registry_t gs_registry;                           /**< device registry */
+static scd4xd_health_config_t gs_health;                        /**< recovery config */
+static const char *gs_power_hook;                               /**< power cycle program, NULL if none */
+static scd4xd_maint_t gs_maint;                                 /**< maintenance run, guarded by gs_mutex */
+static uint8_t gs_maint_start;                                  /**< 1 until the acquisition thread admits a new run */
+static scd4xd_pressure_t gs_pressure;                           /**< pressure compensation feed, guarded by gs_mutex */
+static scd4xd_loop_timer_t gs_pressure_timer;                   /**< pressure read timer of the main loop */
+static uint64_t gs_pressure_read;                               /**< latest file read, sequence << 32 | pa, pa 0 if failed */
+static uint32_t gs_pressure_seq;                                /**< sequence of the main loop reads */
+static uint32_t gs_pressure_taken;                              /**< sequence taken by the acquisition thread */
+static uint32_t gs_pressure_pa;                                 /**< pa of the taken read, source of the feed */
+static const char *gs_pressure_path;                            /**< pressure file, NULL without the feed */
+static float gs_pressure_scale = 1.0f;                          /**< pa of one unit of the pressure file */
+static uint64_t gs_pressure_period_us;                          /**< pressure read interval */
+
+/**
+ * @brief  iic init of the current sensor
+ * @return status code
+ *         - 0 success
+ *         - 1 iic init failed
+ * @note   none
+ */
+static uint8_t a_scd4xd_iic_init(void)
+{
+#ifdef SCD4XD_SIM
+    if (gs_current->bus == NULL)
+    {
+        return scd4x_sim_iic_init();
+    }
+#endif
+    gs_current->dev.addr = 0;
+    
+    return iic_init((char *)gs_current->bus, &gs_current->fd);
+}
+
+/**
+ * @brief  iic deinit of the current sensor
+ * @return status code
+ *         - 0 success
+ *         - 1 iic deinit failed
+ * @note   none
+ */
+static uint8_t a_scd4xd_iic_deinit(void)
+{
+#ifdef SCD4XD_SIM
+    if (gs_current->bus == NULL)
+    {
+        return scd4x_sim_iic_deinit();
+    }
+#endif
+    
+    return iic_deinit(gs_current->fd);
+}
+
+/**
+ * @brief     iic write command of the current sensor
+ * @param[in] addr iic device write address
+ * @param[in] *buf pointer to a data buffer
+ * @param[in] len length of the data buffer
+ * @return    status code
+ *            - 0 success
+ *            - 1 write failed
+ * @note      the simulated sensor runs on the real time
+ */
+static uint8_t a_scd4xd_iic_write_cmd(uint8_t addr, uint8_t *buf, uint16_t len)
+{
+#ifdef SCD4XD_SIM
+    if (gs_current->bus == NULL)
+    {
+        gs_current->sim.now_us = scd4xd_loop_now_us();
+        scd4x_sim_attach(&gs_current->sim);
+        
+        return scd4x_sim_iic_write_cmd(addr, buf, len);
+    }
+#endif
+    if (gs_iic_rw != 0)
+    {
+        /* set the target address once, every command starts with a write */
+        if ((gs_current->dev.addr != addr) && (iic_device_init(&gs_current->dev, gs_current->fd, addr) != 0))
+        {
+            return 1;
+        }
+        
+        return iic_device_write_cmd(&gs_current->dev, buf, len);
+    }
+    
+    return iic_write_cmd(gs_current->fd, addr, buf, len);
+}
+
+/**
+ * @brief      iic read command of the current sensor
+ * @param[in]  addr iic device write address
+ * @param[out] *buf pointer to a data buffer
+ * @param[in]  len length of the data buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ * @note       the simulated sensor runs on the real time
+ */
+static uint8_t a_scd4xd_iic_read_cmd(uint8_t addr, uint8_t *buf, uint16_t len)
+{
+#ifdef SCD4XD_SIM
+    if (gs_current->bus == NULL)
+    {
+        gs_current->sim.now_us = scd4xd_loop_now_us();
+        scd4x_sim_attach(&gs_current->sim);
+        
+        return scd4x_sim_iic_read_cmd(addr, buf, len);
+    }
+#endif
+    if ((gs_iic_rw != 0) && (gs_current->dev.addr == addr))
+    {
+        return iic_device_read_cmd(&gs_current->dev, buf, len);
+    }
+    
+    return iic_read_cmd(gs_current->fd, addr, buf, len);
+}
+
+/**
+ * @brief     copy the records of the history
+ * @param[in] from_seq first sequence to copy
+ * @param[in] max max record number
+ * @param[out] *record pointer to a record buffer
+ * @return    copied record number
+ * @note      older records than the history depth are skipped, the caller holds gs_mutex
+ */
+static uint16_t a_scd4xd_history_copy(uint32_t from_seq, uint16_t max, scd4xd_record_t *record)
+{
+    uint32_t oldest;
+    uint16_t num;
+    
+    /* get the oldest sequence in the history */
+    oldest = (gs_info.samples > SCD4XD_HISTORY) ? (gs_info.samples - SCD4XD_HISTORY) : 0;
+    if (from_seq < oldest)
+    {
+        from_seq = oldest;
+    }
+    
+    /* copy oldest first */
+    for (num = 0; (num < max) && (from_seq < gs_info.samples); num++, from_seq++)
+    {
+        record[num] = gs_history[from_seq % SCD4XD_HISTORY];
+    }
+    
+    return num;
+}
+
+/**
+ * @brief     send a response
+ * @param[in] *client pointer to a client
+ * @param[in] type message type
+ * @param[in] status response status
+ * @param[in] *data pointer to the payload
+ * @param[in] count record number
+ * @param[in] size payload size
+ * @return    status code
+ *            - 0 success
+ *            - 1 send failed
+ * @note      a client which can't take a whole packet is too slow and is closed by the caller
+ */
+static uint8_t a_scd4xd_send(scd4xd_client_t *client, uint8_t type, uint8_t status, 
+                             const void *data, uint16_t count, size_t size)
+{
+    uint8_t buf[sizeof(scd4xd_header_t) + SCD4XD_MAX_RECORDS * sizeof(scd4xd_record_t)];
+    scd4xd_header_t header;
+    
+    header.type = type;
+    header.status = status;
+    header.count = count;
+    memcpy(buf, &header, sizeof(header));
+    if (size != 0)
+    {
+        memcpy(&buf[sizeof(header)], data, size);
+    }
+    
+    /* one packet each message */
+    if (send(client->watch.fd, buf, sizeof(header) + size, MSG_DONTWAIT | MSG_NOSIGNAL) != (ssize_t)(sizeof(header) + size))
+    {
+        return 1;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief     close a client
+ * @param[in] *client pointer to a client
+ * @note      none
+ */
+static void a_scd4xd_close(scd4xd_client_t *client)
+{
+    int fd = client->watch.fd;
+    
+    scd4xd_loop_del_fd(&gs_loop, &client->watch);
+    (void)close(fd);
+    client->subscribed = 0;
+    gs_info.clients--;
+}
+
+/**
+ * @brief  push the new samples to the subscribed clients
+ * @note   none
+ */
+static void a_scd4xd_publish(void)
+{
+    scd4xd_record_t record[SCD4XD_MAX_RECORDS];
+    uint16_t num;
+    int i;
+    
+    for (i = 0; i < SCD4XD_MAX_CLIENTS; i++)
+    {
+        scd4xd_client_t *client = &gs_client[i];
+        
+        if ((client->watch.fd < 0) || (client->subscribed == 0))
+        {
+            continue;
+        }
+        (void)pthread_mutex_lock(&gs_mutex);
+        num = a_scd4xd_history_copy(client->next_seq, SCD4XD_MAX_RECORDS, record);
+        (void)pthread_mutex_unlock(&gs_mutex);
+        if (num == 0)
+        {
+            continue;
+        }
+        if (a_scd4xd_send(client, SCD4XD_MSG_SAMPLE, SCD4XD_STATUS_OK, record, num, num * sizeof(scd4xd_record_t)) != 0)
+        {
+            /* too slow to follow the samples */
+            a_scd4xd_close(client);
+            
+            continue;
+        }
+        client->next_seq = record[num - 1].seq + 1;
+    }
+}
+
+/**
+ * @brief     new sample event
+ * @param[in] *arg unused
+ * @param[in] events epoll events
+ * @note      the samples are published on the client thread
+ */
+static void a_scd4xd_notify(void *arg, uint32_t events)
+{
+    uint64_t value;
+    
+    (void)arg;
+    (void)events;
+    (void)read(gs_notify_watch.fd, &value, sizeof(value));
+    a_scd4xd_publish();
+}
+
+/**
+ * @brief     push a sample
+ * @param[in] *sensor pointer to a sensor
+ * @param[in] *sample pointer to a sample
+ * @note      runs on the acquisition thread
+ */
+static void a_scd4xd_push(scd4xd_sensor_t *sensor, const scd4x_sample_t *sample)
+{
+    scd4xd_record_t record;
+    
+    /* set the record */
+    memset(&record, 0, sizeof(record));
+    record.time_us = sample->read_time_us;
+    record.latency_us = (uint32_t)(sample->read_time_us - sample->ready_time_us);
+    record.co2_ppm = sample->co2_ppm;
+    record.temperature_raw = sample->temperature_raw;
+    record.humidity_raw = sample->humidity_raw;
+    record.sensor = sensor->index;
+    record.flags = gs_flags;
+    
+    /* save it */
+    (void)pthread_mutex_lock(&gs_mutex);
+    record.seq = gs_info.samples;
+    gs_history[gs_info.samples % SCD4XD_HISTORY] = record;
+    gs_info.samples++;
+    sensor->latest = record;
+    sensor->has_latest = 1;
+    (void)pthread_mutex_unlock(&gs_mutex);
+    
+    /* publish it, the eventfd coalesces the samples of one wake up */
+    if (gs_shm.ring != NULL)
+    {
+        scd4xd_shm_write(&gs_shm, sensor->index, gs_flags, sample);
+    }
+    (void)eventfd_write(gs_notify_watch.fd, 1);
+}
+
+/**
+ * @brief     admit the queued maintenance jobs
+ * @param[in] now_us current time
+ * @note      runs on the acquisition thread, an admitted sensor runs its job from its poll timer,
+ *            a sensor in an outage keeps its recovery and its job is skipped
+ */
+static void a_scd4xd_maint_admit(uint64_t now_us)
+{
+    scd4xd_sensor_t *sensor;
+    uint16_t job;
+    
+    (void)pthread_mutex_lock(&gs_mutex);
+    __atomic_store_n(&gs_maint_start, 0, __ATOMIC_RELAXED);
+    while (scd4xd_maint_next(&gs_maint, now_us, &job) == 0)
+    {
+        sensor = &gs_sensor[job];
+        if ((sensor->health.op != 0) || (sensor->health.down_us != 0))
+        {
+            scd4xd_maint_skip(&gs_maint, job, now_us);
+            
+            continue;
+        }
+        sensor->maint = 1;
+        (void)scd4xd_loop_timer_start(gs_acq, &sensor->timer, now_us);
+    }
+    (void)pthread_mutex_unlock(&gs_mutex);
+}
+
+/**
+ * @brief     run the next command of the maintenance job of a sensor
+ * @param[in] *sensor pointer to a sensor
+ * @note      the sensor polls again after its job and the freed slot admits the next job of its bus,
+ *            the forced recalibration and the persisted settings are kept in the registry
+ */
+static void a_scd4xd_maint_step(scd4xd_sensor_t *sensor)
+{
+    scd4xd_maint_config_t config;
+    scd4xd_maint_job_t job;
+    uint32_t wait_us;
+    uint64_t now_us = scd4xd_loop_now_us();
+    
+    (void)pthread_mutex_lock(&gs_mutex);
+    (void)scd4xd_maint_run(&gs_maint, sensor->index, &sensor->handle, now_us, &wait_us);
+    job = gs_maint.job[sensor->index];
+    config = gs_maint.config;
+    (void)pthread_mutex_unlock(&gs_mutex);
+    if (job.state == SCD4XD_MAINT_STATE_ACTIVE)
+    {
+        (void)scd4xd_loop_timer_start(gs_acq, &sensor->timer, now_us + wait_us);
+        
+        return;
+    }
+    
+    /* a sensor left idle by a failed restore stalls and recovers */
+    sensor->maint = 0;
+    sensor->health.watch_us = now_us;
+    if (sensor->entry != NULL)
+    {
+        if ((config.op == SCD4XD_MAINT_OP_FRC) && 
+            ((job.state == SCD4XD_MAINT_STATE_DONE) || (job.result == SCD4XD_MAINT_FRC_FAILED)))
+        {
+            scd4xd_registry_add_frc(sensor->entry, (uint32_t)time(NULL), config.target_ppm, job.result);
+        }
+        else if ((config.op == SCD4XD_MAINT_OP_PERSIST) && (job.state == SCD4XD_MAINT_STATE_DONE))
+        {
+            sensor->entry->power_offset = sensor->entry->offset;
+            sensor->entry->power_altitude = sensor->entry->altitude;
+        }
+        scd4xd_registry_sync(&gs_registry);
+    }
+    a_scd4xd_maint_admit(now_us);
+    (void)scd4xd_loop_timer_start(gs_acq, &sensor->timer, now_us + gs_period_us - SCD4XD_RETRY_US);
+}
+
+/**
+ * @brief      read the pressure file
+ * @param[in]  *arg pointer to the file path
+ * @param[out] *pa pointer to a pressure buffer in pa
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ * @note       the file holds one number, e.g. in_pressure_input of an iio barometer in kpa with the scale 1000
+ */
+static uint8_t a_scd4xd_pressure_read(void *arg, float *pa)
+{
+    FILE *fp;
+    float value;
+    int num;
+    
+    fp = fopen((const char *)arg, "r");
+    if (fp == NULL)
+    {
+        return 1;
+    }
+    num = fscanf(fp, "%f", &value);
+    (void)fclose(fp);
+    if (num != 1)
+    {
+        return 1;
+    }
+    *pa = value * gs_pressure_scale;
+    
+    return 0;
+}
+
+/**
+ * @brief      get the pressure taken by the acquisition thread
+ * @param[in]  *arg pointer to the taken pa
+ * @param[out] *pa pointer to a pressure buffer in pa
+ * @return     status code
+ *             - 0 success
+ *             - 1 the file read failed
+ * @note       source of the feed, it never touches the file
+ */
+static uint8_t a_scd4xd_pressure_value(void *arg, float *pa)
+{
+    uint32_t value = *(const uint32_t *)arg;
+    
+    if (value == 0)
+    {
+        return 1;
+    }
+    *pa = (float)value;
+    
+    return 0;
+}
+
+/**
+ * @brief     pressure read timer
+ * @param[in] *arg unused
+ * @note      runs on the main loop so the file access never runs on the real time thread,
+ *            the read is handed over with one atomic store
+ */
+static void a_scd4xd_pressure_feed(void *arg)
+{
+    uint64_t now_us = scd4xd_loop_now_us();
+    uint32_t value = 0;
+    float pa;
+    
+    (void)arg;
+    if ((a_scd4xd_pressure_read((void *)gs_pressure_path, &pa) == 0) && (pa >= 1.0f) && (pa < 4294967040.0f))
+    {
+        value = (uint32_t)(pa + 0.5f);
+    }
+    gs_pressure_seq++;
+    __atomic_store_n(&gs_pressure_read, ((uint64_t)gs_pressure_seq << 32) | value, __ATOMIC_RELEASE);
+    (void)scd4xd_loop_timer_start(&gs_loop, &gs_pressure_timer, now_us + gs_pressure_period_us);
+}
+
+/**
+ * @brief     take a new pressure read and queue the pushes
+ * @param[in] now_us current time
+ * @note      runs on the acquisition thread, the queued pushes go out at the next wake up of each sensor
+ */
+static void a_scd4xd_pressure_take(uint64_t now_us)
+{
+    uint64_t read = __atomic_load_n(&gs_pressure_read, __ATOMIC_ACQUIRE);
+    uint16_t queued;
+    
+    if ((uint32_t)(read >> 32) == gs_pressure_taken)
+    {
+        return;
+    }
+    gs_pressure_taken = (uint32_t)(read >> 32);
+    gs_pressure_pa = (uint32_t)(read & 0xFFFFFFFFU);
+    (void)pthread_mutex_lock(&gs_mutex);
+    (void)scd4xd_pressure_update(&gs_pressure, now_us, &queued);
+    (void)pthread_mutex_unlock(&gs_mutex);
+}
+
+/**
+ * @brief     push the queued pressure of a sensor
+ * @param[in] *sensor pointer to a sensor
+ * @return    status code
+ *            - 0 success, the push took this wake up
+ *            - 1 nothing to push
+ * @note      the push goes between two poll sequences while no command is in flight,
+ *            a failed push is queued again by the next read and a broken sensor is found by the next poll
+ */
+static uint8_t a_scd4xd_pressure_push(scd4xd_sensor_t *sensor)
+{
+    uint32_t wait_us;
+    uint16_t reg;
+    uint8_t res;
+    
+    (void)pthread_mutex_lock(&gs_mutex);
+    res = scd4xd_pressure_take(&gs_pressure, sensor->index, &reg);
+    (void)pthread_mutex_unlock(&gs_mutex);
+    if ((res != 0) || (scd4x_get_pending_time(&sensor->handle, &wait_us) != 0) || (wait_us != 0))
+    {
+        return 1;
+    }
+    res = scd4x_set_ambient_pressure(&sensor->handle, reg);
+    (void)pthread_mutex_lock(&gs_mutex);
+    scd4xd_pressure_done(&gs_pressure, sensor->index, res, scd4xd_loop_now_us());
+    (void)pthread_mutex_unlock(&gs_mutex);
+    (void)scd4x_get_pending_time(&sensor->handle, &wait_us);
+    (void)scd4xd_loop_timer_start(gs_acq, &sensor->timer, scd4xd_loop_now_us() + wait_us);
+    
+    return 0;
+}
+
+/**
+ * @brief     poll timer of a sensor
+ * @param[in] *arg pointer to a sensor
+ * @note      one bus transfer each call, the driver never delays here
+ */
+static void a_scd4xd_sensor_poll(void *arg)
+{
+    scd4xd_sensor_t *sensor = (scd4xd_sensor_t *)arg;
+    scd4x_sample_t sample;
+    uint32_t wait_us = 0;
+    uint64_t next_us;
+    uint8_t res;
+    
+    gs_current = sensor;
+    
+    /* a new maintenance run starts on the acquisition thread */
+    if (__atomic_load_n(&gs_maint_start, __ATOMIC_ACQUIRE) != 0)
+    {
+        a_scd4xd_maint_admit(scd4xd_loop_now_us());
+    }
+    
+    /* a new pressure read is queued on the acquisition thread */
+    if (gs_pressure_path != NULL)
+    {
+        a_scd4xd_pressure_take(scd4xd_loop_now_us());
+    }
+    
+    /* a maintenance job runs one command each wake up */
+    if (sensor->maint != 0)
+    {
+        a_scd4xd_maint_step(sensor);
+        
+        return;
+    }
+    
+    /* a recovery runs one command each wake up */
+    if (sensor->health.op != 0)
+    {
+        res = scd4xd_health_run(&sensor->health, &sensor->handle, scd4xd_loop_now_us(), &wait_us);
+        if (res != 0)
+        {
+            next_us = scd4xd_loop_now_us() + SCD4XD_ERROR_US;
+        }
+        else if (sensor->health.op != 0)
+        {
+            next_us = scd4xd_loop_now_us() + wait_us;
+        }
+        else
+        {
+            /* a reinit or power cycle cleared the ambient pressure */
+            if (gs_pressure_path != NULL)
+            {
+                (void)pthread_mutex_lock(&gs_mutex);
+                scd4xd_pressure_reset(&gs_pressure, sensor->index);
+                (void)pthread_mutex_unlock(&gs_mutex);
+            }
+            next_us = scd4xd_loop_now_us() + gs_period_us - SCD4XD_RETRY_US;
+        }
+        (void)scd4xd_loop_timer_start(gs_acq, &sensor->timer, next_us);
+        
+        return;
+    }
+    
+    /* a queued pressure goes out before the next poll sequence */
+    if ((sensor->idle != 0) && (gs_pressure_path != NULL) && (a_scd4xd_pressure_push(sensor) == 0))
+    {
+        return;
+    }
+    res = scd4x_poll_sample(&sensor->handle, &sample, &wait_us);
+    sensor->idle = (res != 6) ? 1 : 0;
+    if (scd4xd_health_report(&sensor->health, res, scd4xd_loop_now_us()) != 0)
+    {
+        next_us = scd4xd_loop_now_us();
+    }
+    else if (res == 6)
+    {
+        /* a command is in flight */
+        next_us = scd4xd_loop_now_us() + wait_us;
+    }
+    else if (res == 5)
+    {
+        next_us = scd4xd_loop_now_us() + SCD4XD_RETRY_US;
+    }
+    else if (res == 0)
+    {
+        /* wake up a little before the next data so the ready time is seen within the retry interval */
+        a_scd4xd_push(sensor, &sample);
+        next_us = sample.ready_time_us + gs_period_us - SCD4XD_RETRY_US;
+    }
+    else
+    {
+        next_us = scd4xd_loop_now_us() + SCD4XD_ERROR_US;
+    }
+    if ((res != 0) && (res != 5) && (res != 6))
+    {
+        (void)pthread_mutex_lock(&gs_mutex);
+        gs_info.errors++;
+        (void)pthread_mutex_unlock(&gs_mutex);
+    }
+    (void)scd4xd_loop_timer_start(gs_acq, &sensor->timer, next_us);
+}
+
+/**
+ * @brief      get the read jitter
+ * @param[out] *jitter pointer to a jitter structure
+ * @note       every sensor read is a timer callback, so the timer lateness is the actual minus the scheduled read time,
+ *             the counters are statistics and are copied without stopping the acquisition thread
+ */
+static void a_scd4xd_jitter(scd4xd_jitter_t *jitter)
+{
+    int i;
+    
+    memset(jitter, 0, sizeof(scd4xd_jitter_t));
+    jitter->realtime = gs_realtime;
+    jitter->count = (uint32_t)gs_acq->fired;
+    jitter->avg_us = (uint32_t)((gs_acq->fired != 0) ? (gs_acq->late_sum_us / gs_acq->fired) : 0);
+    jitter->max_us = (uint32_t)gs_acq->late_max_us;
+    for (i = 0; (i < SCD4XD_JITTER_BUCKETS) && (i < SCD4XD_LOOP_BUCKETS); i++)
+    {
+        jitter->bucket[i] = gs_acq->late_hist[i];
+    }
+}
+
+/**
+ * @brief      get the recovery stats
+ * @param[out] *info pointer to a health buffer
+ * @note       the counters are read without the acquisition thread like the jitter
+ */
+static void a_scd4xd_health(scd4xd_health_info_t *info)
+{
+    scd4xd_health_stats_t total;
+    int i;
+    
+    memset(&total, 0, sizeof(total));
+    memset(info, 0, sizeof(scd4xd_health_info_t));
+    for (i = 0; i < gs_sensors; i++)
+    {
+        scd4xd_health_add_stats(&total, &gs_sensor[i].health.stats);
+        info->down += (gs_sensor[i].health.down_us != 0) ? 1 : 0;
+    }
+    info->sensors = gs_sensors;
+    info->failures = total.failures;
+    info->stalls = total.stalls;
+    info->ladders = total.ladders;
+    for (i = 0; (i < SCD4XD_RUNGS) && (i < SCD4XD_HEALTH_RUNGS); i++)
+    {
+        info->attempts[i] = total.attempts[i];
+        info->recovered[i] = total.recovered[i];
+    }
+    info->down_ms = (uint32_t)(total.down_us / 1000);
+    info->recover_max_ms = (uint32_t)(total.recover_max_us / 1000);
+}
+
+/**
+ * @brief      get the pressure compensation stats
+ * @param[out] *info pointer to a pressure info buffer
+ * @note       the caller holds gs_mutex
+ */
+static void a_scd4xd_pressure_info(scd4xd_pressure_info_t *info)
+{
+    int i;
+    
+    memset(info, 0, sizeof(scd4xd_pressure_info_t));
+    info->sensors = gs_pressure.sensors;
+    info->pa = (uint32_t)(gs_pressure.pa + 0.5f);
+    info->threshold_pa = gs_pressure.config.threshold_pa;
+    info->max_age_ms = (uint32_t)(gs_pressure.config.max_age_us / 1000);
+    info->reads = gs_pressure.reads;
+    info->read_failed = gs_pressure.read_failed;
+    info->rounds = gs_pressure.rounds;
+    info->pushes = gs_pressure.pushes;
+    info->failed = gs_pressure.failed;
+    info->avoided = gs_pressure.avoided;
+    for (i = 0; i < gs_pressure.sensors; i++)
+    {
+        info->pending += (gs_pressure.sensor[i].pending != 0) ? 1 : 0;
+    }
+}
+
+/**
+ * @brief     power cycle a sensor with the hook program
+ * @param[in] *arg pointer to a sensor
+ * @return    status code
+ *            - 0 success
+ *            - 1 power cycle failed
+ * @note      the program gets the iic device or sim-<index> and blocks the acquisition until it exits,
+ *            a simulated sensor boots again
+ */
+static uint8_t a_scd4xd_power_cycle(void *arg)
+{
+    scd4xd_sensor_t *sensor = gs_current;
+    char cmd[256];
+    
+    (void)arg;
+    if (sensor->bus != NULL)
+    {
+        (void)snprintf(cmd, sizeof(cmd), "%s %s", gs_power_hook, sensor->bus);
+    }
+    else
+    {
+        (void)snprintf(cmd, sizeof(cmd), "%s sim-%d", gs_power_hook, sensor->index);
+    }
+    if (system(cmd) != 0)
+    {
+        return 1;
+    }
+#ifdef SCD4XD_SIM
+    if (sensor->bus == NULL)
+    {
+        scd4x_sim_init(&sensor->sim, sensor->type);
+        sensor->sim.serial[2] = sensor->index;
+    }
+#endif
+    
+    return 0;
+}
+
+/**
+ * @brief     start a maintenance run
+ * @param[in] *request pointer to a maint request
+ * @note      the sensors are grouped by their root adapter like discover, 8 simulated sensors share a bus,
+ *            the acquisition thread admits the jobs at its next wake up
+ */
+static void a_scd4xd_maint_begin(const scd4xd_maint_request_t *request)
+{
+    static char root[SCD4XD_MAINT_MAX_BUSES][SCD4XD_DISCOVER_NAME];
+    char name[SCD4XD_DISCOVER_NAME];
+    scd4xd_maint_config_t config;
+    uint16_t buses = 0;
+    uint16_t bus;
+    int i;
+    
+    config.op = request->op;
+    config.per_bus = request->per_bus;
+    config.target_ppm = request->target_ppm;
+    config.budget_us = (uint64_t)request->budget_ms * 1000;
+    scd4xd_maint_init(&gs_maint, &config, scd4xd_loop_now_us());
+    for (i = 0; i < gs_sensors; i++)
+    {
+        if (gs_sensor[i].bus != NULL)
+        {
+            scd4xd_discover_root(gs_sensor[i].bus, name);
+        }
+        else
+        {
+            (void)snprintf(name, sizeof(name), "sim-%d", i / 8);
+        }
+        for (bus = 0; (bus < buses) && (strcmp(root[bus], name) != 0); bus++)
+        {
+            
+        }
+        if (bus == buses)
+        {
+            memcpy(root[buses++], name, sizeof(name));
+        }
+        (void)scd4xd_maint_add(&gs_maint, bus, (gs_health.low_power != 0) ? SCD4XD_MAINT_MODE_LOW_POWER : SCD4XD_MAINT_MODE_PERIODIC);
+    }
+    __atomic_store_n(&gs_maint_start, 1, __ATOMIC_RELEASE);
+}
+
+/**
+ * @brief      get the maintenance progress
+ * @param[out] *buf pointer to a status and results buffer
+ * @param[out] *count pointer to a result number buffer
+ * @return     payload size
+ * @note       the status is followed by a result of each sensor
+ */
+static size_t a_scd4xd_maint_status(uint8_t *buf, uint16_t *count)
+{
+    scd4xd_maint_status_t status;
+    scd4xd_maint_result_t result;
+    scd4xd_maint_job_t *job;
+    uint64_t now_us = scd4xd_loop_now_us();
+    uint16_t i;
+    
+    memset(&status, 0, sizeof(status));
+    status.op = gs_maint.config.op;
+    status.per_bus = gs_maint.config.per_bus;
+    status.target_ppm = gs_maint.config.target_ppm;
+    status.budget_ms = (uint32_t)(gs_maint.config.budget_us / 1000);
+    status.buses = gs_maint.buses;
+    status.queued = gs_maint.queued;
+    status.active = gs_maint.active;
+    status.done = gs_maint.done;
+    status.failed = gs_maint.failed;
+    status.skipped = gs_maint.skipped;
+    status.elapsed_ms = (uint32_t)((((gs_maint.end_us != 0) ? gs_maint.end_us : now_us) - gs_maint.start_us) / 1000);
+    status.serial_ms = (uint32_t)(gs_maint.serial_us / 1000);
+    memcpy(buf, &status, sizeof(status));
+    for (i = 0; i < gs_maint.jobs; i++)
+    {
+        job = &gs_maint.job[i];
+        memset(&result, 0, sizeof(result));
+        result.sensor = (uint8_t)i;
+        result.state = job->state;
+        result.step = job->step;
+        result.steps = job->steps;
+        result.bus = job->bus;
+        result.result = job->result;
+        if (job->state != SCD4XD_MAINT_STATE_QUEUED)
+        {
+            result.start_ms = (uint32_t)((job->start_us - gs_maint.start_us) / 1000);
+            result.time_ms = (uint32_t)((((job->state == SCD4XD_MAINT_STATE_ACTIVE) ? now_us : job->end_us) - job->start_us) / 1000);
+        }
+        memcpy(&buf[sizeof(status) + i * sizeof(result)], &result, sizeof(result));
+    }
+    *count = gs_maint.jobs;
+    
+    return sizeof(status) + gs_maint.jobs * sizeof(result);
+}
+
+/**
+ * @brief     handle a client request
+ * @param[in] *client pointer to a client
+ * @return    status code
+ *            - 0 success
+ *            - 1 client is closed
+ * @note      none
+ */
+static uint8_t a_scd4xd_request(scd4xd_client_t *client)
+{
+    uint8_t buf[sizeof(scd4xd_header_t) + sizeof(scd4xd_maint_request_t)];
+    uint8_t maint[sizeof(scd4xd_maint_status_t) + SCD4XD_MAINT_MAX_JOBS * sizeof(scd4xd_maint_result_t)];
+    scd4xd_header_t header;
+    scd4xd_record_t record[SCD4XD_MAX_RECORDS];
+    scd4xd_info_t info;
+    scd4xd_jitter_t jitter;
+    scd4xd_health_info_t health;
+    scd4xd_maint_request_t request;
+    scd4xd_pressure_info_t pressure;
+    ssize_t len;
+    size_t size;
+    uint16_t num;
+    uint8_t res;
+    int i;
+    
+    /* one request each packet, a maint request has a payload */
+    len = recv(client->watch.fd, buf, sizeof(buf), MSG_DONTWAIT);
+    if ((len < 0) && ((errno == EAGAIN) || (errno == EWOULDBLOCK)))
+    {
+        return 0;
+    }
+    if (len < (ssize_t)sizeof(header))
+    {
+        return 1;
+    }
+    memcpy(&header, buf, sizeof(header));
+    
+    switch (header.type)
+    {
+        case SCD4XD_MSG_LATEST :
+        {
+            (void)pthread_mutex_lock(&gs_mutex);
+            for (i = 0, num = 0; (i < gs_sensors) && (num < SCD4XD_MAX_RECORDS); i++)
+            {
+                if (gs_sensor[i].has_latest != 0)
+                {
+                    record[num++] = gs_sensor[i].latest;
+                }
+            }
+            (void)pthread_mutex_unlock(&gs_mutex);
+            res = a_scd4xd_send(client, header.type, (num != 0) ? SCD4XD_STATUS_OK : SCD4XD_STATUS_NO_DATA, 
+                                record, num, num * sizeof(scd4xd_record_t));
+            
+            break;
+        }
+        case SCD4XD_MSG_HISTORY :
+        {
+            if ((header.count == 0) || (header.count > SCD4XD_MAX_RECORDS))
+            {
+                res = a_scd4xd_send(client, header.type, SCD4XD_STATUS_INVALID, NULL, 0, 0);
+                
+                break;
+            }
+            (void)pthread_mutex_lock(&gs_mutex);
+            num = a_scd4xd_history_copy((gs_info.samples > header.count) ? (gs_info.samples - header.count) : 0, 
+                                        header.count, record);
+            (void)pthread_mutex_unlock(&gs_mutex);
+            res = a_scd4xd_send(client, header.type, (num != 0) ? SCD4XD_STATUS_OK : SCD4XD_STATUS_NO_DATA, 
+                                record, num, num * sizeof(scd4xd_record_t));
+            
+            break;
+        }
+        case SCD4XD_MSG_SUBSCRIBE :
+        {
+            (void)pthread_mutex_lock(&gs_mutex);
+            client->next_seq = gs_info.samples;
+            (void)pthread_mutex_unlock(&gs_mutex);
+            client->subscribed = 1;
+            res = a_scd4xd_send(client, header.type, SCD4XD_STATUS_OK, NULL, 0, 0);
+            
+            break;
+        }
+        case SCD4XD_MSG_UNSUBSCRIBE :
+        {
+            client->subscribed = 0;
+            res = a_scd4xd_send(client, header.type, SCD4XD_STATUS_OK, NULL, 0, 0);
+            
+            break;
+        }
+        case SCD4XD_MSG_INFO :
+        {
+            (void)pthread_mutex_lock(&gs_mutex);
+            info = gs_info;
+            (void)pthread_mutex_unlock(&gs_mutex);
+            res = a_scd4xd_send(client, header.type, SCD4XD_STATUS_OK, &info, 1, sizeof(info));
+            
+            break;
+        }
+        case SCD4XD_MSG_JITTER :
+        {
+            a_scd4xd_jitter(&jitter);
+            res = a_scd4xd_send(client, header.type, (jitter.count != 0) ? SCD4XD_STATUS_OK : SCD4XD_STATUS_NO_DATA, 
+                                &jitter, 1, sizeof(jitter));
+            
+            break;
+        }
+        case SCD4XD_MSG_HEALTH :
+        {
+            a_scd4xd_health(&health);
+            res = a_scd4xd_send(client, header.type, SCD4XD_STATUS_OK, &health, 1, sizeof(health));
+            
+            break;
+        }
+        case SCD4XD_MSG_MAINT :
+        {
+            memcpy(&request, &buf[sizeof(header)], sizeof(request));
+            if ((len != (ssize_t)sizeof(buf)) || (request.op < SCD4XD_MAINT_OP_SELF_TEST) || (request.op > SCD4XD_MAINT_OP_PERSIST) || 
+                ((request.op == SCD4XD_MAINT_OP_FRC) && (request.target_ppm == 0)))
+            {
+                res = a_scd4xd_send(client, header.type, SCD4XD_STATUS_INVALID, NULL, 0, 0);
+                
+                break;
+            }
+            
+            /* one run at a time */
+            (void)pthread_mutex_lock(&gs_mutex);
+            if (((gs_maint.jobs != 0) && (gs_maint.end_us == 0)) || (__atomic_load_n(&gs_maint_start, __ATOMIC_RELAXED) != 0))
+            {
+                (void)pthread_mutex_unlock(&gs_mutex);
+                res = a_scd4xd_send(client, header.type, SCD4XD_STATUS_BUSY, NULL, 0, 0);
+                
+                break;
+            }
+            a_scd4xd_maint_begin(&request);
+            (void)pthread_mutex_unlock(&gs_mutex);
+            
+            /* the client thread runs the sensors without the real time thread */
+            if (gs_acq == &gs_loop)
+            {
+                a_scd4xd_maint_admit(scd4xd_loop_now_us());
+            }
+            res = a_scd4xd_send(client, header.type, SCD4XD_STATUS_OK, NULL, gs_sensors, 0);
+            
+            break;
+        }
+        case SCD4XD_MSG_MAINT_STATUS :
+        {
+            (void)pthread_mutex_lock(&gs_mutex);
+            size = a_scd4xd_maint_status(maint, &num);
+            (void)pthread_mutex_unlock(&gs_mutex);
+            res = a_scd4xd_send(client, header.type, (num != 0) ? SCD4XD_STATUS_OK : SCD4XD_STATUS_NO_DATA, maint, num, size);
+            
+            break;
+        }
+        case SCD4XD_MSG_PRESSURE :
+        {
+            (void)pthread_mutex_lock(&gs_mutex);
+            a_scd4xd_pressure_info(&pressure);
+            (void)pthread_mutex_unlock(&gs_mutex);
+            res = a_scd4xd_send(client, header.type, (gs_pressure_path != NULL) ? SCD4XD_STATUS_OK : SCD4XD_STATUS_NO_DATA, 
+                                &pressure, 1, sizeof(pressure));
+            
+            break;
+        }
+        default :
+        {
+            res = a_scd4xd_send(client, header.type, SCD4XD_STATUS_INVALID, NULL, 0, 0);
+            
+            break;
+        }
+    }
+    
+    return res;
+}
+
+/**
+ * @brief     client socket event
+ * @param[in] *arg pointer to a client
+ * @param[in] events epoll events
+ * @note      none
+ */
+static void a_scd4xd_client_event(void *arg, uint32_t events)
+{
+    scd4xd_client_t *client = (scd4xd_client_t *)arg;
+    
+    (void)events;
+    if (a_scd4xd_request(client) != 0)
+    {
+        a_scd4xd_close(client);
+    }
+}
+
+/**
+ * @brief     listen socket event
+ * @param[in] *arg listen fd
+ * @param[in] events epoll events
+ * @note      none
+ */
+static void a_scd4xd_accept(void *arg, uint32_t events)
+{
+    int listen_fd = *(int *)arg;
+    int fd;
+    int i;
+    
+    (void)events;
+    while ((fd = accept4(listen_fd, NULL, NULL, SOCK_NONBLOCK | SOCK_CLOEXEC)) >= 0)
+    {
+        for (i = 0; i < SCD4XD_MAX_CLIENTS; i++)
+        {
+            if (gs_client[i].watch.fd < 0)
+            {
+                break;
+            }
+        }
+        if ((i == SCD4XD_MAX_CLIENTS) || 
+            (scd4xd_loop_add_fd(&gs_loop, &gs_client[i].watch, fd, EPOLLIN, a_scd4xd_client_event, &gs_client[i]) != 0))
+        {
+            (void)close(fd);
+            
+            continue;
+        }
+        gs_client[i].subscribed = 0;
+        gs_info.clients++;
+    }
+}
+
+/**
+ * @brief     stop signal event
+ * @param[in] *arg unused
+ * @param[in] events epoll events
+ * @note      none
+ */
+static void a_scd4xd_signal(void *arg, uint32_t events)
+{
+    (void)arg;
+    (void)events;
+    scd4xd_loop_stop(&gs_loop);
+}
+
+/**
+ * @brief     open the listen socket
+ * @param[in] *path pointer to a socket path
+ * @return    fd or -1 if failed
+ * @note      an old socket file is removed
+ */
+static int a_scd4xd_listen(const char *path)
+{
+    struct sockaddr_un addr;
+    int fd;
+    
+    if (strlen(path) >= sizeof(addr.sun_path))
+    {
+        return -1;
+    }
+    fd = socket(AF_UNIX, SOCK_SEQPACKET | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (fd < 0)
+    {
+        return -1;
+    }
+    memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    strcpy(addr.sun_path, path);
+    (void)unlink(path);
+    if ((bind(fd, (struct sockaddr *)&addr, sizeof(addr)) != 0) || (listen(fd, 16) != 0))
+    {
+        (void)close(fd);
+        
+        return -1;
+    }
+    
+    return fd;
+}
+
+/**
+ * @brief      apply the registry settings to a stopped sensor
+ * @param[in]  *sensor pointer to a sensor
+ * @param[out] *commands pointer to a command counter
+ * @return     status code
+ *             - 0 success
+ *             - 1 apply failed
+ * @note       the settings of a new sensor are read once, a known sensor only gets
+ *             the settings which differ from the ones it loads at power up and nothing is read back
+ */
+static uint8_t a_scd4xd_apply(scd4xd_sensor_t *sensor, uint32_t *commands)
+{
+    scd4xd_registry_entry_t *entry;
+    uint16_t number[3];
+    uint8_t changed = 0;
+    
+    /* discover has read the serial already */
+    if (sensor->serial == 0)
+    {
+        if (scd4x_get_serial_number(&sensor->handle, number) != 0)
+        {
+            return 1;
+        }
+        (*commands)++;
+        sensor->serial = ((uint64_t)number[0] << 32) | ((uint64_t)number[1] << 16) | number[2];
+    }
+    entry = scd4xd_registry_add(&gs_registry, sensor->serial);
+    if (entry == NULL)
+    {
+        scd4x_interface_debug_print("scd4xd: registry is full.\n");
+        
+        return 1;
+    }
+    
+    /* a new sensor keeps its own settings */
+    if ((entry->flags & SCD4XD_REGISTRY_FLAG_KNOWN) == 0)
+    {
+        if ((scd4x_get_temperature_offset(&sensor->handle, &entry->power_offset) != 0) || 
+            (scd4x_get_sensor_altitude(&sensor->handle, &entry->power_altitude) != 0))
+        {
+            return 1;
+        }
+        *commands += 2;
+        if (entry->connects == 0)
+        {
+            entry->offset = entry->power_offset;
+            entry->altitude = entry->power_altitude;
+            entry->first_seen_s = (uint64_t)time(NULL);
+        }
+        entry->flags |= SCD4XD_REGISTRY_FLAG_KNOWN;
+    }
+    
+    /* write only the differences */
+    if (entry->offset != entry->power_offset)
+    {
+        if (scd4x_set_temperature_offset(&sensor->handle, entry->offset) != 0)
+        {
+            return 1;
+        }
+        (*commands)++;
+        changed = 1;
+    }
+    if (entry->altitude != entry->power_altitude)
+    {
+        if (scd4x_set_sensor_altitude(&sensor->handle, entry->altitude) != 0)
+        {
+            return 1;
+        }
+        (*commands)++;
+        changed = 1;
+    }
+    if ((changed != 0) && ((entry->flags & SCD4XD_REGISTRY_FLAG_PERSIST) != 0))
+    {
+        if (scd4x_persist_settings(&sensor->handle) != 0)
+        {
+            return 1;
+        }
+        (*commands)++;
+        entry->power_offset = entry->offset;
+        entry->power_altitude = entry->altitude;
+    }
+    
+    /* the connect */
+    if (sensor->bus != NULL)
+    {
+        (void)snprintf(entry->location, SCD4XD_REGISTRY_LOCATION, "%s", sensor->bus);
+    }
+    else
+    {
+        (void)snprintf(entry->location, SCD4XD_REGISTRY_LOCATION, "sim-%d", sensor->index);
+    }
+    entry->type = (uint8_t)sensor->type;
+    entry->connects++;
+    entry->last_seen_s = (uint64_t)time(NULL);
+    sensor->entry = entry;
+    
+    return 0;
+}
+
+/**
+ * @brief     start all sensors
+ * @param[in] low_power 1 for the low power periodic measurement
+ * @return    status code
+ *            - 0 success
+ *            - 1 start failed
+ * @note      the stop commands of all sensors run first so their execution times overlap,
+ *            the registry settings are applied while the sensors are idle
+ */
+static uint8_t a_scd4xd_start(uint8_t low_power)
+{
+    scd4xd_sensor_t *sensor;
+    uint32_t commands = 0;
+    uint64_t start;
+    uint8_t res;
+    int known = 0;
+    int i;
+    
+    for (i = 0; i < gs_sensors; i++)
+    {
+        sensor = &gs_sensor[i];
+        gs_current = sensor;
+        
+        /* link functions */
+        DRIVER_SCD4X_LINK_INIT(&sensor->handle, scd4x_handle_t);
+        DRIVER_SCD4X_LINK_IIC_INIT(&sensor->handle, a_scd4xd_iic_init);
+        DRIVER_SCD4X_LINK_IIC_DEINIT(&sensor->handle, a_scd4xd_iic_deinit);
+        DRIVER_SCD4X_LINK_IIC_WRITE_COMMAND(&sensor->handle, a_scd4xd_iic_write_cmd);
+        DRIVER_SCD4X_LINK_IIC_READ_COMMAND(&sensor->handle, a_scd4xd_iic_read_cmd);
+        DRIVER_SCD4X_LINK_DELAY_MS(&sensor->handle, scd4x_interface_delay_ms);
+        DRIVER_SCD4X_LINK_GET_TIME_US(&sensor->handle, scd4x_interface_get_time_us);
+        DRIVER_SCD4X_LINK_DEBUG_PRINT(&sensor->handle, scd4x_interface_debug_print);
+#ifdef SCD4XD_SIM
+        if (sensor->bus == NULL)
+        {
+            scd4x_sim_init(&sensor->sim, sensor->type);
+            sensor->sim.serial[2] = (uint16_t)i;
+        }
+#endif
+        scd4xd_loop_timer_init(&sensor->timer, a_scd4xd_sensor_poll, sensor);
+        sensor->index = (uint8_t)i;
+        
+        /* init and stop */
+        if ((scd4x_set_type(&sensor->handle, sensor->type) != 0) || (scd4x_init(&sensor->handle) != 0))
+        {
+            scd4x_interface_debug_print("scd4xd: sensor %d init failed.\n", i);
+            
+            return 1;
+        }
+        (void)scd4x_stop_periodic_measurement(&sensor->handle);
+    }
+    if (gs_registry.file != NULL)
+    {
+        start = scd4xd_loop_now_us();
+        for (i = 0; i < gs_sensors; i++)
+        {
+            sensor = &gs_sensor[i];
+            gs_current = sensor;
+            if (a_scd4xd_apply(sensor, &commands) != 0)
+            {
+                scd4x_interface_debug_print("scd4xd: sensor %d apply failed.\n", i);
+                
+                return 1;
+            }
+            known += (sensor->entry->connects > 1) ? 1 : 0;
+        }
+        scd4xd_registry_sync(&gs_registry);
+        scd4x_interface_debug_print("scd4xd: registry %d known, %d new, %u commands, %llu ms.\n", known, gs_sensors - known, 
+                                    commands, (unsigned long long)((scd4xd_loop_now_us() - start) / 1000));
+    }
+    for (i = 0; i < gs_sensors; i++)
+    {
+        sensor = &gs_sensor[i];
+        gs_current = sensor;
+        res = (low_power != 0) ? scd4x_start_low_power_periodic_measurement(&sensor->handle) : 
+                                 scd4x_start_periodic_measurement(&sensor->handle);
+        if (res != 0)
+        {
+            scd4x_interface_debug_print("scd4xd: sensor %d start failed.\n", i);
+            
+            return 1;
+        }
+        if (sensor->entry != NULL)
+        {
+            sensor->entry->state = (low_power != 0) ? SCD4XD_REGISTRY_STATE_LOW_POWER : SCD4XD_REGISTRY_STATE_PERIODIC;
+        }
+        scd4xd_health_init(&sensor->health, &gs_health, scd4xd_loop_now_us());
+        sensor->idle = 1;
+        (void)scd4xd_loop_timer_start(gs_acq, &sensor->timer, scd4xd_loop_now_us() + gs_period_us - SCD4XD_RETRY_US);
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief  stop all sensors
+ * @note   none
+ */
+static void a_scd4xd_stop(void)
+{
+    int i;
+    
+    scd4xd_loop_timer_stop(&gs_loop, &gs_pressure_timer);
+    for (i = 0; i < gs_sensors; i++)
+    {
+        gs_current = &gs_sensor[i];
+        scd4xd_loop_timer_stop(gs_acq, &gs_sensor[i].timer);
+        if ((gs_sensor[i].handle.inited != 0) && (scd4x_deinit(&gs_sensor[i].handle) == 0) && (gs_sensor[i].entry != NULL))
+        {
+            gs_sensor[i].entry->state = SCD4XD_REGISTRY_STATE_IDLE;
+            gs_sensor[i].entry->last_seen_s = (uint64_t)time(NULL);
+        }
+    }
+}
+
+/**
+ * @brief     discover the sensors
+ * @param[in] sim simulated location number, 0 for the iic devices
+ * @param[in] print 1 to print the sensors
+ * @return    status code
+ *            - 0 success
+ *            - 1 discover failed
+ * @note      the given --bus devices are probed, or every iic device if none is given,
+ *            the simulated locations are 8 channels behind each simulated adapter
+ */
+static uint8_t a_scd4xd_discover(uint32_t sim, uint8_t print)
+{
+    static char name[SCD4XD_DISCOVER_MAX][SCD4XD_DISCOVER_NAME];
+    const char *bus[SCD4XD_DISCOVER_MAX];
+    uint64_t start;
+    uint16_t found;
+    uint16_t workers;
+    uint16_t num;
+    uint16_t i;
+    
+    /* get the locations */
+    if (sim != 0)
+    {
+        for (num = 0; num < sim; num++)
+        {
+            (void)snprintf(name[num], SCD4XD_DISCOVER_NAME, "sim-%u-%u", num / 8, num % 8);
+            bus[num] = name[num];
+        }
+    }
+    else if (gs_sensors != 0)
+    {
+        for (num = 0; num < gs_sensors; num++)
+        {
+            bus[num] = gs_sensor[num].bus;
+        }
+    }
+    else
+    {
+        num = scd4xd_discover_scan(name, SCD4XD_DISCOVER_MAX);
+        for (i = 0; i < num; i++)
+        {
+            bus[i] = name[i];
+        }
+    }
+    if (num == 0)
+    {
+        scd4x_interface_debug_print("scd4xd: no iic device.\n");
+        
+        return 1;
+    }
+    
+    /* probe them */
+    start = scd4xd_loop_now_us();
+    if (scd4xd_discover(bus, num, gs_device, &found, &workers) != 0)
+    {
+        scd4x_interface_debug_print("scd4xd: discover failed.\n");
+        
+        return 1;
+    }
+    if (print != 0)
+    {
+        printf("bus,type,serial\n");
+        for (i = 0; i < found; i++)
+        {
+            printf("%s,SCD4%d,0x%012llX\n", gs_device[i].bus, (gs_device[i].type == SCD40) ? 0 : ((gs_device[i].type == SCD41) ? 1 : 3), 
+                   (unsigned long long)gs_device[i].serial);
+        }
+        fflush(stdout);
+    }
+    fprintf(stderr, "scd4xd: %d sensors on %d locations, %d workers, %llu ms.\n", found, num, workers, 
+            (unsigned long long)((scd4xd_loop_now_us() - start) / 1000));
+    
+    /* the found sensors replace the probed ones */
+    for (gs_sensors = 0; gs_sensors < found; gs_sensors++)
+    {
+        gs_sensor[gs_sensors].bus = gs_device[gs_sensors].bus;
+        gs_sensor[gs_sensors].type = gs_device[gs_sensors].type;
+        gs_sensor[gs_sensors].serial = gs_device[gs_sensors].serial;
+    }
+    
+    return (found != 0) ? 0 : 1;
+}
+
+/**
+ * @brief     real time acquisition thread
+ * @param[in] *arg unused
+ * @return    NULL
+ * @note      none
+ */
+static void *a_scd4xd_rt_thread(void *arg)
+{
+    volatile uint8_t stack[SCD4XD_RT_STACK];
+    
+    /* prefault the stack so the first reads don't take page faults */
+    (void)arg;
+    memset((void *)stack, 0, sizeof(stack));
+    (void)scd4xd_loop_run_sleep(&gs_rt_loop, SCD4XD_RT_SLEEP_US);
+    
+    return NULL;
+}
+
+/**
+ * @brief      start the real time acquisition thread
+ * @param[in]  priority SCHED_FIFO priority
+ * @param[out] *thread pointer to a thread
+ * @return     status code
+ *             - 0 success
+ *             - 1 start failed
+ * @note       without the permissions it warns and runs the thread with the normal policy
+ */
+static uint8_t a_scd4xd_rt_start(int priority, pthread_t *thread)
+{
+    pthread_attr_t attr;
+    struct sched_param param;
+    int res;
+    
+    /* lock the pages so the reads never wait for a page in */
+    if (mlockall(MCL_CURRENT | MCL_FUTURE) != 0)
+    {
+        scd4x_interface_debug_print("scd4xd: mlockall failed, page faults may delay the reads.\n");
+    }
+    
+    /* fifo thread */
+    memset(&param, 0, sizeof(param));
+    param.sched_priority = priority;
+    (void)pthread_attr_init(&attr);
+    (void)pthread_attr_setinheritsched(&attr, PTHREAD_EXPLICIT_SCHED);
+    (void)pthread_attr_setschedpolicy(&attr, SCHED_FIFO);
+    (void)pthread_attr_setschedparam(&attr, &param);
+    res = pthread_create(thread, &attr, a_scd4xd_rt_thread, NULL);
+    (void)pthread_attr_destroy(&attr);
+    if (res == 0)
+    {
+        gs_realtime = 1;
+        
+        return 0;
+    }
+    
+    /* normal thread */
+    scd4x_interface_debug_print("scd4xd: no SCHED_FIFO permission, the acquisition thread runs with the normal policy.\n");
+    if (pthread_create(thread, NULL, a_scd4xd_rt_thread, NULL) != 0)
+    {
+        return 1;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief     scd4xd main function
+ * @param[in] argc arg numbers
+ * @param[in] **argv arg address
+ * @return    status code
+ *            - 0 success
+ *            - 1 run failed
+ *            - 5 param is invalid
+ * @note      none
+ */
+int main(int argc, char **argv)
+{
+    int c;
+    int longindex = 0;
+    const char short_options[] = "h";
+    const struct option long_options[] =
+    {
+        {"help", no_argument, NULL, 'h'},
+        {"socket", required_argument, NULL, 1},
+        {"type", required_argument, NULL, 2},
+        {"low-power", no_argument, NULL, 3},
+#ifdef SCD4XD_SIM
+        {"sim", optional_argument, NULL, 4},
+#endif
+        {"shm", required_argument, NULL, 5},
+        {"bus", required_argument, NULL, 6},
+        {"rt", optional_argument, NULL, 7},
+        {"iic-rw", no_argument, NULL, 8},
+        {"discover", no_argument, NULL, 9},
+        {"registry", required_argument, NULL, 10},
+        {"power-hook", required_argument, NULL, 11},
+        {"factory-reset", no_argument, NULL, 12},
+        {"pressure", required_argument, NULL, 13},
+        {"pressure-scale", required_argument, NULL, 14},
+        {"pressure-threshold", required_argument, NULL, 15},
+        {"pressure-age", required_argument, NULL, 16},
+        {"pressure-period", required_argument, NULL, 17},
+        {NULL, 0, NULL, 0},
+    };
+    const char *path = SCD4XD_DEFAULT_SOCKET;
+    const char *shm_name = NULL;
+    const char *registry = NULL;
+    scd4xd_pressure_config_t pressure;
+    uint32_t pressure_period = SCD4XD_PRESSURE_PERIOD;
+    uint32_t pressure_age = SCD4XD_PRESSURE_AGE;
+    scd4x_t chip_type = SCD41;
+    uint8_t low_power = 0;
+    uint8_t discover = 0;
+    uint32_t sim = 0;
+    int priority = 0;
+    pthread_t thread;
+    pthread_mutexattr_t mutex_attr;
+    int listen_fd;
+    int signal_fd;
+    int notify_fd;
+    sigset_t mask;
+    struct rusage usage;
+    uint8_t res;
+    int i;
+    
+    /* init 0 */
+    optind = 0;
+    pressure.threshold_pa = SCD4XD_PRESSURE_THRESHOLD;
+    
+    /* parse */
+    do
+    {
+        /* parse the args */
+        c = getopt_long(argc, argv, short_options, long_options, &longindex);
+        
+        /* judge the result */
+        switch (c)
+        {
+            /* help */
+            case 'h' :
+            {
+                scd4x_interface_debug_print("Usage:\n");
+                scd4x_interface_debug_print("  scd4xd [--socket=<path>] [--type=<SCD40 | SCD41 | SCD43>] [--low-power]\n");
+#ifdef SCD4XD_SIM
+                scd4x_interface_debug_print("         [--bus=<dev | auto>]... [--sim[=<num>]] [--shm=<name>] [--rt[=<priority>]] [--iic-rw]\n");
+#else
+                scd4x_interface_debug_print("         [--bus=<dev | auto>]... [--shm=<name>] [--rt[=<priority>]] [--iic-rw]\n");
+#endif
+                scd4x_interface_debug_print("         [--registry=<path>] [--power-hook=<program>] [--factory-reset]\n");
+                scd4x_interface_debug_print("         [--pressure=<path> [--pressure-scale=<pa>] [--pressure-threshold=<pa>] [--pressure-age=<ms>]\n");
+                scd4x_interface_debug_print("          [--pressure-period=<ms>]]\n");
+#ifdef SCD4XD_SIM
+                scd4x_interface_debug_print("  scd4xd --discover [--bus=<dev>]... [--sim=<num>]\n");
+#else
+                scd4x_interface_debug_print("  scd4xd --discover [--bus=<dev>]...\n");
+#endif
+                scd4x_interface_debug_print("\n");
+                scd4x_interface_debug_print("Options:\n");
+                scd4x_interface_debug_print("      --bus=<dev>      Add a sensor on an iic device, repeat it for more sensors, auto finds all sensors.\n");
+                scd4x_interface_debug_print("                       ([default: /dev/i2c-1])\n");
+                scd4x_interface_debug_print("      --discover       Probe the iic devices in parallel, print bus,type,serial of each sensor and exit.\n");
+                scd4x_interface_debug_print("      --factory-reset  Allow one factory reset in each outage as the last recovery.\n");
+                scd4x_interface_debug_print("  -h, --help           Show the help.\n");
+                scd4x_interface_debug_print("      --iic-rw         Set I2C_SLAVE once and use read and write instead of I2C_RDWR.\n");
+                scd4x_interface_debug_print("      --low-power      Run the low power periodic measurement.\n");
+                scd4x_interface_debug_print("      --power-hook=<program>\n");
+                scd4x_interface_debug_print("                       Power cycle a wedged sensor with the program, its argument is the iic device.\n");
+                scd4x_interface_debug_print("      --pressure=<path>\n");
+                scd4x_interface_debug_print("                       Read the ambient pressure from a file and push it to all sensors when it changes.\n");
+                scd4x_interface_debug_print("      --pressure-age=<ms>\n");
+                scd4x_interface_debug_print("                       Set the max time between the pushes of a sensor, 0 for no limit.([default: %d])\n", 
+                                            SCD4XD_PRESSURE_AGE);
+                scd4x_interface_debug_print("      --pressure-period=<ms>\n");
+                scd4x_interface_debug_print("                       Set the pressure read interval.([default: %d])\n", SCD4XD_PRESSURE_PERIOD);
+                scd4x_interface_debug_print("      --pressure-scale=<pa>\n");
+                scd4x_interface_debug_print("                       Set the pa of one unit of the pressure file, 1000 for kpa.([default: 1])\n");
+                scd4x_interface_debug_print("      --pressure-threshold=<pa>\n");
+                scd4x_interface_debug_print("                       Set the pressure change which pushes the sensors.([default: %d])\n", 
+                                            SCD4XD_PRESSURE_THRESHOLD);
+                scd4x_interface_debug_print("      --registry=<path>\n");
+                scd4x_interface_debug_print("                       Keep the sensors by serial in a registry file and apply its settings without read back.\n");
+                scd4x_interface_debug_print("      --rt[=<priority>]\n");
+                scd4x_interface_debug_print("                       Read the sensors on a locked SCHED_FIFO thread with absolute deadline sleeps.([default: %d])\n", 
+                                            SCD4XD_RT_PRIORITY);
+                scd4x_interface_debug_print("      --shm=<name>     Publish every sample to a shared memory ring, e.g. %s.\n", SCD4XD_SHM_DEFAULT_NAME);
+#ifdef SCD4XD_SIM
+                scd4x_interface_debug_print("      --sim[=<num>]    Add simulated sensors instead of the iic devices.([default: 1])\n");
+#endif
+                scd4x_interface_debug_print("      --socket=<path>  Set the unix socket path.([default: %s])\n", SCD4XD_DEFAULT_SOCKET);
+                scd4x_interface_debug_print("      --type=<SCD40 | SCD41 | SCD43>\n");
+                scd4x_interface_debug_print("                       Set the chip type.([default: SCD41])\n");
+                
+                return 0;
+            }
+            
+            /* socket path */
+            case 1 :
+            {
+                path = optarg;
+                
+                break;
+            }
+            
+            /* chip type */
+            case 2 :
+            {
+                if (strcmp(optarg, "SCD40") == 0)
+                {
+                    chip_type = SCD40;
+                }
+                else if (strcmp(optarg, "SCD41") == 0)
+                {
+                    chip_type = SCD41;
+                }
+                else if (strcmp(optarg, "SCD43") == 0)
+                {
+                    chip_type = SCD43;
+                }
+                else
+                {
+                    return 5;
+                }
+                
+                break;
+            }
+            
+            /* low power */
+            case 3 :
+            {
+                low_power = 1;
+                
+                break;
+            }
+            
+#ifdef SCD4XD_SIM
+            /* simulated sensors */
+            case 4 :
+            {
+                sim = (optarg != NULL) ? (uint32_t)atol(optarg) : 1;
+                if ((sim == 0) || (sim > SCD4XD_MAX_SENSORS))
+                {
+                    return 5;
+                }
+                
+                break;
+            }
+
+#endif
+            
+            /* shared memory feed */
+            case 5 :
+            {
+                shm_name = optarg;
+                
+                break;
+            }
+            
+            /* iic device */
+            case 6 :
+            {
+                if (strcmp(optarg, "auto") == 0)
+                {
+                    discover = 2;
+                    
+                    break;
+                }
+                if (gs_sensors >= SCD4XD_MAX_SENSORS)
+                {
+                    return 5;
+                }
+                gs_sensor[gs_sensors++].bus = optarg;
+                
+                break;
+            }
+            
+            /* real time thread */
+            case 7 :
+            {
+                priority = (optarg != NULL) ? atoi(optarg) : SCD4XD_RT_PRIORITY;
+                if ((priority < sched_get_priority_min(SCHED_FIFO)) || (priority > sched_get_priority_max(SCHED_FIFO)))
+                {
+                    return 5;
+                }
+                
+                break;
+            }
+            
+            /* read and write transport */
+            case 8 :
+            {
+                gs_iic_rw = 1;
+                
+                break;
+            }
+            
+            /* discover */
+            case 9 :
+            {
+                discover = 1;
+                
+                break;
+            }
+            
+            /* device registry */
+            case 10 :
+            {
+                registry = optarg;
+                
+                break;
+            }
+            
+            /* power cycle hook */
+            case 11 :
+            {
+                gs_power_hook = optarg;
+                
+                break;
+            }
+            
+            /* factory reset recovery */
+            case 12 :
+            {
+                gs_health.factory_reset = 1;
+                
+                break;
+            }
+            
+            /* pressure file */
+            case 13 :
+            {
+                gs_pressure_path = optarg;
+                
+                break;
+            }
+            
+            /* pressure file unit */
+            case 14 :
+            {
+                gs_pressure_scale = (float)atof(optarg);
+                if (!(gs_pressure_scale > 0.0f))
+                {
+                    return 5;
+                }
+                
+                break;
+            }
+            
+            /* pressure change of a push */
+            case 15 :
+            {
+                pressure.threshold_pa = (uint32_t)atol(optarg);
+                
+                break;
+            }
+            
+            /* max time between the pushes */
+            case 16 :
+            {
+                pressure_age = (uint32_t)atol(optarg);
+                
+                break;
+            }
+            
+            /* pressure read interval */
+            case 17 :
+            {
+                pressure_period = (uint32_t)atol(optarg);
+                if (pressure_period == 0)
+                {
+                    return 5;
+                }
+                
+                break;
+            }
+            
+            /* the end */
+            case -1 :
+            {
+                break;
+            }
+            
+            /* others */
+            default :
+            {
+                return 5;
+            }
+        }
+    } while (c != -1);
+    
+    /* find the sensors */
+    if (discover == 1)
+    {
+        return (a_scd4xd_discover(sim, 1) == 0) ? 0 : 1;
+    }
+    if ((discover == 2) && (sim == 0))
+    {
+        gs_sensors = 0;
+        if (a_scd4xd_discover(0, 0) != 0)
+        {
+            return 1;
+        }
+    }
+    
+    /* set the sensors, the discovered ones keep their variant */
+    for (i = 0; (i < gs_sensors) && (discover != 2); i++)
+    {
+        gs_sensor[i].type = chip_type;
+    }
+    if (sim != 0)
+    {
+        for (gs_sensors = 0; gs_sensors < sim; gs_sensors++)
+        {
+            gs_sensor[gs_sensors].bus = NULL;
+            gs_sensor[gs_sensors].type = chip_type;
+        }
+        gs_flags |= SCD4XD_FLAG_SIM;
+    }
+    else if (gs_sensors == 0)
+    {
+        gs_sensor[gs_sensors].type = chip_type;
+        gs_sensor[gs_sensors++].bus = "/dev/i2c-1";
+    }
+    if (low_power != 0)
+    {
+        gs_flags |= SCD4XD_FLAG_LOW_POWER;
+    }
+    gs_period_us = (low_power != 0) ? 30000000 : 5000000;
+    gs_health.retries = SCD4XD_HEALTH_RETRIES;
+    gs_health.low_power = low_power;
+    gs_health.stall_us = 3 * gs_period_us;
+    gs_health.power_cycle = (gs_power_hook != NULL) ? a_scd4xd_power_cycle : NULL;
+    pressure.max_age_us = (uint64_t)pressure_age * 1000;
+    pressure.batch_us = pressure.max_age_us / 10;
+    gs_pressure_period_us = (uint64_t)pressure_period * 1000;
+    
+    /* the real time thread shares the lock with the client thread, a client holding it runs at the real time priority */
+    (void)pthread_mutexattr_init(&mutex_attr);
+    if ((pthread_mutexattr_setprotocol(&mutex_attr, PTHREAD_PRIO_INHERIT) != 0) || (pthread_mutex_init(&gs_mutex, &mutex_attr) != 0))
+    {
+        scd4x_interface_debug_print("scd4xd: init the lock failed.\n");
+        (void)pthread_mutexattr_destroy(&mutex_attr);
+        
+        return 1;
+    }
+    (void)pthread_mutexattr_destroy(&mutex_attr);
+    
+    /* block the stop signals and take them from a signalfd */
+    sigemptyset(&mask);
+    sigaddset(&mask, SIGINT);
+    sigaddset(&mask, SIGTERM);
+    (void)sigprocmask(SIG_BLOCK, &mask, NULL);
+    signal_fd = signalfd(-1, &mask, SFD_NONBLOCK | SFD_CLOEXEC);
+    listen_fd = a_scd4xd_listen(path);
+    notify_fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if ((signal_fd < 0) || (listen_fd < 0) || (notify_fd < 0) || (scd4xd_loop_init(&gs_loop, SCD4XD_MAX_SENSORS + 1) != 0) || 
+        ((priority != 0) && (scd4xd_loop_init(&gs_rt_loop, SCD4XD_MAX_SENSORS + 1) != 0)))
+    {
+        scd4x_interface_debug_print("scd4xd: open %s failed.\n", path);
+        
+        return 1;
+    }
+    for (i = 0; i < SCD4XD_MAX_CLIENTS; i++)
+    {
+        gs_client[i].watch.fd = -1;
+    }
+    (void)scd4xd_loop_add_fd(&gs_loop, &gs_listen_watch, listen_fd, EPOLLIN, a_scd4xd_accept, &listen_fd);
+    (void)scd4xd_loop_add_fd(&gs_loop, &gs_signal_watch, signal_fd, EPOLLIN, a_scd4xd_signal, NULL);
+    (void)scd4xd_loop_add_fd(&gs_loop, &gs_notify_watch, notify_fd, EPOLLIN, a_scd4xd_notify, NULL);
+    gs_acq = (priority != 0) ? &gs_rt_loop : &gs_loop;
+    if ((shm_name != NULL) && (scd4xd_shm_create(&gs_shm, shm_name) != 0))
+    {
+        scd4x_interface_debug_print("scd4xd: create shm %s failed.\n", shm_name);
+        
+        return 1;
+    }
+    if ((registry != NULL) && (scd4xd_registry_open(&gs_registry, registry, SCD4XD_REGISTRY_CAPACITY) != 0))
+    {
+        scd4x_interface_debug_print("scd4xd: open registry %s failed.\n", registry);
+        
+        return 1;
+    }
+    gs_info.version = SCD4XD_PROTOCOL_VERSION;
+    gs_info.history = SCD4XD_HISTORY;
+    gs_info.sensors = gs_sensors;
+    
+    /* one thread runs all sensors and clients, or the sensors run on the real time thread */
+    scd4xd_loop_timer_init(&gs_pressure_timer, a_scd4xd_pressure_feed, NULL);
+    res = a_scd4xd_start(low_power);
+    if ((res == 0) && (gs_pressure_path != NULL))
+    {
+        /* the first read pushes every sensor */
+        res = scd4xd_pressure_init(&gs_pressure, &pressure, a_scd4xd_pressure_value, &gs_pressure_pa, gs_sensors);
+        if (res != 0)
+        {
+            scd4x_interface_debug_print("scd4xd: init the pressure feed failed.\n");
+        }
+        (void)scd4xd_loop_timer_start(&gs_loop, &gs_pressure_timer, scd4xd_loop_now_us());
+    }
+    if ((res == 0) && (priority != 0))
+    {
+        res = a_scd4xd_rt_start(priority, &thread);
+        if (res != 0)
+        {
+            scd4x_interface_debug_print("scd4xd: start the acquisition thread failed.\n");
+            priority = 0;
+        }
+    }
+    if (res == 0)
+    {
+        scd4x_interface_debug_print("scd4xd: %d sensors, serving on %s.\n", gs_sensors, path);
+        res = scd4xd_loop_run(&gs_loop);
+    }
+    
+    /* stop */
+    if (priority != 0)
+    {
+        scd4xd_loop_stop(&gs_rt_loop);
+        (void)pthread_join(thread, NULL);
+    }
+    a_scd4xd_stop();
+    for (i = 0; i < SCD4XD_MAX_CLIENTS; i++)
+    {
+        if (gs_client[i].watch.fd >= 0)
+        {
+            a_scd4xd_close(&gs_client[i]);
+        }
+    }
+    (void)getrusage(RUSAGE_SELF, &usage);
+    scd4x_interface_debug_print("scd4xd: %u samples, %u errors, %llu wakeups, timer late avg %llu us max %llu us, cpu %ld ms.\n", 
+                                gs_info.samples, gs_info.errors, (unsigned long long)gs_acq->wakeups, 
+                                (unsigned long long)((gs_acq->fired != 0) ? (gs_acq->late_sum_us / gs_acq->fired) : 0), 
+                                (unsigned long long)gs_acq->late_max_us, 
+                                (long)((usage.ru_utime.tv_sec + usage.ru_stime.tv_sec) * 1000 + 
+                                       (usage.ru_utime.tv_usec + usage.ru_stime.tv_usec) / 1000));
+    scd4xd_loop_deinit(&gs_loop);
+    if (gs_acq == &gs_rt_loop)
+    {
+        scd4xd_loop_deinit(&gs_rt_loop);
+    }
+    (void)close(notify_fd);
+    (void)close(listen_fd);
+    (void)unlink(path);
+    (void)close(signal_fd);
+    scd4xd_shm_close(&gs_shm);
+    scd4xd_registry_close(&gs_registry);
+    (void)pthread_mutex_destroy(&gs_mutex);
+    scd4x_interface_debug_print("scd4xd: stopped.\n");
+    
+    return (res == 0) ? 0 : 1;
+}
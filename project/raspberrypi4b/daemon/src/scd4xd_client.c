@@ -0,0 +1,785 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      scd4xd_client.c
+ * @brief     scd4xd client source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "scd4xd_protocol.h"
+#include "scd4xd_registry.h"
+#include "scd4xd_shm.h"
+#include <getopt.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+/**
+ * @brief     connect to the daemon
+ * @param[in] *path pointer to a socket path
+ * @return    fd or -1 if failed
+ * @note      none
+ */
+static int a_scd4xd_client_connect(const char *path)
+{
+    struct sockaddr_un addr;
+    int fd;
+    
+    if (strlen(path) >= sizeof(addr.sun_path))
+    {
+        return -1;
+    }
+    fd = socket(AF_UNIX, SOCK_SEQPACKET | SOCK_CLOEXEC, 0);
+    if (fd < 0)
+    {
+        return -1;
+    }
+    memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    strcpy(addr.sun_path, path);
+    if (connect(fd, (struct sockaddr *)&addr, sizeof(addr)) != 0)
+    {
+        (void)close(fd);
+        
+        return -1;
+    }
+    
+    return fd;
+}
+
+/**
+ * @brief     send a request
+ * @param[in] fd socket fd
+ * @param[in] type message type
+ * @param[in] count requested record number
+ * @return    status code
+ *            - 0 success
+ *            - 1 send failed
+ * @note      none
+ */
+static uint8_t a_scd4xd_client_request(int fd, uint8_t type, uint16_t count)
+{
+    scd4xd_header_t header;
+    
+    header.type = type;
+    header.status = 0;
+    header.count = count;
+    if (send(fd, &header, sizeof(header), MSG_NOSIGNAL) != (ssize_t)sizeof(header))
+    {
+        return 1;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief     send a maint request
+ * @param[in] fd socket fd
+ * @param[in] argc arg number after the command
+ * @param[in] **argv pointer to the args after the command
+ * @return    status code
+ *            - 0 success
+ *            - 1 send failed
+ *            - 5 param is invalid
+ * @note      the operation is followed by key=value settings
+ */
+static uint8_t a_scd4xd_client_maint(int fd, int argc, char **argv)
+{
+    uint8_t buf[sizeof(scd4xd_header_t) + sizeof(scd4xd_maint_request_t)];
+    scd4xd_maint_request_t request;
+    scd4xd_header_t header;
+    int j;
+    
+    memset(&request, 0, sizeof(request));
+    if (argc < 1)
+    {
+        return 5;
+    }
+    if (strcmp(argv[0], "self-test") == 0)
+    {
+        request.op = 1;
+    }
+    else if (strcmp(argv[0], "frc") == 0)
+    {
+        request.op = 2;
+    }
+    else if (strcmp(argv[0], "persist") == 0)
+    {
+        request.op = 3;
+    }
+    else
+    {
+        return 5;
+    }
+    
+    /* key=value settings */
+    for (j = 1; j < argc; j++)
+    {
+        if (strncmp(argv[j], "target=", 7) == 0)
+        {
+            request.target_ppm = (uint16_t)atoi(&argv[j][7]);
+        }
+        else if (strncmp(argv[j], "per-bus=", 8) == 0)
+        {
+            request.per_bus = (uint8_t)atoi(&argv[j][8]);
+        }
+        else if (strncmp(argv[j], "budget=", 7) == 0)
+        {
+            request.budget_ms = (uint32_t)atol(&argv[j][7]);
+        }
+        else
+        {
+            return 5;
+        }
+    }
+    
+    /* one packet */
+    header.type = SCD4XD_MSG_MAINT;
+    header.status = 0;
+    header.count = 0;
+    memcpy(buf, &header, sizeof(header));
+    memcpy(&buf[sizeof(header)], &request, sizeof(request));
+    if (send(fd, buf, sizeof(buf), MSG_NOSIGNAL) != (ssize_t)sizeof(buf))
+    {
+        return 1;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief      receive a message
+ * @param[in]  fd socket fd
+ * @param[out] *header pointer to a header buffer
+ * @param[out] *data pointer to a payload buffer
+ * @param[in]  size payload buffer size
+ * @return     status code
+ *             - 0 success
+ *             - 1 receive failed
+ * @note       none
+ */
+static uint8_t a_scd4xd_client_receive(int fd, scd4xd_header_t *header, void *data, size_t size)
+{
+    uint8_t buf[sizeof(scd4xd_header_t) + SCD4XD_MAX_RECORDS * sizeof(scd4xd_record_t)];
+    ssize_t len;
+    
+    len = recv(fd, buf, sizeof(buf), 0);
+    if (len < (ssize_t)sizeof(scd4xd_header_t))
+    {
+        return 1;
+    }
+    memcpy(header, buf, sizeof(scd4xd_header_t));
+    len -= (ssize_t)sizeof(scd4xd_header_t);
+    if ((size_t)len > size)
+    {
+        return 1;
+    }
+    memcpy(data, &buf[sizeof(scd4xd_header_t)], (size_t)len);
+    
+    return 0;
+}
+
+/**
+ * @brief     print the records
+ * @param[in] *record pointer to a record buffer
+ * @param[in] count record number
+ * @note      the temperature and humidity formulas are the ones of the driver
+ */
+static void a_scd4xd_client_print(const scd4xd_record_t *record, uint16_t count)
+{
+    uint16_t i;
+    
+    for (i = 0; i < count; i++)
+    {
+        printf("%u,%llu,%u,%u,%.2f,%.2f,%u\n", (unsigned int)record[i].seq, 
+               (unsigned long long)record[i].time_us, (unsigned int)record[i].sensor, 
+               (unsigned int)record[i].co2_ppm,
+               -45.0f + 175.0f * (float)record[i].temperature_raw / 65535.0f,
+               100.0f * (float)record[i].humidity_raw / 65535.0f, 
+               (unsigned int)record[i].latency_us);
+    }
+    fflush(stdout);
+}
+
+/**
+ * @brief     follow the shared memory feed
+ * @param[in] *name pointer to a shared memory name
+ * @param[in] times sample number, 0 means forever
+ * @return    status code
+ *            - 0 success
+ *            - 1 open failed
+ * @note      the read path has no syscall, the client only sleeps while the ring is empty
+ */
+static uint8_t a_scd4xd_client_feed(const char *name, uint32_t times)
+{
+    scd4xd_shm_sample_t out;
+    scd4xd_shm_t shm;
+    uint64_t cursor;
+    uint64_t lost = 0;
+    uint32_t i;
+    
+    memset(&shm, 0, sizeof(shm));
+    if (scd4xd_shm_open(&shm, name) != 0)
+    {
+        return 1;
+    }
+    cursor = scd4xd_shm_head(&shm);
+    for (i = 0; (times == 0) || (i < times); )
+    {
+        if (scd4xd_shm_read(&shm, &cursor, &out, &lost) != 0)
+        {
+            (void)usleep(100000);
+            
+            continue;
+        }
+        printf("%llu,%llu,%u,%u,%.2f,%.2f,%u\n", (unsigned long long)out.index, 
+               (unsigned long long)out.sample.read_time_us, (unsigned int)out.sensor, 
+               (unsigned int)out.sample.co2_ppm, out.sample.temperature_s, out.sample.humidity_s, 
+               (unsigned int)(out.sample.read_time_us - out.sample.ready_time_us));
+        fflush(stdout);
+        i++;
+    }
+    scd4xd_shm_close(&shm);
+    
+    return 0;
+}
+
+/**
+ * @brief     print a registry entry
+ * @param[in] *entry pointer to a registry entry
+ * @param[in] detail 1 to print every field and the frc history
+ * @note      the register formulas are the ones of the driver
+ */
+static void a_scd4xd_client_print_entry(const scd4xd_registry_entry_t *entry, uint8_t detail)
+{
+    uint8_t i;
+    uint8_t n;
+    
+    if (detail == 0)
+    {
+        printf("0x%012llX,SCD4%d,%s,%u,%u,%llu,%.2f,%u,%u\n", (unsigned long long)entry->serial, 
+               (entry->type == 0) ? 0 : ((entry->type == 1) ? 1 : 3), entry->location, (unsigned int)entry->connects, 
+               (unsigned int)entry->state, (unsigned long long)entry->last_seen_s, 
+               175.0f * (float)entry->offset / 65535.0f, (unsigned int)entry->altitude, (unsigned int)entry->frc_num);
+        
+        return;
+    }
+    printf("serial: 0x%012llX\n", (unsigned long long)entry->serial);
+    printf("type: SCD4%d\n", (entry->type == 0) ? 0 : ((entry->type == 1) ? 1 : 3));
+    printf("location: %s\n", entry->location);
+    printf("connects: %u\n", (unsigned int)entry->connects);
+    printf("state: %u\n", (unsigned int)entry->state);
+    printf("first_seen_s: %llu\n", (unsigned long long)entry->first_seen_s);
+    printf("last_seen_s: %llu\n", (unsigned long long)entry->last_seen_s);
+    printf("offset_c: %.2f\n", 175.0f * (float)entry->offset / 65535.0f);
+    printf("altitude_m: %u\n", (unsigned int)entry->altitude);
+    printf("power_offset_c: %.2f\n", 175.0f * (float)entry->power_offset / 65535.0f);
+    printf("power_altitude_m: %u\n", (unsigned int)entry->power_altitude);
+    printf("known: %d\n", ((entry->flags & SCD4XD_REGISTRY_FLAG_KNOWN) != 0) ? 1 : 0);
+    printf("persist: %d\n", ((entry->flags & SCD4XD_REGISTRY_FLAG_PERSIST) != 0) ? 1 : 0);
+    
+    /* oldest first */
+    n = (entry->frc_num < SCD4XD_REGISTRY_FRC) ? entry->frc_num : SCD4XD_REGISTRY_FRC;
+    for (i = 0; i < n; i++)
+    {
+        const scd4xd_registry_frc_t *frc = &entry->frc[(entry->frc_num - n + i) % SCD4XD_REGISTRY_FRC];
+        
+        printf("frc: %u,%u,%d\n", (unsigned int)frc->time_s, (unsigned int)frc->target_ppm, 
+               (frc->correction == 0xFFFF) ? -1 : ((int)frc->correction - 0x8000));
+    }
+}
+
+/**
+ * @brief     list, show or edit the registry
+ * @param[in] *path pointer to a registry file path
+ * @param[in] argc arg number after the command
+ * @param[in] **argv pointer to the args after the command
+ * @param[in] set 1 to edit a sensor
+ * @return    status code
+ *            - 0 success
+ *            - 1 open failed
+ *            - 4 sensor not found
+ *            - 5 param is invalid
+ * @note      the file is not locked, an edited sensor gets its settings at its next connect
+ */
+static uint8_t a_scd4xd_client_registry(const char *path, int argc, char **argv, uint8_t set)
+{
+    scd4xd_registry_entry_t *entry;
+    scd4xd_registry_t reg;
+    uint64_t serial;
+    uint32_t i;
+    int j;
+    
+    memset(&reg, 0, sizeof(reg));
+    if ((set != 0) && (argc < 2))
+    {
+        return 5;
+    }
+    if (scd4xd_registry_open(&reg, path, 0) != 0)
+    {
+        return 1;
+    }
+    if (argc == 0)
+    {
+        printf("serial,type,location,connects,state,last_seen_s,offset_c,altitude_m,frc\n");
+        for (i = 0; i < reg.file->capacity; i++)
+        {
+            if (reg.file->entry[i].serial != 0)
+            {
+                a_scd4xd_client_print_entry(&reg.file->entry[i], 0);
+            }
+        }
+        scd4xd_registry_close(&reg);
+        
+        return 0;
+    }
+    serial = strtoull(argv[0], NULL, 0);
+    entry = scd4xd_registry_find(&reg, serial);
+    if (entry == NULL)
+    {
+        scd4xd_registry_close(&reg);
+        
+        return 4;
+    }
+    
+    /* key=value settings */
+    for (j = 1; (set != 0) && (j < argc); j++)
+    {
+        if (strncmp(argv[j], "offset=", 7) == 0)
+        {
+            entry->offset = (uint16_t)(atof(&argv[j][7]) * (65535.0f / 175.0f));
+        }
+        else if (strncmp(argv[j], "altitude=", 9) == 0)
+        {
+            entry->altitude = (uint16_t)atoi(&argv[j][9]);
+        }
+        else if (strncmp(argv[j], "persist=", 8) == 0)
+        {
+            entry->flags = (atoi(&argv[j][8]) != 0) ? (entry->flags | SCD4XD_REGISTRY_FLAG_PERSIST) : 
+                                                      (entry->flags & ~SCD4XD_REGISTRY_FLAG_PERSIST);
+        }
+        else
+        {
+            scd4xd_registry_close(&reg);
+            
+            return 5;
+        }
+    }
+    a_scd4xd_client_print_entry(entry, 1);
+    scd4xd_registry_close(&reg);
+    
+    return 0;
+}
+
+/**
+ * @brief     scd4xd client main function
+ * @param[in] argc arg numbers
+ * @param[in] **argv arg address
+ * @return    status code
+ *            - 0 success
+ *            - 1 run failed
+ *            - 5 param is invalid
+ * @note      none
+ */
+int main(int argc, char **argv)
+{
+    int c;
+    int longindex = 0;
+    const char short_options[] = "h";
+    const struct option long_options[] =
+    {
+        {"help", no_argument, NULL, 'h'},
+        {"socket", required_argument, NULL, 1},
+        {"shm", required_argument, NULL, 2},
+        {"registry", required_argument, NULL, 3},
+        {NULL, 0, NULL, 0},
+    };
+    const char *path = SCD4XD_DEFAULT_SOCKET;
+    const char *shm_name = SCD4XD_SHM_DEFAULT_NAME;
+    const char *registry = NULL;
+    scd4xd_record_t record[SCD4XD_MAX_RECORDS];
+    scd4xd_header_t header;
+    scd4xd_info_t info;
+    scd4xd_jitter_t jitter;
+    scd4xd_health_info_t health;
+    scd4xd_pressure_info_t pressure;
+    scd4xd_maint_status_t status;
+    scd4xd_maint_result_t result;
+    uint8_t maint[sizeof(scd4xd_maint_status_t) + SCD4XD_MAX_RECORDS * sizeof(scd4xd_maint_result_t)];
+    const char *rung[SCD4XD_RUNGS] = {"retry", "reinit", "restart", "power_cycle", "factory_reset"};
+    const char *state[5] = {"queued", "active", "done", "failed", "skipped"};
+    const char *op[4] = {"none", "self-test", "frc", "persist"};
+    uint32_t times = 0;
+    uint32_t i;
+    uint8_t res;
+    int fd;
+    
+    /* init 0 */
+    optind = 0;
+    
+    /* parse */
+    do
+    {
+        /* parse the args */
+        c = getopt_long(argc, argv, short_options, long_options, &longindex);
+        
+        /* judge the result */
+        switch (c)
+        {
+            /* help */
+            case 'h' :
+            {
+                printf("Usage:\n");
+                printf("  scd4xd_client [--socket=<path>] [--shm=<name>] (latest | history <n> | stream [n] | feed [n] | info | jitter | health)\n");
+                printf("  scd4xd_client [--socket=<path>] maint (self-test | frc target=<ppm> | persist) [per-bus=<n>] [budget=<ms>]\n");
+                printf("  scd4xd_client [--socket=<path>] maint-status\n");
+                printf("  scd4xd_client [--socket=<path>] pressure\n");
+                printf("  scd4xd_client --registry=<path> registry [<serial>]\n");
+                printf("  scd4xd_client --registry=<path> registry-set <serial> [offset=<c>] [altitude=<m>] [persist=<0 | 1>]\n");
+                printf("\n");
+                printf("Options:\n");
+                printf("  -h, --help           Show the help.\n");
+                printf("      --registry=<path>\n");
+                printf("                       Set the registry file of the daemon.\n");
+                printf("      --shm=<name>     Set the shared memory name of feed.([default: %s])\n", SCD4XD_SHM_DEFAULT_NAME);
+                printf("      --socket=<path>  Set the unix socket path.([default: %s])\n", SCD4XD_DEFAULT_SOCKET);
+                printf("\n");
+                printf("Records are printed as seq,time_us,sensor,co2_ppm,temperature_c,humidity_pct,latency_us.\n");
+                printf("Jitter is printed as from_us,to_us,reads of the actual minus the scheduled read time.\n");
+                printf("Health is printed with rung,attempts,recovered of each recovery rung.\n");
+                printf("Pressure avoided counts the pushes of a feed sending every read to every sensor which are not sent.\n");
+                printf("Frc is printed as time_s,target_ppm,correction_ppm, -1 if it failed.\n");
+                printf("Maint runs per-bus sensors of each bus at once, 1 by default, and skips the jobs over budget ms of each bus.\n");
+                printf("Maint status is printed as sensor,bus,state,step,steps,result,start_ms,time_ms,\n");
+                printf("result is 1 for a self test malfunction or the frc correction_ppm, -1 if it failed.\n");
+                
+                return 0;
+            }
+            
+            /* socket path */
+            case 1 :
+            {
+                path = optarg;
+                
+                break;
+            }
+            
+            /* shared memory name */
+            case 2 :
+            {
+                shm_name = optarg;
+                
+                break;
+            }
+            
+            /* registry file */
+            case 3 :
+            {
+                registry = optarg;
+                
+                break;
+            }
+            
+            /* the end */
+            case -1 :
+            {
+                break;
+            }
+            
+            /* others */
+            default :
+            {
+                return 5;
+            }
+        }
+    } while (c != -1);
+    if (optind >= argc)
+    {
+        return 5;
+    }
+    
+    /* the feed doesn't use the socket */
+    if (strcmp(argv[optind], "feed") == 0)
+    {
+        if (a_scd4xd_client_feed(shm_name, (optind + 1 < argc) ? (uint32_t)atoi(argv[optind + 1]) : 0) != 0)
+        {
+            printf("scd4xd_client: open %s failed.\n", shm_name);
+            
+            return 1;
+        }
+        
+        return 0;
+    }
+    
+    /* the registry is a file */
+    if ((strcmp(argv[optind], "registry") == 0) || (strcmp(argv[optind], "registry-set") == 0))
+    {
+        if (registry == NULL)
+        {
+            return 5;
+        }
+        res = a_scd4xd_client_registry(registry, argc - optind - 1, &argv[optind + 1], 
+                                       (strcmp(argv[optind], "registry-set") == 0) ? 1 : 0);
+        if (res == 1)
+        {
+            printf("scd4xd_client: open %s failed.\n", registry);
+        }
+        else if (res == 4)
+        {
+            printf("scd4xd_client: sensor not found.\n");
+        }
+        
+        return (res == 5) ? 5 : ((res == 0) ? 0 : 1);
+    }
+    
+    /* connect */
+    fd = a_scd4xd_client_connect(path);
+    if (fd < 0)
+    {
+        printf("scd4xd_client: connect %s failed.\n", path);
+        
+        return 1;
+    }
+    
+    if (strcmp(argv[optind], "latest") == 0)
+    {
+        res = a_scd4xd_client_request(fd, SCD4XD_MSG_LATEST, 1);
+        if (res == 0)
+        {
+            res = a_scd4xd_client_receive(fd, &header, record, sizeof(record));
+        }
+        if ((res == 0) && (header.status == SCD4XD_STATUS_OK))
+        {
+            a_scd4xd_client_print(record, header.count);
+        }
+    }
+    else if ((strcmp(argv[optind], "history") == 0) && (optind + 1 < argc))
+    {
+        res = a_scd4xd_client_request(fd, SCD4XD_MSG_HISTORY, (uint16_t)atoi(argv[optind + 1]));
+        if (res == 0)
+        {
+            res = a_scd4xd_client_receive(fd, &header, record, sizeof(record));
+        }
+        if ((res == 0) && (header.status == SCD4XD_STATUS_OK))
+        {
+            a_scd4xd_client_print(record, header.count);
+        }
+    }
+    else if (strcmp(argv[optind], "stream") == 0)
+    {
+        if (optind + 1 < argc)
+        {
+            times = (uint32_t)atoi(argv[optind + 1]);
+        }
+        res = a_scd4xd_client_request(fd, SCD4XD_MSG_SUBSCRIBE, 0);
+        if (res == 0)
+        {
+            res = a_scd4xd_client_receive(fd, &header, record, sizeof(record));
+        }
+        
+        /* 0 means forever */
+        for (i = 0; (res == 0) && (header.status == SCD4XD_STATUS_OK) && ((times == 0) || (i < times)); i += header.count)
+        {
+            res = a_scd4xd_client_receive(fd, &header, record, sizeof(record));
+            if (res == 0)
+            {
+                a_scd4xd_client_print(record, header.count);
+            }
+        }
+    }
+    else if (strcmp(argv[optind], "info") == 0)
+    {
+        res = a_scd4xd_client_request(fd, SCD4XD_MSG_INFO, 0);
+        if (res == 0)
+        {
+            res = a_scd4xd_client_receive(fd, &header, &info, sizeof(info));
+        }
+        if ((res == 0) && (header.status == SCD4XD_STATUS_OK))
+        {
+            printf("version: %u\n", (unsigned int)info.version);
+            printf("samples: %u\n", (unsigned int)info.samples);
+            printf("errors: %u\n", (unsigned int)info.errors);
+            printf("clients: %u\n", (unsigned int)info.clients);
+            printf("history: %u\n", (unsigned int)info.history);
+            printf("sensors: %u\n", (unsigned int)info.sensors);
+        }
+    }
+    else if (strcmp(argv[optind], "jitter") == 0)
+    {
+        res = a_scd4xd_client_request(fd, SCD4XD_MSG_JITTER, 0);
+        if (res == 0)
+        {
+            res = a_scd4xd_client_receive(fd, &header, &jitter, sizeof(jitter));
+        }
+        if ((res == 0) && (header.status == SCD4XD_STATUS_OK))
+        {
+            printf("realtime: %u\n", (unsigned int)jitter.realtime);
+            printf("reads: %u\n", (unsigned int)jitter.count);
+            printf("avg_us: %u\n", (unsigned int)jitter.avg_us);
+            printf("max_us: %u\n", (unsigned int)jitter.max_us);
+            for (i = 0; i < SCD4XD_JITTER_BUCKETS; i++)
+            {
+                if (jitter.bucket[i] != 0)
+                {
+                    printf("%u,%u,%u\n", (i == 0) ? 0U : (1U << (i - 1)), (1U << i) - 1, (unsigned int)jitter.bucket[i]);
+                }
+            }
+        }
+    }
+    else if (strcmp(argv[optind], "health") == 0)
+    {
+        res = a_scd4xd_client_request(fd, SCD4XD_MSG_HEALTH, 0);
+        if (res == 0)
+        {
+            res = a_scd4xd_client_receive(fd, &header, &health, sizeof(health));
+        }
+        if ((res == 0) && (header.status == SCD4XD_STATUS_OK))
+        {
+            printf("sensors: %u\n", (unsigned int)health.sensors);
+            printf("down: %u\n", (unsigned int)health.down);
+            printf("failures: %u\n", (unsigned int)health.failures);
+            printf("stalls: %u\n", (unsigned int)health.stalls);
+            printf("ladders: %u\n", (unsigned int)health.ladders);
+            printf("down_ms: %u\n", (unsigned int)health.down_ms);
+            printf("recover_max_ms: %u\n", (unsigned int)health.recover_max_ms);
+            for (i = 0; i < SCD4XD_RUNGS; i++)
+            {
+                printf("%s,%u,%u\n", rung[i], (unsigned int)health.attempts[i], (unsigned int)health.recovered[i]);
+            }
+        }
+    }
+    else if (strcmp(argv[optind], "pressure") == 0)
+    {
+        res = a_scd4xd_client_request(fd, SCD4XD_MSG_PRESSURE, 0);
+        if (res == 0)
+        {
+            res = a_scd4xd_client_receive(fd, &header, &pressure, sizeof(pressure));
+        }
+        if ((res == 0) && (header.status == SCD4XD_STATUS_OK))
+        {
+            printf("sensors: %u\n", (unsigned int)pressure.sensors);
+            printf("pa: %u\n", (unsigned int)pressure.pa);
+            printf("threshold_pa: %u\n", (unsigned int)pressure.threshold_pa);
+            printf("max_age_ms: %u\n", (unsigned int)pressure.max_age_ms);
+            printf("reads: %u\n", (unsigned int)pressure.reads);
+            printf("read_failed: %u\n", (unsigned int)pressure.read_failed);
+            printf("rounds: %u\n", (unsigned int)pressure.rounds);
+            printf("pushes: %u\n", (unsigned int)pressure.pushes);
+            printf("failed: %u\n", (unsigned int)pressure.failed);
+            printf("avoided: %u\n", (unsigned int)pressure.avoided);
+            printf("pending: %u\n", (unsigned int)pressure.pending);
+        }
+    }
+    else if (strcmp(argv[optind], "maint") == 0)
+    {
+        res = a_scd4xd_client_maint(fd, argc - optind - 1, &argv[optind + 1]);
+        if (res == 5)
+        {
+            (void)close(fd);
+            
+            return 5;
+        }
+        if (res == 0)
+        {
+            res = a_scd4xd_client_receive(fd, &header, maint, sizeof(maint));
+        }
+        if ((res == 0) && (header.status == SCD4XD_STATUS_OK))
+        {
+            printf("scd4xd_client: maint started on %u sensors.\n", (unsigned int)header.count);
+        }
+        else if ((res == 0) && (header.status == SCD4XD_STATUS_BUSY))
+        {
+            printf("scd4xd_client: maint is running.\n");
+            (void)close(fd);
+            
+            return 1;
+        }
+    }
+    else if (strcmp(argv[optind], "maint-status") == 0)
+    {
+        res = a_scd4xd_client_request(fd, SCD4XD_MSG_MAINT_STATUS, 0);
+        if (res == 0)
+        {
+            res = a_scd4xd_client_receive(fd, &header, maint, sizeof(maint));
+        }
+        if ((res == 0) && (header.status == SCD4XD_STATUS_OK))
+        {
+            memcpy(&status, maint, sizeof(status));
+            printf("op: %s\n", op[(status.op < 4) ? status.op : 0]);
+            printf("per_bus: %u\n", (unsigned int)status.per_bus);
+            printf("budget_ms: %u\n", (unsigned int)status.budget_ms);
+            printf("buses: %u\n", (unsigned int)status.buses);
+            printf("queued: %u\n", (unsigned int)status.queued);
+            printf("active: %u\n", (unsigned int)status.active);
+            printf("done: %u\n", (unsigned int)status.done);
+            printf("failed: %u\n", (unsigned int)status.failed);
+            printf("skipped: %u\n", (unsigned int)status.skipped);
+            printf("elapsed_ms: %u\n", (unsigned int)status.elapsed_ms);
+            printf("serial_ms: %u\n", (unsigned int)status.serial_ms);
+            for (i = 0; i < header.count; i++)
+            {
+                memcpy(&result, &maint[sizeof(status) + i * sizeof(result)], sizeof(result));
+                printf("%u,%u,%s,%u,%u,%d,%u,%u\n", (unsigned int)result.sensor, (unsigned int)result.bus, 
+                       state[(result.state < 5) ? result.state : 3], (unsigned int)result.step, (unsigned int)result.steps, 
+                       (status.op != 2) ? (int)result.result : 
+                       (((result.result == 0xFFFF) || (result.result == 0)) ? -1 : ((int)result.result - 0x8000)), 
+                       (unsigned int)result.start_ms, (unsigned int)result.time_ms);
+            }
+        }
+    }
+    else
+    {
+        (void)close(fd);
+        
+        return 5;
+    }
+    (void)close(fd);
+    
+    /* check the result */
+    if ((res == 0) && (header.status == SCD4XD_STATUS_NO_DATA))
+    {
+        printf("scd4xd_client: no data yet.\n");
+        
+        return 1;
+    }
+    if ((res != 0) || (header.status != SCD4XD_STATUS_OK))
+    {
+        printf("scd4xd_client: request failed.\n");
+        
+        return 1;
+    }
+    
+    return 0;
+}
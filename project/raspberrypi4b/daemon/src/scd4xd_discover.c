@@ -0,0 +1,488 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      scd4xd_discover.c
+ * @brief     scd4xd discover source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#define _GNU_SOURCE
+
+#include "scd4xd_discover.h"
+#include "driver_scd4x_interface.h"
+#ifdef SCD4XD_SIM
+#include "driver_scd4x_sim.h"
+#endif
+#include <fcntl.h>
+#include <glob.h>
+#include <limits.h>
+#include <linux/i2c-dev.h>
+#include <pthread.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/ioctl.h>
+#include <unistd.h>
+
+/**
+ * @brief scd4xd location structure definition
+ */
+typedef struct scd4xd_location_s
+{
+    scd4x_handle_t handle;                 /**< scd4x handle */
+#ifdef SCD4XD_SIM
+    scd4x_sim_t sim;                       /**< simulated sensor of a sim location */
+#endif
+    const char *bus;                       /**< location name */
+    char root[SCD4XD_DISCOVER_NAME];       /**< root adapter */
+    uint16_t worker;                       /**< worker index */
+    int fd;                                /**< iic fd */
+    uint8_t addr;                          /**< I2C_SLAVE address, 0 until the first frame */
+    uint8_t sim_flag;                      /**< 1 if simulated */
+    uint8_t present;                       /**< 1 while the location answers */
+    uint8_t found;                         /**< 1 if the serial and variant are read */
+    uint16_t serial[3];                    /**< serial number */
+    scd4x_t type;                          /**< chip variant */
+} scd4xd_location_t;
+
+/**
+ * @brief scd4xd worker structure definition
+ */
+typedef struct scd4xd_worker_s
+{
+    pthread_t thread;                      /**< worker thread */
+    scd4xd_location_t *location;           /**< all locations */
+    uint16_t num;                          /**< location number */
+    uint16_t index;                        /**< worker index */
+} scd4xd_worker_t;
+
+static __thread scd4xd_location_t *gs_location;                      /**< location of the running driver call of this thread */
+#ifdef SCD4XD_SIM
+static pthread_mutex_t gs_sim_mutex = PTHREAD_MUTEX_INITIALIZER;      /**< the sim has one attached sensor */
+#endif
+
+/**
+ * @brief  iic init of the current location
+ * @return status code
+ *         - 0 success
+ *         - 1 iic init failed
+ * @note   none
+ */
+static uint8_t a_scd4xd_discover_iic_init(void)
+{
+    if (gs_location->sim_flag != 0)
+    {
+        return 0;
+    }
+    gs_location->fd = open(gs_location->bus, O_RDWR | O_CLOEXEC);
+    gs_location->addr = 0;
+    
+    return (gs_location->fd < 0) ? 1 : 0;
+}
+
+/**
+ * @brief  iic deinit of the current location
+ * @return status code
+ *         - 0 success
+ *         - 1 iic deinit failed
+ * @note   none
+ */
+static uint8_t a_scd4xd_discover_iic_deinit(void)
+{
+    if (gs_location->sim_flag != 0)
+    {
+        return 0;
+    }
+    
+    return (close(gs_location->fd) != 0) ? 1 : 0;
+}
+
+/**
+ * @brief     set the target address of the current location
+ * @param[in] addr iic device write address
+ * @return    status code
+ *            - 0 success
+ *            - 1 set failed
+ * @note      once each location
+ */
+static uint8_t a_scd4xd_discover_address(uint8_t addr)
+{
+    if (gs_location->addr == addr)
+    {
+        return 0;
+    }
+    if (ioctl(gs_location->fd, I2C_SLAVE, (unsigned long)(addr >> 1)) < 0)
+    {
+        return 1;
+    }
+    gs_location->addr = addr;
+    
+    return 0;
+}
+
+/**
+ * @brief     iic write command of the current location
+ * @param[in] addr iic device write address
+ * @param[in] *buf pointer to a data buffer
+ * @param[in] len length of the data buffer
+ * @return    status code
+ *            - 0 success
+ *            - 1 write failed
+ * @note      quiet, most probes of an empty location fail
+ */
+static uint8_t a_scd4xd_discover_iic_write_cmd(uint8_t addr, uint8_t *buf, uint16_t len)
+{
+#ifdef SCD4XD_SIM
+    uint8_t res;
+    
+    if (gs_location->sim_flag != 0)
+    {
+        (void)pthread_mutex_lock(&gs_sim_mutex);
+        gs_location->sim.now_us = scd4x_interface_get_time_us();
+        scd4x_sim_attach(&gs_location->sim);
+        res = scd4x_sim_iic_write_cmd(addr, buf, len);
+        (void)pthread_mutex_unlock(&gs_sim_mutex);
+        
+        return res;
+    }
+#endif
+    if (a_scd4xd_discover_address(addr) != 0)
+    {
+        return 1;
+    }
+    
+    return (write(gs_location->fd, buf, len) != (ssize_t)len) ? 1 : 0;
+}
+
+/**
+ * @brief      iic read command of the current location
+ * @param[in]  addr iic device write address
+ * @param[out] *buf pointer to a data buffer
+ * @param[in]  len length of the data buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ * @note       quiet, most probes of an empty location fail
+ */
+static uint8_t a_scd4xd_discover_iic_read_cmd(uint8_t addr, uint8_t *buf, uint16_t len)
+{
+#ifdef SCD4XD_SIM
+    uint8_t res;
+    
+    if (gs_location->sim_flag != 0)
+    {
+        (void)pthread_mutex_lock(&gs_sim_mutex);
+        gs_location->sim.now_us = scd4x_interface_get_time_us();
+        scd4x_sim_attach(&gs_location->sim);
+        res = scd4x_sim_iic_read_cmd(addr, buf, len);
+        (void)pthread_mutex_unlock(&gs_sim_mutex);
+        
+        return res;
+    }
+#endif
+    if (a_scd4xd_discover_address(addr) != 0)
+    {
+        return 1;
+    }
+    
+    return (read(gs_location->fd, buf, len) != (ssize_t)len) ? 1 : 0;
+}
+
+/**
+ * @brief     quiet debug print
+ * @param[in] fmt format data
+ * @note      the failed probes are expected
+ */
+static void a_scd4xd_discover_print(const char *const fmt, ...)
+{
+    (void)fmt;
+}
+
+/**
+ * @brief     discover worker
+ * @param[in] *arg pointer to a worker
+ * @return    NULL
+ * @note      the passes overlap the execution times of all locations of the worker
+ */
+static void *a_scd4xd_discover_worker(void *arg)
+{
+    scd4xd_worker_t *worker = (scd4xd_worker_t *)arg;
+    scd4xd_location_t *location;
+    uint16_t i;
+    
+    /* open and wake up, a sleeping scd41 or scd43 doesn't answer the other commands */
+    for (i = 0; i < worker->num; i++)
+    {
+        location = &worker->location[i];
+        if (location->worker != worker->index)
+        {
+            continue;
+        }
+        gs_location = location;
+        if ((scd4x_set_type(&location->handle, SCD41) == 0) && (scd4x_init(&location->handle) == 0))
+        {
+            location->present = 1;
+            (void)scd4x_wake_up(&location->handle);
+        }
+    }
+    
+    /* stop the periodic measurement, the first answer proves a sensor */
+    for (i = 0; i < worker->num; i++)
+    {
+        location = &worker->location[i];
+        if ((location->worker != worker->index) || (location->present == 0))
+        {
+            continue;
+        }
+        gs_location = location;
+        if (scd4x_stop_periodic_measurement(&location->handle) != 0)
+        {
+            (void)a_scd4xd_discover_iic_deinit();
+            location->present = 0;
+        }
+    }
+    
+    /* identify, only the first location waits the stop time */
+    for (i = 0; i < worker->num; i++)
+    {
+        location = &worker->location[i];
+        if ((location->worker != worker->index) || (location->present == 0))
+        {
+            continue;
+        }
+        gs_location = location;
+        if ((scd4x_get_serial_number(&location->handle, location->serial) == 0) && 
+            (scd4x_get_sensor_variant(&location->handle, &location->type) == 0))
+        {
+            location->found = 1;
+        }
+        if (scd4x_deinit(&location->handle) != 0)
+        {
+            (void)a_scd4xd_discover_iic_deinit();
+        }
+    }
+    
+    return NULL;
+}
+
+/**
+ * @brief      list the iic devices
+ * @param[out] bus pointer to a location name buffer
+ * @param[in]  max max location number
+ * @return     location number
+ * @note       every /dev/i2c-N, the channels of a kernel iic mux are iic devices too
+ */
+uint16_t scd4xd_discover_scan(char bus[][SCD4XD_DISCOVER_NAME], uint16_t max)
+{
+    glob_t g;
+    uint16_t num = 0;
+    size_t i;
+    
+    if (glob("/dev/i2c-*", 0, NULL, &g) != 0)
+    {
+        return 0;
+    }
+    for (i = 0; (i < g.gl_pathc) && (num < max); i++)
+    {
+        if (strlen(g.gl_pathv[i]) < SCD4XD_DISCOVER_NAME)
+        {
+            strcpy(bus[num++], g.gl_pathv[i]);
+        }
+    }
+    globfree(&g);
+    
+    return num;
+}
+
+/**
+ * @brief      get the root adapter of a location
+ * @param[in]  *bus pointer to a location name
+ * @param[out] *root pointer to a root name buffer
+ * @note       a mux channel is a child of its parent adapter in sysfs,
+ *             a sim-<adapter>-<channel> location belongs to sim-<adapter>
+ */
+void scd4xd_discover_root(const char *bus, char root[SCD4XD_DISCOVER_NAME])
+{
+    char path[PATH_MAX];
+    char real[PATH_MAX];
+    const char *name;
+    const char *p;
+    size_t len;
+    
+    /* the location is its own root by default */
+    (void)snprintf(root, SCD4XD_DISCOVER_NAME, "%s", bus);
+    if (strncmp(bus, "sim-", 4) == 0)
+    {
+        p = strrchr(bus, '-');
+        if (p > bus + 3)
+        {
+            root[p - bus] = '\0';
+        }
+        
+        return;
+    }
+    
+    /* the first iic adapter in the sysfs path */
+    name = strrchr(bus, '/');
+    name = (name != NULL) ? (name + 1) : bus;
+    (void)snprintf(path, sizeof(path), "/sys/bus/i2c/devices/%s", name);
+    if (realpath(path, real) == NULL)
+    {
+        return;
+    }
+    for (p = strstr(real, "/i2c-"); p != NULL; p = strstr(p + 1, "/i2c-"))
+    {
+        if ((p[5] >= '0') && (p[5] <= '9'))
+        {
+            len = strspn(p + 5, "0123456789") + 4;
+            if (len < SCD4XD_DISCOVER_NAME)
+            {
+                memcpy(root, p + 1, len);
+                root[len] = '\0';
+            }
+            
+            return;
+        }
+    }
+}
+
+/**
+ * @brief      probe the locations and find the sensors
+ * @param[in]  **bus pointer to a location name list
+ * @param[in]  num location number
+ * @param[out] *device pointer to a device buffer of num devices
+ * @param[out] *found pointer to a found device number buffer
+ * @param[out] *workers pointer to a worker number buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 discover failed
+ * @note       one worker runs the locations of each root adapter, the mux channels share their root adapter,
+ *             every command is sent to all locations of a worker before the next one,
+ *             so the execution times overlap and the time depends on the bus number instead of the sensor number,
+ *             the sensors are left stopped and idle
+ */
+uint8_t scd4xd_discover(const char *const *bus, uint16_t num, scd4xd_device_t *device, uint16_t *found, uint16_t *workers)
+{
+    scd4xd_location_t *location;
+    scd4xd_worker_t *worker;
+    uint16_t started = 0;
+    uint16_t groups = 0;
+    uint16_t i;
+    uint16_t j;
+    
+    *found = 0;
+    *workers = 0;
+    if ((num == 0) || (num > SCD4XD_DISCOVER_MAX))
+    {
+        return 1;
+    }
+    location = (scd4xd_location_t *)calloc(num, sizeof(scd4xd_location_t));
+    worker = (scd4xd_worker_t *)calloc(num, sizeof(scd4xd_worker_t));
+    if ((location == NULL) || (worker == NULL))
+    {
+        free(location);
+        free(worker);
+        
+        return 1;
+    }
+    
+    /* group the locations by the root adapter */
+    for (i = 0; i < num; i++)
+    {
+        location[i].bus = bus[i];
+        location[i].fd = -1;
+#ifdef SCD4XD_SIM
+        location[i].sim_flag = (uint8_t)(strncmp(bus[i], "sim-", 4) == 0);
+#endif
+        scd4xd_discover_root(bus[i], location[i].root);
+        for (j = 0; j < i; j++)
+        {
+            if (strcmp(location[j].root, location[i].root) == 0)
+            {
+                break;
+            }
+        }
+        location[i].worker = (j < i) ? location[j].worker : groups++;
+#ifdef SCD4XD_SIM
+        if (location[i].sim_flag != 0)
+        {
+            scd4x_sim_init(&location[i].sim, (scd4x_t)(i % 3));
+            location[i].sim.serial[1] = location[i].worker;
+            location[i].sim.serial[2] = i;
+        }
+#endif
+        
+        /* link functions */
+        DRIVER_SCD4X_LINK_INIT(&location[i].handle, scd4x_handle_t);
+        DRIVER_SCD4X_LINK_IIC_INIT(&location[i].handle, a_scd4xd_discover_iic_init);
+        DRIVER_SCD4X_LINK_IIC_DEINIT(&location[i].handle, a_scd4xd_discover_iic_deinit);
+        DRIVER_SCD4X_LINK_IIC_WRITE_COMMAND(&location[i].handle, a_scd4xd_discover_iic_write_cmd);
+        DRIVER_SCD4X_LINK_IIC_READ_COMMAND(&location[i].handle, a_scd4xd_discover_iic_read_cmd);
+        DRIVER_SCD4X_LINK_DELAY_MS(&location[i].handle, scd4x_interface_delay_ms);
+        DRIVER_SCD4X_LINK_GET_TIME_US(&location[i].handle, scd4x_interface_get_time_us);
+        DRIVER_SCD4X_LINK_DEBUG_PRINT(&location[i].handle, a_scd4xd_discover_print);
+    }
+    
+    /* one worker each root adapter */
+    for (i = 0; i < groups; i++)
+    {
+        worker[i].location = location;
+        worker[i].num = num;
+        worker[i].index = i;
+        if (pthread_create(&worker[i].thread, NULL, a_scd4xd_discover_worker, &worker[i]) != 0)
+        {
+            break;
+        }
+        started++;
+    }
+    for (i = 0; i < started; i++)
+    {
+        (void)pthread_join(worker[i].thread, NULL);
+    }
+    
+    /* keep the order of the locations */
+    for (i = 0; i < num; i++)
+    {
+        if (location[i].found != 0)
+        {
+            memset(&device[*found], 0, sizeof(scd4xd_device_t));
+            (void)snprintf(device[*found].bus, SCD4XD_DISCOVER_NAME, "%s", location[i].bus);
+            device[*found].type = location[i].type;
+            device[*found].serial = ((uint64_t)location[i].serial[0] << 32) | 
+                                    ((uint64_t)location[i].serial[1] << 16) | location[i].serial[2];
+            (*found)++;
+        }
+    }
+    *workers = started;
+    free(location);
+    free(worker);
+    
+    return (started == groups) ? 0 : 1;
+}
@@ -0,0 +1,287 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      scd4xd_health.c
+ * @brief     scd4xd health source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "scd4xd_health.h"
+#include <string.h>
+
+/**
+ * @brief scd4xd health command enumeration definition
+ */
+typedef enum
+{
+    SCD4XD_HEALTH_OP_NONE = 0,             /**< end of the rung */
+    SCD4XD_HEALTH_OP_STOP,                 /**< stop periodic measurement */
+    SCD4XD_HEALTH_OP_REINIT,               /**< reinit */
+    SCD4XD_HEALTH_OP_WAKE_UP,              /**< wake up, not acknowledged */
+    SCD4XD_HEALTH_OP_POWER_CYCLE,          /**< power cycle hook */
+    SCD4XD_HEALTH_OP_FACTORY_RESET,        /**< perform factory reset */
+    SCD4XD_HEALTH_OP_START,                /**< start the periodic measurement */
+} scd4xd_health_op_t;
+
+/**
+ * @brief commands of each rung
+ */
+static const uint8_t gs_health_op[SCD4XD_HEALTH_RUNGS][3] =
+{
+    [SCD4XD_HEALTH_RUNG_RETRY]         = {SCD4XD_HEALTH_OP_NONE,        SCD4XD_HEALTH_OP_NONE,          SCD4XD_HEALTH_OP_NONE},
+    [SCD4XD_HEALTH_RUNG_REINIT]        = {SCD4XD_HEALTH_OP_STOP,        SCD4XD_HEALTH_OP_REINIT,        SCD4XD_HEALTH_OP_START},
+    [SCD4XD_HEALTH_RUNG_RESTART]       = {SCD4XD_HEALTH_OP_WAKE_UP,     SCD4XD_HEALTH_OP_STOP,          SCD4XD_HEALTH_OP_START},
+    [SCD4XD_HEALTH_RUNG_POWER_CYCLE]   = {SCD4XD_HEALTH_OP_POWER_CYCLE, SCD4XD_HEALTH_OP_STOP,          SCD4XD_HEALTH_OP_START},
+    [SCD4XD_HEALTH_RUNG_FACTORY_RESET] = {SCD4XD_HEALTH_OP_STOP,        SCD4XD_HEALTH_OP_FACTORY_RESET, SCD4XD_HEALTH_OP_START},
+};
+
+/**
+ * @brief     climb one rung
+ * @param[in] *health pointer to a health structure
+ * @note      the disabled rungs are skipped, the factory reset runs once in each outage
+ */
+static void a_scd4xd_health_escalate(scd4xd_health_t *health)
+{
+    const scd4xd_health_config_t *config = health->config;
+    
+    do
+    {
+        health->rung++;
+        if (health->rung >= SCD4XD_HEALTH_RUNGS)
+        {
+            health->rung = SCD4XD_HEALTH_RUNG_REINIT;
+            health->stats.ladders++;
+        }
+    } while (((health->rung == SCD4XD_HEALTH_RUNG_POWER_CYCLE) && (config->power_cycle == NULL)) ||
+             ((health->rung == SCD4XD_HEALTH_RUNG_FACTORY_RESET) && ((config->factory_reset == 0) || (health->reset_done != 0))));
+    health->op = 1;
+    health->stats.attempts[health->rung]++;
+}
+
+/**
+ * @brief     init the health of a sensor
+ * @param[in] *health pointer to a health structure
+ * @param[in] *config pointer to a config shared by the sensors
+ * @param[in] now_us current time
+ * @note      the sensor is healthy and the stall timer starts now
+ */
+void scd4xd_health_init(scd4xd_health_t *health, const scd4xd_health_config_t *config, uint64_t now_us)
+{
+    memset(health, 0, sizeof(scd4xd_health_t));
+    health->config = config;
+    health->watch_us = now_us;
+}
+
+/**
+ * @brief     report a scd4x_poll_sample result
+ * @param[in] *health pointer to a health structure
+ * @param[in] res scd4x_poll_sample status code
+ * @param[in] now_us current time
+ * @return    1 if a recovery is started, then call scd4xd_health_run until op is 0
+ * @note      every retries consecutive failures, or a stall, climb one rung,
+ *            the ladder restarts from reinit after the last enabled rung
+ */
+uint8_t scd4xd_health_report(scd4xd_health_t *health, uint8_t res, uint64_t now_us)
+{
+    uint64_t down_us;
+    
+    if (res == 0)
+    {
+        /* the outage ends on the rung which fixed it */
+        if (health->down_us != 0)
+        {
+            down_us = now_us - health->down_us;
+            health->stats.down_us += down_us;
+            health->stats.recovered[health->rung]++;
+            if (down_us > health->stats.recover_max_us)
+            {
+                health->stats.recover_max_us = down_us;
+            }
+        }
+        health->rung = SCD4XD_HEALTH_RUNG_RETRY;
+        health->reset_done = 0;
+        health->failures = 0;
+        health->down_us = 0;
+        health->watch_us = now_us;
+        
+        return 0;
+    }
+    if (res == 6)
+    {
+        /* a command is in flight */
+        return 0;
+    }
+    if (res == 5)
+    {
+        /* not ready, a stall is down since the last sample and retrying can't fix it */
+        if (now_us - health->watch_us < health->config->stall_us)
+        {
+            return 0;
+        }
+        health->stats.stalls++;
+        if (health->down_us == 0)
+        {
+            health->down_us = health->watch_us;
+        }
+        a_scd4xd_health_escalate(health);
+        
+        return 1;
+    }
+    
+    /* a failure */
+    health->stats.failures++;
+    health->failures++;
+    if (health->down_us == 0)
+    {
+        health->down_us = now_us;
+    }
+    if ((health->config->retries > 1) && ((health->failures % health->config->retries) != 0))
+    {
+        return 0;
+    }
+    a_scd4xd_health_escalate(health);
+    
+    return 1;
+}
+
+/**
+ * @brief      run the next command of the recovery
+ * @param[in]  *health pointer to a health structure
+ * @param[in]  *handle pointer to an scd4x handle structure
+ * @param[in]  now_us current time
+ * @param[out] *wait_us pointer to the time before the next call
+ * @return     status code
+ *             - 0 success, the recovery runs until op is 0
+ *             - 1 command failed and the recovery ended
+ * @note       one command each call and its execution time is returned instead of waited,
+ *             so an event loop is never blocked, the power cycle hook is called synchronously
+ */
+uint8_t scd4xd_health_run(scd4xd_health_t *health, scd4x_handle_t *handle, uint64_t now_us, uint32_t *wait_us)
+{
+    const scd4xd_health_config_t *config = health->config;
+    uint8_t res;
+    uint8_t op;
+    
+    *wait_us = 0;
+    if (health->op == 0)
+    {
+        return 1;
+    }
+    op = gs_health_op[health->rung][health->op - 1];
+    switch (op)
+    {
+        case SCD4XD_HEALTH_OP_STOP :
+        {
+            res = scd4x_stop_periodic_measurement(handle);
+            
+            break;
+        }
+        case SCD4XD_HEALTH_OP_REINIT :
+        {
+            res = scd4x_reinit(handle);
+            
+            break;
+        }
+        case SCD4XD_HEALTH_OP_WAKE_UP :
+        {
+            /* an awake sensor or scd40 rejects it */
+            (void)scd4x_wake_up(handle);
+            res = 0;
+            
+            break;
+        }
+        case SCD4XD_HEALTH_OP_POWER_CYCLE :
+        {
+            res = config->power_cycle(config->arg);
+            
+            break;
+        }
+        case SCD4XD_HEALTH_OP_FACTORY_RESET :
+        {
+            res = scd4x_perform_factory_reset(handle);
+            health->reset_done = 1;
+            
+            break;
+        }
+        default :
+        {
+            res = (config->low_power != 0) ? scd4x_start_low_power_periodic_measurement(handle) : 
+                                             scd4x_start_periodic_measurement(handle);
+            
+            break;
+        }
+    }
+    
+    /* a failed command ends the recovery, the next failures climb further */
+    health->op++;
+    if ((res != 0) || (health->op > 3) || (gs_health_op[health->rung][health->op - 1] == SCD4XD_HEALTH_OP_NONE))
+    {
+        health->op = 0;
+        health->watch_us = now_us;
+        
+        return (res != 0) ? 1 : 0;
+    }
+    if (op == SCD4XD_HEALTH_OP_POWER_CYCLE)
+    {
+        *wait_us = SCD4XD_HEALTH_POWER_UP_US;
+    }
+    else
+    {
+        (void)scd4x_get_pending_time(handle, wait_us);
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief     add the stats of a sensor to a total
+ * @param[in] *total pointer to a total stats
+ * @param[in] *stats pointer to the stats of a sensor
+ * @note      none
+ */
+void scd4xd_health_add_stats(scd4xd_health_stats_t *total, const scd4xd_health_stats_t *stats)
+{
+    uint8_t i;
+    
+    total->failures += stats->failures;
+    total->stalls += stats->stalls;
+    for (i = 0; i < SCD4XD_HEALTH_RUNGS; i++)
+    {
+        total->attempts[i] += stats->attempts[i];
+        total->recovered[i] += stats->recovered[i];
+    }
+    total->ladders += stats->ladders;
+    total->down_us += stats->down_us;
+    if (stats->recover_max_us > total->recover_max_us)
+    {
+        total->recover_max_us = stats->recover_max_us;
+    }
+}
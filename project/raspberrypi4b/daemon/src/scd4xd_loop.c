@@ -0,0 +1,460 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      scd4xd_loop.c
+ * @brief     scd4xd event loop source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#define _GNU_SOURCE
+
+#include "scd4xd_loop.h"
+#include <errno.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/epoll.h>
+#include <sys/timerfd.h>
+#include <time.h>
+#include <unistd.h>
+
+/**
+ * @brief     swap two heap entries
+ * @param[in] *loop pointer to a loop structure
+ * @param[in] i first index
+ * @param[in] j second index
+ * @note      none
+ */
+static void a_scd4xd_loop_swap(scd4xd_loop_t *loop, uint32_t i, uint32_t j)
+{
+    scd4xd_loop_timer_t *t = loop->heap[i];
+    
+    loop->heap[i] = loop->heap[j];
+    loop->heap[j] = t;
+    loop->heap[i]->index = i;
+    loop->heap[j]->index = j;
+}
+
+/**
+ * @brief     move a heap entry up
+ * @param[in] *loop pointer to a loop structure
+ * @param[in] i index
+ * @note      none
+ */
+static void a_scd4xd_loop_up(scd4xd_loop_t *loop, uint32_t i)
+{
+    while ((i != 0) && (loop->heap[(i - 1) / 2]->deadline_us > loop->heap[i]->deadline_us))
+    {
+        a_scd4xd_loop_swap(loop, i, (i - 1) / 2);
+        i = (i - 1) / 2;
+    }
+}
+
+/**
+ * @brief     move a heap entry down
+ * @param[in] *loop pointer to a loop structure
+ * @param[in] i index
+ * @note      none
+ */
+static void a_scd4xd_loop_down(scd4xd_loop_t *loop, uint32_t i)
+{
+    uint32_t min;
+    uint32_t c;
+    
+    while (1)
+    {
+        min = i;
+        c = 2 * i + 1;
+        if ((c < loop->heap_len) && (loop->heap[c]->deadline_us < loop->heap[min]->deadline_us))
+        {
+            min = c;
+        }
+        c++;
+        if ((c < loop->heap_len) && (loop->heap[c]->deadline_us < loop->heap[min]->deadline_us))
+        {
+            min = c;
+        }
+        if (min == i)
+        {
+            return;
+        }
+        a_scd4xd_loop_swap(loop, i, min);
+        i = min;
+    }
+}
+
+/**
+ * @brief     arm the timerfd to the earliest deadline
+ * @param[in] *loop pointer to a loop structure
+ * @note      the timerfd is only touched when the earliest deadline changes
+ */
+static void a_scd4xd_loop_arm(scd4xd_loop_t *loop)
+{
+    struct itimerspec its;
+    uint64_t deadline_us;
+    
+    if ((loop->expiring != 0) || (loop->sleeping != 0))
+    {
+        return;
+    }
+    deadline_us = (loop->heap_len != 0) ? loop->heap[0]->deadline_us : 0;
+    if (deadline_us == loop->armed_us)
+    {
+        return;
+    }
+    memset(&its, 0, sizeof(its));
+    if (deadline_us != 0)
+    {
+        /* 0 disarms, so a past deadline is armed at 1 ns */
+        its.it_value.tv_sec = (time_t)(deadline_us / 1000000);
+        its.it_value.tv_nsec = (long)(deadline_us % 1000000) * 1000;
+        if ((its.it_value.tv_sec == 0) && (its.it_value.tv_nsec == 0))
+        {
+            its.it_value.tv_nsec = 1;
+        }
+    }
+    (void)timerfd_settime(loop->timer_fd, TFD_TIMER_ABSTIME, &its, NULL);
+    loop->armed_us = deadline_us;
+}
+
+/**
+ * @brief     run the expired timers
+ * @param[in] *loop pointer to a loop structure
+ * @note      a callback may restart its own timer
+ */
+static void a_scd4xd_loop_fire(scd4xd_loop_t *loop)
+{
+    scd4xd_loop_timer_t *timer;
+    uint64_t now;
+    uint64_t late;
+    uint32_t bucket;
+    
+    loop->expiring = 1;
+    now = scd4xd_loop_now_us();
+    while ((loop->heap_len != 0) && (loop->heap[0]->deadline_us <= now))
+    {
+        /* lateness of the callback against the deadline */
+        timer = loop->heap[0];
+        late = now - timer->deadline_us;
+        bucket = 0;
+        while ((bucket < SCD4XD_LOOP_BUCKETS - 1) && ((late >> bucket) != 0))
+        {
+            bucket++;
+        }
+        loop->late_hist[bucket]++;
+        loop->fired++;
+        loop->late_sum_us += late;
+        loop->late_max_us = (late > loop->late_max_us) ? late : loop->late_max_us;
+        
+        scd4xd_loop_timer_stop(loop, timer);
+        timer->cb(timer->arg);
+        now = scd4xd_loop_now_us();
+    }
+    loop->expiring = 0;
+    a_scd4xd_loop_arm(loop);
+}
+
+/**
+ * @brief     init the loop
+ * @param[in] *loop pointer to a loop structure
+ * @param[in] timers max armed timers
+ * @return    status code
+ *            - 0 success
+ *            - 1 init failed
+ * @note      none
+ */
+uint8_t scd4xd_loop_init(scd4xd_loop_t *loop, uint32_t timers)
+{
+    struct epoll_event ev;
+    
+    memset(loop, 0, sizeof(scd4xd_loop_t));
+    loop->heap = (scd4xd_loop_timer_t **)calloc(timers, sizeof(scd4xd_loop_timer_t *));
+    loop->heap_size = timers;
+    loop->epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+    loop->timer_fd = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+    if ((loop->heap == NULL) || (loop->epoll_fd < 0) || (loop->timer_fd < 0))
+    {
+        scd4xd_loop_deinit(loop);
+        
+        return 1;
+    }
+    
+    /* the timerfd is the only watch without a watch structure */
+    memset(&ev, 0, sizeof(ev));
+    ev.events = EPOLLIN;
+    ev.data.ptr = NULL;
+    if (epoll_ctl(loop->epoll_fd, EPOLL_CTL_ADD, loop->timer_fd, &ev) != 0)
+    {
+        scd4xd_loop_deinit(loop);
+        
+        return 1;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief     close the loop
+ * @param[in] *loop pointer to a loop structure
+ * @note      the watched fds are not closed
+ */
+void scd4xd_loop_deinit(scd4xd_loop_t *loop)
+{
+    if (loop->timer_fd >= 0)
+    {
+        (void)close(loop->timer_fd);
+    }
+    if (loop->epoll_fd >= 0)
+    {
+        (void)close(loop->epoll_fd);
+    }
+    free(loop->heap);
+    loop->heap = NULL;
+    loop->heap_len = 0;
+    loop->timer_fd = -1;
+    loop->epoll_fd = -1;
+}
+
+/**
+ * @brief  get the loop time
+ * @return CLOCK_MONOTONIC in us
+ * @note   none
+ */
+uint64_t scd4xd_loop_now_us(void)
+{
+    struct timespec ts;
+    
+    (void)clock_gettime(CLOCK_MONOTONIC, &ts);
+    
+    return (uint64_t)ts.tv_sec * 1000000 + (uint64_t)(ts.tv_nsec / 1000);
+}
+
+/**
+ * @brief     watch a fd
+ * @param[in] *loop pointer to a loop structure
+ * @param[in] *watch pointer to a watch structure, it must live until removed
+ * @param[in] fd watched fd
+ * @param[in] events epoll events
+ * @param[in] cb callback
+ * @param[in] *arg callback argument
+ * @return    status code
+ *            - 0 success
+ *            - 1 add failed
+ * @note      none
+ */
+uint8_t scd4xd_loop_add_fd(scd4xd_loop_t *loop, scd4xd_loop_watch_t *watch, int fd, uint32_t events,
+                           scd4xd_loop_fd_cb_t cb, void *arg)
+{
+    struct epoll_event ev;
+    
+    watch->fd = fd;
+    watch->cb = cb;
+    watch->arg = arg;
+    memset(&ev, 0, sizeof(ev));
+    ev.events = events;
+    ev.data.ptr = watch;
+    
+    return (epoll_ctl(loop->epoll_fd, EPOLL_CTL_ADD, fd, &ev) == 0) ? 0 : 1;
+}
+
+/**
+ * @brief     remove a watched fd
+ * @param[in] *loop pointer to a loop structure
+ * @param[in] *watch pointer to a watch structure
+ * @note      call it before closing the fd
+ */
+void scd4xd_loop_del_fd(scd4xd_loop_t *loop, scd4xd_loop_watch_t *watch)
+{
+    (void)epoll_ctl(loop->epoll_fd, EPOLL_CTL_DEL, watch->fd, NULL);
+    watch->fd = -1;
+}
+
+/**
+ * @brief     init a timer
+ * @param[in] *timer pointer to a timer structure
+ * @param[in] cb callback
+ * @param[in] *arg callback argument
+ * @note      none
+ */
+void scd4xd_loop_timer_init(scd4xd_loop_timer_t *timer, scd4xd_loop_timer_cb_t cb, void *arg)
+{
+    timer->deadline_us = 0;
+    timer->index = SCD4XD_LOOP_IDLE;
+    timer->cb = cb;
+    timer->arg = arg;
+}
+
+/**
+ * @brief     start or move a one shot timer
+ * @param[in] *loop pointer to a loop structure
+ * @param[in] *timer pointer to a timer structure
+ * @param[in] deadline_us expiry time of CLOCK_MONOTONIC in us
+ * @return    status code
+ *            - 0 success
+ *            - 1 too many timers
+ * @note      O(log n)
+ */
+uint8_t scd4xd_loop_timer_start(scd4xd_loop_t *loop, scd4xd_loop_timer_t *timer, uint64_t deadline_us)
+{
+    if (timer->index == SCD4XD_LOOP_IDLE)
+    {
+        if (loop->heap_len >= loop->heap_size)
+        {
+            return 1;
+        }
+        timer->index = loop->heap_len;
+        loop->heap[loop->heap_len++] = timer;
+    }
+    timer->deadline_us = deadline_us;
+    a_scd4xd_loop_up(loop, timer->index);
+    a_scd4xd_loop_down(loop, timer->index);
+    a_scd4xd_loop_arm(loop);
+    
+    return 0;
+}
+
+/**
+ * @brief     stop a timer
+ * @param[in] *loop pointer to a loop structure
+ * @param[in] *timer pointer to a timer structure
+ * @note      O(log n)
+ */
+void scd4xd_loop_timer_stop(scd4xd_loop_t *loop, scd4xd_loop_timer_t *timer)
+{
+    uint32_t i = timer->index;
+    
+    if (i == SCD4XD_LOOP_IDLE)
+    {
+        return;
+    }
+    loop->heap_len--;
+    if (i != loop->heap_len)
+    {
+        a_scd4xd_loop_swap(loop, i, loop->heap_len);
+        a_scd4xd_loop_up(loop, i);
+        a_scd4xd_loop_down(loop, i);
+    }
+    timer->index = SCD4XD_LOOP_IDLE;
+    a_scd4xd_loop_arm(loop);
+}
+
+/**
+ * @brief     run the loop until scd4xd_loop_stop
+ * @param[in] *loop pointer to a loop structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 epoll failed
+ * @note      none
+ */
+uint8_t scd4xd_loop_run(scd4xd_loop_t *loop)
+{
+    struct epoll_event ev[SCD4XD_LOOP_EVENTS];
+    scd4xd_loop_watch_t *watch;
+    uint64_t value;
+    int num;
+    int i;
+    
+    while (__atomic_load_n(&loop->stop, __ATOMIC_RELAXED) == 0)
+    {
+        num = epoll_wait(loop->epoll_fd, ev, SCD4XD_LOOP_EVENTS, -1);
+        if (num < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+            
+            return 1;
+        }
+        loop->wakeups++;
+        for (i = 0; i < num; i++)
+        {
+            watch = (scd4xd_loop_watch_t *)ev[i].data.ptr;
+            if (watch == NULL)
+            {
+                /* timerfd */
+                (void)read(loop->timer_fd, &value, sizeof(value));
+                loop->armed_us = 0;
+                a_scd4xd_loop_fire(loop);
+            }
+            else if (watch->fd >= 0)
+            {
+                watch->cb(watch->arg, ev[i].events);
+            }
+        }
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief     run only the timers with absolute deadline sleeps until scd4xd_loop_stop
+ * @param[in] *loop pointer to a loop structure
+ * @param[in] max_sleep_us max sleep, the stop flag is checked after each sleep
+ * @return    status code
+ *            - 0 success
+ * @note      for a dedicated real time thread, the fds are not watched and the timerfd is not used
+ */
+uint8_t scd4xd_loop_run_sleep(scd4xd_loop_t *loop, uint32_t max_sleep_us)
+{
+    struct timespec ts;
+    uint64_t deadline_us;
+    
+    loop->sleeping = 1;
+    while (__atomic_load_n(&loop->stop, __ATOMIC_RELAXED) == 0)
+    {
+        /* sleep to the absolute deadline, a late wake up never adds up */
+        deadline_us = scd4xd_loop_now_us() + max_sleep_us;
+        if ((loop->heap_len != 0) && (loop->heap[0]->deadline_us < deadline_us))
+        {
+            deadline_us = loop->heap[0]->deadline_us;
+        }
+        ts.tv_sec = (time_t)(deadline_us / 1000000);
+        ts.tv_nsec = (long)(deadline_us % 1000000) * 1000;
+        while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, NULL) == EINTR)
+        {
+            
+        }
+        loop->wakeups++;
+        a_scd4xd_loop_fire(loop);
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief     stop the loop
+ * @param[in] *loop pointer to a loop structure
+ * @note      the loop returns after the current callbacks
+ */
+void scd4xd_loop_stop(scd4xd_loop_t *loop)
+{
+    __atomic_store_n(&loop->stop, 1, __ATOMIC_RELAXED);
+}
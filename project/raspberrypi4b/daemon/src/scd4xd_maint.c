@@ -0,0 +1,379 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      scd4xd_maint.c
+ * @brief     scd4xd maint source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "scd4xd_maint.h"
+#include <string.h>
+
+/**
+ * @brief scd4xd maint step enumeration definition
+ */
+typedef enum
+{
+    SCD4XD_MAINT_STEP_NONE = 0,            /**< end of the operation */
+    SCD4XD_MAINT_STEP_STOP,                /**< stop periodic measurement */
+    SCD4XD_MAINT_STEP_START_SELF_TEST,     /**< start self test */
+    SCD4XD_MAINT_STEP_GET_SELF_TEST,       /**< get self test result */
+    SCD4XD_MAINT_STEP_START_FRC,           /**< start forced recalibration */
+    SCD4XD_MAINT_STEP_GET_FRC,             /**< get forced recalibration result */
+    SCD4XD_MAINT_STEP_PERSIST,             /**< persist settings */
+    SCD4XD_MAINT_STEP_RESTORE,             /**< start the measurement of the mode */
+} scd4xd_maint_step_t;
+
+/**
+ * @brief commands of each operation
+ */
+static const uint8_t gs_maint_step[4][2] =
+{
+    [SCD4XD_MAINT_OP_SELF_TEST] = {SCD4XD_MAINT_STEP_START_SELF_TEST, SCD4XD_MAINT_STEP_GET_SELF_TEST},
+    [SCD4XD_MAINT_OP_FRC]       = {SCD4XD_MAINT_STEP_START_FRC,       SCD4XD_MAINT_STEP_GET_FRC},
+    [SCD4XD_MAINT_OP_PERSIST]   = {SCD4XD_MAINT_STEP_PERSIST,         SCD4XD_MAINT_STEP_NONE},
+};
+
+/**
+ * @brief execution time of each step in ms
+ */
+static const uint16_t gs_maint_step_ms[] =
+{
+    [SCD4XD_MAINT_STEP_NONE]            = 0,
+    [SCD4XD_MAINT_STEP_STOP]            = 500,
+    [SCD4XD_MAINT_STEP_START_SELF_TEST] = 10000,
+    [SCD4XD_MAINT_STEP_GET_SELF_TEST]   = 1,
+    [SCD4XD_MAINT_STEP_START_FRC]       = 400,
+    [SCD4XD_MAINT_STEP_GET_FRC]         = 1,
+    [SCD4XD_MAINT_STEP_PERSIST]         = 800,
+    [SCD4XD_MAINT_STEP_RESTORE]         = 1,
+};
+
+/**
+ * @brief     end a job
+ * @param[in] *maint pointer to a maint structure
+ * @param[in] *job pointer to a job
+ * @param[in] state end state
+ * @param[in] now_us current time
+ * @note      the run ends with its last job
+ */
+static void a_scd4xd_maint_end(scd4xd_maint_t *maint, scd4xd_maint_job_t *job, uint8_t state, uint64_t now_us)
+{
+    job->state = state;
+    job->end_us = now_us;
+    maint->bus_active[job->bus]--;
+    maint->active--;
+    if (state == SCD4XD_MAINT_STATE_DONE)
+    {
+        maint->done++;
+    }
+    else if (state == SCD4XD_MAINT_STATE_FAILED)
+    {
+        maint->failed++;
+    }
+    else
+    {
+        maint->skipped++;
+    }
+    maint->serial_us += job->end_us - job->start_us;
+    if ((maint->queued == 0) && (maint->active == 0))
+    {
+        maint->end_us = now_us;
+    }
+}
+
+/**
+ * @brief     init a maintenance run
+ * @param[in] *maint pointer to a maint structure
+ * @param[in] *config pointer to a config
+ * @param[in] now_us current time
+ * @note      the config is copied, then add a job for each sensor
+ */
+void scd4xd_maint_init(scd4xd_maint_t *maint, const scd4xd_maint_config_t *config, uint64_t now_us)
+{
+    memset(maint, 0, sizeof(scd4xd_maint_t));
+    maint->config = *config;
+    if (maint->config.per_bus == 0)
+    {
+        maint->config.per_bus = 1;
+    }
+    maint->start_us = now_us;
+    maint->end_us = now_us;
+}
+
+/**
+ * @brief     add a job
+ * @param[in] *maint pointer to a maint structure
+ * @param[in] bus bus group of the sensor
+ * @param[in] mode measurement mode of the sensor
+ * @return    status code
+ *            - 0 success
+ *            - 1 add failed
+ * @note      the job index is the add order
+ */
+uint8_t scd4xd_maint_add(scd4xd_maint_t *maint, uint16_t bus, uint8_t mode)
+{
+    scd4xd_maint_job_t *job;
+    uint8_t op = maint->config.op;
+    uint8_t i;
+    
+    if ((maint->jobs >= SCD4XD_MAINT_MAX_JOBS) || (bus >= SCD4XD_MAINT_MAX_BUSES) || 
+        (op < SCD4XD_MAINT_OP_SELF_TEST) || (op > SCD4XD_MAINT_OP_PERSIST))
+    {
+        return 1;
+    }
+    
+    /* stop, the operation and restore */
+    job = &maint->job[maint->jobs++];
+    memset(job, 0, sizeof(scd4xd_maint_job_t));
+    job->bus = bus;
+    job->mode = mode;
+    if (mode != SCD4XD_MAINT_MODE_IDLE)
+    {
+        job->seq[job->steps++] = SCD4XD_MAINT_STEP_STOP;
+    }
+    for (i = 0; (i < 2) && (gs_maint_step[op][i] != SCD4XD_MAINT_STEP_NONE); i++)
+    {
+        job->seq[job->steps++] = gs_maint_step[op][i];
+    }
+    if (mode != SCD4XD_MAINT_MODE_IDLE)
+    {
+        job->seq[job->steps++] = SCD4XD_MAINT_STEP_RESTORE;
+    }
+    if (bus >= maint->buses)
+    {
+        maint->buses = bus + 1;
+    }
+    maint->queued++;
+    maint->end_us = 0;
+    
+    return 0;
+}
+
+/**
+ * @brief      admit the next queued job
+ * @param[in]  *maint pointer to a maint structure
+ * @param[in]  now_us current time
+ * @param[out] *job pointer to a job index buffer
+ * @return     status code
+ *             - 0 success, call scd4xd_maint_run until its state is not active
+ *             - 1 no job can start now
+ * @note       a bus runs at most per_bus jobs at once, a job which doesn't fit
+ *             the rest of its bus budget is skipped and the sensor keeps measuring
+ */
+uint8_t scd4xd_maint_next(scd4xd_maint_t *maint, uint64_t now_us, uint16_t *job)
+{
+    scd4xd_maint_job_t *j;
+    uint64_t estimate_us;
+    uint16_t i;
+    
+    for (i = 0; (i < maint->jobs) && (maint->queued != 0); i++)
+    {
+        j = &maint->job[i];
+        if ((j->state != SCD4XD_MAINT_STATE_QUEUED) || (maint->bus_active[j->bus] >= maint->config.per_bus))
+        {
+            continue;
+        }
+        
+        /* admitted jobs take a slot, the skipped ones end at once */
+        estimate_us = scd4xd_maint_estimate_us(maint->config.op, j->mode);
+        maint->queued--;
+        maint->active++;
+        maint->bus_active[j->bus]++;
+        j->start_us = now_us;
+        if ((maint->config.budget_us != 0) && (maint->bus_used_us[j->bus] + estimate_us > maint->config.budget_us))
+        {
+            a_scd4xd_maint_end(maint, j, SCD4XD_MAINT_STATE_SKIPPED, now_us);
+            
+            continue;
+        }
+        maint->bus_used_us[j->bus] += estimate_us;
+        j->state = SCD4XD_MAINT_STATE_ACTIVE;
+        *job = i;
+        
+        return 0;
+    }
+    
+    return 1;
+}
+
+/**
+ * @brief     skip an admitted job
+ * @param[in] *maint pointer to a maint structure
+ * @param[in] job job index
+ * @param[in] now_us current time
+ * @note      for a sensor which is down, its slot and budget are given back
+ */
+void scd4xd_maint_skip(scd4xd_maint_t *maint, uint16_t job, uint64_t now_us)
+{
+    scd4xd_maint_job_t *j = &maint->job[job];
+    
+    if (j->state != SCD4XD_MAINT_STATE_ACTIVE)
+    {
+        return;
+    }
+    maint->bus_used_us[j->bus] -= scd4xd_maint_estimate_us(maint->config.op, j->mode);
+    a_scd4xd_maint_end(maint, j, SCD4XD_MAINT_STATE_SKIPPED, now_us);
+}
+
+/**
+ * @brief      run the next step of a job
+ * @param[in]  *maint pointer to a maint structure
+ * @param[in]  job job index
+ * @param[in]  *handle pointer to an scd4x handle structure
+ * @param[in]  now_us current time
+ * @param[out] *wait_us pointer to the time before the next call
+ * @return     status code
+ *             - 0 success, the job runs until its state is not active
+ *             - 1 command failed
+ * @note       one command each call and its execution time is returned instead of waited,
+ *             a failed command still restores the measurement mode
+ */
+uint8_t scd4xd_maint_run(scd4xd_maint_t *maint, uint16_t job, scd4x_handle_t *handle, uint64_t now_us, uint32_t *wait_us)
+{
+    scd4xd_maint_job_t *j = &maint->job[job];
+    scd4x_bool_t malfunction;
+    uint8_t failed;
+    uint8_t step;
+    uint8_t res;
+    
+    *wait_us = 0;
+    if (j->state != SCD4XD_MAINT_STATE_ACTIVE)
+    {
+        return 1;
+    }
+    step = j->seq[j->step];
+    switch (step)
+    {
+        case SCD4XD_MAINT_STEP_STOP :
+        {
+            res = scd4x_stop_periodic_measurement(handle);
+            
+            break;
+        }
+        case SCD4XD_MAINT_STEP_START_SELF_TEST :
+        {
+            res = scd4x_start_self_test(handle);
+            
+            break;
+        }
+        case SCD4XD_MAINT_STEP_GET_SELF_TEST :
+        {
+            res = scd4x_get_self_test_result(handle, &malfunction);
+            j->result = (malfunction == SCD4X_BOOL_TRUE) ? 1 : 0;
+            
+            break;
+        }
+        case SCD4XD_MAINT_STEP_START_FRC :
+        {
+            res = scd4x_start_forced_recalibration(handle, maint->config.target_ppm);
+            
+            break;
+        }
+        case SCD4XD_MAINT_STEP_GET_FRC :
+        {
+            res = scd4x_get_forced_recalibration_result(handle, &j->result);
+            
+            break;
+        }
+        case SCD4XD_MAINT_STEP_PERSIST :
+        {
+            res = scd4x_persist_settings(handle);
+            
+            break;
+        }
+        default :
+        {
+            res = (j->mode == SCD4XD_MAINT_MODE_LOW_POWER) ? scd4x_start_low_power_periodic_measurement(handle) : 
+                                                             scd4x_start_periodic_measurement(handle);
+            
+            break;
+        }
+    }
+    
+    /* a failed operation jumps to the restore, a failed stop or restore ends the job */
+    j->step++;
+    if (res != 0)
+    {
+        j->res = res;
+        if ((step == SCD4XD_MAINT_STEP_STOP) || (step == SCD4XD_MAINT_STEP_RESTORE))
+        {
+            j->step = j->steps;
+        }
+        else if (j->seq[j->steps - 1] == SCD4XD_MAINT_STEP_RESTORE)
+        {
+            j->step = j->steps - 1;
+        }
+        else
+        {
+            j->step = j->steps;
+        }
+    }
+    if (j->step >= j->steps)
+    {
+        /* the sensor rejects a recalibration without a stable reference */
+        failed = (uint8_t)((j->res != 0) || ((maint->config.op == SCD4XD_MAINT_OP_FRC) && (j->result == SCD4XD_MAINT_FRC_FAILED)));
+        a_scd4xd_maint_end(maint, j, (failed != 0) ? SCD4XD_MAINT_STATE_FAILED : SCD4XD_MAINT_STATE_DONE, now_us);
+        
+        return (res != 0) ? 1 : 0;
+    }
+    (void)scd4x_get_pending_time(handle, wait_us);
+    
+    return (res != 0) ? 1 : 0;
+}
+
+/**
+ * @brief     estimate the time of a job
+ * @param[in] op operation
+ * @param[in] mode measurement mode of the sensor
+ * @return    estimated time in us
+ * @note      the execution times of the commands
+ */
+uint64_t scd4xd_maint_estimate_us(uint8_t op, uint8_t mode)
+{
+    uint64_t ms = 0;
+    uint8_t i;
+    
+    if ((op < SCD4XD_MAINT_OP_SELF_TEST) || (op > SCD4XD_MAINT_OP_PERSIST))
+    {
+        return 0;
+    }
+    if (mode != SCD4XD_MAINT_MODE_IDLE)
+    {
+        ms += gs_maint_step_ms[SCD4XD_MAINT_STEP_STOP] + gs_maint_step_ms[SCD4XD_MAINT_STEP_RESTORE];
+    }
+    for (i = 0; i < 2; i++)
+    {
+        ms += gs_maint_step_ms[gs_maint_step[op][i]];
+    }
+    
+    return ms * 1000;
+}
@@ -0,0 +1,244 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      scd4xd_pressure.c
+ * @brief     scd4xd pressure source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "scd4xd_pressure.h"
+#include <string.h>
+
+/**
+ * @brief     get the register a sensor has or will have
+ * @param[in] *sensor pointer to a sensor
+ * @return    queued register, or the pushed one if none is queued
+ * @note      none
+ */
+static uint16_t a_scd4xd_pressure_target(const scd4xd_pressure_sensor_t *sensor)
+{
+    return (sensor->pending != 0) ? sensor->pending : sensor->reg;
+}
+
+/**
+ * @brief     check the max age of a sensor
+ * @param[in] *pressure pointer to a pressure structure
+ * @param[in] *sensor pointer to a sensor
+ * @param[in] age_us time to add to the age
+ * @param[in] now_us current time
+ * @return    1 if the age is over max_age_us, 0 if not or a push is queued
+ * @note      none
+ */
+static uint8_t a_scd4xd_pressure_old(const scd4xd_pressure_t *pressure, const scd4xd_pressure_sensor_t *sensor, 
+                                     uint64_t age_us, uint64_t now_us)
+{
+    if ((pressure->config.max_age_us == 0) || (sensor->pending != 0))
+    {
+        return 0;
+    }
+    
+    return (now_us - sensor->pushed_us + age_us >= pressure->config.max_age_us) ? 1 : 0;
+}
+
+/**
+ * @brief     queue a push
+ * @param[in] *pressure pointer to a pressure structure
+ * @param[in] *sensor pointer to a sensor
+ * @note      a queued register which is not sent yet is replaced
+ */
+static void a_scd4xd_pressure_queue(scd4xd_pressure_t *pressure, scd4xd_pressure_sensor_t *sensor)
+{
+    if (sensor->pending != 0)
+    {
+        pressure->avoided++;
+    }
+    sensor->pending = pressure->reg;
+}
+
+/**
+ * @brief     init a pressure feed
+ * @param[in] *pressure pointer to a pressure structure
+ * @param[in] *config pointer to a config
+ * @param[in] source pressure source
+ * @param[in] *arg pointer to the source argument
+ * @param[in] sensors sensor number
+ * @return    status code
+ *            - 0 success
+ *            - 1 init failed
+ * @note      the config is copied, every sensor is pushed after the first read
+ */
+uint8_t scd4xd_pressure_init(scd4xd_pressure_t *pressure, const scd4xd_pressure_config_t *config, 
+                             scd4xd_pressure_source_t source, void *arg, uint16_t sensors)
+{
+    if ((source == NULL) || (sensors > SCD4XD_PRESSURE_MAX_SENSORS) || 
+        ((config->max_age_us != 0) && (config->batch_us >= config->max_age_us)))
+    {
+        return 1;
+    }
+    memset(pressure, 0, sizeof(scd4xd_pressure_t));
+    pressure->config = *config;
+    pressure->source = source;
+    pressure->arg = arg;
+    pressure->sensors = sensors;
+    
+    return 0;
+}
+
+/**
+ * @brief      read the source and queue the pushes
+ * @param[in]  *pressure pointer to a pressure structure
+ * @param[in]  now_us current time
+ * @param[out] *queued pointer to a queued push number buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed or the pressure is out of range
+ * @note       a round starts if a sensor is off by threshold_pa, over max_age_us or never pushed,
+ *             then every sensor with another register or near its max age is queued at once,
+ *             a queued register which is not sent yet is replaced and counted as avoided
+ */
+uint8_t scd4xd_pressure_update(scd4xd_pressure_t *pressure, uint64_t now_us, uint16_t *queued)
+{
+    scd4xd_pressure_sensor_t *sensor;
+    uint16_t target;
+    float diff;
+    float pa;
+    uint8_t round = 0;
+    uint16_t i;
+    
+    *queued = 0;
+    if ((pressure->source(pressure->arg, &pa) != 0) || !(pa >= SCD4XD_PRESSURE_MIN_PA) || !(pa <= SCD4XD_PRESSURE_MAX_PA))
+    {
+        pressure->read_failed++;
+        
+        return 1;
+    }
+    pressure->reads++;
+    pressure->pa = pa;
+    pressure->reg = (uint16_t)(pa / 100.0f + 0.5f);
+    
+    /* one sensor off by the threshold or too old starts a round */
+    for (i = 0; (i < pressure->sensors) && (round == 0); i++)
+    {
+        sensor = &pressure->sensor[i];
+        target = a_scd4xd_pressure_target(sensor);
+        diff = pa - (float)target * 100.0f;
+        if ((target == 0) || (diff >= (float)pressure->config.threshold_pa) || (-diff >= (float)pressure->config.threshold_pa) || 
+            (a_scd4xd_pressure_old(pressure, sensor, 0, now_us) != 0))
+        {
+            round = 1;
+        }
+    }
+    if (round == 0)
+    {
+        pressure->avoided += pressure->sensors;
+        
+        return 0;
+    }
+    
+    /* the round takes every sensor it can refresh, so the sensors don't start rounds of their own */
+    pressure->rounds++;
+    for (i = 0; i < pressure->sensors; i++)
+    {
+        sensor = &pressure->sensor[i];
+        if ((a_scd4xd_pressure_target(sensor) != pressure->reg) || 
+            (a_scd4xd_pressure_old(pressure, sensor, pressure->config.batch_us, now_us) != 0))
+        {
+            a_scd4xd_pressure_queue(pressure, sensor);
+            (*queued)++;
+        }
+        else
+        {
+            pressure->avoided++;
+        }
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief      take the queued push of a sensor
+ * @param[in]  *pressure pointer to a pressure structure
+ * @param[in]  index sensor index
+ * @param[out] *reg pointer to a register buffer in hpa
+ * @return     status code
+ *             - 0 success, send it and call scd4xd_pressure_done
+ *             - 1 nothing to push
+ * @note       none
+ */
+uint8_t scd4xd_pressure_take(scd4xd_pressure_t *pressure, uint16_t index, uint16_t *reg)
+{
+    if ((index >= pressure->sensors) || (pressure->sensor[index].pending == 0))
+    {
+        return 1;
+    }
+    *reg = pressure->sensor[index].pending;
+    
+    return 0;
+}
+
+/**
+ * @brief     end the push of a sensor
+ * @param[in] *pressure pointer to a pressure structure
+ * @param[in] index sensor index
+ * @param[in] res status code of the set ambient pressure command
+ * @param[in] now_us current time
+ * @note      a failed push keeps the old register, so the next read queues it again
+ */
+void scd4xd_pressure_done(scd4xd_pressure_t *pressure, uint16_t index, uint8_t res, uint64_t now_us)
+{
+    scd4xd_pressure_sensor_t *sensor = &pressure->sensor[index];
+    
+    if (res == 0)
+    {
+        sensor->reg = sensor->pending;
+        sensor->pushed_us = now_us;
+        pressure->pushes++;
+    }
+    else
+    {
+        pressure->failed++;
+    }
+    sensor->pending = 0;
+}
+
+/**
+ * @brief     forget the pushed register of a sensor
+ * @param[in] *pressure pointer to a pressure structure
+ * @param[in] index sensor index
+ * @note      call it after a reinit or power cycle cleared the sensor settings, the next read pushes it
+ */
+void scd4xd_pressure_reset(scd4xd_pressure_t *pressure, uint16_t index)
+{
+    if (index < pressure->sensors)
+    {
+        pressure->sensor[index].reg = 0;
+    }
+}
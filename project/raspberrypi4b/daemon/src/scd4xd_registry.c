@@ -0,0 +1,265 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      scd4xd_registry.c
+ * @brief     scd4xd registry source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#define _GNU_SOURCE
+
+#include "scd4xd_registry.h"
+#include <fcntl.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+/**
+ * @brief     get the home slot of a serial
+ * @param[in] *reg pointer to a registry handle structure
+ * @param[in] serial 48 bits serial number
+ * @return    slot index
+ * @note      fibonacci hashing, the serials of one batch differ only in the low bits
+ */
+static inline uint32_t a_scd4xd_registry_hash(scd4xd_registry_t *reg, uint64_t serial)
+{
+    return (uint32_t)((serial * 0x9E3779B97F4A7C15ULL) >> 32) & (reg->file->capacity - 1);
+}
+
+/**
+ * @brief     open or create a registry file
+ * @param[in] *reg pointer to a registry handle structure
+ * @param[in] *path pointer to a file path
+ * @param[in] capacity slot number of a new file, a power of 2, 0 to open an existing file only
+ * @return    status code
+ *            - 0 success
+ *            - 1 open failed
+ *            - 4 layout is different
+ * @note      an existing file keeps its capacity, the file is mapped shared so
+ *            the edits of another process are seen at the next lookup
+ */
+uint8_t scd4xd_registry_open(scd4xd_registry_t *reg, const char *path, uint32_t capacity)
+{
+    scd4xd_registry_file_t *file;
+    struct stat st;
+    uint64_t size;
+    void *addr;
+    uint8_t created;
+    int fd;
+    
+    if ((capacity & (capacity - 1)) != 0)
+    {
+        return 1;
+    }
+    fd = open(path, O_RDWR | O_CLOEXEC | ((capacity != 0) ? O_CREAT : 0), 0644);
+    if ((fd < 0) || (fstat(fd, &st) != 0))
+    {
+        if (fd >= 0)
+        {
+            (void)close(fd);
+        }
+        
+        return 1;
+    }
+    
+    /* a new file is sized and zero, an old one keeps its size */
+    created = ((st.st_size == 0) && (capacity != 0)) ? 1 : 0;
+    size = (created != 0) ? (sizeof(scd4xd_registry_file_t) + (uint64_t)capacity * sizeof(scd4xd_registry_entry_t)) : 
+                            (uint64_t)st.st_size;
+    if ((size < sizeof(scd4xd_registry_file_t)) || ((created != 0) && (ftruncate(fd, (off_t)size) != 0)))
+    {
+        (void)close(fd);
+        
+        return (created != 0) ? 1 : 4;
+    }
+    addr = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    (void)close(fd);
+    if (addr == MAP_FAILED)
+    {
+        return 1;
+    }
+    file = (scd4xd_registry_file_t *)addr;
+    if (created != 0)
+    {
+        file->version = SCD4XD_REGISTRY_VERSION;
+        file->capacity = capacity;
+        file->entry_size = sizeof(scd4xd_registry_entry_t);
+        file->magic = SCD4XD_REGISTRY_MAGIC;
+    }
+    
+    /* check the layout */
+    if ((file->magic != SCD4XD_REGISTRY_MAGIC) ||
+        (file->version != SCD4XD_REGISTRY_VERSION) ||
+        (file->entry_size != sizeof(scd4xd_registry_entry_t)) ||
+        (file->capacity == 0) || ((file->capacity & (file->capacity - 1)) != 0) ||
+        (size != sizeof(scd4xd_registry_file_t) + (uint64_t)file->capacity * sizeof(scd4xd_registry_entry_t)))
+    {
+        (void)munmap(addr, size);
+        
+        return 4;
+    }
+    reg->file = file;
+    reg->size = size;
+    
+    return 0;
+}
+
+/**
+ * @brief     write back and close a registry
+ * @param[in] *reg pointer to a registry handle structure
+ * @note      none
+ */
+void scd4xd_registry_close(scd4xd_registry_t *reg)
+{
+    if (reg->file == NULL)
+    {
+        return;
+    }
+    (void)msync(reg->file, reg->size, MS_SYNC);
+    (void)munmap(reg->file, reg->size);
+    reg->file = NULL;
+}
+
+/**
+ * @brief     start writing back the dirty pages
+ * @param[in] *reg pointer to a registry handle structure
+ * @note      does not wait for the disk
+ */
+void scd4xd_registry_sync(scd4xd_registry_t *reg)
+{
+    if (reg->file != NULL)
+    {
+        (void)msync(reg->file, reg->size, MS_ASYNC);
+    }
+}
+
+/**
+ * @brief     find a sensor
+ * @param[in] *reg pointer to a registry handle structure
+ * @param[in] serial 48 bits serial number
+ * @return    pointer to the mapped entry, NULL if not found
+ * @note      the load factor is kept under 3/4, so the probe is short
+ */
+scd4xd_registry_entry_t *scd4xd_registry_find(scd4xd_registry_t *reg, uint64_t serial)
+{
+    scd4xd_registry_entry_t *entry;
+    uint32_t mask = reg->file->capacity - 1;
+    uint32_t i;
+    uint32_t n;
+    
+    if (serial == 0)
+    {
+        return NULL;
+    }
+    for (i = a_scd4xd_registry_hash(reg, serial), n = 0; n <= mask; i = (i + 1) & mask, n++)
+    {
+        entry = &reg->file->entry[i];
+        if (entry->serial == serial)
+        {
+            return entry;
+        }
+        if (entry->serial == 0)
+        {
+            break;
+        }
+    }
+    
+    return NULL;
+}
+
+/**
+ * @brief     find or add a sensor
+ * @param[in] *reg pointer to a registry handle structure
+ * @param[in] serial 48 bits serial number
+ * @return    pointer to the mapped entry, NULL if the serial is 0 or the registry is full
+ * @note      a new entry is zero except the serial, its connects is 0
+ */
+scd4xd_registry_entry_t *scd4xd_registry_add(scd4xd_registry_t *reg, uint64_t serial)
+{
+    scd4xd_registry_entry_t *entry;
+    uint32_t mask = reg->file->capacity - 1;
+    uint32_t i;
+    uint32_t n;
+    
+    if (serial == 0)
+    {
+        return NULL;
+    }
+    
+    /* the entries are never removed, the first free slot ends the probe */
+    for (i = a_scd4xd_registry_hash(reg, serial), n = 0; ; i = (i + 1) & mask, n++)
+    {
+        if (n > mask)
+        {
+            return NULL;
+        }
+        entry = &reg->file->entry[i];
+        if (entry->serial == serial)
+        {
+            return entry;
+        }
+        if (entry->serial == 0)
+        {
+            break;
+        }
+    }
+    if ((uint64_t)(reg->file->count + 1) * 4 > (uint64_t)reg->file->capacity * 3)
+    {
+        return NULL;
+    }
+    memset(entry, 0, sizeof(scd4xd_registry_entry_t));
+    entry->serial = serial;
+    reg->file->count++;
+    
+    return entry;
+}
+
+/**
+ * @brief     record a forced recalibration
+ * @param[in] *entry pointer to a registry entry
+ * @param[in] time_s unix time
+ * @param[in] target_ppm reference co2
+ * @param[in] correction frc correction register, 0xFFFF if failed
+ * @note      the oldest record is overwritten
+ */
+void scd4xd_registry_add_frc(scd4xd_registry_entry_t *entry, uint32_t time_s, uint16_t target_ppm, uint16_t correction)
+{
+    scd4xd_registry_frc_t *frc;
+    
+    frc = &entry->frc[entry->frc_num % SCD4XD_REGISTRY_FRC];
+    frc->time_s = time_s;
+    frc->target_ppm = target_ppm;
+    frc->correction = correction;
+    
+    /* wrap to a full ring at the same position */
+    entry->frc_num = (entry->frc_num == 255) ? (256 - SCD4XD_REGISTRY_FRC) : (entry->frc_num + 1);
+}
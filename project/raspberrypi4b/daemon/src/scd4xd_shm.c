@@ -0,0 +1,277 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      scd4xd_shm.c
+ * @brief     scd4xd shared memory feed source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#define _GNU_SOURCE
+
+#include "scd4xd_shm.h"
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <time.h>
+#include <unistd.h>
+
+/**
+ * @brief     create the ring as the only writer
+ * @param[in] *shm pointer to a shm handle structure
+ * @param[in] *name pointer to a shared memory name
+ * @return    status code
+ *            - 0 success
+ *            - 1 create failed
+ * @note      an old ring of the same name is replaced
+ */
+uint8_t scd4xd_shm_create(scd4xd_shm_t *shm, const char *name)
+{
+    void *addr;
+    int fd;
+    
+    if (strlen(name) >= sizeof(shm->name))
+    {
+        return 1;
+    }
+    
+    /* the readers which still map an old ring keep it */
+    (void)shm_unlink(name);
+    fd = shm_open(name, O_RDWR | O_CREAT | O_EXCL | O_CLOEXEC, 0644);
+    if (fd < 0)
+    {
+        return 1;
+    }
+    if (ftruncate(fd, sizeof(scd4xd_shm_ring_t)) != 0)
+    {
+        (void)close(fd);
+        (void)shm_unlink(name);
+        
+        return 1;
+    }
+    addr = mmap(NULL, sizeof(scd4xd_shm_ring_t), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    (void)close(fd);
+    if (addr == MAP_FAILED)
+    {
+        (void)shm_unlink(name);
+        
+        return 1;
+    }
+    
+    /* the pages are zero, a reader checks the magic last */
+    shm->ring = (scd4xd_shm_ring_t *)addr;
+    shm->ring->version = SCD4XD_SHM_VERSION;
+    shm->ring->slots = SCD4XD_SHM_SLOTS;
+    shm->ring->slot_size = sizeof(scd4xd_shm_slot_t);
+    __atomic_store_n(&shm->ring->magic, SCD4XD_SHM_MAGIC, __ATOMIC_RELEASE);
+    shm->writer = 1;
+    strcpy(shm->name, name);
+    
+    return 0;
+}
+
+/**
+ * @brief     open the ring as a reader
+ * @param[in] *shm pointer to a shm handle structure
+ * @param[in] *name pointer to a shared memory name
+ * @return    status code
+ *            - 0 success
+ *            - 1 open failed
+ *            - 4 layout is different
+ * @note      the ring is mapped read only
+ */
+uint8_t scd4xd_shm_open(scd4xd_shm_t *shm, const char *name)
+{
+    scd4xd_shm_ring_t *ring;
+    struct stat st;
+    void *addr;
+    int fd;
+    
+    if (strlen(name) >= sizeof(shm->name))
+    {
+        return 1;
+    }
+    fd = shm_open(name, O_RDONLY | O_CLOEXEC, 0);
+    if (fd < 0)
+    {
+        return 1;
+    }
+    if ((fstat(fd, &st) != 0) || (st.st_size != (off_t)sizeof(scd4xd_shm_ring_t)))
+    {
+        (void)close(fd);
+        
+        return 4;
+    }
+    addr = mmap(NULL, sizeof(scd4xd_shm_ring_t), PROT_READ, MAP_SHARED, fd, 0);
+    (void)close(fd);
+    if (addr == MAP_FAILED)
+    {
+        return 1;
+    }
+    
+    /* check the layout */
+    ring = (scd4xd_shm_ring_t *)addr;
+    if ((__atomic_load_n(&ring->magic, __ATOMIC_ACQUIRE) != SCD4XD_SHM_MAGIC) ||
+        (ring->version != SCD4XD_SHM_VERSION) ||
+        (ring->slots != SCD4XD_SHM_SLOTS) ||
+        (ring->slot_size != sizeof(scd4xd_shm_slot_t)))
+    {
+        (void)munmap(addr, sizeof(scd4xd_shm_ring_t));
+        
+        return 4;
+    }
+    shm->ring = ring;
+    shm->writer = 0;
+    strcpy(shm->name, name);
+    
+    return 0;
+}
+
+/**
+ * @brief     close the ring
+ * @param[in] *shm pointer to a shm handle structure
+ * @note      the writer removes the name
+ */
+void scd4xd_shm_close(scd4xd_shm_t *shm)
+{
+    if (shm->ring == NULL)
+    {
+        return;
+    }
+    (void)munmap(shm->ring, sizeof(scd4xd_shm_ring_t));
+    shm->ring = NULL;
+    if (shm->writer != 0)
+    {
+        (void)shm_unlink(shm->name);
+    }
+}
+
+/**
+ * @brief     publish a sample
+ * @param[in] *shm pointer to a shm handle structure
+ * @param[in] sensor sensor index
+ * @param[in] flags scd4xd record flags
+ * @param[in] *sample pointer to a sample filled by the driver
+ * @note      no syscall, lock free and never waits for the readers
+ */
+void scd4xd_shm_write(scd4xd_shm_t *shm, uint8_t sensor, uint8_t flags, const scd4x_sample_t *sample)
+{
+    scd4xd_shm_ring_t *ring = shm->ring;
+    scd4xd_shm_slot_t *slot;
+    struct timespec ts;
+    uint64_t index;
+    
+    /* only one writer, the head is its own */
+    index = __atomic_load_n(&ring->head, __ATOMIC_RELAXED);
+    slot = &ring->slot[index & (SCD4XD_SHM_SLOTS - 1)];
+    (void)clock_gettime(CLOCK_MONOTONIC, &ts);
+    
+    /* odd while writing */
+    __atomic_store_n(&slot->seq, 2 * index + 1, __ATOMIC_RELAXED);
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+    slot->data.index = index;
+    slot->data.time_ns = (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+    slot->data.sensor = sensor;
+    slot->data.flags = flags;
+    slot->data.sample = *sample;
+    
+    /* stable, then publish */
+    __atomic_store_n(&slot->seq, 2 * index + 2, __ATOMIC_RELEASE);
+    __atomic_store_n(&ring->head, index + 1, __ATOMIC_RELEASE);
+}
+
+/**
+ * @brief     get the next sample index to be written
+ * @param[in] *shm pointer to a shm handle structure
+ * @return    head index
+ * @note      start a cursor here to read only the new samples, or at 0 to replay the ring
+ */
+uint64_t scd4xd_shm_head(scd4xd_shm_t *shm)
+{
+    return __atomic_load_n(&shm->ring->head, __ATOMIC_ACQUIRE);
+}
+
+/**
+ * @brief         read the sample at the cursor
+ * @param[in]     *shm pointer to a shm handle structure
+ * @param[in,out] *cursor pointer to a reader cursor
+ * @param[out]    *out pointer to a sample buffer
+ * @param[in,out] *lost pointer to a lost sample counter
+ * @return        status code
+ *                - 0 success
+ *                - 1 no new sample
+ * @note          no syscall and never blocks the writer, the samples overwritten before
+ *                they are read are skipped and added to lost
+ */
+uint8_t scd4xd_shm_read(scd4xd_shm_t *shm, uint64_t *cursor, scd4xd_shm_sample_t *out, uint64_t *lost)
+{
+    scd4xd_shm_ring_t *ring = shm->ring;
+    const scd4xd_shm_slot_t *slot;
+    uint64_t head;
+    uint64_t seq;
+    
+    while (1)
+    {
+        head = __atomic_load_n(&ring->head, __ATOMIC_ACQUIRE);
+        if (*cursor >= head)
+        {
+            /* a cursor of an old ring restarts at the head */
+            *cursor = head;
+            
+            return 1;
+        }
+        
+        /* skip the overwritten samples */
+        if (head - *cursor > SCD4XD_SHM_SLOTS)
+        {
+            *lost += head - SCD4XD_SHM_SLOTS - *cursor;
+            *cursor = head - SCD4XD_SHM_SLOTS;
+        }
+        
+        /* copy between two equal stable sequences */
+        slot = &ring->slot[*cursor & (SCD4XD_SHM_SLOTS - 1)];
+        seq = __atomic_load_n(&slot->seq, __ATOMIC_ACQUIRE);
+        if (seq == 2 * (*cursor) + 2)
+        {
+            *out = slot->data;
+            __atomic_thread_fence(__ATOMIC_ACQUIRE);
+            if (__atomic_load_n(&slot->seq, __ATOMIC_RELAXED) == seq)
+            {
+                (*cursor)++;
+                
+                return 0;
+            }
+        }
+        
+        /* the writer lapped the cursor, the sample is gone */
+        (*lost)++;
+        (*cursor)++;
+    }
+}
@@ -36,7 +36,9 @@
 
 #include "driver_scd4x_interface.h"
 #include "iic.h"
+#include <errno.h>
 #include <stdarg.h>
+#include <time.h>
 
 /**
  * @brief iic device name definition
@@ -105,11 +107,41 @@ uint8_t scd4x_interface_iic_read_cmd(uint8_t addr, uint8_t *buf, uint16_t len)
 /**
  * @brief     interface delay ms
  * @param[in] ms time
- * @note      none
+ * @note      sleeps to an absolute deadline, so a signal or a late wake up never stretches the delay
  */
 void scd4x_interface_delay_ms(uint32_t ms)
 {
-    usleep(1000 * ms);
+    struct timespec ts;
+    
+    /* get the deadline */
+    (void)clock_gettime(CLOCK_MONOTONIC, &ts);
+    ts.tv_sec += (time_t)(ms / 1000);
+    ts.tv_nsec += (long)(ms % 1000) * 1000000L;
+    if (ts.tv_nsec >= 1000000000L)
+    {
+        ts.tv_sec++;
+        ts.tv_nsec -= 1000000000L;
+    }
+    
+    /* sleep again after a signal */
+    while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, NULL) == EINTR)
+    {
+        
+    }
+}
+
+/**
+ * @brief  interface get time us
+ * @return monotonic time in us
+ * @note   none
+ */
+uint64_t scd4x_interface_get_time_us(void)
+{
+    struct timespec ts;
+    
+    (void)clock_gettime(CLOCK_MONOTONIC, &ts);
+    
+    return (uint64_t)ts.tv_sec * 1000000 + (uint64_t)(ts.tv_nsec / 1000);
 }
 
 /**
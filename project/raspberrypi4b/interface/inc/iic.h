@@ -37,6 +37,8 @@
 #ifndef IIC_H
 #define IIC_H
 
+#include <linux/i2c.h>
+#include <linux/i2c-dev.h>
 #include <unistd.h>
 #include <stdlib.h>
 #include <stdint.h>
@@ -53,6 +55,18 @@ extern "C" {
  * @{
  */
 
+/**
+ * @brief iic device structure definition
+ * @note  the target address is set once, so the plain frames need no message at all
+ */
+typedef struct iic_device_s
+{
+    int fd;                                 /**< iic handle */
+    uint8_t addr;                           /**< iic device write address */
+    struct i2c_msg msgs[1];                 /**< pre-built message of the I2C_RDWR frames */
+    struct i2c_rdwr_ioctl_data data;        /**< pre-built ioctl data */
+} iic_device_t;
+
 /**
  * @brief      iic bus init
  * @param[in]  *name pointer to an iic device name buffer
@@ -156,6 +170,56 @@ uint8_t iic_write(int fd, uint8_t addr, uint8_t reg, uint8_t *buf, uint16_t len)
  */
 uint8_t iic_write_address16(int fd, uint8_t addr, uint16_t reg, uint8_t *buf, uint16_t len);
 
+/**
+ * @brief      iic device init
+ * @param[out] *dev pointer to an iic device structure
+ * @param[in]  fd iic handle
+ * @param[in]  addr iic device write address
+ * @return     status code
+ *             - 0 success
+ *             - 1 init failed
+ * @note       addr = device_address_7bits << 1,
+ *             it sets I2C_SLAVE of the fd once and fails if a kernel driver owns the address
+ */
+uint8_t iic_device_init(iic_device_t *dev, int fd, uint8_t addr);
+
+/**
+ * @brief      iic device read command
+ * @param[in]  *dev pointer to an iic device structure
+ * @param[out] *buf pointer to a data buffer
+ * @param[in]  len length of the data buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ * @note       one read, the same frame as iic_read_cmd
+ */
+uint8_t iic_device_read_cmd(iic_device_t *dev, uint8_t *buf, uint16_t len);
+
+/**
+ * @brief     iic device write command
+ * @param[in] *dev pointer to an iic device structure
+ * @param[in] *buf pointer to a data buffer
+ * @param[in] len length of the data buffer
+ * @return    status code
+ *            - 0 success
+ *            - 1 write failed
+ * @note      one write, the same frame as iic_write_cmd
+ */
+uint8_t iic_device_write_cmd(iic_device_t *dev, uint8_t *buf, uint16_t len);
+
+/**
+ * @brief     iic device transfer with the pre-built message
+ * @param[in] *dev pointer to an iic device structure
+ * @param[in] flags 0 to write or I2C_M_RD to read
+ * @param[in] *buf pointer to a data buffer
+ * @param[in] len length of the data buffer
+ * @return    status code
+ *            - 0 success
+ *            - 1 transfer failed
+ * @note      one I2C_RDWR ioctl without clearing or building the message
+ */
+uint8_t iic_device_transfer(iic_device_t *dev, uint16_t flags, uint8_t *buf, uint16_t len);
+
 /**
  * @}
  */
@@ -35,8 +35,6 @@
  */
 
 #include "iic.h"
-#include <linux/i2c.h>
-#include <linux/i2c-dev.h>
 #include <sys/ioctl.h>
 #include <fcntl.h>
 
@@ -363,3 +361,110 @@ uint8_t iic_write_address16(int fd, uint8_t addr, uint16_t reg, uint8_t *buf, ui
      
     return 0;
 }
+
+/**
+ * @brief      iic device init
+ * @param[out] *dev pointer to an iic device structure
+ * @param[in]  fd iic handle
+ * @param[in]  addr iic device write address
+ * @return     status code
+ *             - 0 success
+ *             - 1 init failed
+ * @note       addr = device_address_7bits << 1,
+ *             it sets I2C_SLAVE of the fd once and fails if a kernel driver owns the address
+ */
+uint8_t iic_device_init(iic_device_t *dev, int fd, uint8_t addr)
+{
+    /* set the target address of read and write */
+    if (ioctl(fd, I2C_SLAVE, (unsigned long)(addr >> 1)) < 0)
+    {
+        perror("iic: set slave failed.\n");
+        
+        return 1;
+    }
+    
+    /* build the message once */
+    memset(dev, 0, sizeof(iic_device_t));
+    dev->fd = fd;
+    dev->addr = addr;
+    dev->msgs[0].addr = addr >> 1;
+    dev->data.msgs = dev->msgs;
+    dev->data.nmsgs = 1;
+    
+    return 0;
+}
+
+/**
+ * @brief      iic device read command
+ * @param[in]  *dev pointer to an iic device structure
+ * @param[out] *buf pointer to a data buffer
+ * @param[in]  len length of the data buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ * @note       one read, the same frame as iic_read_cmd
+ */
+uint8_t iic_device_read_cmd(iic_device_t *dev, uint8_t *buf, uint16_t len)
+{
+    /* transmit */
+    if (read(dev->fd, buf, len) != (ssize_t)len)
+    {
+        perror("iic: read failed.\n");
+        
+        return 1;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief     iic device write command
+ * @param[in] *dev pointer to an iic device structure
+ * @param[in] *buf pointer to a data buffer
+ * @param[in] len length of the data buffer
+ * @return    status code
+ *            - 0 success
+ *            - 1 write failed
+ * @note      one write, the same frame as iic_write_cmd
+ */
+uint8_t iic_device_write_cmd(iic_device_t *dev, uint8_t *buf, uint16_t len)
+{
+    /* transmit */
+    if (write(dev->fd, buf, len) != (ssize_t)len)
+    {
+        perror("iic: write failed.\n");
+        
+        return 1;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief     iic device transfer with the pre-built message
+ * @param[in] *dev pointer to an iic device structure
+ * @param[in] flags 0 to write or I2C_M_RD to read
+ * @param[in] *buf pointer to a data buffer
+ * @param[in] len length of the data buffer
+ * @return    status code
+ *            - 0 success
+ *            - 1 transfer failed
+ * @note      one I2C_RDWR ioctl without clearing or building the message
+ */
+uint8_t iic_device_transfer(iic_device_t *dev, uint16_t flags, uint8_t *buf, uint16_t len)
+{
+    /* set the param */
+    dev->msgs[0].flags = flags;
+    dev->msgs[0].buf = buf;
+    dev->msgs[0].len = len;
+    
+    /* transmit */
+    if (ioctl(dev->fd, I2C_RDWR, &dev->data) < 0)
+    {
+        perror("iic: transfer failed.\n");
+        
+        return 1;
+    }
+    
+    return 0;
+}
@@ -0,0 +1,389 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      account_bench.c
+ * @brief     energy accounting benchmark source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "driver_scd4x_sim.h"
+#include <getopt.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+/**
+ * @brief account bench definition
+ */
+#define SCD4X_ACCOUNT_BENCH_HOURS          1                /**< default simulated hours of each run */
+#define SCD4X_ACCOUNT_BENCH_POWER_UP_US    30000            /**< power up time of the simulated sensor */
+#define SCD4X_ACCOUNT_BENCH_MAX_ERROR      0.01             /**< max state time error in percent */
+
+/**
+ * @brief account bench mode enumeration definition
+ */
+typedef enum
+{
+    SCD4X_ACCOUNT_BENCH_PERIODIC   = 0x00,        /**< periodic measurement, read each 5 s */
+    SCD4X_ACCOUNT_BENCH_LOW_POWER  = 0x01,        /**< low power periodic measurement, read each 30 s */
+    SCD4X_ACCOUNT_BENCH_SHOT_IDLE  = 0x02,        /**< single shot each 60 s, idle in between */
+    SCD4X_ACCOUNT_BENCH_RHT_IDLE   = 0x03,        /**< rht only single shot each 10 s, idle in between */
+    SCD4X_ACCOUNT_BENCH_SHOT_SLEEP = 0x04,        /**< sleepy shot each 5 min */
+    SCD4X_ACCOUNT_BENCH_SELF_TEST  = 0x05,        /**< self test each hour, idle in between */
+    SCD4X_ACCOUNT_BENCH_MAX        = 0x06,        /**< mode number */
+} scd4x_account_bench_mode_t;
+
+static scd4x_handle_t gs_handle;        /**< scd4x handle */
+static scd4x_sim_t gs_sim;              /**< simulated sensor */
+
+/**
+ * @brief cycle time of each mode in ms
+ */
+static const uint32_t gs_cycle_ms[SCD4X_ACCOUNT_BENCH_MAX] =
+{
+    5000, 30000, 60000, 10000, 300000, 3600000,
+};
+
+/**
+ * @brief mode names
+ */
+static const char *const gs_mode[SCD4X_ACCOUNT_BENCH_MAX] =
+{
+    "periodic", "low_power", "shot_idle", "rht_idle", "shot_sleep", "self_test",
+};
+
+/**
+ * @brief     start a mode
+ * @param[in] mode bench mode
+ * @return    status code
+ *            - 0 success
+ *            - 1 start failed
+ * @note      none
+ */
+static uint8_t a_account_bench_start(uint8_t mode)
+{
+    switch (mode)
+    {
+        case SCD4X_ACCOUNT_BENCH_PERIODIC :
+        {
+            return scd4x_start_periodic_measurement(&gs_handle);
+        }
+        case SCD4X_ACCOUNT_BENCH_LOW_POWER :
+        {
+            return scd4x_start_low_power_periodic_measurement(&gs_handle);
+        }
+        case SCD4X_ACCOUNT_BENCH_SHOT_SLEEP :
+        {
+            return scd4x_set_sleepy_shot(&gs_handle, SCD4X_BOOL_TRUE, SCD4X_BOOL_FALSE);
+        }
+        default :
+        {
+            return 0;
+        }
+    }
+}
+
+/**
+ * @brief     run one cycle of a mode
+ * @param[in] mode bench mode
+ * @param[in] start_us cycle start time
+ * @return    status code
+ *            - 0 success
+ *            - 1 run failed
+ * @note      the periodic modes read the sample at the cycle end, the other modes start at the cycle start
+ */
+static uint8_t a_account_bench_cycle(uint8_t mode, uint64_t start_us)
+{
+    scd4x_sample_t sample;
+    scd4x_bool_t malfunction;
+    uint16_t co2_raw;
+    uint16_t co2_ppm;
+    uint16_t temperature_raw;
+    uint16_t humidity_raw;
+    float temperature_s;
+    float humidity_s;
+    
+    switch (mode)
+    {
+        case SCD4X_ACCOUNT_BENCH_PERIODIC :
+        case SCD4X_ACCOUNT_BENCH_LOW_POWER :
+        {
+            if (gs_sim.now_us < start_us + (uint64_t)gs_cycle_ms[mode] * 1000)
+            {
+                gs_sim.now_us = start_us + (uint64_t)gs_cycle_ms[mode] * 1000;
+            }
+            
+            return scd4x_read(&gs_handle, &co2_raw, &co2_ppm, &temperature_raw, &temperature_s, &humidity_raw, &humidity_s);
+        }
+        case SCD4X_ACCOUNT_BENCH_SHOT_IDLE :
+        {
+            if (scd4x_measure_single_shot(&gs_handle) != 0)
+            {
+                return 1;
+            }
+            
+            return scd4x_read(&gs_handle, &co2_raw, &co2_ppm, &temperature_raw, &temperature_s, &humidity_raw, &humidity_s);
+        }
+        case SCD4X_ACCOUNT_BENCH_RHT_IDLE :
+        {
+            if (scd4x_measure_single_shot_rht_only(&gs_handle) != 0)
+            {
+                return 1;
+            }
+            
+            return scd4x_read(&gs_handle, &co2_raw, &co2_ppm, &temperature_raw, &temperature_s, &humidity_raw, &humidity_s);
+        }
+        case SCD4X_ACCOUNT_BENCH_SHOT_SLEEP :
+        {
+            return scd4x_read_sleepy_shot(&gs_handle, &sample);
+        }
+        case SCD4X_ACCOUNT_BENCH_SELF_TEST :
+        {
+            if (scd4x_perform_self_test(&gs_handle, &malfunction) != 0)
+            {
+                return 1;
+            }
+            
+            return (malfunction == SCD4X_BOOL_FALSE) ? 0 : 1;
+        }
+        default :
+        {
+            return 1;
+        }
+    }
+}
+
+/**
+ * @brief     get the charge of the state times
+ * @param[in] *model pointer to an energy model structure
+ * @param[in] *state_us pointer to the time in each state
+ * @param[in] states state number
+ * @return    charge in uah
+ * @note      the states are in the order of the model
+ */
+static double a_account_bench_charge(const scd4x_energy_model_t *model, const uint64_t *state_us, uint8_t states)
+{
+    const uint32_t na[SCD4X_ACCOUNT_MAX] =
+    {
+        model->sleep_na, model->idle_na, model->periodic_na, model->low_power_na, 
+        model->shot_na, model->rht_only_na, model->wake_up_na, model->self_test_na,
+    };
+    double charge = 0.0;
+    uint8_t i;
+    
+    for (i = 0; i < states; i++)
+    {
+        charge += (double)state_us[i] * (double)na[i] / 3.6e12;
+    }
+    
+    return charge;
+}
+
+/**
+ * @brief     run a mode and check the accounted state times against the simulated sensor
+ * @param[in] *model pointer to an energy model structure
+ * @param[in] mode bench mode
+ * @param[in] hours simulated hours
+ * @return    status code
+ *            - 0 success
+ *            - 1 run failed
+ *            - 4 the accounted state times don't match the simulated sensor
+ * @note      the sim has no self test state and stays idle during it, so the accounted
+ *            self test time is compared with the idle time of the sim
+ */
+static uint8_t a_account_bench_run(const scd4x_energy_model_t *model, uint8_t mode, uint32_t hours)
+{
+    scd4x_account_stats_t stats;
+    uint64_t start_us[SCD4X_SIM_STATE_MAX];
+    uint64_t state_us[SCD4X_SIM_STATE_MAX];
+    uint64_t driver_us[SCD4X_SIM_STATE_MAX];
+    uint64_t base_us;
+    uint64_t end_us;
+    uint64_t diff_us;
+    uint32_t cycles;
+    uint32_t c;
+    double error;
+    uint8_t i;
+    
+    /* power up, init and start the accounting in the idle state */
+    scd4x_sim_init(&gs_sim, SCD41);
+    gs_sim.now_us = SCD4X_ACCOUNT_BENCH_POWER_UP_US;
+    scd4x_sim_attach(&gs_sim);
+    DRIVER_SCD4X_LINK_INIT(&gs_handle, scd4x_handle_t);
+    DRIVER_SCD4X_LINK_SIM(&gs_handle);
+    if ((scd4x_set_type(&gs_handle, SCD41) != 0) || (scd4x_init(&gs_handle) != 0))
+    {
+        return 1;
+    }
+    if (scd4x_account_start(&gs_handle, model, SCD4X_ACCOUNT_IDLE) != 0)
+    {
+        return 1;
+    }
+    base_us = gs_sim.now_us;
+    scd4x_sim_account(&gs_sim);
+    for (i = 0; i < SCD4X_SIM_STATE_MAX; i++)
+    {
+        start_us[i] = gs_sim.state_us[i];
+    }
+    
+    /* run the cycles */
+    if (a_account_bench_start(mode) != 0)
+    {
+        return 1;
+    }
+    end_us = base_us + (uint64_t)hours * 3600000000ULL;
+    cycles = (uint32_t)(((uint64_t)hours * 3600000) / gs_cycle_ms[mode]);
+    for (c = 0; c < cycles; c++)
+    {
+        if (gs_sim.now_us < base_us + (uint64_t)c * gs_cycle_ms[mode] * 1000)
+        {
+            gs_sim.now_us = base_us + (uint64_t)c * gs_cycle_ms[mode] * 1000;
+        }
+        if (a_account_bench_cycle(mode, base_us + (uint64_t)c * gs_cycle_ms[mode] * 1000) != 0)
+        {
+            return 1;
+        }
+    }
+    if (gs_sim.now_us < end_us)
+    {
+        gs_sim.now_us = end_us;
+    }
+    
+    /* compare the state times */
+    if (scd4x_get_account_stats(&gs_handle, &stats) != 0)
+    {
+        return 1;
+    }
+    scd4x_sim_account(&gs_sim);
+    (void)scd4x_deinit(&gs_handle);
+    for (i = 0; i < SCD4X_SIM_STATE_MAX; i++)
+    {
+        state_us[i] = gs_sim.state_us[i] - start_us[i];
+        driver_us[i] = stats.state_us[i];
+    }
+    driver_us[SCD4X_SIM_STATE_IDLE] += stats.state_us[SCD4X_ACCOUNT_SELF_TEST];
+    diff_us = 0;
+    for (i = 0; i < SCD4X_SIM_STATE_MAX; i++)
+    {
+        diff_us += (driver_us[i] > state_us[i]) ? (driver_us[i] - state_us[i]) : (state_us[i] - driver_us[i]);
+    }
+    error = (stats.elapsed_us != 0) ? ((double)diff_us * 100.0 / (double)stats.elapsed_us) : 0.0;
+    printf("%s,%u,%u,%.3f,%.3f,%.1f,%.3f,%.4f\n", gs_mode[mode], hours, stats.commands, 
+           (double)stats.charge_uah, a_account_bench_charge(model, state_us, SCD4X_SIM_STATE_MAX), 
+           (double)stats.average_ua, (double)stats.state_uah[SCD4X_ACCOUNT_SELF_TEST], error);
+    
+    return (error > SCD4X_ACCOUNT_BENCH_MAX_ERROR) ? 4 : 0;
+}
+
+/**
+ * @brief     account bench main function
+ * @param[in] argc arg numbers
+ * @param[in] **argv arg address
+ * @return    status code
+ *            - 0 success
+ *            - 1 run failed or the accounted state times don't match the simulated sensor
+ * @note      each mode prints one csv line, driver_uah is the charge accounted by the driver, sim_uah is the
+ *            charge of the state times of the simulated sensor and error_pct is the state time difference
+ */
+int main(int argc, char **argv)
+{
+    int c;
+    int longindex = 0;
+    const char short_options[] = "h";
+    const struct option long_options[] =
+    {
+        {"help", no_argument, NULL, 'h'},
+        {"hours", required_argument, NULL, 1},
+        {NULL, 0, NULL, 0},
+    };
+    scd4x_energy_model_t model;
+    uint32_t hours = SCD4X_ACCOUNT_BENCH_HOURS;
+    uint8_t failed = 0;
+    uint8_t res;
+    uint8_t i;
+    
+    optind = 0;
+    do
+    {
+        c = getopt_long(argc, argv, short_options, long_options, &longindex);
+        switch (c)
+        {
+            case 'h' :
+            {
+                printf("Usage:\n");
+                printf("  scd4x_account_bench [--hours=<num>]\n");
+                printf("\n");
+                printf("Options:\n");
+                printf("  -h, --help           Show the help.\n");
+                printf("      --hours=<num>    Set the simulated hours of each run.([default: %d])\n", SCD4X_ACCOUNT_BENCH_HOURS);
+                
+                return 0;
+            }
+            case 1 :
+            {
+                hours = (uint32_t)atol(optarg);
+                
+                break;
+            }
+            case -1 :
+            {
+                break;
+            }
+            default :
+            {
+                return 1;
+            }
+        }
+    } while (c != -1);
+    if ((hours == 0) || (hours > 24 * 365))
+    {
+        return 1;
+    }
+    
+    (void)scd4x_energy_default_model(&model);
+    printf("mode,hours,commands,driver_uah,sim_uah,average_ua,self_test_uah,error_pct\n");
+    for (i = 0; i < SCD4X_ACCOUNT_BENCH_MAX; i++)
+    {
+        res = a_account_bench_run(&model, i, hours);
+        if (res == 1)
+        {
+            fprintf(stderr, "scd4x_account_bench: run failed.\n");
+            
+            return 1;
+        }
+        if (res != 0)
+        {
+            fprintf(stderr, "scd4x_account_bench: the accounted state times don't match the simulated sensor.\n");
+            failed = 1;
+        }
+    }
+    
+    return failed;
+}
@@ -0,0 +1,412 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      adaptive_bench.c
+ * @brief     adaptive sampling benchmark source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "driver_scd4x_adaptive.h"
+#include "driver_scd4x_sim.h"
+#include <getopt.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+/**
+ * @brief adaptive bench definition
+ */
+#define SCD4X_ADAPTIVE_BENCH_HOURS          24               /**< default simulated hours of each run */
+#define SCD4X_ADAPTIVE_BENCH_SHOT_MS        60000            /**< default shot interval of the sparse single shots */
+#define SCD4X_ADAPTIVE_BENCH_NOISE          10               /**< default co2 noise in ppm */
+#define SCD4X_ADAPTIVE_BENCH_POWER_UP_US    30000            /**< power up time of the simulated sensor */
+#define SCD4X_ADAPTIVE_BENCH_CYCLE_S        14400            /**< one occupancy event each 4 h */
+#define SCD4X_ADAPTIVE_BENCH_EVENT_S        1800             /**< the room is occupied for 30 min after 30 min of the cycle */
+#define SCD4X_ADAPTIVE_BENCH_BASE_PPM       450.0            /**< outdoor co2 */
+#define SCD4X_ADAPTIVE_BENCH_RISE_PPM       1000.0           /**< co2 rise of one event */
+#define SCD4X_ADAPTIVE_BENCH_DECAY_S        600.0            /**< ventilation time constant */
+
+/**
+ * @brief adaptive bench mode enumeration definition
+ */
+typedef enum
+{
+    SCD4X_ADAPTIVE_BENCH_PERIODIC      = 0,        /**< periodic measurement only */
+    SCD4X_ADAPTIVE_BENCH_LOW_POWER     = 1,        /**< low power periodic measurement only */
+    SCD4X_ADAPTIVE_BENCH_ADAPTIVE      = 2,        /**< adaptive with the low power periodic measurement */
+    SCD4X_ADAPTIVE_BENCH_ADAPTIVE_SHOT = 3,        /**< adaptive with the sparse single shots */
+    SCD4X_ADAPTIVE_BENCH_MAX           = 4,        /**< mode number */
+} scd4x_adaptive_bench_mode_t;
+
+/**
+ * @brief adaptive bench result structure definition
+ */
+typedef struct scd4x_adaptive_bench_result_s
+{
+    uint32_t samples;              /**< delivered samples */
+    uint32_t switches;             /**< mode switches */
+    uint32_t fast_s;               /**< seconds in the fast mode */
+    uint32_t seconds;              /**< run seconds */
+    uint32_t event_seconds;        /**< seconds of the events */
+    double error;                  /**< sum of the absolute error of the latest sample */
+    double event_error;            /**< sum of the absolute error during the events */
+    double max_error;              /**< max absolute error */
+    double average_ua;             /**< average current */
+} scd4x_adaptive_bench_result_t;
+
+static scd4x_handle_t gs_handle;        /**< scd4x handle */
+static scd4x_sim_t gs_sim;              /**< simulated sensor */
+static uint32_t gs_seed = 1;            /**< noise seed */
+
+/**
+ * @brief mode names
+ */
+static const char *const gs_mode[SCD4X_ADAPTIVE_BENCH_MAX] =
+{
+    "periodic", "low_power", "adaptive", "adaptive_shot",
+};
+
+/**
+ * @brief     get the true co2 of the room
+ * @param[in] s time in the cycle in seconds
+ * @param[in] *event pointer to an event flag buffer
+ * @return    co2 in ppm
+ * @note      the co2 rises linearly while the room is occupied and decays with the ventilation after it,
+ *            the event lasts until 4 time constants after the room is left
+ */
+static double a_adaptive_bench_co2(uint32_t s, uint8_t *event)
+{
+    double t;
+    
+    s %= SCD4X_ADAPTIVE_BENCH_CYCLE_S;
+    *event = ((s >= SCD4X_ADAPTIVE_BENCH_EVENT_S) && 
+              (s < 2 * SCD4X_ADAPTIVE_BENCH_EVENT_S + 4 * SCD4X_ADAPTIVE_BENCH_DECAY_S)) ? 1 : 0;
+    if (s < SCD4X_ADAPTIVE_BENCH_EVENT_S)
+    {
+        return SCD4X_ADAPTIVE_BENCH_BASE_PPM;
+    }
+    t = (double)(s - SCD4X_ADAPTIVE_BENCH_EVENT_S);
+    if (t < SCD4X_ADAPTIVE_BENCH_EVENT_S)
+    {
+        return SCD4X_ADAPTIVE_BENCH_BASE_PPM + SCD4X_ADAPTIVE_BENCH_RISE_PPM * t / SCD4X_ADAPTIVE_BENCH_EVENT_S;
+    }
+    t -= SCD4X_ADAPTIVE_BENCH_EVENT_S;
+    
+    return SCD4X_ADAPTIVE_BENCH_BASE_PPM + SCD4X_ADAPTIVE_BENCH_RISE_PPM * exp(-t / SCD4X_ADAPTIVE_BENCH_DECAY_S);
+}
+
+/**
+ * @brief     get a uniform noise sample
+ * @param[in] noise noise amplitude in ppm
+ * @return    noise in ppm
+ * @note      none
+ */
+static int32_t a_adaptive_bench_noise(uint32_t noise)
+{
+    gs_seed = gs_seed * 1103515245U + 12345U;
+    
+    return (int32_t)((gs_seed >> 16) % (2 * noise + 1)) - (int32_t)noise;
+}
+
+/**
+ * @brief     get the average current of the simulated sensor
+ * @param[in] *model pointer to an energy model structure
+ * @param[in] *state_us pointer to the time in each state
+ * @param[in] run_us run time
+ * @return    average current in ua
+ * @note      none
+ */
+static double a_adaptive_bench_current(const scd4x_energy_model_t *model, const uint64_t *state_us, uint64_t run_us)
+{
+    const uint32_t na[SCD4X_SIM_STATE_MAX] =
+    {
+        model->sleep_na, model->idle_na, model->periodic_na, model->low_power_na, 
+        model->shot_na, model->rht_only_na, model->wake_up_na,
+    };
+    double charge = 0.0;
+    uint8_t i;
+    
+    for (i = 0; i < SCD4X_SIM_STATE_MAX; i++)
+    {
+        charge += (double)state_us[i] * (double)na[i] / 1e3;
+    }
+    
+    return charge / (double)run_us;
+}
+
+/**
+ * @brief      run a mode on the simulated sensor
+ * @param[in]  *model pointer to an energy model structure
+ * @param[in]  mode bench mode
+ * @param[in]  hours simulated hours
+ * @param[in]  shot_ms shot interval of the sparse single shots
+ * @param[in]  noise co2 noise in ppm
+ * @param[out] *result pointer to a result structure
+ * @return     status code
+ *             - 0 success
+ *             - 1 run failed
+ * @note       the fixed modes run the controller with thresholds which never or always switch
+ */
+static uint8_t a_adaptive_bench_run(const scd4x_energy_model_t *model, uint8_t mode, uint32_t hours, uint32_t shot_ms, 
+                                    uint32_t noise, scd4x_adaptive_bench_result_t *result)
+{
+    scd4x_adaptive_param_t param;
+    scd4x_adaptive_t adaptive;
+    scd4x_sample_t sample;
+    uint64_t start_us[SCD4X_SIM_STATE_MAX];
+    uint64_t state_us[SCD4X_SIM_STATE_MAX];
+    uint64_t base_us;
+    uint64_t grid_us;
+    uint64_t end_us;
+    uint32_t wait_us;
+    uint16_t held = 0;
+    double co2;
+    double error;
+    uint8_t event;
+    uint8_t res;
+    uint8_t i;
+    
+    (void)scd4x_adaptive_default_param(&param);
+    if (mode == SCD4X_ADAPTIVE_BENCH_PERIODIC)
+    {
+        param.fast_rate = 0.0f;
+        param.slow_rate = 0.0f;
+        param.fast_std = 0.0f;
+        param.slow_std = 0.0f;
+    }
+    else if (mode == SCD4X_ADAPTIVE_BENCH_LOW_POWER)
+    {
+        param.fast_rate = 1e9f;
+        param.fast_std = 1e9f;
+    }
+    else if (mode == SCD4X_ADAPTIVE_BENCH_ADAPTIVE_SHOT)
+    {
+        param.shot_interval_ms = shot_ms;
+    }
+    else
+    {
+        /* default parameters */
+    }
+    
+    scd4x_sim_init(&gs_sim, SCD41);
+    gs_sim.now_us = SCD4X_ADAPTIVE_BENCH_POWER_UP_US;
+    scd4x_sim_attach(&gs_sim);
+    DRIVER_SCD4X_LINK_INIT(&gs_handle, scd4x_handle_t);
+    DRIVER_SCD4X_LINK_SIM(&gs_handle);
+    if ((scd4x_set_type(&gs_handle, SCD41) != 0) || (scd4x_init(&gs_handle) != 0))
+    {
+        return 1;
+    }
+    if (scd4x_adaptive_init(&gs_handle, &adaptive, &param) != 0)
+    {
+        return 1;
+    }
+    base_us = gs_sim.now_us;
+    scd4x_sim_account(&gs_sim);
+    for (i = 0; i < SCD4X_SIM_STATE_MAX; i++)
+    {
+        start_us[i] = gs_sim.state_us[i];
+    }
+    gs_seed = 1;
+    grid_us = base_us;
+    end_us = base_us + (uint64_t)hours * 3600000000ULL;
+    while (gs_sim.now_us < end_us)
+    {
+        /* update the room and the error each second */
+        while ((grid_us <= gs_sim.now_us) && (grid_us < end_us))
+        {
+            co2 = a_adaptive_bench_co2(result->seconds, &event);
+            scd4x_sim_set_sample(&gs_sim, (uint16_t)((int32_t)co2 + a_adaptive_bench_noise(noise)), 26214, 32768);
+            if (held != 0)
+            {
+                error = fabs(co2 - held);
+                result->error += error;
+                result->event_error += (event != 0) ? error : 0.0;
+                result->max_error = (error > result->max_error) ? error : result->max_error;
+            }
+            result->event_seconds += event;
+            result->fast_s += (adaptive.mode == SCD4X_ADAPTIVE_FAST) ? 1 : 0;
+            result->seconds++;
+            grid_us += 1000000;
+        }
+        
+        res = scd4x_adaptive_poll(&gs_handle, &adaptive, &sample, &wait_us);
+        if (res == 0)
+        {
+            held = sample.co2_ppm;
+            result->samples++;
+        }
+        else if (res == 6)
+        {
+            gs_sim.now_us += (wait_us == 0) ? 1 : wait_us;
+        }
+        else
+        {
+            return 1;
+        }
+    }
+    if (scd4x_stop_periodic_measurement(&gs_handle) != 0)
+    {
+        return 1;
+    }
+    gs_sim.now_us = end_us;
+    scd4x_sim_account(&gs_sim);
+    for (i = 0; i < SCD4X_SIM_STATE_MAX; i++)
+    {
+        state_us[i] = gs_sim.state_us[i] - start_us[i];
+    }
+    (void)scd4x_deinit(&gs_handle);
+    result->switches = adaptive.switches;
+    result->average_ua = a_adaptive_bench_current(model, state_us, end_us - base_us);
+    
+    return 0;
+}
+
+/**
+ * @brief     adaptive bench main function
+ * @param[in] argc arg numbers
+ * @param[in] **argv arg address
+ * @return    status code
+ *            - 0 success
+ *            - 1 run failed or the adaptive controller doesn't pay off
+ * @note      each mode prints one csv line with the samples, the mode switches, the time in the fast mode,
+ *            the average current from the state times of the simulated sensor and the mean absolute error
+ *            of the latest sample against the room co2, over the run and during the events,
+ *            the adaptive controller must take less current than the periodic measurement, follow the events
+ *            better than the low power periodic measurement and switch at most twice per event
+ */
+int main(int argc, char **argv)
+{
+    int c;
+    int longindex = 0;
+    const char short_options[] = "h";
+    const struct option long_options[] =
+    {
+        {"help", no_argument, NULL, 'h'},
+        {"hours", required_argument, NULL, 1},
+        {"noise", required_argument, NULL, 2},
+        {"shot", required_argument, NULL, 3},
+        {NULL, 0, NULL, 0},
+    };
+    scd4x_energy_model_t model;
+    scd4x_adaptive_bench_result_t result[SCD4X_ADAPTIVE_BENCH_MAX];
+    uint32_t hours = SCD4X_ADAPTIVE_BENCH_HOURS;
+    uint32_t shot_ms = SCD4X_ADAPTIVE_BENCH_SHOT_MS;
+    uint32_t noise = SCD4X_ADAPTIVE_BENCH_NOISE;
+    uint32_t events;
+    uint8_t failed = 0;
+    uint8_t i;
+    
+    optind = 0;
+    do
+    {
+        c = getopt_long(argc, argv, short_options, long_options, &longindex);
+        switch (c)
+        {
+            case 'h' :
+            {
+                printf("Usage:\n");
+                printf("  scd4x_adaptive_bench [--hours=<num>] [--shot=<ms>] [--noise=<ppm>]\n");
+                printf("\n");
+                printf("Options:\n");
+                printf("  -h, --help           Show the help.\n");
+                printf("      --hours=<num>    Set the simulated hours of each run.([default: %d])\n", SCD4X_ADAPTIVE_BENCH_HOURS);
+                printf("      --noise=<ppm>    Set the co2 noise amplitude.([default: %d])\n", SCD4X_ADAPTIVE_BENCH_NOISE);
+                printf("      --shot=<ms>      Set the shot interval of the sparse single shots.([default: %d])\n", SCD4X_ADAPTIVE_BENCH_SHOT_MS);
+                
+                return 0;
+            }
+            case 1 :
+            {
+                hours = (uint32_t)atol(optarg);
+                
+                break;
+            }
+            case 2 :
+            {
+                noise = (uint32_t)atol(optarg);
+                
+                break;
+            }
+            case 3 :
+            {
+                shot_ms = (uint32_t)atol(optarg);
+                
+                break;
+            }
+            case -1 :
+            {
+                break;
+            }
+            default :
+            {
+                return 1;
+            }
+        }
+    } while (c != -1);
+    if ((hours == 0) || (hours > 24 * 365) || (shot_ms < 5000) || (noise > 200))
+    {
+        return 1;
+    }
+    
+    (void)scd4x_energy_default_model(&model);
+    printf("mode,samples,switches,fast_pct,average_ua,error_ppm,event_error_ppm,max_error_ppm\n");
+    for (i = 0; i < SCD4X_ADAPTIVE_BENCH_MAX; i++)
+    {
+        result[i] = (scd4x_adaptive_bench_result_t){0};
+        if (a_adaptive_bench_run(&model, i, hours, shot_ms, noise, &result[i]) != 0)
+        {
+            fprintf(stderr, "scd4x_adaptive_bench: %s run failed.\n", gs_mode[i]);
+            
+            return 1;
+        }
+        printf("%s,%u,%u,%.1f,%.1f,%.1f,%.1f,%.1f\n", gs_mode[i], result[i].samples, result[i].switches, 
+               (double)result[i].fast_s * 100.0 / result[i].seconds, result[i].average_ua, 
+               result[i].error / result[i].seconds, 
+               (result[i].event_seconds != 0) ? result[i].event_error / result[i].event_seconds : 0.0, result[i].max_error);
+    }
+    
+    /* check the adaptive runs against the fixed modes */
+    events = (hours * 3600 + SCD4X_ADAPTIVE_BENCH_CYCLE_S - SCD4X_ADAPTIVE_BENCH_EVENT_S - 1) / SCD4X_ADAPTIVE_BENCH_CYCLE_S;
+    for (i = SCD4X_ADAPTIVE_BENCH_ADAPTIVE; i < SCD4X_ADAPTIVE_BENCH_MAX; i++)
+    {
+        if ((result[i].average_ua >= result[SCD4X_ADAPTIVE_BENCH_PERIODIC].average_ua) ||
+            (result[i].event_error * result[SCD4X_ADAPTIVE_BENCH_LOW_POWER].event_seconds >= 
+             result[SCD4X_ADAPTIVE_BENCH_LOW_POWER].event_error * result[i].event_seconds) ||
+            (result[i].switches > 2 * events))
+        {
+            fprintf(stderr, "scd4x_adaptive_bench: %s doesn't pay off.\n", gs_mode[i]);
+            failed = 1;
+        }
+    }
+    
+    return failed;
+}
@@ -0,0 +1,581 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      bench.c
+ * @brief     bench source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "driver_scd4x.h"
+#include "driver_scd4x_sim.h"
+#include <getopt.h>
+#include <linux/perf_event.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <time.h>
+#include <unistd.h>
+
+/**
+ * @brief bench definition
+ */
+#define SCD4X_BENCH_RUNS         5             /**< runs of each bench, the best one is reported */
+#define SCD4X_BENCH_TIMES        100000        /**< default iterations of each run */
+
+/**
+ * @brief bench structure definition
+ */
+typedef struct scd4x_bench_s
+{
+    const char *name;                /**< bench name */
+    uint8_t periodic;                /**< 1 if the sensor must be in periodic measurement */
+    void (*run)(uint32_t times);     /**< bench function */
+} scd4x_bench_t;
+
+static scd4x_handle_t gs_handle;        /**< scd4x handle */
+static scd4x_sim_t gs_sim;              /**< simulated sensor */
+static volatile uint32_t gs_sink;       /**< keep the results alive */
+
+/**
+ * @brief     bench scd4x_read
+ * @param[in] times iterations
+ * @note      none
+ */
+static void a_bench_read(uint32_t times)
+{
+    uint16_t co2_raw;
+    uint16_t co2_ppm = 0;
+    uint16_t temperature_raw;
+    uint16_t humidity_raw;
+    float temperature_s = 0.0f;
+    float humidity_s = 0.0f;
+    uint32_t i;
+    
+    for (i = 0; i < times; i++)
+    {
+        gs_sink += scd4x_read(&gs_handle, &co2_raw, &co2_ppm, &temperature_raw, &temperature_s, &humidity_raw, &humidity_s);
+        gs_sink += co2_ppm + (uint32_t)temperature_s + (uint32_t)humidity_s;
+    }
+}
+
+/**
+ * @brief     bench scd4x_read_sample
+ * @param[in] times iterations
+ * @note      none
+ */
+static void a_bench_read_sample(uint32_t times)
+{
+    scd4x_sample_t sample = {0};
+    uint32_t i;
+    
+    for (i = 0; i < times; i++)
+    {
+        gs_sink += scd4x_read_sample(&gs_handle, &sample);
+        gs_sink += sample.co2_raw;
+    }
+}
+
+/**
+ * @brief     bench a_scd4x_generate_crc
+ * @param[in] times iterations
+ * @note      none
+ */
+static void a_bench_generate_crc(uint32_t times)
+{
+    uint8_t buf[2];
+    uint32_t i;
+    
+    for (i = 0; i < times; i++)
+    {
+        buf[0] = (uint8_t)(i >> 8);
+        buf[1] = (uint8_t)i;
+        gs_sink += scd4x_bench_generate_crc(buf, 2);
+    }
+}
+
+/**
+ * @brief     bench scd4x_temperature_offset_convert_to_register
+ * @param[in] times iterations
+ * @note      none
+ */
+static void a_bench_temperature_offset_to_register(uint32_t times)
+{
+    uint16_t reg = 0;
+    uint32_t i;
+    
+    for (i = 0; i < times; i++)
+    {
+        gs_sink += scd4x_temperature_offset_convert_to_register(&gs_handle, (float)(i & 0x1F), &reg);
+        gs_sink += reg;
+    }
+}
+
+/**
+ * @brief     bench scd4x_temperature_offset_convert_to_data
+ * @param[in] times iterations
+ * @note      none
+ */
+static void a_bench_temperature_offset_to_data(uint32_t times)
+{
+    float degrees = 0.0f;
+    uint32_t i;
+    
+    for (i = 0; i < times; i++)
+    {
+        gs_sink += scd4x_temperature_offset_convert_to_data(&gs_handle, (uint16_t)i, &degrees);
+        gs_sink += (uint32_t)degrees;
+    }
+}
+
+/**
+ * @brief     bench scd4x_sensor_altitude_convert_to_register
+ * @param[in] times iterations
+ * @note      none
+ */
+static void a_bench_sensor_altitude_to_register(uint32_t times)
+{
+    uint16_t reg = 0;
+    uint32_t i;
+    
+    for (i = 0; i < times; i++)
+    {
+        gs_sink += scd4x_sensor_altitude_convert_to_register(&gs_handle, (float)(i & 0xFFF), &reg);
+        gs_sink += reg;
+    }
+}
+
+/**
+ * @brief     bench scd4x_sensor_altitude_convert_to_data
+ * @param[in] times iterations
+ * @note      none
+ */
+static void a_bench_sensor_altitude_to_data(uint32_t times)
+{
+    float m = 0.0f;
+    uint32_t i;
+    
+    for (i = 0; i < times; i++)
+    {
+        gs_sink += scd4x_sensor_altitude_convert_to_data(&gs_handle, (uint16_t)i, &m);
+        gs_sink += (uint32_t)m;
+    }
+}
+
+/**
+ * @brief     bench scd4x_ambient_pressure_convert_to_register
+ * @param[in] times iterations
+ * @note      none
+ */
+static void a_bench_ambient_pressure_to_register(uint32_t times)
+{
+    uint16_t reg = 0;
+    uint32_t i;
+    
+    for (i = 0; i < times; i++)
+    {
+        gs_sink += scd4x_ambient_pressure_convert_to_register(&gs_handle, (float)(70000 + (i & 0x7FFF)), &reg);
+        gs_sink += reg;
+    }
+}
+
+/**
+ * @brief     bench scd4x_ambient_pressure_convert_to_data
+ * @param[in] times iterations
+ * @note      none
+ */
+static void a_bench_ambient_pressure_to_data(uint32_t times)
+{
+    float pa = 0.0f;
+    uint32_t i;
+    
+    for (i = 0; i < times; i++)
+    {
+        gs_sink += scd4x_ambient_pressure_convert_to_data(&gs_handle, (uint16_t)i, &pa);
+        gs_sink += (uint32_t)pa;
+    }
+}
+
+/**
+ * @brief     bench scd4x_co2_convert_to_register
+ * @param[in] times iterations
+ * @note      none
+ */
+static void a_bench_co2_to_register(uint32_t times)
+{
+    uint16_t reg = 0;
+    uint32_t i;
+    
+    for (i = 0; i < times; i++)
+    {
+        gs_sink += scd4x_co2_convert_to_register(&gs_handle, (float)(i & 0x1FFF), &reg);
+        gs_sink += reg;
+    }
+}
+
+/**
+ * @brief     bench scd4x_co2_convert_to_data
+ * @param[in] times iterations
+ * @note      none
+ */
+static void a_bench_co2_to_data(uint32_t times)
+{
+    float ppm = 0.0f;
+    uint32_t i;
+    
+    for (i = 0; i < times; i++)
+    {
+        gs_sink += scd4x_co2_convert_to_data(&gs_handle, (uint16_t)i, &ppm);
+        gs_sink += (uint32_t)ppm;
+    }
+}
+
+/**
+ * @brief     bench scd4x_set_temperature_offset
+ * @param[in] times iterations
+ * @note      none
+ */
+static void a_bench_set_temperature_offset(uint32_t times)
+{
+    uint32_t i;
+    
+    for (i = 0; i < times; i++)
+    {
+        gs_sink += scd4x_set_temperature_offset(&gs_handle, (uint16_t)i);
+    }
+}
+
+/**
+ * @brief     bench scd4x_set_sensor_altitude
+ * @param[in] times iterations
+ * @note      none
+ */
+static void a_bench_set_sensor_altitude(uint32_t times)
+{
+    uint32_t i;
+    
+    for (i = 0; i < times; i++)
+    {
+        gs_sink += scd4x_set_sensor_altitude(&gs_handle, (uint16_t)i);
+    }
+}
+
+/**
+ * @brief     bench scd4x_set_ambient_pressure
+ * @param[in] times iterations
+ * @note      none
+ */
+static void a_bench_set_ambient_pressure(uint32_t times)
+{
+    uint32_t i;
+    
+    for (i = 0; i < times; i++)
+    {
+        gs_sink += scd4x_set_ambient_pressure(&gs_handle, (uint16_t)i);
+    }
+}
+
+/**
+ * @brief     bench scd4x_set_automatic_self_calibration
+ * @param[in] times iterations
+ * @note      none
+ */
+static void a_bench_set_automatic_self_calibration(uint32_t times)
+{
+    uint32_t i;
+    
+    for (i = 0; i < times; i++)
+    {
+        gs_sink += scd4x_set_automatic_self_calibration(&gs_handle, (scd4x_bool_t)(i & 1));
+    }
+}
+
+/**
+ * @brief     bench scd4x_set_automatic_self_calibration_initial_period
+ * @param[in] times iterations
+ * @note      none
+ */
+static void a_bench_set_automatic_self_calibration_initial_period(uint32_t times)
+{
+    uint32_t i;
+    
+    for (i = 0; i < times; i++)
+    {
+        gs_sink += scd4x_set_automatic_self_calibration_initial_period(&gs_handle, (uint16_t)((i & 0xFF) * 4));
+    }
+}
+
+/**
+ * @brief     bench scd4x_set_automatic_self_calibration_standard_period
+ * @param[in] times iterations
+ * @note      none
+ */
+static void a_bench_set_automatic_self_calibration_standard_period(uint32_t times)
+{
+    uint32_t i;
+    
+    for (i = 0; i < times; i++)
+    {
+        gs_sink += scd4x_set_automatic_self_calibration_standard_period(&gs_handle, (uint16_t)((i & 0xFF) * 4));
+    }
+}
+
+/**
+ * @brief bench list
+ */
+static const scd4x_bench_t gs_bench[] =
+{
+    {"scd4x_read",                                               1, a_bench_read},
+    {"scd4x_read_sample",                                        1, a_bench_read_sample},
+    {"a_scd4x_generate_crc",                                     0, a_bench_generate_crc},
+    {"scd4x_temperature_offset_convert_to_register",             0, a_bench_temperature_offset_to_register},
+    {"scd4x_temperature_offset_convert_to_data",                 0, a_bench_temperature_offset_to_data},
+    {"scd4x_sensor_altitude_convert_to_register",                0, a_bench_sensor_altitude_to_register},
+    {"scd4x_sensor_altitude_convert_to_data",                    0, a_bench_sensor_altitude_to_data},
+    {"scd4x_ambient_pressure_convert_to_register",               0, a_bench_ambient_pressure_to_register},
+    {"scd4x_ambient_pressure_convert_to_data",                   0, a_bench_ambient_pressure_to_data},
+    {"scd4x_co2_convert_to_register",                            0, a_bench_co2_to_register},
+    {"scd4x_co2_convert_to_data",                                0, a_bench_co2_to_data},
+    {"scd4x_set_temperature_offset",                             0, a_bench_set_temperature_offset},
+    {"scd4x_set_sensor_altitude",                                0, a_bench_set_sensor_altitude},
+    {"scd4x_set_ambient_pressure",                               0, a_bench_set_ambient_pressure},
+    {"scd4x_set_automatic_self_calibration",                     0, a_bench_set_automatic_self_calibration},
+    {"scd4x_set_automatic_self_calibration_initial_period",      0, a_bench_set_automatic_self_calibration_initial_period},
+    {"scd4x_set_automatic_self_calibration_standard_period",     0, a_bench_set_automatic_self_calibration_standard_period},
+};
+
+/**
+ * @brief  open the instruction counter
+ * @return file descriptor or -1 if the counter is not available
+ * @note   none
+ */
+static int a_bench_counter_open(void)
+{
+    struct perf_event_attr attr;
+    
+    memset(&attr, 0, sizeof(attr));
+    attr.type = PERF_TYPE_HARDWARE;
+    attr.size = sizeof(attr);
+    attr.config = PERF_COUNT_HW_INSTRUCTIONS;
+    attr.disabled = 1;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    
+    return (int)syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0);
+}
+
+/**
+ * @brief  get the monotonic time
+ * @return time in ns
+ * @note   none
+ */
+static uint64_t a_bench_now_ns(void)
+{
+    struct timespec ts;
+    
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+/**
+ * @brief     reset the simulated sensor and the handle
+ * @param[in] periodic 1 if the sensor must be in periodic measurement
+ * @return    status code
+ *            - 0 success
+ *            - 1 setup failed
+ * @note      the sim answers instantly and always has data ready
+ */
+static uint8_t a_bench_setup(uint8_t periodic)
+{
+    scd4x_sim_init(&gs_sim, SCD41);
+    gs_sim.instant = 1;
+    scd4x_sim_attach(&gs_sim);
+    
+    DRIVER_SCD4X_LINK_INIT(&gs_handle, scd4x_handle_t);
+    DRIVER_SCD4X_LINK_SIM(&gs_handle);
+    if (scd4x_set_type(&gs_handle, SCD41) != 0)
+    {
+        return 1;
+    }
+    if (scd4x_init(&gs_handle) != 0)
+    {
+        return 1;
+    }
+    if (periodic != 0)
+    {
+        if (scd4x_start_periodic_measurement(&gs_handle) != 0)
+        {
+            return 1;
+        }
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief     bench main function
+ * @param[in] argc arg numbers
+ * @param[in] **argv arg address
+ * @return    status code
+ *            - 0 success
+ *            - 1 run failed
+ * @note      the results are printed as csv, instructions_per_op is empty if the counter is not available
+ */
+int main(int argc, char **argv)
+{
+    int c;
+    int longindex = 0;
+    int fd;
+    const char short_options[] = "h";
+    const struct option long_options[] =
+    {
+        {"help", no_argument, NULL, 'h'},
+        {"times", required_argument, NULL, 1},
+        {"filter", required_argument, NULL, 2},
+        {NULL, 0, NULL, 0},
+    };
+    const char *filter = NULL;
+    uint32_t times = SCD4X_BENCH_TIMES;
+    size_t i;
+    uint32_t run;
+    
+    optind = 0;
+    do
+    {
+        c = getopt_long(argc, argv, short_options, long_options, &longindex);
+        switch (c)
+        {
+            case 'h' :
+            {
+                printf("Usage:\n");
+                printf("  scd4x_bench [--times=<num>] [--filter=<name>]\n");
+                printf("\n");
+                printf("Options:\n");
+                printf("      --filter=<name>    Only run the benches whose name contains <name>.\n");
+                printf("  -h, --help             Show the help.\n");
+                printf("      --times=<num>      Set the iterations of each run.([default: %d])\n", SCD4X_BENCH_TIMES);
+                
+                return 0;
+            }
+            case 1 :
+            {
+                times = (uint32_t)atol(optarg);
+                
+                break;
+            }
+            case 2 :
+            {
+                filter = optarg;
+                
+                break;
+            }
+            case -1 :
+            {
+                break;
+            }
+            default :
+            {
+                return 1;
+            }
+        }
+    } while (c != -1);
+    if (times == 0)
+    {
+        return 1;
+    }
+    
+    fd = a_bench_counter_open();
+    printf("name,iterations,ns_per_op,instructions_per_op\n");
+    for (i = 0; i < sizeof(gs_bench) / sizeof(gs_bench[0]); i++)
+    {
+        uint64_t best_ns = UINT64_MAX;
+        uint64_t best_inst = UINT64_MAX;
+        
+        if ((filter != NULL) && (strstr(gs_bench[i].name, filter) == NULL))
+        {
+            continue;
+        }
+        if (a_bench_setup(gs_bench[i].periodic) != 0)
+        {
+            fprintf(stderr, "scd4x_bench: %s setup failed.\n", gs_bench[i].name);
+            
+            return 1;
+        }
+        gs_bench[i].run(times / 10 + 1);
+        for (run = 0; run < SCD4X_BENCH_RUNS; run++)
+        {
+            uint64_t start;
+            uint64_t ns;
+            uint64_t inst = 0;
+            
+            if (fd >= 0)
+            {
+                ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+                ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+            }
+            start = a_bench_now_ns();
+            gs_bench[i].run(times);
+            ns = a_bench_now_ns() - start;
+            if (fd >= 0)
+            {
+                ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+                if (read(fd, &inst, sizeof(inst)) != (ssize_t)sizeof(inst))
+                {
+                    inst = UINT64_MAX;
+                }
+            }
+            best_ns = (ns < best_ns) ? ns : best_ns;
+            best_inst = (inst < best_inst) ? inst : best_inst;
+        }
+        if (gs_sim.naks != 0)
+        {
+            fprintf(stderr, "scd4x_bench: %s got %u naks.\n", gs_bench[i].name, gs_sim.naks);
+            
+            return 1;
+        }
+        if ((fd >= 0) && (best_inst != UINT64_MAX))
+        {
+            printf("%s,%u,%.2f,%.1f\n", gs_bench[i].name, times, 
+                   (double)best_ns / times, (double)best_inst / times);
+        }
+        else
+        {
+            printf("%s,%u,%.2f,\n", gs_bench[i].name, times, (double)best_ns / times);
+        }
+    }
+    if (fd >= 0)
+    {
+        close(fd);
+    }
+    
+    return 0;
+}
@@ -0,0 +1,420 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      bus_bench.c
+ * @brief     bus bench source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "driver_scd4x_sim_bus.h"
+#include <getopt.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+/**
+ * @brief bus bench definition
+ */
+#define SCD4X_BUS_BENCH_SECONDS        300        /**< default simulated time of each strategy */
+#define SCD4X_BUS_BENCH_SENSORS        8          /**< sensors behind the mux */
+#define SCD4X_BUS_BENCH_PERIOD_MS      5000       /**< periodic measurement interval */
+#define SCD4X_BUS_BENCH_POLL_MS        100        /**< mux polling interval */
+
+/**
+ * @brief bus bench structure definition
+ */
+typedef struct scd4x_bus_bench_s
+{
+    const char *name;                      /**< strategy name */
+    uint8_t sensors;                       /**< sensor number */
+    uint8_t periodic;                      /**< 1 if the sensors run periodic measurement */
+    uint32_t (*run)(uint64_t end_us);      /**< strategy function, return the sample number */
+} scd4x_bus_bench_t;
+
+static scd4x_sim_t gs_sim[SCD4X_SIM_BUS_MAX_CHANNEL];                /**< simulated sensors */
+static scd4x_handle_t gs_handle[SCD4X_SIM_BUS_MAX_CHANNEL];          /**< scd4x handles */
+static scd4x_sim_bus_t gs_bus;                                       /**< simulated bus */
+static uint8_t gs_sensors;                                           /**< sensor number */
+
+/**
+ * @brief     read one sample
+ * @param[in] index sensor index
+ * @return    status code
+ *            - 0 success
+ *            - 1 read failed
+ * @note      none
+ */
+static uint8_t a_bus_bench_read(uint8_t index)
+{
+    scd4x_sample_t sample;
+    
+    scd4x_sim_bus_select(&gs_bus, index);
+    
+    return (scd4x_read_sample(&gs_handle[index], &sample) == 0) ? 0 : 1;
+}
+
+/**
+ * @brief     wait until a time
+ * @param[in] us virtual time
+ * @note      none
+ */
+static void a_bus_bench_sleep_until(uint64_t us)
+{
+    uint64_t now = scd4x_sim_bus_get_time_us();
+    
+    if (us > now)
+    {
+        scd4x_sim_bus_delay_ms((uint32_t)((us - now + 999) / 1000));
+    }
+}
+
+/**
+ * @brief     poll the data ready status with the driver backoff, then read
+ * @param[in] end_us end time
+ * @return    sample number
+ * @note      none
+ */
+static uint32_t a_bus_bench_poll(uint64_t end_us)
+{
+    uint32_t samples = 0;
+    
+    while (scd4x_sim_bus_get_time_us() < end_us)
+    {
+        if (scd4x_wait_data_ready(&gs_handle[0], 10000) != 0)
+        {
+            continue;
+        }
+        samples += (a_bus_bench_read(0) == 0) ? 1 : 0;
+    }
+    
+    return samples;
+}
+
+/**
+ * @brief     sleep to the next sample time, then read without polling
+ * @param[in] end_us end time
+ * @return    sample number
+ * @note      the first sample is found by polling to learn the sensor phase
+ */
+static uint32_t a_bus_bench_schedule(uint64_t end_us)
+{
+    uint32_t samples = 0;
+    uint64_t next_us;
+    uint8_t i;
+    
+    for (i = 0; i < gs_sensors; i++)
+    {
+        scd4x_sim_bus_select(&gs_bus, i);
+        (void)scd4x_wait_data_ready(&gs_handle[i], 10000);
+    }
+    next_us = scd4x_sim_bus_get_time_us();
+    while (next_us < end_us)
+    {
+        a_bus_bench_sleep_until(next_us);
+        for (i = 0; i < gs_sensors; i++)
+        {
+            samples += (a_bus_bench_read(i) == 0) ? 1 : 0;
+        }
+        next_us += (uint64_t)SCD4X_BUS_BENCH_PERIOD_MS * 1000;
+    }
+    
+    return samples;
+}
+
+/**
+ * @brief     check the data ready status of all sensors at a fixed interval
+ * @param[in] end_us end time
+ * @return    sample number
+ * @note      none
+ */
+static uint32_t a_bus_bench_mux_poll(uint64_t end_us)
+{
+    uint32_t samples = 0;
+    uint64_t next_us;
+    scd4x_bool_t ready;
+    uint8_t i;
+    
+    next_us = scd4x_sim_bus_get_time_us();
+    while (next_us < end_us)
+    {
+        a_bus_bench_sleep_until(next_us);
+        for (i = 0; i < gs_sensors; i++)
+        {
+            scd4x_sim_bus_select(&gs_bus, i);
+            if ((scd4x_get_data_ready_status(&gs_handle[i], &ready) == 0) && (ready == SCD4X_BOOL_TRUE))
+            {
+                samples += (a_bus_bench_read(i) == 0) ? 1 : 0;
+            }
+        }
+        next_us += (uint64_t)SCD4X_BUS_BENCH_POLL_MS * 1000;
+    }
+    
+    return samples;
+}
+
+/**
+ * @brief     run a single shot on each sensor one after another
+ * @param[in] end_us end time
+ * @return    sample number
+ * @note      none
+ */
+static uint32_t a_bus_bench_shot_sequential(uint64_t end_us)
+{
+    uint32_t samples = 0;
+    uint8_t i;
+    
+    while (scd4x_sim_bus_get_time_us() < end_us)
+    {
+        for (i = 0; i < gs_sensors; i++)
+        {
+            scd4x_sim_bus_select(&gs_bus, i);
+            if (scd4x_measure_single_shot(&gs_handle[i]) != 0)
+            {
+                continue;
+            }
+            samples += (a_bus_bench_read(i) == 0) ? 1 : 0;
+        }
+    }
+    
+    return samples;
+}
+
+/**
+ * @brief     start a single shot on all sensors, then read all of them
+ * @param[in] end_us end time
+ * @return    sample number
+ * @note      the driver waits only the rest execution time of each handle
+ */
+static uint32_t a_bus_bench_shot_pipelined(uint64_t end_us)
+{
+    uint32_t samples = 0;
+    uint8_t i;
+    
+    while (scd4x_sim_bus_get_time_us() < end_us)
+    {
+        for (i = 0; i < gs_sensors; i++)
+        {
+            scd4x_sim_bus_select(&gs_bus, i);
+            (void)scd4x_measure_single_shot(&gs_handle[i]);
+        }
+        for (i = 0; i < gs_sensors; i++)
+        {
+            samples += (a_bus_bench_read(i) == 0) ? 1 : 0;
+        }
+    }
+    
+    return samples;
+}
+
+/**
+ * @brief strategy list
+ */
+static const scd4x_bus_bench_t gs_bench[] =
+{
+    {"poll",               1,                          1, a_bus_bench_poll},
+    {"schedule",           1,                          1, a_bus_bench_schedule},
+    {"mux_poll",           SCD4X_BUS_BENCH_SENSORS,    1, a_bus_bench_mux_poll},
+    {"mux_schedule",       SCD4X_BUS_BENCH_SENSORS,    1, a_bus_bench_schedule},
+    {"shot_sequential",    SCD4X_BUS_BENCH_SENSORS,    0, a_bus_bench_shot_sequential},
+    {"shot_pipelined",     SCD4X_BUS_BENCH_SENSORS,    0, a_bus_bench_shot_pipelined},
+};
+
+/**
+ * @brief     set up the sensors, the bus and the handles
+ * @param[in] freq_hz scl frequency
+ * @param[in] sensors sensor number
+ * @param[in] periodic 1 if the sensors run periodic measurement
+ * @param[in] stretch_ns clock stretching of each transfer
+ * @return    status code
+ *            - 0 success
+ *            - 1 setup failed
+ * @note      none
+ */
+static uint8_t a_bus_bench_setup(uint32_t freq_hz, uint8_t sensors, uint8_t periodic, uint32_t stretch_ns)
+{
+    scd4x_sim_t *list[SCD4X_SIM_BUS_MAX_CHANNEL];
+    uint8_t i;
+    
+    for (i = 0; i < sensors; i++)
+    {
+        scd4x_sim_init(&gs_sim[i], SCD41);
+        gs_sim[i].now_us = 30000;
+        list[i] = &gs_sim[i];
+    }
+    if (scd4x_sim_bus_init(&gs_bus, freq_hz, list, sensors) != 0)
+    {
+        return 1;
+    }
+    gs_bus.stretch_ns = stretch_ns;
+    scd4x_sim_bus_attach(&gs_bus);
+    gs_sensors = sensors;
+    
+    for (i = 0; i < sensors; i++)
+    {
+        DRIVER_SCD4X_LINK_INIT(&gs_handle[i], scd4x_handle_t);
+        DRIVER_SCD4X_LINK_SIM_BUS(&gs_handle[i]);
+        if (scd4x_set_type(&gs_handle[i], SCD41) != 0)
+        {
+            return 1;
+        }
+        if (scd4x_init(&gs_handle[i]) != 0)
+        {
+            return 1;
+        }
+        if (periodic != 0)
+        {
+            scd4x_sim_bus_select(&gs_bus, i);
+            if (scd4x_start_periodic_measurement(&gs_handle[i]) != 0)
+            {
+                return 1;
+            }
+        }
+    }
+    
+    /* count the measurement only */
+    gs_bus.busy_ns = 0;
+    gs_bus.transfers = 0;
+    gs_bus.bytes = 0;
+    gs_bus.naks = 0;
+    gs_bus.switches = 0;
+    
+    return 0;
+}
+
+/**
+ * @brief     bus bench main function
+ * @param[in] argc arg numbers
+ * @param[in] **argv arg address
+ * @return    status code
+ *            - 0 success
+ *            - 1 run failed
+ * @note      the results are printed as csv, sensors_fit is the sensor number the bus carries at the same per sensor rate
+ */
+int main(int argc, char **argv)
+{
+    int c;
+    int longindex = 0;
+    const char short_options[] = "h";
+    const struct option long_options[] =
+    {
+        {"help", no_argument, NULL, 'h'},
+        {"seconds", required_argument, NULL, 1},
+        {"stretch", required_argument, NULL, 2},
+        {NULL, 0, NULL, 0},
+    };
+    const uint32_t freq[] = {100000, 400000, 1000000};
+    uint32_t seconds = SCD4X_BUS_BENCH_SECONDS;
+    uint32_t stretch_ns = 0;
+    size_t i;
+    size_t j;
+    
+    optind = 0;
+    do
+    {
+        c = getopt_long(argc, argv, short_options, long_options, &longindex);
+        switch (c)
+        {
+            case 'h' :
+            {
+                printf("Usage:\n");
+                printf("  scd4x_bus_bench [--seconds=<num>] [--stretch=<ns>]\n");
+                printf("\n");
+                printf("Options:\n");
+                printf("  -h, --help             Show the help.\n");
+                printf("      --seconds=<num>    Set the simulated time of each strategy.([default: %d])\n", SCD4X_BUS_BENCH_SECONDS);
+                printf("      --stretch=<ns>     Set the clock stretching of each transfer.([default: 0])\n");
+                
+                return 0;
+            }
+            case 1 :
+            {
+                seconds = (uint32_t)atol(optarg);
+                
+                break;
+            }
+            case 2 :
+            {
+                stretch_ns = (uint32_t)atol(optarg);
+                
+                break;
+            }
+            case -1 :
+            {
+                break;
+            }
+            default :
+            {
+                return 1;
+            }
+        }
+    } while (c != -1);
+    if (seconds == 0)
+    {
+        return 1;
+    }
+    
+    printf("strategy,freq_hz,sensors,samples,seconds,transfers,bytes,mux_switches,naks,bus_busy_us,utilization_pct,bus_us_per_sample,sensors_fit\n");
+    for (i = 0; i < sizeof(freq) / sizeof(freq[0]); i++)
+    {
+        for (j = 0; j < sizeof(gs_bench) / sizeof(gs_bench[0]); j++)
+        {
+            uint64_t start_ns;
+            uint64_t elapsed_ns;
+            uint32_t samples;
+            double per_sample_us;
+            double interval_us;
+            
+            if (a_bus_bench_setup(freq[i], gs_bench[j].sensors, gs_bench[j].periodic, stretch_ns) != 0)
+            {
+                fprintf(stderr, "scd4x_bus_bench: %s setup failed.\n", gs_bench[j].name);
+                
+                return 1;
+            }
+            start_ns = gs_bus.now_ns;
+            samples = gs_bench[j].run(start_ns / 1000 + (uint64_t)seconds * 1000000);
+            elapsed_ns = gs_bus.now_ns - start_ns;
+            if (samples == 0)
+            {
+                fprintf(stderr, "scd4x_bus_bench: %s got no sample.\n", gs_bench[j].name);
+                
+                return 1;
+            }
+            per_sample_us = (double)gs_bus.busy_ns / 1000.0 / samples;
+            interval_us = (double)elapsed_ns / 1000.0 * gs_bench[j].sensors / samples;
+            printf("%s,%u,%u,%u,%.3f,%u,%u,%u,%u,%.1f,%.4f,%.1f,%u\n", 
+                   gs_bench[j].name, freq[i], gs_bench[j].sensors, samples, 
+                   (double)elapsed_ns / 1e9, gs_bus.transfers, gs_bus.bytes, gs_bus.switches, gs_bus.naks, 
+                   (double)gs_bus.busy_ns / 1000.0, 100.0 * (double)gs_bus.busy_ns / (double)elapsed_ns, 
+                   per_sample_us, (uint32_t)(interval_us / per_sample_us));
+        }
+    }
+    
+    return 0;
+}
@@ -0,0 +1,441 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      coroutine_bench.cpp
+ * @brief     coroutine sensor benchmark source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "driver_scd4x_coroutine.hpp"
+#include "driver_scd4x_sim_bus.h"
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <getopt.h>
+#include <queue>
+#include <vector>
+
+/**
+ * @brief coroutine bench definition
+ */
+#define SCD4X_COROUTINE_BENCH_SECONDS        300        /**< default simulated time */
+#define SCD4X_COROUTINE_BENCH_PERIOD_MS      5000       /**< periodic and single shot interval */
+
+/**
+ * @brief single thread executor on the virtual time of the simulated bus
+ * @note  the bus time jumps to the earliest timer, so the run takes no real time
+ */
+class SimExecutor
+{
+  public:
+    /**
+     * @brief sleep awaiter
+     */
+    struct SleepAwaiter
+    {
+        SimExecutor &executor;        /**< executor */
+        uint64_t deadline;            /**< wake up time in us */
+        
+        bool await_ready() const noexcept
+        {
+            return deadline <= executor.now_us();
+        }
+        
+        void await_suspend(std::coroutine_handle<> h)
+        {
+            executor.m_timers.push(Timer{deadline, executor.m_seq++, h});
+        }
+        
+        void await_resume() const noexcept
+        {
+        }
+    };
+    
+    explicit SimExecutor(scd4x_sim_bus_t &bus) noexcept : m_bus(bus)
+    {
+    }
+    
+    /**
+     * @brief  get the virtual time
+     * @return time in us
+     */
+    uint64_t now_us() const noexcept
+    {
+        return m_bus.now_ns / 1000;
+    }
+    
+    /**
+     * @brief     suspend for a while
+     * @param[in] us sleep time in us
+     * @return    awaiter
+     */
+    SleepAwaiter sleep_for(uint64_t us) noexcept
+    {
+        return SleepAwaiter{*this, now_us() + us};
+    }
+    
+    /**
+     * @brief run until no timer is left
+     */
+    void run()
+    {
+        while (!m_timers.empty())
+        {
+            Timer t = m_timers.top();
+            
+            m_timers.pop();
+            if (t.deadline * 1000 > m_bus.now_ns)
+            {
+                m_bus.now_ns = t.deadline * 1000;
+            }
+            t.h.resume();
+        }
+    }
+    
+  private:
+    /**
+     * @brief timer entry
+     */
+    struct Timer
+    {
+        uint64_t deadline;                 /**< wake up time in us */
+        uint64_t seq;                      /**< insertion order */
+        std::coroutine_handle<> h;         /**< coroutine to resume */
+        
+        bool operator>(const Timer &t) const noexcept
+        {
+            return (deadline != t.deadline) ? (deadline > t.deadline) : (seq > t.seq);
+        }
+    };
+    
+    scd4x_sim_bus_t &m_bus;                                                            /**< simulated bus */
+    uint64_t m_seq = 0;                                                                /**< timer sequence */
+    std::priority_queue<Timer, std::vector<Timer>, std::greater<Timer>> m_timers;      /**< timer min heap */
+};
+
+/**
+ * @brief coroutine bench result structure definition
+ */
+typedef struct scd4x_coroutine_bench_s
+{
+    uint32_t samples;        /**< sample number */
+    uint32_t errors;         /**< failed read number */
+} scd4x_coroutine_bench_t;
+
+static scd4x_sim_t gs_sim[SCD4X_SIM_BUS_MAX_CHANNEL];                       /**< simulated sensors */
+static scd4x_handle_t gs_handle[SCD4X_SIM_BUS_MAX_CHANNEL];                 /**< scd4x handles */
+static scd4x_sim_bus_t gs_bus;                                              /**< simulated bus */
+static scd4x_coroutine_bench_t gs_result[SCD4X_SIM_BUS_MAX_CHANNEL];        /**< result of each sensor */
+static uint32_t gs_delay_ms;                                                /**< time blocked in the driver delay */
+
+/**
+ * @brief     iic write command of one mux channel
+ * @param[in] addr iic device write address
+ * @param[in] *buf pointer to a data buffer
+ * @param[in] len length of the data buffer
+ * @return    status code
+ *            - 0 success
+ *            - 1 not acknowledged
+ * @note      the coroutines interleave, so each transfer selects its channel
+ */
+template <uint8_t Channel>
+static uint8_t a_coroutine_bench_write(uint8_t addr, uint8_t *buf, uint16_t len)
+{
+    scd4x_sim_bus_select(&gs_bus, Channel);
+    
+    return scd4x_sim_bus_iic_write_cmd(addr, buf, len);
+}
+
+/**
+ * @brief      iic read command of one mux channel
+ * @param[in]  addr iic device write address
+ * @param[out] *buf pointer to a data buffer
+ * @param[in]  len length of the data buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 not acknowledged
+ * @note       the coroutines interleave, so each transfer selects its channel
+ */
+template <uint8_t Channel>
+static uint8_t a_coroutine_bench_read(uint8_t addr, uint8_t *buf, uint16_t len)
+{
+    scd4x_sim_bus_select(&gs_bus, Channel);
+    
+    return scd4x_sim_bus_iic_read_cmd(addr, buf, len);
+}
+
+/**
+ * @brief     counted delay, the coroutines must never block in it
+ * @param[in] ms time
+ * @note      none
+ */
+static void a_coroutine_bench_delay_ms(uint32_t ms)
+{
+    gs_delay_ms += ms;
+    scd4x_sim_bus_delay_ms(ms);
+}
+
+/**
+ * @brief iic command list of each channel
+ */
+static uint8_t (*const gs_write[SCD4X_SIM_BUS_MAX_CHANNEL])(uint8_t, uint8_t *, uint16_t) =
+{
+    a_coroutine_bench_write<0>, a_coroutine_bench_write<1>, a_coroutine_bench_write<2>, a_coroutine_bench_write<3>,
+    a_coroutine_bench_write<4>, a_coroutine_bench_write<5>, a_coroutine_bench_write<6>, a_coroutine_bench_write<7>,
+};
+static uint8_t (*const gs_read[SCD4X_SIM_BUS_MAX_CHANNEL])(uint8_t, uint8_t *, uint16_t) =
+{
+    a_coroutine_bench_read<0>, a_coroutine_bench_read<1>, a_coroutine_bench_read<2>, a_coroutine_bench_read<3>,
+    a_coroutine_bench_read<4>, a_coroutine_bench_read<5>, a_coroutine_bench_read<6>, a_coroutine_bench_read<7>,
+};
+
+/**
+ * @brief     read the periodic samples of one sensor until the end time
+ * @param[in] &sensor reference to a coroutine sensor
+ * @param[in] *result pointer to a result structure
+ * @param[in] end_us end time
+ * @return    detached coroutine
+ * @note      none
+ */
+static scd4x::Detached a_coroutine_bench_periodic(scd4x::Sensor<SimExecutor> &sensor, scd4x_coroutine_bench_t *result,
+                                                  SimExecutor &executor, uint64_t end_us)
+{
+    if (co_await sensor.start_periodic() != 0)
+    {
+        result->errors++;
+        
+        co_return;
+    }
+    while (executor.now_us() < end_us)
+    {
+        scd4x::Result<scd4x_sample_t> r = co_await sensor.next_periodic_sample();
+        
+        if (r.res == 0)
+        {
+            result->samples++;
+        }
+        else
+        {
+            result->errors++;
+        }
+    }
+    (void)co_await sensor.stop_periodic();
+}
+
+/**
+ * @brief     measure single shots on one sensor until the end time
+ * @param[in] &sensor reference to a coroutine sensor
+ * @param[in] *result pointer to a result structure
+ * @param[in] end_us end time
+ * @return    detached coroutine
+ * @note      none
+ */
+static scd4x::Detached a_coroutine_bench_shot(scd4x::Sensor<SimExecutor> &sensor, scd4x_coroutine_bench_t *result,
+                                              SimExecutor &executor, uint64_t end_us)
+{
+    while (executor.now_us() < end_us)
+    {
+        scd4x::Result<scd4x_sample_t> r = co_await sensor.single_shot();
+        
+        if (r.res == 0)
+        {
+            result->samples++;
+        }
+        else
+        {
+            result->errors++;
+        }
+    }
+}
+
+/**
+ * @brief     set up the sensors, the bus and the handles
+ * @return    status code
+ *            - 0 success
+ *            - 1 setup failed
+ * @note      none
+ */
+static uint8_t a_coroutine_bench_setup(void)
+{
+    scd4x_sim_t *list[SCD4X_SIM_BUS_MAX_CHANNEL];
+    uint8_t i;
+    
+    for (i = 0; i < SCD4X_SIM_BUS_MAX_CHANNEL; i++)
+    {
+        scd4x_sim_init(&gs_sim[i], SCD41);
+        gs_sim[i].now_us = 30000;
+        list[i] = &gs_sim[i];
+    }
+    if (scd4x_sim_bus_init(&gs_bus, 400000, list, SCD4X_SIM_BUS_MAX_CHANNEL) != 0)
+    {
+        return 1;
+    }
+    scd4x_sim_bus_attach(&gs_bus);
+    
+    for (i = 0; i < SCD4X_SIM_BUS_MAX_CHANNEL; i++)
+    {
+        DRIVER_SCD4X_LINK_INIT(&gs_handle[i], scd4x_handle_t);
+        DRIVER_SCD4X_LINK_SIM_BUS(&gs_handle[i]);
+        DRIVER_SCD4X_LINK_IIC_WRITE_COMMAND(&gs_handle[i], gs_write[i]);
+        DRIVER_SCD4X_LINK_IIC_READ_COMMAND(&gs_handle[i], gs_read[i]);
+        DRIVER_SCD4X_LINK_DELAY_MS(&gs_handle[i], a_coroutine_bench_delay_ms);
+        if (scd4x_set_type(&gs_handle[i], SCD41) != 0)
+        {
+            return 1;
+        }
+        if (scd4x_init(&gs_handle[i]) != 0)
+        {
+            return 1;
+        }
+    }
+    
+    /* count the measurement only */
+    gs_delay_ms = 0;
+    
+    return 0;
+}
+
+/**
+ * @brief     coroutine bench main function
+ * @param[in] argc arg numbers
+ * @param[in] **argv arg address
+ * @return    status code
+ *            - 0 success
+ *            - 1 run failed
+ * @note      half of the sensors read periodic samples and half measure single shots, all of them
+ *            run as coroutines on one executor, it fails if a sample is lost or the driver delays
+ */
+int main(int argc, char **argv)
+{
+    int c;
+    int longindex = 0;
+    const char short_options[] = "h";
+    const struct option long_options[] =
+    {
+        {"help", no_argument, NULL, 'h'},
+        {"seconds", required_argument, NULL, 1},
+        {NULL, 0, NULL, 0},
+    };
+    uint32_t seconds = SCD4X_COROUTINE_BENCH_SECONDS;
+    uint32_t expect;
+    uint64_t end_us;
+    uint8_t failed = 0;
+    uint8_t i;
+    
+    optind = 0;
+    do
+    {
+        c = getopt_long(argc, argv, short_options, long_options, &longindex);
+        switch (c)
+        {
+            case 'h' :
+            {
+                printf("Usage:\n");
+                printf("  scd4x_coroutine_bench [--seconds=<num>]\n");
+                printf("\n");
+                printf("Options:\n");
+                printf("  -h, --help             Show the help.\n");
+                printf("      --seconds=<num>    Set the simulated time.([default: %d])\n", SCD4X_COROUTINE_BENCH_SECONDS);
+                
+                return 0;
+            }
+            case 1 :
+            {
+                seconds = (uint32_t)atol(optarg);
+                
+                break;
+            }
+            case -1 :
+            {
+                break;
+            }
+            default :
+            {
+                return 1;
+            }
+        }
+    } while (c != -1);
+    if (seconds < 30)
+    {
+        return 1;
+    }
+    if (a_coroutine_bench_setup() != 0)
+    {
+        fprintf(stderr, "scd4x_coroutine_bench: setup failed.\n");
+        
+        return 1;
+    }
+    
+    SimExecutor executor(gs_bus);
+    std::vector<scd4x::Sensor<SimExecutor>> sensor;
+    
+    sensor.reserve(SCD4X_SIM_BUS_MAX_CHANNEL);
+    end_us = executor.now_us() + (uint64_t)seconds * 1000000;
+    for (i = 0; i < SCD4X_SIM_BUS_MAX_CHANNEL; i++)
+    {
+        sensor.emplace_back(&gs_handle[i], executor);
+        if (i < SCD4X_SIM_BUS_MAX_CHANNEL / 2)
+        {
+            a_coroutine_bench_periodic(sensor[i], &gs_result[i], executor, end_us);
+        }
+        else
+        {
+            a_coroutine_bench_shot(sensor[i], &gs_result[i], executor, end_us);
+        }
+    }
+    executor.run();
+    
+    /* one sample is missed at the start and the end of the run */
+    expect = seconds * 1000 / SCD4X_COROUTINE_BENCH_PERIOD_MS - 2;
+    printf("sensor,mode,samples,errors,expected\n");
+    for (i = 0; i < SCD4X_SIM_BUS_MAX_CHANNEL; i++)
+    {
+        printf("%d,%s,%u,%u,%u\n", i, (i < SCD4X_SIM_BUS_MAX_CHANNEL / 2) ? "periodic" : "single_shot",
+               gs_result[i].samples, gs_result[i].errors, expect);
+        if ((gs_result[i].errors != 0) || (gs_result[i].samples < expect))
+        {
+            failed = 1;
+        }
+    }
+    printf("blocked_ms,%u\n", gs_delay_ms);
+    if (gs_delay_ms != 0)
+    {
+        failed = 1;
+    }
+    if (failed != 0)
+    {
+        fprintf(stderr, "scd4x_coroutine_bench: a sample is lost or the driver blocked.\n");
+        
+        return 1;
+    }
+    
+    return 0;
+}
@@ -0,0 +1,375 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      energy_bench.c
+ * @brief     energy planner benchmark source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "driver_scd4x_energy.h"
+#include "driver_scd4x_sim.h"
+#include <getopt.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+/**
+ * @brief energy bench definition
+ */
+#define SCD4X_ENERGY_BENCH_HOURS          1                /**< default simulated hours of each run */
+#define SCD4X_ENERGY_BENCH_POWER_UP_US    30000            /**< power up time of the simulated sensor */
+#define SCD4X_ENERGY_BENCH_MAX_ERROR      2.0              /**< max error of the model in percent */
+
+/**
+ * @brief energy bench structure definition
+ */
+typedef struct scd4x_energy_bench_s
+{
+    scd4x_t type;                 /**< chip type */
+    uint32_t interval_ms;         /**< sample interval */
+    uint8_t accuracy;             /**< accuracy */
+} scd4x_energy_bench_t;
+
+static scd4x_handle_t gs_handle;        /**< scd4x handle */
+static scd4x_sim_t gs_sim;              /**< simulated sensor */
+
+/**
+ * @brief run list
+ */
+static const scd4x_energy_bench_t gs_bench[] =
+{
+    {SCD41, 5000,   SCD4X_ACCURACY_CO2},
+    {SCD41, 30000,  SCD4X_ACCURACY_CO2},
+    {SCD41, 300000, SCD4X_ACCURACY_CO2},
+    {SCD41, 600000, SCD4X_ACCURACY_CO2},
+    {SCD41, 60000,  SCD4X_ACCURACY_CO2_FIRST_SHOT},
+    {SCD41, 1000,   SCD4X_ACCURACY_RHT},
+    {SCD41, 60000,  SCD4X_ACCURACY_RHT},
+    {SCD40, 60000,  SCD4X_ACCURACY_CO2},
+    {SCD40, 1000,   SCD4X_ACCURACY_CO2},
+};
+
+/**
+ * @brief mode names
+ */
+static const char *const gs_mode[SCD4X_PLAN_MAX + 1] =
+{
+    "periodic", "low_power", "shot_idle", "shot_sleep", "rht_idle", "rht_sleep", "none",
+};
+
+/**
+ * @brief accuracy names
+ */
+static const char *const gs_accuracy[] =
+{
+    "co2", "co2_first_shot", "rht",
+};
+
+/**
+ * @brief     run a plan step
+ * @param[in] action step action
+ * @param[in] *reads pointer to a used sample number buffer
+ * @return    status code
+ *            - 0 success
+ *            - 1 run failed
+ * @note      none
+ */
+static uint8_t a_energy_bench_step(uint8_t action, uint32_t *reads)
+{
+    uint16_t co2_raw;
+    uint16_t co2_ppm;
+    uint16_t temperature_raw;
+    uint16_t humidity_raw;
+    float temperature_s;
+    float humidity_s;
+    
+    switch (action)
+    {
+        case SCD4X_PLAN_ACTION_START_PERIODIC :
+        {
+            return scd4x_start_periodic_measurement(&gs_handle);
+        }
+        case SCD4X_PLAN_ACTION_START_LOW_POWER :
+        {
+            return scd4x_start_low_power_periodic_measurement(&gs_handle);
+        }
+        case SCD4X_PLAN_ACTION_WAKE_UP :
+        {
+            return scd4x_wake_up(&gs_handle);
+        }
+        case SCD4X_PLAN_ACTION_SHOT :
+        {
+            return scd4x_measure_single_shot(&gs_handle);
+        }
+        case SCD4X_PLAN_ACTION_RHT_SHOT :
+        {
+            return scd4x_measure_single_shot_rht_only(&gs_handle);
+        }
+        case SCD4X_PLAN_ACTION_READ :
+        case SCD4X_PLAN_ACTION_DISCARD :
+        {
+            if (scd4x_read(&gs_handle, &co2_raw, &co2_ppm, &temperature_raw, &temperature_s, &humidity_raw, &humidity_s) != 0)
+            {
+                return 1;
+            }
+            *reads += (action == SCD4X_PLAN_ACTION_READ) ? 1 : 0;
+            
+            return 0;
+        }
+        case SCD4X_PLAN_ACTION_POWER_DOWN :
+        {
+            return scd4x_power_down(&gs_handle);
+        }
+        default :
+        {
+            return 1;
+        }
+    }
+}
+
+/**
+ * @brief     get the charge of the simulated sensor
+ * @param[in] *model pointer to an energy model structure
+ * @param[in] *state_us pointer to the time in each state
+ * @return    charge in uc
+ * @note      none
+ */
+static double a_energy_bench_charge(const scd4x_energy_model_t *model, const uint64_t *state_us)
+{
+    const uint32_t na[SCD4X_SIM_STATE_MAX] =
+    {
+        model->sleep_na, model->idle_na, model->periodic_na, model->low_power_na, 
+        model->shot_na, model->rht_only_na, model->wake_up_na,
+    };
+    double charge = 0.0;
+    uint8_t i;
+    
+    for (i = 0; i < SCD4X_SIM_STATE_MAX; i++)
+    {
+        charge += (double)state_us[i] * (double)na[i] / 1e9;
+    }
+    
+    return charge;
+}
+
+/**
+ * @brief     plan a run and check the plan on the simulated sensor
+ * @param[in] *model pointer to an energy model structure
+ * @param[in] *bench pointer to a run
+ * @param[in] hours simulated hours
+ * @return    status code
+ *            - 0 success
+ *            - 1 run failed
+ *            - 4 the model error is too large or a sample is lost
+ * @note      the state times are counted from the first interval, so the setup steps are not charged
+ */
+static uint8_t a_energy_bench_run(const scd4x_energy_model_t *model, const scd4x_energy_bench_t *bench, uint32_t hours)
+{
+    scd4x_plan_t plan;
+    uint64_t start_us[SCD4X_SIM_STATE_MAX];
+    uint64_t state_us[SCD4X_SIM_STATE_MAX];
+    uint64_t base_us;
+    uint64_t at_us;
+    uint32_t cycles;
+    uint32_t reads = 0;
+    uint32_t c;
+    double sim_uc;
+    double error;
+    uint8_t res;
+    uint8_t i;
+    
+    res = scd4x_energy_plan(model, bench->type, bench->interval_ms, (scd4x_accuracy_t)bench->accuracy, &plan);
+    if ((res != 0) && (res != 5))
+    {
+        return 1;
+    }
+    printf("%s,%.0f,%s,%s", (bench->type == SCD40) ? "SCD40" : "SCD41", (double)bench->interval_ms / 1000.0, 
+           gs_accuracy[bench->accuracy], gs_mode[(res == 0) ? plan.mode : SCD4X_PLAN_MAX]);
+    for (i = 0; i < SCD4X_PLAN_MAX; i++)
+    {
+        if (plan.average_ua[i] < 0.0f)
+        {
+            printf(",");
+        }
+        else
+        {
+            printf(",%.1f", (double)plan.average_ua[i]);
+        }
+    }
+    if (res == 5)
+    {
+        printf(",,,0\n");
+        
+        return 0;
+    }
+    
+    /* run the setup steps after the power up */
+    scd4x_sim_init(&gs_sim, bench->type);
+    gs_sim.now_us = SCD4X_ENERGY_BENCH_POWER_UP_US;
+    scd4x_sim_attach(&gs_sim);
+    DRIVER_SCD4X_LINK_INIT(&gs_handle, scd4x_handle_t);
+    DRIVER_SCD4X_LINK_SIM(&gs_handle);
+    if ((scd4x_set_type(&gs_handle, bench->type) != 0) || (scd4x_init(&gs_handle) != 0))
+    {
+        return 1;
+    }
+    for (i = 0; i < plan.setup; i++)
+    {
+        if (a_energy_bench_step(plan.step[i].action, &reads) != 0)
+        {
+            return 1;
+        }
+    }
+    
+    /* run the intervals */
+    base_us = gs_sim.now_us;
+    scd4x_sim_account(&gs_sim);
+    for (i = 0; i < SCD4X_SIM_STATE_MAX; i++)
+    {
+        start_us[i] = gs_sim.state_us[i];
+    }
+    cycles = (uint32_t)(((uint64_t)hours * 3600000) / bench->interval_ms);
+    cycles = (cycles == 0) ? 1 : cycles;
+    for (c = 0; c < cycles; c++)
+    {
+        for (i = plan.setup; i < plan.steps; i++)
+        {
+            at_us = base_us + ((uint64_t)c * bench->interval_ms + plan.step[i].offset_ms) * 1000;
+            if (gs_sim.now_us < at_us)
+            {
+                gs_sim.now_us = at_us;
+            }
+            if (a_energy_bench_step(plan.step[i].action, &reads) != 0)
+            {
+                return 1;
+            }
+        }
+    }
+    gs_sim.now_us = base_us + (uint64_t)cycles * bench->interval_ms * 1000;
+    scd4x_sim_account(&gs_sim);
+    for (i = 0; i < SCD4X_SIM_STATE_MAX; i++)
+    {
+        state_us[i] = gs_sim.state_us[i] - start_us[i];
+    }
+    (void)scd4x_deinit(&gs_handle);
+    sim_uc = a_energy_bench_charge(model, state_us) / cycles;
+    error = (sim_uc - (double)plan.charge_uc) * 100.0 / (double)plan.charge_uc;
+    printf(",%.1f,%.1f,%.2f,%u\n", (double)plan.charge_uc, sim_uc, error, reads);
+    
+    return ((error > SCD4X_ENERGY_BENCH_MAX_ERROR) || (error < -SCD4X_ENERGY_BENCH_MAX_ERROR) || (reads != cycles)) ? 4 : 0;
+}
+
+/**
+ * @brief     energy bench main function
+ * @param[in] argc arg numbers
+ * @param[in] **argv arg address
+ * @return    status code
+ *            - 0 success
+ *            - 1 run failed, the model error is too large or a sample is lost
+ * @note      each run prints one csv line, the *_ua columns are the planned average currents of each mode
+ *            and empty if the mode doesn't fit, model_uc and sim_uc are the charge of one interval
+ *            from the planner and from the state times of the simulated sensor
+ */
+int main(int argc, char **argv)
+{
+    int c;
+    int longindex = 0;
+    const char short_options[] = "h";
+    const struct option long_options[] =
+    {
+        {"help", no_argument, NULL, 'h'},
+        {"hours", required_argument, NULL, 1},
+        {NULL, 0, NULL, 0},
+    };
+    scd4x_energy_model_t model;
+    uint32_t hours = SCD4X_ENERGY_BENCH_HOURS;
+    uint8_t failed = 0;
+    uint8_t res;
+    size_t i;
+    
+    optind = 0;
+    do
+    {
+        c = getopt_long(argc, argv, short_options, long_options, &longindex);
+        switch (c)
+        {
+            case 'h' :
+            {
+                printf("Usage:\n");
+                printf("  scd4x_energy_bench [--hours=<num>]\n");
+                printf("\n");
+                printf("Options:\n");
+                printf("  -h, --help           Show the help.\n");
+                printf("      --hours=<num>    Set the simulated hours of each run.([default: %d])\n", SCD4X_ENERGY_BENCH_HOURS);
+                
+                return 0;
+            }
+            case 1 :
+            {
+                hours = (uint32_t)atol(optarg);
+                
+                break;
+            }
+            case -1 :
+            {
+                break;
+            }
+            default :
+            {
+                return 1;
+            }
+        }
+    } while (c != -1);
+    if ((hours == 0) || (hours > 24 * 365))
+    {
+        return 1;
+    }
+    
+    (void)scd4x_energy_default_model(&model);
+    printf("type,interval_s,accuracy,mode,periodic_ua,low_power_ua,shot_idle_ua,shot_sleep_ua,rht_idle_ua,rht_sleep_ua,"
+           "model_uc,sim_uc,error_pct,reads\n");
+    for (i = 0; i < sizeof(gs_bench) / sizeof(gs_bench[0]); i++)
+    {
+        res = a_energy_bench_run(&model, &gs_bench[i], hours);
+        if (res == 1)
+        {
+            fprintf(stderr, "scd4x_energy_bench: run failed.\n");
+            
+            return 1;
+        }
+        if (res != 0)
+        {
+            fprintf(stderr, "scd4x_energy_bench: the model doesn't match the simulated sensor.\n");
+            failed = 1;
+        }
+    }
+    
+    return failed;
+}
@@ -0,0 +1,444 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      health_bench.c
+ * @brief     health recovery benchmark source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "driver_scd4x_sim.h"
+#include "scd4xd_health.h"
+#include <getopt.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+/**
+ * @brief health bench definition
+ */
+#define SCD4X_HEALTH_BENCH_SECONDS       600              /**< default simulated time of each fault */
+#define SCD4X_HEALTH_BENCH_PERIOD_US     5000000          /**< periodic measurement interval */
+#define SCD4X_HEALTH_BENCH_RETRY_US      20000            /**< data ready retry interval, the one of scd4xd */
+#define SCD4X_HEALTH_BENCH_ERROR_US      1000000          /**< retry interval after a failure, the one of scd4xd */
+#define SCD4X_HEALTH_BENCH_START         0x21B1U          /**< start periodic measurement command */
+#define SCD4X_HEALTH_BENCH_RESET         0x3632U          /**< perform factory reset command */
+
+/**
+ * @brief health bench fault enumeration definition
+ */
+typedef enum
+{
+    SCD4X_HEALTH_BENCH_NAK = 0,            /**< the bus fails for 2.5 s */
+    SCD4X_HEALTH_BENCH_STALL,              /**< acknowledged but the data is never ready */
+    SCD4X_HEALTH_BENCH_SLEEP,              /**< the sensor is powered down */
+    SCD4X_HEALTH_BENCH_WEDGE,              /**< the bus fails until a power cycle */
+    SCD4X_HEALTH_BENCH_BROKEN,             /**< the data is never ready until a factory reset */
+} scd4x_health_bench_fault_t;
+
+/**
+ * @brief health bench structure definition
+ */
+typedef struct scd4x_health_bench_s
+{
+    const char *name;                      /**< fault name */
+    uint8_t fault;                         /**< fault */
+    uint8_t power_cycle;                   /**< 1 to link the power cycle hook */
+    uint8_t factory_reset;                 /**< 1 to allow the factory reset */
+    uint8_t recoverable;                   /**< 1 if the ladder must recover it */
+} scd4x_health_bench_t;
+
+static scd4x_handle_t gs_handle;           /**< scd4x handle */
+static scd4x_sim_t gs_sim;                 /**< simulated sensor */
+static uint8_t gs_fault;                   /**< active fault, 0xFF if none */
+static uint64_t gs_fault_end_us;           /**< end of a timed fault */
+
+/**
+ * @brief fault list
+ */
+static const scd4x_health_bench_t gs_bench[] =
+{
+    {"nak_2500ms",            SCD4X_HEALTH_BENCH_NAK,    1, 0, 1},
+    {"stall",                 SCD4X_HEALTH_BENCH_STALL,  1, 0, 1},
+    {"sleep",                 SCD4X_HEALTH_BENCH_SLEEP,  1, 0, 1},
+    {"wedge",                 SCD4X_HEALTH_BENCH_WEDGE,  1, 0, 1},
+    {"wedge_no_hook",         SCD4X_HEALTH_BENCH_WEDGE,  0, 0, 0},
+    {"broken",                SCD4X_HEALTH_BENCH_BROKEN, 1, 1, 1},
+    {"broken_no_reset",       SCD4X_HEALTH_BENCH_BROKEN, 1, 0, 0},
+};
+
+/**
+ * @brief     check if the active fault fails the bus
+ * @return    1 if the transfer fails
+ * @note      none
+ */
+static uint8_t a_health_bench_bus_failed(void)
+{
+    if ((gs_fault == SCD4X_HEALTH_BENCH_NAK) && (gs_sim.now_us >= gs_fault_end_us))
+    {
+        gs_fault = 0xFF;
+    }
+    
+    return ((gs_fault == SCD4X_HEALTH_BENCH_NAK) || (gs_fault == SCD4X_HEALTH_BENCH_WEDGE)) ? 1 : 0;
+}
+
+/**
+ * @brief     iic bus write command with the faults
+ * @param[in] addr iic device write address
+ * @param[in] *buf pointer to a data buffer
+ * @param[in] len length of the data buffer
+ * @return    status code
+ *            - 0 success
+ *            - 1 write failed
+ * @note      a broken sensor loses its data at each start until a factory reset
+ */
+static uint8_t a_health_bench_iic_write_cmd(uint8_t addr, uint8_t *buf, uint16_t len)
+{
+    uint16_t command;
+    uint8_t res;
+    
+    if (a_health_bench_bus_failed() != 0)
+    {
+        return 1;
+    }
+    res = scd4x_sim_iic_write_cmd(addr, buf, len);
+    command = (uint16_t)(((uint16_t)buf[0] << 8) | buf[1]);
+    if ((res == 0) && (gs_fault == SCD4X_HEALTH_BENCH_BROKEN))
+    {
+        if (command == SCD4X_HEALTH_BENCH_RESET)
+        {
+            gs_fault = 0xFF;
+        }
+        else if (command == SCD4X_HEALTH_BENCH_START)
+        {
+            gs_sim.sample_us = UINT64_MAX;
+        }
+    }
+    
+    return res;
+}
+
+/**
+ * @brief      iic bus read command with the faults
+ * @param[in]  addr iic device read address
+ * @param[out] *buf pointer to a data buffer
+ * @param[in]  len length of the data buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ * @note       none
+ */
+static uint8_t a_health_bench_iic_read_cmd(uint8_t addr, uint8_t *buf, uint16_t len)
+{
+    if (a_health_bench_bus_failed() != 0)
+    {
+        return 1;
+    }
+    
+    return scd4x_sim_iic_read_cmd(addr, buf, len);
+}
+
+/**
+ * @brief     power cycle hook
+ * @param[in] *arg unused
+ * @return    status code
+ *            - 0 success
+ * @note      the sensor boots idle with its eeprom settings
+ */
+static uint8_t a_health_bench_power_cycle(void *arg)
+{
+    scd4x_sim_settings_t eeprom = gs_sim.eeprom;
+    uint64_t now_us = gs_sim.now_us;
+    
+    (void)arg;
+    if (gs_fault == SCD4X_HEALTH_BENCH_WEDGE)
+    {
+        gs_fault = 0xFF;
+    }
+    scd4x_sim_init(&gs_sim, SCD41);
+    gs_sim.eeprom = eeprom;
+    gs_sim.settings = eeprom;
+    gs_sim.now_us = now_us;
+    gs_sim.busy_until_us = now_us + SCD4XD_HEALTH_POWER_UP_US;
+    
+    return 0;
+}
+
+/**
+ * @brief     inject a fault
+ * @param[in] fault fault
+ * @note      none
+ */
+static void a_health_bench_inject(uint8_t fault)
+{
+    gs_fault = fault;
+    gs_fault_end_us = gs_sim.now_us + 2500000;
+    if ((fault == SCD4X_HEALTH_BENCH_STALL) || (fault == SCD4X_HEALTH_BENCH_BROKEN))
+    {
+        gs_sim.sample_us = UINT64_MAX;
+    }
+    else if (fault == SCD4X_HEALTH_BENCH_SLEEP)
+    {
+        gs_sim.sleeping = 1;
+    }
+}
+
+/**
+ * @brief         run the poll loop of scd4xd in the simulated time
+ * @param[in]     *health pointer to a health structure
+ * @param[in]     end_us simulated end time
+ * @param[in]     stop_on_sample 1 to return at the first sample
+ * @param[in,out] *polls pointer to a poll counter
+ * @return        1 if a sample is read
+ * @note          the same schedule as a_scd4xd_sensor_poll
+ */
+static uint8_t a_health_bench_loop(scd4xd_health_t *health, uint64_t end_us, uint8_t stop_on_sample, uint32_t *polls)
+{
+    scd4x_sample_t sample;
+    uint32_t wait_us;
+    uint64_t next_us;
+    uint8_t res;
+    
+    next_us = gs_sim.now_us;
+    while (next_us < end_us)
+    {
+        if (gs_sim.now_us < next_us)
+        {
+            gs_sim.now_us = next_us;
+        }
+        (*polls)++;
+        
+        /* a recovery runs one command each wake up */
+        if (health->op != 0)
+        {
+            res = scd4xd_health_run(health, &gs_handle, gs_sim.now_us, &wait_us);
+            if (res != 0)
+            {
+                next_us = gs_sim.now_us + SCD4X_HEALTH_BENCH_ERROR_US;
+            }
+            else if (health->op != 0)
+            {
+                next_us = gs_sim.now_us + wait_us;
+            }
+            else
+            {
+                next_us = gs_sim.now_us + SCD4X_HEALTH_BENCH_PERIOD_US - SCD4X_HEALTH_BENCH_RETRY_US;
+            }
+            
+            continue;
+        }
+        wait_us = 0;
+        res = scd4x_poll_sample(&gs_handle, &sample, &wait_us);
+        if (scd4xd_health_report(health, res, gs_sim.now_us) != 0)
+        {
+            next_us = gs_sim.now_us;
+        }
+        else if (res == 6)
+        {
+            next_us = gs_sim.now_us + wait_us;
+        }
+        else if (res == 5)
+        {
+            next_us = gs_sim.now_us + SCD4X_HEALTH_BENCH_RETRY_US;
+        }
+        else if (res == 0)
+        {
+            if (stop_on_sample != 0)
+            {
+                return 1;
+            }
+            next_us = sample.ready_time_us + SCD4X_HEALTH_BENCH_PERIOD_US - SCD4X_HEALTH_BENCH_RETRY_US;
+        }
+        else
+        {
+            next_us = gs_sim.now_us + SCD4X_HEALTH_BENCH_ERROR_US;
+        }
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief     run a fault
+ * @param[in] *bench pointer to a fault
+ * @param[in] seconds simulated time limit
+ * @return    status code
+ *            - 0 success
+ *            - 1 run failed
+ *            - 4 a recoverable fault is not recovered
+ * @note      the sensor runs until its first sample, then the fault is injected
+ */
+static uint8_t a_health_bench_run(const scd4x_health_bench_t *bench, uint32_t seconds)
+{
+    scd4xd_health_config_t config;
+    scd4xd_health_t health;
+    uint32_t attempts = 0;
+    uint32_t polls = 0;
+    uint8_t recovered = 0;
+    uint8_t rung = 0;
+    uint8_t i;
+    
+    /* a periodic sensor */
+    gs_fault = 0xFF;
+    scd4x_sim_init(&gs_sim, SCD41);
+    scd4x_sim_attach(&gs_sim);
+    gs_sim.now_us = SCD4XD_HEALTH_POWER_UP_US;
+    DRIVER_SCD4X_LINK_INIT(&gs_handle, scd4x_handle_t);
+    DRIVER_SCD4X_LINK_SIM(&gs_handle);
+    DRIVER_SCD4X_LINK_IIC_WRITE_COMMAND(&gs_handle, a_health_bench_iic_write_cmd);
+    DRIVER_SCD4X_LINK_IIC_READ_COMMAND(&gs_handle, a_health_bench_iic_read_cmd);
+    if ((scd4x_set_type(&gs_handle, SCD41) != 0) || (scd4x_init(&gs_handle) != 0) || 
+        (scd4x_start_periodic_measurement(&gs_handle) != 0))
+    {
+        return 1;
+    }
+    config.retries = SCD4XD_HEALTH_RETRIES;
+    config.low_power = 0;
+    config.factory_reset = bench->factory_reset;
+    config.stall_us = 3 * (uint64_t)SCD4X_HEALTH_BENCH_PERIOD_US;
+    config.power_cycle = (bench->power_cycle != 0) ? a_health_bench_power_cycle : NULL;
+    config.arg = NULL;
+    scd4xd_health_init(&health, &config, gs_sim.now_us);
+    if (a_health_bench_loop(&health, gs_sim.now_us + 2 * (uint64_t)SCD4X_HEALTH_BENCH_PERIOD_US, 1, &polls) == 0)
+    {
+        return 1;
+    }
+    
+    /* fault, then the first sample is the recovery */
+    a_health_bench_inject(bench->fault);
+    polls = 0;
+    (void)a_health_bench_loop(&health, gs_sim.now_us + (uint64_t)seconds * 1000000, 1, &polls);
+    for (i = 0; i < SCD4XD_HEALTH_RUNGS; i++)
+    {
+        attempts += health.stats.attempts[i];
+        if (health.stats.recovered[i] != 0)
+        {
+            recovered = 1;
+            rung = i;
+        }
+    }
+    if (recovered == 0)
+    {
+        rung = health.rung;
+    }
+    printf("%s,%u,%s,%u,%u,%u,%u,%u,%.3f\n", bench->name, recovered, 
+           (rung == SCD4XD_HEALTH_RUNG_RETRY) ? "retry" : 
+           ((rung == SCD4XD_HEALTH_RUNG_REINIT) ? "reinit" : 
+           ((rung == SCD4XD_HEALTH_RUNG_RESTART) ? "restart" : 
+           ((rung == SCD4XD_HEALTH_RUNG_POWER_CYCLE) ? "power_cycle" : "factory_reset"))), 
+           health.stats.failures, health.stats.stalls, attempts, health.stats.ladders, polls, 
+           (recovered != 0) ? (double)health.stats.recover_max_us / 1e6 : -1.0);
+    (void)scd4x_deinit(&gs_handle);
+    
+    return ((bench->recoverable != 0) && (recovered == 0)) ? 4 : 0;
+}
+
+/**
+ * @brief     health bench main function
+ * @param[in] argc arg numbers
+ * @param[in] **argv arg address
+ * @return    status code
+ *            - 0 success
+ *            - 1 run failed or a recoverable fault is not recovered
+ * @note      the faults are injected into a simulated sensor and the recovery ladder of scd4xd
+ *            runs in the simulated time, each fault prints one csv line
+ */
+int main(int argc, char **argv)
+{
+    int c;
+    int longindex = 0;
+    const char short_options[] = "h";
+    const struct option long_options[] =
+    {
+        {"help", no_argument, NULL, 'h'},
+        {"seconds", required_argument, NULL, 1},
+        {NULL, 0, NULL, 0},
+    };
+    uint32_t seconds = SCD4X_HEALTH_BENCH_SECONDS;
+    uint8_t failed = 0;
+    uint8_t res;
+    size_t i;
+    
+    optind = 0;
+    do
+    {
+        c = getopt_long(argc, argv, short_options, long_options, &longindex);
+        switch (c)
+        {
+            case 'h' :
+            {
+                printf("Usage:\n");
+                printf("  scd4x_health_bench [--seconds=<num>]\n");
+                printf("\n");
+                printf("Options:\n");
+                printf("  -h, --help             Show the help.\n");
+                printf("      --seconds=<num>    Set the simulated time limit of each recovery.([default: %d])\n", SCD4X_HEALTH_BENCH_SECONDS);
+                
+                return 0;
+            }
+            case 1 :
+            {
+                seconds = (uint32_t)atol(optarg);
+                
+                break;
+            }
+            case -1 :
+            {
+                break;
+            }
+            default :
+            {
+                return 1;
+            }
+        }
+    } while (c != -1);
+    if (seconds == 0)
+    {
+        return 1;
+    }
+    
+    printf("fault,recovered,rung,failures,stalls,attempts,ladders,polls,recover_s\n");
+    for (i = 0; i < sizeof(gs_bench) / sizeof(gs_bench[0]); i++)
+    {
+        res = a_health_bench_run(&gs_bench[i], seconds);
+        if (res == 1)
+        {
+            fprintf(stderr, "scd4x_health_bench: %s setup failed.\n", gs_bench[i].name);
+            
+            return 1;
+        }
+        if (res != 0)
+        {
+            fprintf(stderr, "scd4x_health_bench: %s is not recovered.\n", gs_bench[i].name);
+            failed = 1;
+        }
+    }
+    
+    return failed;
+}
@@ -0,0 +1,433 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      hybrid_bench.c
+ * @brief     hybrid schedule benchmark source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "driver_scd4x_sim.h"
+#include <getopt.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+/**
+ * @brief hybrid bench definition
+ */
+#define SCD4X_HYBRID_BENCH_RHT_MS         3000             /**< default temperature and humidity interval */
+#define SCD4X_HYBRID_BENCH_CO2_MS         60000            /**< default co2 interval */
+#define SCD4X_HYBRID_BENCH_HOURS          1                /**< default simulated hours of each run */
+#define SCD4X_HYBRID_BENCH_POWER_UP_US    30000            /**< power up time of the simulated sensor */
+#define SCD4X_HYBRID_BENCH_FULL_MS        5000             /**< full shot time */
+
+/**
+ * @brief hybrid bench mode enumeration definition
+ */
+typedef enum
+{
+    SCD4X_HYBRID_BENCH_HYBRID    = 0,        /**< rht only shots and full shots */
+    SCD4X_HYBRID_BENCH_PERIODIC  = 1,        /**< periodic measurement, the latest sample is used */
+    SCD4X_HYBRID_BENCH_LOW_POWER = 2,        /**< low power periodic measurement, the latest sample is used */
+    SCD4X_HYBRID_BENCH_MAX       = 3,        /**< mode number */
+} scd4x_hybrid_bench_mode_t;
+
+/**
+ * @brief hybrid bench stream structure definition
+ */
+typedef struct scd4x_hybrid_bench_stream_s
+{
+    uint32_t samples;             /**< delivered samples */
+    uint64_t delay_us;            /**< sum of the time from the due time to the delivery */
+    uint64_t age_us;              /**< sum of the time from the measurement end to the delivery */
+    uint64_t max_delay_us;        /**< max delay */
+    uint64_t max_age_us;          /**< max age */
+} scd4x_hybrid_bench_stream_t;
+
+static scd4x_handle_t gs_handle;        /**< scd4x handle */
+static scd4x_sim_t gs_sim;              /**< simulated sensor */
+
+/**
+ * @brief mode names
+ */
+static const char *const gs_mode[SCD4X_HYBRID_BENCH_MAX] =
+{
+    "hybrid", "periodic", "low_power",
+};
+
+/**
+ * @brief     add a sample to a stream
+ * @param[in] *stream pointer to a stream structure
+ * @param[in] due_us due time
+ * @param[in] end_us measurement end time
+ * @param[in] now_us delivery time
+ * @note      none
+ */
+static void a_hybrid_bench_add(scd4x_hybrid_bench_stream_t *stream, uint64_t due_us, uint64_t end_us, uint64_t now_us)
+{
+    uint64_t delay_us = (now_us > due_us) ? (now_us - due_us) : 0;
+    uint64_t age_us = (now_us > end_us) ? (now_us - end_us) : 0;
+    
+    stream->samples++;
+    stream->delay_us += delay_us;
+    stream->age_us += age_us;
+    stream->max_delay_us = (delay_us > stream->max_delay_us) ? delay_us : stream->max_delay_us;
+    stream->max_age_us = (age_us > stream->max_age_us) ? age_us : stream->max_age_us;
+}
+
+/**
+ * @brief     get the average current of the simulated sensor
+ * @param[in] *model pointer to an energy model structure
+ * @param[in] *state_us pointer to the time in each state
+ * @param[in] run_us run time
+ * @return    average current in ua
+ * @note      none
+ */
+static double a_hybrid_bench_current(const scd4x_energy_model_t *model, const uint64_t *state_us, uint64_t run_us)
+{
+    const uint32_t na[SCD4X_SIM_STATE_MAX] =
+    {
+        model->sleep_na, model->idle_na, model->periodic_na, model->low_power_na, 
+        model->shot_na, model->rht_only_na, model->wake_up_na,
+    };
+    double charge = 0.0;
+    uint8_t i;
+    
+    for (i = 0; i < SCD4X_SIM_STATE_MAX; i++)
+    {
+        charge += (double)state_us[i] * (double)na[i] / 1e3;
+    }
+    
+    return charge / (double)run_us;
+}
+
+/**
+ * @brief      run the hybrid schedule
+ * @param[in]  rht_ms temperature and humidity interval
+ * @param[in]  co2_ms co2 interval
+ * @param[in]  end_us end time
+ * @param[out] *stream pointer to the rht and co2 streams
+ * @return     status code
+ *             - 0 success
+ *             - 1 run failed
+ * @note       none
+ */
+static uint8_t a_hybrid_bench_hybrid(uint32_t rht_ms, uint32_t co2_ms, uint64_t end_us, scd4x_hybrid_bench_stream_t *stream)
+{
+    scd4x_hybrid_t hybrid;
+    scd4x_sample_t sample;
+    uint32_t wait_us;
+    uint8_t mask;
+    uint8_t res;
+    
+    if (scd4x_hybrid_init(&gs_handle, &hybrid, rht_ms, co2_ms) != 0)
+    {
+        return 1;
+    }
+    while (gs_sim.now_us < end_us)
+    {
+        res = scd4x_hybrid_poll(&gs_handle, &hybrid, &sample, &mask, &wait_us);
+        if (res == 6)
+        {
+            gs_sim.now_us += (wait_us == 0) ? 1 : wait_us;
+            
+            continue;
+        }
+        if (res != 0)
+        {
+            return 1;
+        }
+        if ((mask & SCD4X_STREAM_RHT) != 0)
+        {
+            a_hybrid_bench_add(&stream[0], hybrid.due_us, sample.ready_time_us, gs_sim.now_us);
+        }
+        if ((mask & SCD4X_STREAM_CO2) != 0)
+        {
+            a_hybrid_bench_add(&stream[1], hybrid.due_us, sample.ready_time_us, gs_sim.now_us);
+        }
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief      run a periodic mode and use the latest sample at each due time
+ * @param[in]  mode periodic or low power periodic
+ * @param[in]  rht_ms temperature and humidity interval
+ * @param[in]  co2_ratio every co2_ratio-th due time is a co2 due time
+ * @param[in]  end_us end time
+ * @param[out] *stream pointer to the rht and co2 streams
+ * @return     status code
+ *             - 0 success
+ *             - 1 run failed
+ * @note       the due times start with the first sample
+ */
+static uint8_t a_hybrid_bench_periodic(uint8_t mode, uint32_t rht_ms, uint32_t co2_ratio, uint64_t end_us, 
+                                       scd4x_hybrid_bench_stream_t *stream)
+{
+    scd4x_sample_t sample;
+    uint64_t period_us;
+    uint64_t start_us;
+    uint64_t due_us;
+    uint64_t last_us = 0;
+    uint32_t tick = 0;
+    uint8_t res;
+    
+    res = (mode == SCD4X_HYBRID_BENCH_PERIODIC) ? scd4x_start_periodic_measurement(&gs_handle) : 
+                                                  scd4x_start_low_power_periodic_measurement(&gs_handle);
+    if (res != 0)
+    {
+        return 1;
+    }
+    period_us = (uint64_t)gs_sim.period_ms * 1000;
+    start_us = gs_sim.now_us;
+    for (due_us = start_us + period_us; due_us < end_us; due_us += (uint64_t)rht_ms * 1000)
+    {
+        if (gs_sim.now_us < due_us)
+        {
+            gs_sim.now_us = due_us;
+        }
+        res = scd4x_read_sample(&gs_handle, &sample);
+        if (res == 0)
+        {
+            last_us = start_us + ((due_us - start_us) / period_us) * period_us;
+        }
+        else if (res != 5)
+        {
+            return 1;
+        }
+        else
+        {
+            /* the latest sample is used again */
+        }
+        a_hybrid_bench_add(&stream[0], due_us, last_us, gs_sim.now_us);
+        if (tick == 0)
+        {
+            a_hybrid_bench_add(&stream[1], due_us, last_us, gs_sim.now_us);
+        }
+        tick = (tick + 1) % co2_ratio;
+    }
+    
+    return (scd4x_stop_periodic_measurement(&gs_handle) != 0) ? 1 : 0;
+}
+
+/**
+ * @brief     run a mode on the simulated sensor
+ * @param[in] *model pointer to an energy model structure
+ * @param[in] mode bench mode
+ * @param[in] rht_ms temperature and humidity interval
+ * @param[in] co2_ms co2 interval
+ * @param[in] hours simulated hours
+ * @return    status code
+ *            - 0 success
+ *            - 1 run failed
+ *            - 4 a stream lost samples
+ * @note      none
+ */
+static uint8_t a_hybrid_bench_run(const scd4x_energy_model_t *model, uint8_t mode, uint32_t rht_ms, uint32_t co2_ms, uint32_t hours)
+{
+    scd4x_hybrid_bench_stream_t stream[2] = {{0}, {0}};
+    uint64_t start_us[SCD4X_SIM_STATE_MAX];
+    uint64_t state_us[SCD4X_SIM_STATE_MAX];
+    uint64_t base_us;
+    uint64_t run_us;
+    uint32_t co2_ratio;
+    uint32_t ticks;
+    uint32_t merged;
+    uint8_t res;
+    uint8_t i;
+    
+    scd4x_sim_init(&gs_sim, SCD41);
+    gs_sim.now_us = SCD4X_HYBRID_BENCH_POWER_UP_US;
+    scd4x_sim_attach(&gs_sim);
+    DRIVER_SCD4X_LINK_INIT(&gs_handle, scd4x_handle_t);
+    DRIVER_SCD4X_LINK_SIM(&gs_handle);
+    if ((scd4x_set_type(&gs_handle, SCD41) != 0) || (scd4x_init(&gs_handle) != 0))
+    {
+        return 1;
+    }
+    base_us = gs_sim.now_us;
+    scd4x_sim_account(&gs_sim);
+    for (i = 0; i < SCD4X_SIM_STATE_MAX; i++)
+    {
+        start_us[i] = gs_sim.state_us[i];
+    }
+    run_us = (uint64_t)hours * 3600000000ULL;
+    co2_ratio = (co2_ms + rht_ms / 2) / rht_ms;
+    if (mode == SCD4X_HYBRID_BENCH_HYBRID)
+    {
+        res = a_hybrid_bench_hybrid(rht_ms, co2_ms, base_us + run_us, stream);
+    }
+    else
+    {
+        res = a_hybrid_bench_periodic(mode, rht_ms, co2_ratio, base_us + run_us, stream);
+    }
+    if (res != 0)
+    {
+        return 1;
+    }
+    if (gs_sim.now_us < base_us + run_us)
+    {
+        gs_sim.now_us = base_us + run_us;
+    }
+    scd4x_sim_account(&gs_sim);
+    for (i = 0; i < SCD4X_SIM_STATE_MAX; i++)
+    {
+        state_us[i] = gs_sim.state_us[i] - start_us[i];
+    }
+    run_us = gs_sim.now_us - base_us;
+    (void)scd4x_deinit(&gs_handle);
+    
+    printf("%s,%u,%u,%.1f,%.1f,%.1f,%.1f,%.1f,%.1f,%.1f\n", gs_mode[mode], stream[0].samples, stream[1].samples, 
+           a_hybrid_bench_current(model, state_us, run_us), 
+           (stream[0].samples != 0) ? (double)stream[0].delay_us / stream[0].samples / 1000.0 : 0.0,
+           (double)stream[0].max_delay_us / 1000.0,
+           (stream[0].samples != 0) ? (double)stream[0].age_us / stream[0].samples / 1000.0 : 0.0,
+           (double)stream[0].max_age_us / 1000.0,
+           (stream[1].samples != 0) ? (double)stream[1].delay_us / stream[1].samples / 1000.0 : 0.0,
+           (stream[1].samples != 0) ? (double)stream[1].age_us / stream[1].samples / 1000.0 : 0.0);
+    
+    /* a due time at the end may be cut off and the due times during a full shot are merged */
+    ticks = (uint32_t)(((uint64_t)hours * 3600000) / rht_ms);
+    merged = stream[1].samples * (SCD4X_HYBRID_BENCH_FULL_MS / rht_ms);
+    if ((mode == SCD4X_HYBRID_BENCH_HYBRID) && 
+        ((stream[0].samples + merged + 1 < ticks) || (stream[1].samples + 1 < (ticks + co2_ratio - 1) / co2_ratio)))
+    {
+        return 4;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief     hybrid bench main function
+ * @param[in] argc arg numbers
+ * @param[in] **argv arg address
+ * @return    status code
+ *            - 0 success
+ *            - 1 run failed or the hybrid schedule lost samples
+ * @note      each mode prints one csv line with the samples of both streams, the average current
+ *            from the state times of the simulated sensor, the delay from the due time to the delivery
+ *            and the age of the delivered sample, the periodic modes use the latest sample at each due time
+ */
+int main(int argc, char **argv)
+{
+    int c;
+    int longindex = 0;
+    const char short_options[] = "h";
+    const struct option long_options[] =
+    {
+        {"help", no_argument, NULL, 'h'},
+        {"co2", required_argument, NULL, 1},
+        {"hours", required_argument, NULL, 2},
+        {"rht", required_argument, NULL, 3},
+        {NULL, 0, NULL, 0},
+    };
+    scd4x_energy_model_t model;
+    uint32_t rht_ms = SCD4X_HYBRID_BENCH_RHT_MS;
+    uint32_t co2_ms = SCD4X_HYBRID_BENCH_CO2_MS;
+    uint32_t hours = SCD4X_HYBRID_BENCH_HOURS;
+    uint8_t failed = 0;
+    uint8_t res;
+    uint8_t i;
+    
+    optind = 0;
+    do
+    {
+        c = getopt_long(argc, argv, short_options, long_options, &longindex);
+        switch (c)
+        {
+            case 'h' :
+            {
+                printf("Usage:\n");
+                printf("  scd4x_hybrid_bench [--rht=<ms>] [--co2=<ms>] [--hours=<num>]\n");
+                printf("\n");
+                printf("Options:\n");
+                printf("  -h, --help           Show the help.\n");
+                printf("      --co2=<ms>       Set the co2 interval.([default: %d])\n", SCD4X_HYBRID_BENCH_CO2_MS);
+                printf("      --hours=<num>    Set the simulated hours of each run.([default: %d])\n", SCD4X_HYBRID_BENCH_HOURS);
+                printf("      --rht=<ms>       Set the temperature and humidity interval.([default: %d])\n", SCD4X_HYBRID_BENCH_RHT_MS);
+                
+                return 0;
+            }
+            case 1 :
+            {
+                co2_ms = (uint32_t)atol(optarg);
+                
+                break;
+            }
+            case 2 :
+            {
+                hours = (uint32_t)atol(optarg);
+                
+                break;
+            }
+            case 3 :
+            {
+                rht_ms = (uint32_t)atol(optarg);
+                
+                break;
+            }
+            case -1 :
+            {
+                break;
+            }
+            default :
+            {
+                return 1;
+            }
+        }
+    } while (c != -1);
+    if ((rht_ms == 0) || (co2_ms < rht_ms) || (hours == 0) || (hours > 24 * 365))
+    {
+        return 1;
+    }
+    
+    (void)scd4x_energy_default_model(&model);
+    printf("mode,rht_samples,co2_samples,average_ua,rht_delay_ms,rht_max_delay_ms,rht_age_ms,rht_max_age_ms,"
+           "co2_delay_ms,co2_age_ms\n");
+    for (i = 0; i < SCD4X_HYBRID_BENCH_MAX; i++)
+    {
+        res = a_hybrid_bench_run(&model, i, rht_ms, co2_ms, hours);
+        if (res == 1)
+        {
+            fprintf(stderr, "scd4x_hybrid_bench: %s run failed.\n", gs_mode[i]);
+            
+            return 1;
+        }
+        if (res != 0)
+        {
+            fprintf(stderr, "scd4x_hybrid_bench: the hybrid schedule lost samples.\n");
+            failed = 1;
+        }
+    }
+    
+    return failed;
+}
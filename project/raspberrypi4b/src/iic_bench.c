@@ -0,0 +1,324 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      iic_bench.c
+ * @brief     iic bench source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#define _GNU_SOURCE
+
+#include "iic.h"
+#include <getopt.h>
+#include <sys/resource.h>
+#include <time.h>
+
+/**
+ * @brief iic bench definition
+ */
+#define SCD4X_IIC_BENCH_FRAMES        1000          /**< default frames of each path */
+#define SCD4X_IIC_BENCH_ADDRESS       0xC4          /**< scd4x iic write address */
+#define SCD4X_IIC_BENCH_WAIT_NS       1000000       /**< get data ready status execution time */
+
+/**
+ * @brief iic bench path enumeration definition
+ */
+typedef enum
+{
+    SCD4X_IIC_BENCH_RDWR     = 0,        /**< iic_write_cmd and iic_read_cmd */
+    SCD4X_IIC_BENCH_PREBUILT = 1,        /**< I2C_RDWR with the pre-built message */
+    SCD4X_IIC_BENCH_RW       = 2,        /**< I2C_SLAVE once, then write and read */
+} scd4x_iic_bench_path_t;
+
+/**
+ * @brief iic bench path name definition
+ */
+static const char *const gsc_path_name[] = {"rdwr", "rdwr_prebuilt", "rw"};
+
+/**
+ * @brief  get the monotonic time
+ * @return time in ns
+ * @note   vdso, no syscall
+ */
+static uint64_t a_iic_bench_now_ns(void)
+{
+    struct timespec ts;
+    
+    (void)clock_gettime(CLOCK_MONOTONIC, &ts);
+    
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+/**
+ * @brief      get the used cpu time
+ * @param[out] *usr_ns pointer to a user time buffer
+ * @param[out] *sys_ns pointer to a kernel time buffer
+ * @note       none
+ */
+static void a_iic_bench_cpu_ns(uint64_t *usr_ns, uint64_t *sys_ns)
+{
+    struct rusage usage;
+    
+    (void)getrusage(RUSAGE_SELF, &usage);
+    *usr_ns = (uint64_t)usage.ru_utime.tv_sec * 1000000000ULL + (uint64_t)usage.ru_utime.tv_usec * 1000ULL;
+    *sys_ns = (uint64_t)usage.ru_stime.tv_sec * 1000000000ULL + (uint64_t)usage.ru_stime.tv_usec * 1000ULL;
+}
+
+/**
+ * @brief     compare two latencies
+ * @param[in] *a pointer to a latency
+ * @param[in] *b pointer to a latency
+ * @return    compare result
+ * @note      none
+ */
+static int a_iic_bench_compare(const void *a, const void *b)
+{
+    uint64_t x = *(const uint64_t *)a;
+    uint64_t y = *(const uint64_t *)b;
+    
+    return (x > y) - (x < y);
+}
+
+/**
+ * @brief     get the scd4x crc
+ * @param[in] *buf pointer to a data buffer
+ * @param[in] len length of the data buffer
+ * @return    crc8
+ * @note      polynomial 0x31, init 0xFF
+ */
+static uint8_t a_iic_bench_crc(const uint8_t *buf, uint8_t len)
+{
+    uint8_t crc = 0xFF;
+    uint8_t i;
+    uint8_t j;
+    
+    for (i = 0; i < len; i++)
+    {
+        crc ^= buf[i];
+        for (j = 0; j < 8; j++)
+        {
+            crc = ((crc & 0x80) != 0) ? (uint8_t)((crc << 1) ^ 0x31) : (uint8_t)(crc << 1);
+        }
+    }
+    
+    return crc;
+}
+
+/**
+ * @brief     run one path
+ * @param[in] fd iic handle
+ * @param[in] path transport path
+ * @param[in] frames frame number
+ * @param[in] *write_ns pointer to a write latency buffer of the frame number
+ * @param[in] *read_ns pointer to a read latency buffer of the frame number
+ * @return    status code
+ *            - 0 success
+ *            - 1 run failed
+ * @note      each frame is get data ready status, a 2 bytes write and a 3 bytes read after the execution time,
+ *            it is valid in the idle and the periodic measurement mode
+ */
+static uint8_t a_iic_bench_run(int fd, scd4x_iic_bench_path_t path, uint32_t frames, uint64_t *write_ns, uint64_t *read_ns)
+{
+    const struct timespec wait = {0, SCD4X_IIC_BENCH_WAIT_NS};
+    uint8_t cmd[2] = {0xE4, 0xB8};
+    uint8_t buf[3];
+    iic_device_t dev;
+    uint32_t setup = 0;
+    uint32_t errors = 0;
+    uint64_t usr_start;
+    uint64_t sys_start;
+    uint64_t usr_end;
+    uint64_t sys_end;
+    uint64_t t;
+    uint8_t res;
+    uint32_t i;
+    
+    /* the other paths set the target address once */
+    if (path != SCD4X_IIC_BENCH_RDWR)
+    {
+        if (iic_device_init(&dev, fd, SCD4X_IIC_BENCH_ADDRESS) != 0)
+        {
+            return 1;
+        }
+        setup = 1;
+    }
+    
+    a_iic_bench_cpu_ns(&usr_start, &sys_start);
+    for (i = 0; i < frames; i++)
+    {
+        /* write the command */
+        t = a_iic_bench_now_ns();
+        if (path == SCD4X_IIC_BENCH_RDWR)
+        {
+            res = iic_write_cmd(fd, SCD4X_IIC_BENCH_ADDRESS, cmd, 2);
+        }
+        else if (path == SCD4X_IIC_BENCH_PREBUILT)
+        {
+            res = iic_device_transfer(&dev, 0, cmd, 2);
+        }
+        else
+        {
+            res = iic_device_write_cmd(&dev, cmd, 2);
+        }
+        write_ns[i] = a_iic_bench_now_ns() - t;
+        (void)nanosleep(&wait, NULL);
+        
+        /* read the status */
+        t = a_iic_bench_now_ns();
+        if (res == 0)
+        {
+            if (path == SCD4X_IIC_BENCH_RDWR)
+            {
+                res = iic_read_cmd(fd, SCD4X_IIC_BENCH_ADDRESS, buf, 3);
+            }
+            else if (path == SCD4X_IIC_BENCH_PREBUILT)
+            {
+                res = iic_device_transfer(&dev, I2C_M_RD, buf, 3);
+            }
+            else
+            {
+                res = iic_device_read_cmd(&dev, buf, 3);
+            }
+        }
+        read_ns[i] = a_iic_bench_now_ns() - t;
+        if ((res != 0) || (a_iic_bench_crc(buf, 2) != buf[2]))
+        {
+            errors++;
+        }
+    }
+    a_iic_bench_cpu_ns(&usr_end, &sys_end);
+    
+    /* output */
+    qsort(write_ns, frames, sizeof(uint64_t), a_iic_bench_compare);
+    qsort(read_ns, frames, sizeof(uint64_t), a_iic_bench_compare);
+    printf("%s,%u,%u,%u,2,%llu,%llu,%llu,%llu,%llu,%llu\n", gsc_path_name[path], frames, errors, setup, 
+           (unsigned long long)write_ns[frames / 2], (unsigned long long)write_ns[(uint64_t)frames * 99 / 100], 
+           (unsigned long long)read_ns[frames / 2], (unsigned long long)read_ns[(uint64_t)frames * 99 / 100], 
+           (unsigned long long)((usr_end - usr_start) / frames), (unsigned long long)((sys_end - sys_start) / frames));
+    
+    return 0;
+}
+
+/**
+ * @brief     iic bench main function
+ * @param[in] argc arg numbers
+ * @param[in] **argv arg address
+ * @return    status code
+ *            - 0 success
+ *            - 1 run failed
+ * @note      none
+ */
+int main(int argc, char **argv)
+{
+    int c;
+    int longindex = 0;
+    const char short_options[] = "h";
+    const struct option long_options[] =
+    {
+        {"help", no_argument, NULL, 'h'},
+        {"bus", required_argument, NULL, 1},
+        {"frames", required_argument, NULL, 2},
+        {NULL, 0, NULL, 0},
+    };
+    char *bus = "/dev/i2c-1";
+    uint32_t frames = SCD4X_IIC_BENCH_FRAMES;
+    uint64_t *write_ns;
+    uint64_t *read_ns;
+    uint8_t res = 0;
+    int fd;
+    int i;
+    
+    optind = 0;
+    do
+    {
+        c = getopt_long(argc, argv, short_options, long_options, &longindex);
+        switch (c)
+        {
+            case 'h' :
+            {
+                printf("Usage:\n");
+                printf("  scd4x_iic_bench [--bus=<dev>] [--frames=<num>]\n");
+                printf("\n");
+                printf("Options:\n");
+                printf("      --bus=<dev>        Set the iic device of a scd4x.([default: /dev/i2c-1])\n");
+                printf("      --frames=<num>     Set the frames of each path.([default: %d])\n", SCD4X_IIC_BENCH_FRAMES);
+                printf("  -h, --help             Show the help.\n");
+                
+                return 0;
+            }
+            case 1 :
+            {
+                bus = optarg;
+                
+                break;
+            }
+            case 2 :
+            {
+                frames = (uint32_t)atol(optarg);
+                
+                break;
+            }
+            case -1 :
+            {
+                break;
+            }
+            default :
+            {
+                return 1;
+            }
+        }
+    } while (c != -1);
+    if (frames == 0)
+    {
+        return 1;
+    }
+    
+    write_ns = (uint64_t *)malloc(sizeof(uint64_t) * frames);
+    read_ns = (uint64_t *)malloc(sizeof(uint64_t) * frames);
+    if ((write_ns == NULL) || (read_ns == NULL) || (iic_init(bus, &fd) != 0))
+    {
+        free(write_ns);
+        free(read_ns);
+        
+        return 1;
+    }
+    printf("path,frames,errors,setup_syscalls,frame_syscalls,write_p50_ns,write_p99_ns,read_p50_ns,read_p99_ns,usr_ns,sys_ns\n");
+    for (i = SCD4X_IIC_BENCH_RDWR; (i <= SCD4X_IIC_BENCH_RW) && (res == 0); i++)
+    {
+        res = a_iic_bench_run(fd, (scd4x_iic_bench_path_t)i, frames, write_ns, read_ns);
+        fflush(stdout);
+    }
+    (void)iic_deinit(fd);
+    free(write_ns);
+    free(read_ns);
+    
+    return (res == 0) ? 0 : 1;
+}
@@ -214,6 +214,10 @@ uint8_t scd4x(uint8_t argc, char **argv)
         uint16_t co2_ppm;
         float temperature;
         float humidity;
+#if (SCD4X_CONFIG_ACCOUNTING != 0)
+        float charge_uah;
+        float average_ua;
+#endif
         
         /* basic init */
         res = scd4x_basic_init(chip_type);
@@ -244,6 +248,14 @@ uint8_t scd4x(uint8_t argc, char **argv)
             scd4x_interface_debug_print("scd4x: humidity is %0.2f%%.\n", humidity);
         }
         
+#if (SCD4X_CONFIG_ACCOUNTING != 0)
+        /* output the energy */
+        if (scd4x_basic_get_charge((float *)&charge_uah, (float *)&average_ua) == 0)
+        {
+            scd4x_interface_debug_print("scd4x: energy is %0.3fuAh, average current is %0.1fuA.\n", charge_uah, average_ua);
+        }
+#endif
+        
         /* basic deinit */
         (void)scd4x_basic_deinit();
         
@@ -256,6 +268,10 @@ uint8_t scd4x(uint8_t argc, char **argv)
         uint16_t co2_ppm;
         float temperature;
         float humidity;
+#if (SCD4X_CONFIG_ACCOUNTING != 0)
+        float charge_uah;
+        float average_ua;
+#endif
         
         /* shot init */
         res = scd4x_shot_init(chip_type);
@@ -286,6 +302,70 @@ uint8_t scd4x(uint8_t argc, char **argv)
             scd4x_interface_debug_print("scd4x: humidity is %0.2f%%.\n", humidity);
         }
         
+#if (SCD4X_CONFIG_ACCOUNTING != 0)
+        /* output the energy */
+        if (scd4x_shot_get_charge((float *)&charge_uah, (float *)&average_ua) == 0)
+        {
+            scd4x_interface_debug_print("scd4x: energy is %0.3fuAh, average current is %0.1fuA.\n", charge_uah, average_ua);
+        }
+#endif
+        
+        /* shot deinit */
+        (void)scd4x_shot_deinit();
+        
+        return 0;
+    }
+    else if (strcmp("e_sleepy-shot", type) == 0)
+    {
+        uint8_t res;
+        uint32_t i;
+        uint16_t co2_ppm;
+        float temperature;
+        float humidity;
+#if (SCD4X_CONFIG_ACCOUNTING != 0)
+        float charge_uah;
+        float average_ua;
+#endif
+        float charge_uc;
+        
+        /* shot init */
+        res = scd4x_shot_init(chip_type);
+        if (res != 0)
+        {
+            return 1;
+        }
+        
+        /* loop */
+        for (i = 0; i < times; i++)
+        {
+            /* delay 5000ms */
+            scd4x_interface_delay_ms(5000);
+            
+            /* read data */
+            res = scd4x_shot_sleepy_read((uint16_t *)&co2_ppm, (float *)&temperature, (float *)&humidity, (float *)&charge_uc);
+            if (res != 0)
+            {
+                (void)scd4x_shot_deinit();
+                
+                return 1;
+            }
+            
+            /* output */
+            scd4x_interface_debug_print("scd4x: %d/%d.\n", (uint32_t)(i + 1), (uint32_t)times);
+            scd4x_interface_debug_print("scd4x: co2 is %02dppm.\n", co2_ppm);
+            scd4x_interface_debug_print("scd4x: temperature is %0.2fC.\n", temperature);
+            scd4x_interface_debug_print("scd4x: humidity is %0.2f%%.\n", humidity);
+            scd4x_interface_debug_print("scd4x: charge is %0.1fuC.\n", charge_uc);
+        }
+        
+#if (SCD4X_CONFIG_ACCOUNTING != 0)
+        /* output the energy */
+        if (scd4x_shot_get_charge((float *)&charge_uah, (float *)&average_ua) == 0)
+        {
+            scd4x_interface_debug_print("scd4x: energy is %0.3fuAh, average current is %0.1fuA.\n", charge_uah, average_ua);
+        }
+#endif
+        
         /* shot deinit */
         (void)scd4x_shot_deinit();
         
@@ -396,12 +476,13 @@ uint8_t scd4x(uint8_t argc, char **argv)
         scd4x_interface_debug_print("  scd4x (-t read | --test=read) [--type=<SCD40 | SCD41 | SCD43>] [--times=<num>]\n");
         scd4x_interface_debug_print("  scd4x (-e read | --example=read) [--type=<SCD40 | SCD41 | SCD43>] [--times=<num>]\n");
         scd4x_interface_debug_print("  scd4x (-e shot | --example=shot) [--type=<SCD40 | SCD41 | SCD43>] [--times=<num>]\n");
+        scd4x_interface_debug_print("  scd4x (-e sleepy-shot | --example=sleepy-shot) [--type=<SCD41 | SCD43>] [--times=<num>]\n");
         scd4x_interface_debug_print("  scd4x (-e wake-up | --example=wake-up) [--type=<SCD40 | SCD41 | SCD43>]\n");
         scd4x_interface_debug_print("  scd4x (-e power-down | --example=power-down) [--type=<SCD40 | SCD41 | SCD43>]\n");
         scd4x_interface_debug_print("  scd4x (-e number | --example=number) [--type=<SCD40 | SCD41 | SCD43>]\n");
         scd4x_interface_debug_print("\n");
         scd4x_interface_debug_print("Options:\n");
-        scd4x_interface_debug_print("  -e <read | shot | wake-up | power-down | number>, --example=<read | shot | wake-up | power-down | number>\n");
+        scd4x_interface_debug_print("  -e <read | shot | sleepy-shot | wake-up | power-down | number>, --example=<read | shot | sleepy-shot | wake-up | power-down | number>\n");
         scd4x_interface_debug_print("                        Run the driver example.\n");
         scd4x_interface_debug_print("  -h, --help            Show the help.\n");
         scd4x_interface_debug_print("  -i, --information     Show the chip information.\n");
@@ -0,0 +1,270 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      maint_bench.c
+ * @brief     fleet maintenance benchmark source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "driver_scd4x_sim.h"
+#include "scd4xd_maint.h"
+#include <getopt.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+/**
+ * @brief maint bench definition
+ */
+#define SCD4X_MAINT_BENCH_SENSORS        64               /**< default sensor number */
+#define SCD4X_MAINT_BENCH_PER_ADAPTER    8                /**< sensors behind each simulated adapter */
+#define SCD4X_MAINT_BENCH_TARGET_PPM     400              /**< forced recalibration reference */
+#define SCD4X_MAINT_BENCH_POWER_UP_US    30000            /**< power up time of the simulated sensors */
+
+/**
+ * @brief maint bench structure definition
+ */
+typedef struct scd4x_maint_bench_s
+{
+    uint8_t op;                            /**< operation */
+    uint8_t per_bus;                       /**< sensors of one bus running at once */
+    uint32_t budget_ms;                    /**< job time of each bus, 0 for no limit */
+} scd4x_maint_bench_t;
+
+static scd4x_handle_t gs_handle[SCD4XD_MAINT_MAX_JOBS];        /**< scd4x handles */
+static scd4x_sim_t gs_sim[SCD4XD_MAINT_MAX_JOBS];              /**< simulated sensors */
+static uint64_t gs_next_us[SCD4XD_MAINT_MAX_JOBS];             /**< next step time of each job */
+static scd4xd_maint_t gs_maint;                                /**< maintenance run */
+
+/**
+ * @brief run list
+ */
+static const scd4x_maint_bench_t gs_bench[] =
+{
+    {SCD4XD_MAINT_OP_SELF_TEST, 1, 0},
+    {SCD4XD_MAINT_OP_SELF_TEST, 2, 0},
+    {SCD4XD_MAINT_OP_SELF_TEST, 8, 0},
+    {SCD4XD_MAINT_OP_SELF_TEST, 1, 60000},
+    {SCD4XD_MAINT_OP_FRC,       1, 0},
+    {SCD4XD_MAINT_OP_FRC,       8, 0},
+    {SCD4XD_MAINT_OP_PERSIST,   1, 0},
+    {SCD4XD_MAINT_OP_PERSIST,   8, 0},
+};
+
+/**
+ * @brief     start the periodic sensors
+ * @param[in] sensors sensor number
+ * @return    status code
+ *            - 0 success
+ *            - 1 start failed
+ * @note      every sensor has its own simulated clock, the bench sets it before each call
+ */
+static uint8_t a_maint_bench_start(uint16_t sensors)
+{
+    uint16_t i;
+    
+    for (i = 0; i < sensors; i++)
+    {
+        scd4x_sim_init(&gs_sim[i], SCD41);
+        gs_sim[i].now_us = SCD4X_MAINT_BENCH_POWER_UP_US;
+        scd4x_sim_attach(&gs_sim[i]);
+        DRIVER_SCD4X_LINK_INIT(&gs_handle[i], scd4x_handle_t);
+        DRIVER_SCD4X_LINK_SIM(&gs_handle[i]);
+        if ((scd4x_set_type(&gs_handle[i], SCD41) != 0) || (scd4x_init(&gs_handle[i]) != 0) || 
+            (scd4x_start_periodic_measurement(&gs_handle[i]) != 0))
+        {
+            return 1;
+        }
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief     run the jobs in the simulated time
+ * @param[in] *bench pointer to a run
+ * @param[in] sensors sensor number
+ * @return    status code
+ *            - 0 success
+ *            - 1 run failed
+ *            - 4 a job failed or a sensor is not measuring after the run
+ * @note      the admitted jobs step in the order of their next time like the poll timers of scd4xd
+ */
+static uint8_t a_maint_bench_run(const scd4x_maint_bench_t *bench, uint16_t sensors)
+{
+    scd4xd_maint_config_t config;
+    uint64_t now_us = SCD4X_MAINT_BENCH_POWER_UP_US;
+    uint32_t wait_us;
+    uint16_t restored = 0;
+    uint16_t job;
+    uint16_t i;
+    int32_t next;
+    
+    if (a_maint_bench_start(sensors) != 0)
+    {
+        return 1;
+    }
+    config.op = bench->op;
+    config.per_bus = bench->per_bus;
+    config.target_ppm = SCD4X_MAINT_BENCH_TARGET_PPM;
+    config.budget_us = (uint64_t)bench->budget_ms * 1000;
+    scd4xd_maint_init(&gs_maint, &config, now_us);
+    for (i = 0; i < sensors; i++)
+    {
+        if (scd4xd_maint_add(&gs_maint, i / SCD4X_MAINT_BENCH_PER_ADAPTER, SCD4XD_MAINT_MODE_PERIODIC) != 0)
+        {
+            return 1;
+        }
+    }
+    while (gs_maint.end_us == 0)
+    {
+        /* fill the free slots */
+        while (scd4xd_maint_next(&gs_maint, now_us, &job) == 0)
+        {
+            gs_next_us[job] = now_us;
+        }
+        
+        /* the earliest step */
+        next = -1;
+        for (i = 0; i < sensors; i++)
+        {
+            if ((gs_maint.job[i].state == SCD4XD_MAINT_STATE_ACTIVE) && ((next < 0) || (gs_next_us[i] < gs_next_us[next])))
+            {
+                next = i;
+            }
+        }
+        if (next < 0)
+        {
+            break;
+        }
+        now_us = gs_next_us[next];
+        gs_sim[next].now_us = now_us;
+        scd4x_sim_attach(&gs_sim[next]);
+        (void)scd4xd_maint_run(&gs_maint, (uint16_t)next, &gs_handle[next], now_us, &wait_us);
+        gs_next_us[next] = now_us + wait_us;
+    }
+    for (i = 0; i < sensors; i++)
+    {
+        restored += (gs_sim[i].period_ms != 0) ? 1 : 0;
+        scd4x_sim_attach(&gs_sim[i]);
+        (void)scd4x_deinit(&gs_handle[i]);
+    }
+    printf("%s,%u,%u,%u,%u,%u,%u,%u,%u,%.3f,%.3f,%.1f\n", 
+           (bench->op == SCD4XD_MAINT_OP_SELF_TEST) ? "self_test" : ((bench->op == SCD4XD_MAINT_OP_FRC) ? "frc" : "persist"), 
+           sensors, gs_maint.buses, bench->per_bus, bench->budget_ms, gs_maint.done, gs_maint.failed, gs_maint.skipped, restored, 
+           (double)(gs_maint.end_us - gs_maint.start_us) / 1e6, (double)gs_maint.serial_us / 1e6, 
+           (gs_maint.end_us > gs_maint.start_us) ? (double)gs_maint.serial_us / (double)(gs_maint.end_us - gs_maint.start_us) : 0.0);
+    
+    return ((gs_maint.failed != 0) || (restored != sensors)) ? 4 : 0;
+}
+
+/**
+ * @brief     maint bench main function
+ * @param[in] argc arg numbers
+ * @param[in] **argv arg address
+ * @return    status code
+ *            - 0 success
+ *            - 1 run failed, a job failed or a sensor is not measuring after the run
+ * @note      the sensors are simulated behind adapters of 8 sensors, each run prints one csv line,
+ *            window_s is the maintenance window and serial_s the window of a one by one run
+ */
+int main(int argc, char **argv)
+{
+    int c;
+    int longindex = 0;
+    const char short_options[] = "h";
+    const struct option long_options[] =
+    {
+        {"help", no_argument, NULL, 'h'},
+        {"sensors", required_argument, NULL, 1},
+        {NULL, 0, NULL, 0},
+    };
+    uint32_t sensors = SCD4X_MAINT_BENCH_SENSORS;
+    uint8_t failed = 0;
+    uint8_t res;
+    size_t i;
+    
+    optind = 0;
+    do
+    {
+        c = getopt_long(argc, argv, short_options, long_options, &longindex);
+        switch (c)
+        {
+            case 'h' :
+            {
+                printf("Usage:\n");
+                printf("  scd4x_maint_bench [--sensors=<num>]\n");
+                printf("\n");
+                printf("Options:\n");
+                printf("  -h, --help             Show the help.\n");
+                printf("      --sensors=<num>    Set the simulated sensor number.([default: %d])\n", SCD4X_MAINT_BENCH_SENSORS);
+                
+                return 0;
+            }
+            case 1 :
+            {
+                sensors = (uint32_t)atol(optarg);
+                
+                break;
+            }
+            case -1 :
+            {
+                break;
+            }
+            default :
+            {
+                return 1;
+            }
+        }
+    } while (c != -1);
+    if ((sensors == 0) || (sensors > SCD4XD_MAINT_MAX_JOBS))
+    {
+        return 1;
+    }
+    
+    printf("op,sensors,buses,per_bus,budget_ms,done,failed,skipped,restored,window_s,serial_s,speedup\n");
+    for (i = 0; i < sizeof(gs_bench) / sizeof(gs_bench[0]); i++)
+    {
+        res = a_maint_bench_run(&gs_bench[i], (uint16_t)sensors);
+        if (res == 1)
+        {
+            fprintf(stderr, "scd4x_maint_bench: setup failed.\n");
+            
+            return 1;
+        }
+        if (res != 0)
+        {
+            fprintf(stderr, "scd4x_maint_bench: a job failed or a sensor is not restored.\n");
+            failed = 1;
+        }
+    }
+    
+    return failed;
+}
@@ -0,0 +1,314 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      pressure_bench.c
+ * @brief     pressure compensation benchmark source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "driver_scd4x_sim.h"
+#include "scd4xd_pressure.h"
+#include <getopt.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+/**
+ * @brief pressure bench definition
+ */
+#define SCD4X_PRESSURE_BENCH_SENSORS        64               /**< default sensor number */
+#define SCD4X_PRESSURE_BENCH_HOURS          24               /**< default simulated hours */
+#define SCD4X_PRESSURE_BENCH_PERIOD_S       10               /**< barometer read interval */
+#define SCD4X_PRESSURE_BENCH_BASE_PA        101325.0         /**< mean pressure */
+#define SCD4X_PRESSURE_BENCH_DAY_PA         800.0            /**< daily swing */
+#define SCD4X_PRESSURE_BENCH_TIDE_PA        150.0            /**< 3 h atmospheric tide */
+#define SCD4X_PRESSURE_BENCH_FRONT_PA       500.0            /**< drop of the weather front */
+#define SCD4X_PRESSURE_BENCH_FRONT_S        50400            /**< start of the weather front */
+#define SCD4X_PRESSURE_BENCH_NOISE_PA       10               /**< barometer noise */
+#define SCD4X_PRESSURE_BENCH_POWER_UP_US    30000            /**< power up time of the simulated sensors */
+
+/**
+ * @brief pressure bench structure definition
+ */
+typedef struct scd4x_pressure_bench_s
+{
+    uint32_t threshold_pa;         /**< change which starts a round */
+    uint32_t max_age_ms;           /**< max time between the pushes, 0 for no limit */
+} scd4x_pressure_bench_t;
+
+static scd4x_handle_t gs_handle[SCD4XD_PRESSURE_MAX_SENSORS];        /**< scd4x handles */
+static scd4x_sim_t gs_sim[SCD4XD_PRESSURE_MAX_SENSORS];              /**< simulated sensors */
+static scd4xd_pressure_t gs_pressure;                                /**< pressure feed */
+static uint32_t gs_seed = 1;                                         /**< noise seed */
+
+/**
+ * @brief run list
+ */
+static const scd4x_pressure_bench_t gs_bench[] =
+{
+    {50,  3600000},
+    {100, 3600000},
+    {200, 3600000},
+    {100, 0},
+};
+
+/**
+ * @brief      read the simulated barometer
+ * @param[in]  *arg pointer to the time in seconds
+ * @param[out] *pa pointer to a pressure buffer in pa
+ * @return     status code
+ *             - 0 success
+ * @note       a daily swing, a 3 h tide, a 1 h front drop and uniform noise
+ */
+static uint8_t a_pressure_bench_read(void *arg, float *pa)
+{
+    double s = (double)(*(uint32_t *)arg);
+    double front;
+    double p;
+    
+    gs_seed = gs_seed * 1103515245U + 12345U;
+    front = (s > SCD4X_PRESSURE_BENCH_FRONT_S) ? fmin(1.0, (s - SCD4X_PRESSURE_BENCH_FRONT_S) / 3600.0) : 0.0;
+    p = SCD4X_PRESSURE_BENCH_BASE_PA + SCD4X_PRESSURE_BENCH_DAY_PA * sin(2.0 * M_PI * s / 86400.0) + 
+        SCD4X_PRESSURE_BENCH_TIDE_PA * sin(2.0 * M_PI * s / 10800.0) - SCD4X_PRESSURE_BENCH_FRONT_PA * front + 
+        (double)((int32_t)((gs_seed >> 16) % (2 * SCD4X_PRESSURE_BENCH_NOISE_PA + 1)) - SCD4X_PRESSURE_BENCH_NOISE_PA);
+    *pa = (float)p;
+    
+    return 0;
+}
+
+/**
+ * @brief     start the periodic sensors
+ * @param[in] sensors sensor number
+ * @return    status code
+ *            - 0 success
+ *            - 1 start failed
+ * @note      every sensor has its own simulated clock, the bench sets it before each call
+ */
+static uint8_t a_pressure_bench_start(uint16_t sensors)
+{
+    uint16_t i;
+    
+    for (i = 0; i < sensors; i++)
+    {
+        scd4x_sim_init(&gs_sim[i], SCD41);
+        gs_sim[i].now_us = SCD4X_PRESSURE_BENCH_POWER_UP_US;
+        scd4x_sim_attach(&gs_sim[i]);
+        DRIVER_SCD4X_LINK_INIT(&gs_handle[i], scd4x_handle_t);
+        DRIVER_SCD4X_LINK_SIM(&gs_handle[i]);
+        if ((scd4x_set_type(&gs_handle[i], SCD41) != 0) || (scd4x_init(&gs_handle[i]) != 0) || 
+            (scd4x_start_periodic_measurement(&gs_handle[i]) != 0))
+        {
+            return 1;
+        }
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief     run the feed in the simulated time
+ * @param[in] *bench pointer to a run
+ * @param[in] sensors sensor number
+ * @param[in] hours simulated hours
+ * @return    status code
+ *            - 0 success
+ *            - 1 run failed
+ *            - 4 a push failed, a sensor is off by more than the threshold or a push is lost
+ * @note      the queued pushes are sent right after each read like the next wake up of the scd4xd sensors,
+ *            sensor 0 loses its settings in the middle of the run and must be pushed again
+ */
+static uint8_t a_pressure_bench_run(const scd4x_pressure_bench_t *bench, uint16_t sensors, uint32_t hours)
+{
+    scd4xd_pressure_config_t config;
+    uint64_t now_us;
+    uint32_t s;
+    uint32_t naive;
+    uint32_t pending = 0;
+    uint16_t queued;
+    uint16_t reg;
+    uint16_t i;
+    double error;
+    double max_error = 0.0;
+    double limit;
+    uint8_t res;
+    
+    if (a_pressure_bench_start(sensors) != 0)
+    {
+        return 1;
+    }
+    config.threshold_pa = bench->threshold_pa;
+    config.max_age_us = (uint64_t)bench->max_age_ms * 1000;
+    config.batch_us = config.max_age_us / 10;
+    if (scd4xd_pressure_init(&gs_pressure, &config, a_pressure_bench_read, &s, sensors) != 0)
+    {
+        return 1;
+    }
+    gs_seed = 1;
+    for (s = 0; s < hours * 3600; s += SCD4X_PRESSURE_BENCH_PERIOD_S)
+    {
+        now_us = SCD4X_PRESSURE_BENCH_POWER_UP_US + (uint64_t)s * 1000000;
+        if (s == hours * 1800)
+        {
+            /* a power cycle clears the ambient pressure of sensor 0 */
+            gs_sim[0].settings.pressure = 1013;
+            scd4xd_pressure_reset(&gs_pressure, 0);
+        }
+        if (scd4xd_pressure_update(&gs_pressure, now_us, &queued) != 0)
+        {
+            return 1;
+        }
+        for (i = 0; i < sensors; i++)
+        {
+            if (scd4xd_pressure_take(&gs_pressure, i, &reg) == 0)
+            {
+                gs_sim[i].now_us = now_us;
+                scd4x_sim_attach(&gs_sim[i]);
+                res = scd4x_set_ambient_pressure(&gs_handle[i], reg);
+                scd4xd_pressure_done(&gs_pressure, i, res, now_us);
+            }
+            error = fabs((double)gs_pressure.pa - (double)gs_sim[i].settings.pressure * 100.0);
+            max_error = (error > max_error) ? error : max_error;
+        }
+    }
+    for (i = 0; i < sensors; i++)
+    {
+        pending += (gs_pressure.sensor[i].pending != 0) ? 1 : 0;
+        scd4x_sim_attach(&gs_sim[i]);
+        (void)scd4x_deinit(&gs_handle[i]);
+    }
+    naive = gs_pressure.reads * sensors;
+    printf("%u,%u,%u,%u,%u,%u,%u,%u,%u,%.1f,%.1f\n", sensors, bench->threshold_pa, bench->max_age_ms, gs_pressure.reads, 
+           gs_pressure.rounds, naive, gs_pressure.pushes, gs_pressure.failed, gs_pressure.avoided, 
+           100.0 * (double)gs_pressure.avoided / (double)naive, max_error);
+    
+    /* the register has 100 pa steps, so a sensor is off by at most half a step after a push */
+    limit = (bench->threshold_pa > 50) ? (double)bench->threshold_pa : 50.0;
+    if ((gs_pressure.failed != 0) || (max_error >= limit + 1.0) || 
+        (gs_pressure.pushes + gs_pressure.failed + gs_pressure.avoided + pending != naive))
+    {
+        return 4;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief     pressure bench main function
+ * @param[in] argc arg numbers
+ * @param[in] **argv arg address
+ * @return    status code
+ *            - 0 success
+ *            - 1 run failed, a push failed, a sensor is off by more than the threshold or a push is lost
+ * @note      each run prints one csv line, naive is the pushes of a feed sending every read to every sensor
+ *            and max_error_pa is the largest difference of the read and the pressure set in a sensor
+ */
+int main(int argc, char **argv)
+{
+    int c;
+    int longindex = 0;
+    const char short_options[] = "h";
+    const struct option long_options[] =
+    {
+        {"help", no_argument, NULL, 'h'},
+        {"sensors", required_argument, NULL, 1},
+        {"hours", required_argument, NULL, 2},
+        {NULL, 0, NULL, 0},
+    };
+    uint32_t sensors = SCD4X_PRESSURE_BENCH_SENSORS;
+    uint32_t hours = SCD4X_PRESSURE_BENCH_HOURS;
+    uint8_t failed = 0;
+    uint8_t res;
+    size_t i;
+    
+    optind = 0;
+    do
+    {
+        c = getopt_long(argc, argv, short_options, long_options, &longindex);
+        switch (c)
+        {
+            case 'h' :
+            {
+                printf("Usage:\n");
+                printf("  scd4x_pressure_bench [--sensors=<num>] [--hours=<num>]\n");
+                printf("\n");
+                printf("Options:\n");
+                printf("  -h, --help             Show the help.\n");
+                printf("      --hours=<num>      Set the simulated hours.([default: %d])\n", SCD4X_PRESSURE_BENCH_HOURS);
+                printf("      --sensors=<num>    Set the simulated sensor number.([default: %d])\n", SCD4X_PRESSURE_BENCH_SENSORS);
+                
+                return 0;
+            }
+            case 1 :
+            {
+                sensors = (uint32_t)atol(optarg);
+                
+                break;
+            }
+            case 2 :
+            {
+                hours = (uint32_t)atol(optarg);
+                
+                break;
+            }
+            case -1 :
+            {
+                break;
+            }
+            default :
+            {
+                return 1;
+            }
+        }
+    } while (c != -1);
+    if ((sensors == 0) || (sensors > SCD4XD_PRESSURE_MAX_SENSORS) || (hours == 0))
+    {
+        return 1;
+    }
+    
+    printf("sensors,threshold_pa,max_age_ms,reads,rounds,naive,pushes,failed,avoided,avoided_pct,max_error_pa\n");
+    for (i = 0; i < sizeof(gs_bench) / sizeof(gs_bench[0]); i++)
+    {
+        res = a_pressure_bench_run(&gs_bench[i], (uint16_t)sensors, hours);
+        if (res == 1)
+        {
+            fprintf(stderr, "scd4x_pressure_bench: setup failed.\n");
+            
+            return 1;
+        }
+        if (res != 0)
+        {
+            fprintf(stderr, "scd4x_pressure_bench: a push failed, a sensor is off or a push is lost.\n");
+            failed = 1;
+        }
+    }
+    
+    return failed;
+}
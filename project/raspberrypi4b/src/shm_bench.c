@@ -0,0 +1,393 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      shm_bench.c
+ * @brief     shm bench source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#define _GNU_SOURCE
+
+#include "scd4xd_shm.h"
+#include <getopt.h>
+#include <sched.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/wait.h>
+#include <time.h>
+#include <unistd.h>
+
+/**
+ * @brief shm bench definition
+ */
+#define SCD4X_SHM_BENCH_NAME           "/scd4x_shm_bench"        /**< shared memory name */
+#define SCD4X_SHM_BENCH_SAMPLES        10000                     /**< default published samples */
+#define SCD4X_SHM_BENCH_PERIOD_US      1000                      /**< default publish interval */
+#define SCD4X_SHM_BENCH_MAX_READERS    64                        /**< max reader processes */
+#define SCD4X_SHM_BENCH_SPIN           256                       /**< empty polls before yielding the cpu */
+#define SCD4X_SHM_BENCH_HOT_READS      1000000                   /**< reads of the hot read cost */
+
+/**
+ * @brief shm bench result structure definition
+ */
+typedef struct scd4x_shm_bench_result_s
+{
+    uint64_t received;        /**< read samples */
+    uint64_t lost;            /**< overwritten samples */
+    uint64_t torn;            /**< inconsistent samples */
+    uint64_t read_ns;         /**< hot read cost in ns */
+    uint64_t p50_ns;          /**< median latency */
+    uint64_t p99_ns;          /**< 99th percentile latency */
+    uint64_t max_ns;          /**< max latency */
+} scd4x_shm_bench_result_t;
+
+/**
+ * @brief  get the monotonic time
+ * @return time in ns
+ * @note   vdso, no syscall
+ */
+static uint64_t a_shm_bench_now_ns(void)
+{
+    struct timespec ts;
+    
+    (void)clock_gettime(CLOCK_MONOTONIC, &ts);
+    
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+/**
+ * @brief     compare two latencies
+ * @param[in] *a pointer to a latency
+ * @param[in] *b pointer to a latency
+ * @return    compare result
+ * @note      none
+ */
+static int a_shm_bench_compare(const void *a, const void *b)
+{
+    uint64_t x = *(const uint64_t *)a;
+    uint64_t y = *(const uint64_t *)b;
+    
+    return (x > y) - (x < y);
+}
+
+/**
+ * @brief     reader process
+ * @param[in] samples published sample number
+ * @param[in] ready_fd ready pipe
+ * @param[in] result_fd result pipe
+ * @return    status code
+ *            - 0 success
+ *            - 1 run failed
+ * @note      the read path has no syscall, the cpu is only yielded when the ring is empty
+ */
+static int a_shm_bench_reader(uint32_t samples, int ready_fd, int result_fd)
+{
+    scd4x_shm_bench_result_t result;
+    scd4xd_shm_sample_t out;
+    scd4xd_shm_t shm;
+    uint64_t *latency;
+    uint64_t cursor;
+    uint64_t start;
+    uint32_t spin = 0;
+    uint32_t i;
+    char c = 0;
+    
+    memset(&result, 0, sizeof(result));
+    memset(&shm, 0, sizeof(shm));
+    latency = (uint64_t *)malloc(sizeof(uint64_t) * samples);
+    if ((latency == NULL) || (scd4xd_shm_open(&shm, SCD4X_SHM_BENCH_NAME) != 0))
+    {
+        return 1;
+    }
+    cursor = scd4xd_shm_head(&shm);
+    if (write(ready_fd, &c, 1) != 1)
+    {
+        return 1;
+    }
+    
+    /* follow the writer */
+    while (cursor < samples)
+    {
+        if (scd4xd_shm_read(&shm, &cursor, &out, &result.lost) != 0)
+        {
+            if (++spin >= SCD4X_SHM_BENCH_SPIN)
+            {
+                spin = 0;
+                (void)sched_yield();
+            }
+            
+            continue;
+        }
+        latency[result.received++] = a_shm_bench_now_ns() - out.time_ns;
+        
+        /* the writer derives every field from the index */
+        if ((out.sample.co2_raw != (uint16_t)out.index) || 
+            (out.sample.read_time_us != out.index) || 
+            (out.sample.ready_time_us != ~out.index))
+        {
+            result.torn++;
+        }
+    }
+    
+    /* hot read cost of one stable slot */
+    start = a_shm_bench_now_ns();
+    for (i = 0; i < SCD4X_SHM_BENCH_HOT_READS; i++)
+    {
+        cursor = samples - 1;
+        (void)scd4xd_shm_read(&shm, &cursor, &out, &result.lost);
+    }
+    result.read_ns = (a_shm_bench_now_ns() - start) / SCD4X_SHM_BENCH_HOT_READS;
+    
+    /* latency percentiles */
+    if (result.received != 0)
+    {
+        qsort(latency, result.received, sizeof(uint64_t), a_shm_bench_compare);
+        result.p50_ns = latency[result.received / 2];
+        result.p99_ns = latency[(result.received * 99) / 100];
+        result.max_ns = latency[result.received - 1];
+    }
+    free(latency);
+    scd4xd_shm_close(&shm);
+    
+    return (write(result_fd, &result, sizeof(result)) == (ssize_t)sizeof(result)) ? 0 : 1;
+}
+
+/**
+ * @brief     run the writer and the readers
+ * @param[in] readers reader process number
+ * @param[in] samples published sample number
+ * @param[in] period_us publish interval
+ * @return    status code
+ *            - 0 success
+ *            - 1 run failed
+ * @note      the worst reader percentiles are printed
+ */
+static uint8_t a_shm_bench_run(uint32_t readers, uint32_t samples, uint32_t period_us)
+{
+    scd4x_shm_bench_result_t total;
+    scd4x_shm_bench_result_t result;
+    scd4x_sample_t sample;
+    scd4xd_shm_t shm;
+    struct timespec next;
+    int ready[2];
+    int results[2];
+    uint32_t done = 0;
+    uint32_t i;
+    pid_t pid;
+    char c;
+    
+    memset(&shm, 0, sizeof(shm));
+    memset(&total, 0, sizeof(total));
+    memset(&sample, 0, sizeof(sample));
+    if (scd4xd_shm_create(&shm, SCD4X_SHM_BENCH_NAME) != 0)
+    {
+        return 1;
+    }
+    if ((pipe(ready) != 0) || (pipe(results) != 0))
+    {
+        scd4xd_shm_close(&shm);
+        
+        return 1;
+    }
+    
+    /* start the readers and wait until all of them are mapped */
+    for (i = 0; i < readers; i++)
+    {
+        pid = fork();
+        if (pid == 0)
+        {
+            _exit(a_shm_bench_reader(samples, ready[1], results[1]));
+        }
+        if (pid < 0)
+        {
+            break;
+        }
+    }
+    readers = i;
+    for (i = 0; i < readers; i++)
+    {
+        if (read(ready[0], &c, 1) != 1)
+        {
+            break;
+        }
+    }
+    
+    /* publish on a fixed period */
+    (void)clock_gettime(CLOCK_MONOTONIC, &next);
+    for (i = 0; i < samples; i++)
+    {
+        next.tv_nsec += (long)period_us * 1000;
+        while (next.tv_nsec >= 1000000000L)
+        {
+            next.tv_nsec -= 1000000000L;
+            next.tv_sec++;
+        }
+        (void)clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &next, NULL);
+        sample.co2_raw = (uint16_t)i;
+        sample.co2_ppm = (uint16_t)i;
+        sample.read_time_us = i;
+        sample.ready_time_us = ~(uint64_t)i;
+        scd4xd_shm_write(&shm, 0, 0, &sample);
+    }
+    
+    /* collect the results */
+    for (i = 0; i < readers; i++)
+    {
+        if (read(results[0], &result, sizeof(result)) != (ssize_t)sizeof(result))
+        {
+            break;
+        }
+        done++;
+        total.received += result.received;
+        total.lost += result.lost;
+        total.torn += result.torn;
+        total.read_ns += result.read_ns;
+        total.p50_ns = (result.p50_ns > total.p50_ns) ? result.p50_ns : total.p50_ns;
+        total.p99_ns = (result.p99_ns > total.p99_ns) ? result.p99_ns : total.p99_ns;
+        total.max_ns = (result.max_ns > total.max_ns) ? result.max_ns : total.max_ns;
+    }
+    while (wait(NULL) > 0)
+    {
+        
+    }
+    (void)close(ready[0]);
+    (void)close(ready[1]);
+    (void)close(results[0]);
+    (void)close(results[1]);
+    scd4xd_shm_close(&shm);
+    if ((done == 0) || (done != readers))
+    {
+        return 1;
+    }
+    printf("%u,%u,%u,%llu,%llu,%llu,%llu,%llu,%llu,%llu\n", readers, samples, period_us, 
+           (unsigned long long)total.received, (unsigned long long)total.lost, (unsigned long long)total.torn, 
+           (unsigned long long)(total.read_ns / done), (unsigned long long)total.p50_ns, 
+           (unsigned long long)total.p99_ns, (unsigned long long)total.max_ns);
+    
+    return (total.torn == 0) ? 0 : 1;
+}
+
+/**
+ * @brief     shm bench main function
+ * @param[in] argc arg numbers
+ * @param[in] **argv arg address
+ * @return    status code
+ *            - 0 success
+ *            - 1 run failed
+ * @note      none
+ */
+int main(int argc, char **argv)
+{
+    int c;
+    int longindex = 0;
+    const char short_options[] = "h";
+    const struct option long_options[] =
+    {
+        {"help", no_argument, NULL, 'h'},
+        {"samples", required_argument, NULL, 1},
+        {"period", required_argument, NULL, 2},
+        {"readers", required_argument, NULL, 3},
+        {NULL, 0, NULL, 0},
+    };
+    uint32_t readers[2] = {1, 16};
+    uint32_t runs = 2;
+    uint32_t samples = SCD4X_SHM_BENCH_SAMPLES;
+    uint32_t period_us = SCD4X_SHM_BENCH_PERIOD_US;
+    uint32_t i;
+    
+    optind = 0;
+    do
+    {
+        c = getopt_long(argc, argv, short_options, long_options, &longindex);
+        switch (c)
+        {
+            case 'h' :
+            {
+                printf("Usage:\n");
+                printf("  scd4x_shm_bench [--samples=<num>] [--period=<us>] [--readers=<num>]\n");
+                printf("\n");
+                printf("Options:\n");
+                printf("  -h, --help             Show the help.\n");
+                printf("      --period=<us>      Set the publish interval.([default: %d])\n", SCD4X_SHM_BENCH_PERIOD_US);
+                printf("      --readers=<num>    Run only this reader number.([default: 1 and 16])\n");
+                printf("      --samples=<num>    Set the published samples.([default: %d])\n", SCD4X_SHM_BENCH_SAMPLES);
+                
+                return 0;
+            }
+            case 1 :
+            {
+                samples = (uint32_t)atol(optarg);
+                
+                break;
+            }
+            case 2 :
+            {
+                period_us = (uint32_t)atol(optarg);
+                
+                break;
+            }
+            case 3 :
+            {
+                readers[0] = (uint32_t)atol(optarg);
+                runs = 1;
+                
+                break;
+            }
+            case -1 :
+            {
+                break;
+            }
+            default :
+            {
+                return 1;
+            }
+        }
+    } while (c != -1);
+    if ((samples == 0) || (readers[0] == 0) || (readers[0] > SCD4X_SHM_BENCH_MAX_READERS))
+    {
+        return 1;
+    }
+    
+    printf("readers,samples,period_us,received,lost,torn,read_ns,p50_ns,p99_ns,max_ns\n");
+    fflush(stdout);
+    for (i = 0; i < runs; i++)
+    {
+        if (a_shm_bench_run(readers[i], samples, period_us) != 0)
+        {
+            fprintf(stderr, "scd4x_shm_bench: %u readers failed.\n", readers[i]);
+            
+            return 1;
+        }
+        fflush(stdout);
+    }
+    
+    return 0;
+}
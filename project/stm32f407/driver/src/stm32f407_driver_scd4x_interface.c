@@ -104,6 +104,42 @@ void scd4x_interface_delay_ms(uint32_t ms)
     delay_ms(ms);
 }
 
+static uint32_t gs_tick_last = 0;        /**< last hal tick */
+static uint32_t gs_tick_high = 0;        /**< hal tick wrap number */
+
+/**
+ * @brief  interface get time us
+ * @return monotonic time in us
+ * @note   the 1ms hal tick is extended to 64 bits and the microseconds are read from the systick counter,
+ *         call it at least once each 49.7 days and not with the interrupts disabled
+ */
+uint64_t scd4x_interface_get_time_us(void)
+{
+    uint32_t tick;
+    uint32_t val;
+    uint32_t load;
+    
+    /* read the tick and the counter of the same millisecond */
+    do
+    {
+        tick = HAL_GetTick();
+        val = SysTick->VAL;
+    } while (tick != HAL_GetTick());
+    
+    /* extend the tick */
+    if (tick < gs_tick_last)
+    {
+        gs_tick_high++;
+    }
+    gs_tick_last = tick;
+    
+    /* the systick counts down from load each millisecond */
+    load = SysTick->LOAD;
+    
+    return ((((uint64_t)gs_tick_high << 32) | tick) * 1000) + 
+           (uint64_t)(load - val) * 1000 / ((uint64_t)load + 1);
+}
+
 /**
  * @brief     interface print format data
  * @param[in] fmt format data
@@ -72,6 +72,7 @@
 #define SCD4X_COMMAND_GET_DATA_READY_STATUS                         0xE4B8U        /**< get data ready status command */
 #define SCD4X_COMMAND_PERSIST_SETTINGS                              0x3615U        /**< persist settings command */
 #define SCD4X_COMMAND_GET_SERIAL_NUMBER                             0x3682U        /**< get serial number command */
+#define SCD4X_COMMAND_GET_SENSOR_VARIANT                            0x202FU        /**< get sensor variant command */
 #define SCD4X_COMMAND_PERFORM_SELF_TEST                             0x3639U        /**< perform self test command */
 #define SCD4X_COMMAND_PERFORM_FACTORY_RESET                         0x3632U        /**< perform factory reset command */
 #define SCD4X_COMMAND_REINIT                                        0x3646U        /**< reinit command */
@@ -91,52 +92,423 @@
 #define SCD4X_CRC8_INIT              0xFF
 
 /**
- * @brief      read bytes with param
- * @param[in]  *handle pointer to an scd4x handle structure
- * @param[in]  reg iic register address
- * @param[in]  *data pointer to a data buffer
- * @param[in]  len data length
- * @param[in]  delay_ms delay time in ms
- * @param[out] *output pointer to an output buffer
- * @param[in]  output_len output length
- * @return     status code
- *             - 0 success
- *             - 1 read failed
- * @note       none
+ * @brief data ready polling definition
+ */
+#define SCD4X_DATA_READY_MIN_INTERVAL        10          /**< 10ms */
+#define SCD4X_DATA_READY_MAX_INTERVAL        1000        /**< 1000ms */
+#define SCD4X_DATA_READY_MAX_INTERVAL_LIMIT  60000       /**< 60000ms */
+
+/**
+ * @brief non-blocking poll state definition
+ */
+#define SCD4X_POLL_IDLE          0        /**< no command in flight */
+#define SCD4X_POLL_STATUS        1        /**< get data ready status is sent */
+#define SCD4X_POLL_READ          2        /**< read measurement is sent */
+
+#if (SCD4X_CONFIG_SINGLE_SHOT != 0)
+/**
+ * @brief sleepy shot flag definition
+ */
+#define SCD4X_SLEEPY_ENABLE            (1 << 0)        /**< sleepy shot mode, the chip sleeps between the readings */
+#define SCD4X_SLEEPY_FIRST_SHOT        (1 << 1)        /**< the first shot after a wake up is used */
+
+/**
+ * @brief hybrid shot definition
+ */
+#define SCD4X_HYBRID_NONE        0        /**< no shot in flight */
+#define SCD4X_HYBRID_RHT         1        /**< rht only shot in flight */
+#define SCD4X_HYBRID_FULL        2        /**< full shot in flight */
+
+/**
+ * @brief shot data ready timeout definition
+ */
+#define SCD4X_SHOT_READY_TIMEOUT        1000        /**< 1000ms after the shot execution time */
+#endif
+
+#if (SCD4X_CONFIG_ACCOUNTING != 0)
+/**
+ * @brief account flag and timed state definition
+ */
+#define SCD4X_ACCOUNT_OFF              0                  /**< accounting is not started */
+#define SCD4X_ACCOUNT_RUN              1                  /**< accounting is running */
+#define SCD4X_ACCOUNT_HOLD             2                  /**< accounting is stopped, the counters are kept */
+#define SCD4X_ACCOUNT_SHOT_US          5000000ULL         /**< single shot time */
+#define SCD4X_ACCOUNT_RHT_ONLY_US      50000ULL           /**< rht only single shot time */
+#define SCD4X_ACCOUNT_WAKE_UP_US       30000ULL           /**< wake up time */
+#define SCD4X_ACCOUNT_SELF_TEST_US     10000000ULL        /**< self test time */
+#endif
+
+/**
+ * @brief log definition
+ */
+#define SCD4X_LOG_TEXT          ((SCD4X_CONFIG_LOG_BINARY == 0) && (SCD4X_CONFIG_LOG_LEVEL >= SCD4X_LOG_LEVEL_ERROR))        /**< text log */
+#define SCD4X_LOG_BINARY        ((SCD4X_CONFIG_LOG_BINARY != 0) && (SCD4X_CONFIG_LOG_LEVEL >= SCD4X_LOG_LEVEL_ERROR))        /**< binary log */
+#if (SCD4X_CONFIG_LOG_BINARY != 0)
+    #define SCD4X_LOG_OUTPUT(HANDLE, LEVEL, ID, ARG, ...)    a_scd4x_log(HANDLE, LEVEL, ID, (uint16_t)(ARG))
+#else
+    #define SCD4X_LOG_OUTPUT(HANDLE, LEVEL, ID, ARG, ...)    (HANDLE)->debug_print(__VA_ARGS__)
+#endif
+#if (SCD4X_CONFIG_LOG_LEVEL >= SCD4X_LOG_LEVEL_ERROR)
+    #define SCD4X_LOG_ERROR(HANDLE, ID, ARG, ...)            SCD4X_LOG_OUTPUT(HANDLE, SCD4X_LOG_LEVEL_ERROR, ID, ARG, __VA_ARGS__)
+#else
+    #define SCD4X_LOG_ERROR(HANDLE, ID, ARG, ...)            ((void)(HANDLE))
+#endif
+#if (SCD4X_CONFIG_LOG_LEVEL >= SCD4X_LOG_LEVEL_WARNING)
+    #define SCD4X_LOG_WARNING(HANDLE, ID, ARG, ...)          SCD4X_LOG_OUTPUT(HANDLE, SCD4X_LOG_LEVEL_WARNING, ID, ARG, __VA_ARGS__)
+#else
+    #define SCD4X_LOG_WARNING(HANDLE, ID, ARG, ...)          ((void)(HANDLE))
+#endif
+#if (SCD4X_LOG_TEXT != 0)
+    #define SCD4X_NAME(NAME)                                 NAME
+#else
+    #define SCD4X_NAME(NAME)
+#endif
+
+/**
+ * @brief chip type mask definition
+ */
+#define SCD4X_TYPE_ALL               ((1U << SCD40) | (1U << SCD41) | (1U << SCD43))        /**< all chips */
+#define SCD4X_TYPE_SCD41_SCD43       ((1U << SCD41) | (1U << SCD43))                        /**< scd41 and scd43 only */
+
+/**
+ * @brief command flag definition
  */
-static uint8_t a_scd4x_iic_read_with_param(scd4x_handle_t *handle, uint16_t reg, uint8_t *data, uint16_t len,
-                                           uint16_t delay_ms, uint8_t *output, uint16_t output_len)
+#define SCD4X_FLAG_NO_ACK            (1U << 0)        /**< the write result is ignored */
+#define SCD4X_FLAG_NO_WRITE          (1U << 1)        /**< only read the response of the last command */
+
+/**
+ * @brief scd4x command index enumeration definition
+ */
+typedef enum
 {
-    uint8_t buf[16];
-    uint16_t i;
-        
-    if ((len + 2) > 16)                                                            /* check length */
+    SCD4X_CMD_START_PERIODIC = 0,                    /**< start periodic measurement */
+    SCD4X_CMD_READ,                                  /**< read measurement */
+    SCD4X_CMD_STOP_PERIODIC,                         /**< stop periodic measurement */
+#if (SCD4X_CONFIG_COMPENSATION != 0)
+    SCD4X_CMD_SET_TEMPERATURE_OFFSET,                /**< set temperature offset */
+    SCD4X_CMD_GET_TEMPERATURE_OFFSET,                /**< get temperature offset */
+    SCD4X_CMD_SET_SENSOR_ALTITUDE,                   /**< set sensor altitude */
+    SCD4X_CMD_GET_SENSOR_ALTITUDE,                   /**< get sensor altitude */
+    SCD4X_CMD_SET_AMBIENT_PRESSURE,                  /**< set ambient pressure */
+    SCD4X_CMD_GET_AMBIENT_PRESSURE,                  /**< get ambient pressure */
+#endif
+#if (SCD4X_CONFIG_FRC != 0)
+    SCD4X_CMD_PERFORM_FORCED_RECALIBRATION,          /**< perform forced recalibration */
+    SCD4X_CMD_START_FORCED_RECALIBRATION,            /**< start forced recalibration */
+    SCD4X_CMD_GET_FORCED_RECALIBRATION_RESULT,       /**< get forced recalibration result */
+#endif
+#if (SCD4X_CONFIG_ASC != 0)
+    SCD4X_CMD_SET_AUTO_SELF_CALIBRATION,             /**< set automatic self calibration */
+    SCD4X_CMD_GET_AUTO_SELF_CALIBRATION,             /**< get automatic self calibration */
+    SCD4X_CMD_SET_AUTO_SELF_CALIBRATION_INIT,        /**< set automatic self calibration initial period */
+    SCD4X_CMD_GET_AUTO_SELF_CALIBRATION_INIT,        /**< get automatic self calibration initial period */
+    SCD4X_CMD_SET_AUTO_SELF_CALIBRATION_STANDARD,    /**< set automatic self calibration standard period */
+    SCD4X_CMD_GET_AUTO_SELF_CALIBRATION_STANDARD,    /**< get automatic self calibration standard period */
+#endif
+    SCD4X_CMD_START_LOW_POWER_PERIODIC,              /**< start low power periodic measurement */
+    SCD4X_CMD_GET_DATA_READY_STATUS,                 /**< get data ready status */
+#if (SCD4X_CONFIG_PERSIST != 0)
+    SCD4X_CMD_PERSIST_SETTINGS,                      /**< persist settings */
+#endif
+    SCD4X_CMD_GET_SERIAL_NUMBER,                     /**< get serial number */
+    SCD4X_CMD_GET_SENSOR_VARIANT,                    /**< get sensor variant */
+#if (SCD4X_CONFIG_SELF_TEST != 0)
+    SCD4X_CMD_PERFORM_SELF_TEST,                     /**< perform self test */
+    SCD4X_CMD_START_SELF_TEST,                       /**< start self test */
+    SCD4X_CMD_GET_SELF_TEST_RESULT,                  /**< get self test result */
+#endif
+#if (SCD4X_CONFIG_FACTORY_RESET != 0)
+    SCD4X_CMD_PERFORM_FACTORY_RESET,                 /**< perform factory reset */
+#endif
+    SCD4X_CMD_REINIT,                                /**< reinit */
+#if (SCD4X_CONFIG_SINGLE_SHOT != 0)
+    SCD4X_CMD_MEASURE_SINGLE_SHOT,                   /**< measure single shot */
+    SCD4X_CMD_MEASURE_SINGLE_SHOT_RHT_ONLY,          /**< measure single shot rht only */
+    SCD4X_CMD_POWER_DOWN,                            /**< power down */
+    SCD4X_CMD_WAKE_UP,                               /**< wake up */
+#endif
+    SCD4X_CMD_MAX,                                   /**< command number */
+} scd4x_cmd_t;
+
+/**
+ * @brief scd4x command descriptor structure definition
+ */
+typedef struct scd4x_command_s
+{
+    uint16_t command;          /**< command code */
+    uint16_t exec_ms;          /**< execution time in ms */
+    uint8_t tx_words;          /**< argument words */
+    uint8_t rx_words;          /**< response words */
+    uint8_t type_mask;         /**< allowed chip types */
+    uint8_t crc_res;           /**< status code of a crc error */
+    uint8_t flags;             /**< command flags */
+#if (SCD4X_LOG_TEXT != 0)
+    const char *name;          /**< command name used by the failed message */
+#endif
+} scd4x_command_t;
+
+/**
+ * @brief scd4x command descriptor table
+ */
+static const scd4x_command_t gs_scd4x_command[SCD4X_CMD_MAX] =
+{
+    /* command, execution time, tx words, rx words, chip types, crc error code, flags, name */
+    [SCD4X_CMD_START_PERIODIC]                     = {SCD4X_COMMAND_START_PERIODIC,                            0,     0, 0, SCD4X_TYPE_ALL,         4, 0,                   SCD4X_NAME("start periodic measurement")},
+    [SCD4X_CMD_READ]                               = {SCD4X_COMMAND_READ,                                      1,     0, 3, SCD4X_TYPE_ALL,         4, 0,                   SCD4X_NAME("read")},
+    [SCD4X_CMD_STOP_PERIODIC]                      = {SCD4X_COMMAND_STOP_PERIODIC,                             500,   0, 0, SCD4X_TYPE_ALL,         4, 0,                   SCD4X_NAME("stop periodic measurement")},
+#if (SCD4X_CONFIG_COMPENSATION != 0)
+    [SCD4X_CMD_SET_TEMPERATURE_OFFSET]             = {SCD4X_COMMAND_SET_TEMPERATURE_OFFSET,                    1,     1, 0, SCD4X_TYPE_ALL,         4, 0,                   SCD4X_NAME("set temperature offset")},
+    [SCD4X_CMD_GET_TEMPERATURE_OFFSET]             = {SCD4X_COMMAND_GET_TEMPERATURE_OFFSET,                    1,     0, 1, SCD4X_TYPE_ALL,         4, 0,                   SCD4X_NAME("get temperature offset")},
+    [SCD4X_CMD_SET_SENSOR_ALTITUDE]                = {SCD4X_COMMAND_SET_SENSOR_ALTITUDE,                       1,     1, 0, SCD4X_TYPE_ALL,         4, 0,                   SCD4X_NAME("set sensor altitude")},
+    [SCD4X_CMD_GET_SENSOR_ALTITUDE]                = {SCD4X_COMMAND_GET_SENSOR_ALTITUDE,                       1,     0, 1, SCD4X_TYPE_ALL,         4, 0,                   SCD4X_NAME("get sensor altitude")},
+    [SCD4X_CMD_SET_AMBIENT_PRESSURE]               = {SCD4X_COMMAND_SET_AMBIENT_PRESSURE,                      1,     1, 0, SCD4X_TYPE_ALL,         4, 0,                   SCD4X_NAME("set ambient pressure")},
+    [SCD4X_CMD_GET_AMBIENT_PRESSURE]               = {SCD4X_COMMAND_GET_AMBIENT_PRESSURE,                      1,     0, 1, SCD4X_TYPE_ALL,         4, 0,                   SCD4X_NAME("get ambient pressure")},
+#endif
+#if (SCD4X_CONFIG_FRC != 0)
+    [SCD4X_CMD_PERFORM_FORCED_RECALIBRATION]       = {SCD4X_COMMAND_PERFORM_FORCED_RECALIBRATION,              400,   1, 1, SCD4X_TYPE_ALL,         4, 0,                   SCD4X_NAME("perform forced recalibration")},
+    [SCD4X_CMD_START_FORCED_RECALIBRATION]         = {SCD4X_COMMAND_PERFORM_FORCED_RECALIBRATION,              400,   1, 0, SCD4X_TYPE_ALL,         4, 0,                   SCD4X_NAME("start forced recalibration")},
+    [SCD4X_CMD_GET_FORCED_RECALIBRATION_RESULT]    = {SCD4X_COMMAND_PERFORM_FORCED_RECALIBRATION,              0,     0, 1, SCD4X_TYPE_ALL,         4, SCD4X_FLAG_NO_WRITE, SCD4X_NAME("get forced recalibration result")},
+#endif
+#if (SCD4X_CONFIG_ASC != 0)
+    [SCD4X_CMD_SET_AUTO_SELF_CALIBRATION]          = {SCD4X_COMMAND_SET_AUTO_SELF_CALIBRATION,                 1,     1, 0, SCD4X_TYPE_ALL,         4, 0,                   SCD4X_NAME("set automatic self calibration")},
+    [SCD4X_CMD_GET_AUTO_SELF_CALIBRATION]          = {SCD4X_COMMAND_GET_AUTO_SELF_CALIBRATION,                 1,     0, 1, SCD4X_TYPE_ALL,         4, 0,                   SCD4X_NAME("get automatic self calibration")},
+    [SCD4X_CMD_SET_AUTO_SELF_CALIBRATION_INIT]     = {SCD4X_COMMAND_SET_AUTO_SELF_CALIBRATION_INIT_PERIOD,     1,     1, 0, SCD4X_TYPE_SCD41_SCD43, 4, 0,                   SCD4X_NAME("set automatic self calibration initial period")},
+    [SCD4X_CMD_GET_AUTO_SELF_CALIBRATION_INIT]     = {SCD4X_COMMAND_GET_AUTO_SELF_CALIBRATION_INIT_PERIOD,     1,     0, 1, SCD4X_TYPE_SCD41_SCD43, 5, 0,                   SCD4X_NAME("get automatic self calibration initial period")},
+    [SCD4X_CMD_SET_AUTO_SELF_CALIBRATION_STANDARD] = {SCD4X_COMMAND_SET_AUTO_SELF_CALIBRATION_STANDARD_PERIOD, 1,     1, 0, SCD4X_TYPE_SCD41_SCD43, 4, 0,                   SCD4X_NAME("set automatic self calibration standard period")},
+    [SCD4X_CMD_GET_AUTO_SELF_CALIBRATION_STANDARD] = {SCD4X_COMMAND_GET_AUTO_SELF_CALIBRATION_STANDARD_PERIOD, 1,     0, 1, SCD4X_TYPE_SCD41_SCD43, 5, 0,                   SCD4X_NAME("get automatic self calibration standard period")},
+#endif
+    [SCD4X_CMD_START_LOW_POWER_PERIODIC]           = {SCD4X_COMMAND_START_LOW_POWER_PERIODIC,                  0,     0, 0, SCD4X_TYPE_ALL,         4, 0,                   SCD4X_NAME("start low power periodic measurement")},
+    [SCD4X_CMD_GET_DATA_READY_STATUS]              = {SCD4X_COMMAND_GET_DATA_READY_STATUS,                     1,     0, 1, SCD4X_TYPE_ALL,         4, 0,                   SCD4X_NAME("get data ready status")},
+#if (SCD4X_CONFIG_PERSIST != 0)
+    [SCD4X_CMD_PERSIST_SETTINGS]                   = {SCD4X_COMMAND_PERSIST_SETTINGS,                          800,   0, 0, SCD4X_TYPE_ALL,         4, 0,                   SCD4X_NAME("persist settings")},
+#endif
+    [SCD4X_CMD_GET_SERIAL_NUMBER]                  = {SCD4X_COMMAND_GET_SERIAL_NUMBER,                         1,     0, 3, SCD4X_TYPE_ALL,         4, 0,                   SCD4X_NAME("get serial number")},
+    [SCD4X_CMD_GET_SENSOR_VARIANT]                 = {SCD4X_COMMAND_GET_SENSOR_VARIANT,                        1,     0, 1, SCD4X_TYPE_ALL,         4, 0,                   SCD4X_NAME("get sensor variant")},
+#if (SCD4X_CONFIG_SELF_TEST != 0)
+    [SCD4X_CMD_PERFORM_SELF_TEST]                  = {SCD4X_COMMAND_PERFORM_SELF_TEST,                         10000, 0, 1, SCD4X_TYPE_ALL,         4, 0,                   SCD4X_NAME("perform self test")},
+    [SCD4X_CMD_START_SELF_TEST]                    = {SCD4X_COMMAND_PERFORM_SELF_TEST,                         10000, 0, 0, SCD4X_TYPE_ALL,         4, 0,                   SCD4X_NAME("start self test")},
+    [SCD4X_CMD_GET_SELF_TEST_RESULT]               = {SCD4X_COMMAND_PERFORM_SELF_TEST,                         0,     0, 1, SCD4X_TYPE_ALL,         4, SCD4X_FLAG_NO_WRITE, SCD4X_NAME("get self test result")},
+#endif
+#if (SCD4X_CONFIG_FACTORY_RESET != 0)
+    [SCD4X_CMD_PERFORM_FACTORY_RESET]              = {SCD4X_COMMAND_PERFORM_FACTORY_RESET,                     1200,  0, 0, SCD4X_TYPE_ALL,         4, 0,                   SCD4X_NAME("perform factory reset")},
+#endif
+    [SCD4X_CMD_REINIT]                             = {SCD4X_COMMAND_REINIT,                                    30,    0, 0, SCD4X_TYPE_ALL,         4, 0,                   SCD4X_NAME("reinit")},
+#if (SCD4X_CONFIG_SINGLE_SHOT != 0)
+    [SCD4X_CMD_MEASURE_SINGLE_SHOT]                = {SCD4X_COMMAND_MEASURE_SINGLE_SHOT,                       5000,  0, 0, SCD4X_TYPE_SCD41_SCD43, 4, 0,                   SCD4X_NAME("measure single shot")},
+    [SCD4X_CMD_MEASURE_SINGLE_SHOT_RHT_ONLY]       = {SCD4X_COMMAND_MEASURE_SINGLE_SHOT_RHT_ONLY,              50,    0, 0, SCD4X_TYPE_SCD41_SCD43, 4, 0,                   SCD4X_NAME("measure single shot rht only")},
+    [SCD4X_CMD_POWER_DOWN]                         = {SCD4X_COMMAND_POWER_DOWN,                                1,     0, 0, SCD4X_TYPE_SCD41_SCD43, 4, 0,                   SCD4X_NAME("power down")},
+    [SCD4X_CMD_WAKE_UP]                            = {SCD4X_COMMAND_WAKE_UP,                                   30,    0, 0, SCD4X_TYPE_SCD41_SCD43, 4, SCD4X_FLAG_NO_ACK,   SCD4X_NAME("wake up")},
+#endif
+};
+
+/**
+ * @brief     set the pending command execution time
+ * @param[in] *handle pointer to an scd4x handle structure
+ * @param[in] ms execution time in ms
+ * @note      the time is counted from now if get_time_us is linked
+ */
+static void a_scd4x_set_pending(scd4x_handle_t *handle, uint32_t ms)
+{
+    handle->wait_ms = ms;                                 /* set pending time */
+    if (handle->get_time_us != NULL)                      /* check time source */
     {
-        return 1;                                                                  /* return error */
+        handle->cmd_time_us = handle->get_time_us();      /* save the command issue time */
     }
-    memset(buf, 0, sizeof(uint8_t) * 16);                                          /* clear the buffer */
-    buf[0] = (uint8_t)((reg >> 8) & 0xFF);                                         /* set MSB of reg */
-    buf[1] = (uint8_t)(reg & 0xFF);                                                /* set LSB of reg */
-    for (i = 0; i < len; i++)
+}
+
+/**
+ * @brief     wait the pending command execution time
+ * @param[in] *handle pointer to an scd4x handle structure
+ * @note      only the rest time is waited if get_time_us is linked
+ */
+static void a_scd4x_wait_pending(scd4x_handle_t *handle)
+{
+    uint64_t wait_us;
+    uint64_t elapsed_us;
+    
+    if (handle->wait_ms == 0)                                                    /* check pending time */
     {
-        buf[2 + i] = data[i];                                                      /* copy write data */
+        return;                                                                  /* no pending command */
+    }
+    if (handle->get_time_us != NULL)                                             /* check time source */
+    {
+        wait_us = (uint64_t)handle->wait_ms * 1000;                              /* set wait time */
+        elapsed_us = handle->get_time_us() - handle->cmd_time_us;                /* get elapsed time */
+        if (elapsed_us < wait_us)                                                /* check elapsed time */
+        {
+            handle->delay_ms((uint32_t)((wait_us - elapsed_us + 999) / 1000));   /* delay the rest time */
+        }
+    }
+    else
+    {
+        handle->delay_ms(handle->wait_ms);                                       /* delay pending time */
     }
+    handle->wait_ms = 0;                                                         /* clear pending time */
+}
+
+/**
+ * @brief     get the rest of the pending command execution time
+ * @param[in] *handle pointer to an scd4x handle structure
+ * @return    rest time in us
+ * @note      the whole execution time is returned if get_time_us is not linked
+ */
+static uint64_t a_scd4x_pending_us(scd4x_handle_t *handle)
+{
+    uint64_t wait_us;
+    uint64_t elapsed_us;
     
-    if (handle->iic_write_cmd(SCD4X_ADDRESS, (uint8_t *)buf, len + 2) != 0)        /* write iic command */
+    wait_us = (uint64_t)handle->wait_ms * 1000;                             /* set wait time */
+    if ((wait_us != 0) && (handle->get_time_us != NULL))                    /* check time source */
     {
-        return 1;                                                                  /* write command */
+        elapsed_us = handle->get_time_us() - handle->cmd_time_us;           /* get elapsed time */
+        if (elapsed_us < wait_us)                                           /* check elapsed time */
+        {
+            wait_us -= elapsed_us;                                          /* get the rest time */
+        }
+        else
+        {
+            wait_us = 0;                                                    /* finished */
+        }
     }
-    handle->delay_ms(delay_ms);                                                    /* delay ms */
-    if (handle->iic_read_cmd(SCD4X_ADDRESS, output, output_len) != 0)              /* read data */
+    
+    return wait_us;                                                         /* return the rest time */
+}
+
+/**
+ * @brief     save the data ready seen time
+ * @param[in] *handle pointer to an scd4x handle structure
+ * @note      the first transition is kept until the data is read
+ */
+static void a_scd4x_mark_ready(scd4x_handle_t *handle)
+{
+    if (handle->ready_flag == 0)                                   /* check flag */
     {
-        return 1;                                                                  /* write command */
+        if (handle->get_time_us != NULL)                           /* check time source */
+        {
+            handle->ready_time_us = handle->get_time_us();         /* save the time */
+        }
+        else
+        {
+            handle->ready_time_us = 0;                             /* no time source */
+        }
+        handle->ready_flag = 1;                                    /* set flag */
     }
-    else
+}
+
+#if (SCD4X_CONFIG_ACCOUNTING != 0)
+/**
+ * @brief     count the time of the accounted states up to now
+ * @param[in] *handle pointer to an scd4x handle structure
+ * @param[in] now_us current time
+ * @note      a timed state ends at its end time and the chip is idle after it
+ */
+static void a_scd4x_account_update(scd4x_handle_t *handle, uint64_t now_us)
+{
+    if ((handle->account_end_us != 0) && (now_us >= handle->account_end_us))                          /* check the timed state */
+    {
+        if (handle->account_end_us > handle->account_us)                                              /* check the time */
+        {
+            handle->account_state_us[handle->account_state] += handle->account_end_us - 
+                                                               handle->account_us;                    /* count the timed state */
+            handle->account_us = handle->account_end_us;                                              /* counted up to the end */
+        }
+        handle->account_state = SCD4X_ACCOUNT_IDLE;                                                   /* idle after it */
+        handle->account_end_us = 0;                                                                   /* not timed */
+    }
+    if (now_us > handle->account_us)                                                                  /* check the time */
+    {
+        handle->account_state_us[handle->account_state] += now_us - handle->account_us;              /* count the state */
+        handle->account_us = now_us;                                                                  /* counted up to now */
+    }
+}
+
+/**
+ * @brief     account a sent command
+ * @param[in] *handle pointer to an scd4x handle structure
+ * @param[in] command sent command
+ * @note      the commands without their own state keep the current state
+ */
+static void a_scd4x_account_command(scd4x_handle_t *handle, uint16_t command)
+{
+    uint64_t now_us;
+    uint64_t timed_us;
+    
+    if (handle->account_enable != SCD4X_ACCOUNT_RUN)                                      /* check accounting */
     {
-        return 0;                                                                  /* success return 0 */
+        return;                                                                           /* not running */
+    }
+    
+    now_us = handle->get_time_us();                                                       /* get the time */
+    a_scd4x_account_update(handle, now_us);                                               /* count up to now */
+    handle->account_commands++;                                                           /* count the command */
+    timed_us = 0;                                                                         /* not timed */
+    switch (command)
+    {
+        case SCD4X_COMMAND_START_PERIODIC :
+        {
+            handle->account_state = SCD4X_ACCOUNT_PERIODIC;                               /* periodic measurement */
+            
+            break;
+        }
+        case SCD4X_COMMAND_START_LOW_POWER_PERIODIC :
+        {
+            handle->account_state = SCD4X_ACCOUNT_LOW_POWER;                              /* low power periodic measurement */
+            
+            break;
+        }
+        case SCD4X_COMMAND_STOP_PERIODIC :
+        {
+            handle->account_state = SCD4X_ACCOUNT_IDLE;                                   /* idle */
+            
+            break;
+        }
+        case SCD4X_COMMAND_MEASURE_SINGLE_SHOT :
+        {
+            handle->account_state = SCD4X_ACCOUNT_SHOT;                                   /* single shot */
+            timed_us = SCD4X_ACCOUNT_SHOT_US;                                             /* set shot time */
+            
+            break;
+        }
+        case SCD4X_COMMAND_MEASURE_SINGLE_SHOT_RHT_ONLY :
+        {
+            handle->account_state = SCD4X_ACCOUNT_RHT_ONLY;                               /* rht only single shot */
+            timed_us = SCD4X_ACCOUNT_RHT_ONLY_US;                                         /* set shot time */
+            
+            break;
+        }
+        case SCD4X_COMMAND_POWER_DOWN :
+        {
+            handle->account_state = SCD4X_ACCOUNT_SLEEP;                                  /* power down */
+            
+            break;
+        }
+        case SCD4X_COMMAND_WAKE_UP :
+        {
+            if (handle->account_state == SCD4X_ACCOUNT_SLEEP)                             /* only a sleeping chip wakes up */
+            {
+                handle->account_state = SCD4X_ACCOUNT_WAKE_UP;                            /* wake up */
+                timed_us = SCD4X_ACCOUNT_WAKE_UP_US;                                      /* set wake up time */
+            }
+            
+            break;
+        }
+        case SCD4X_COMMAND_PERFORM_SELF_TEST :
+        {
+            handle->account_state = SCD4X_ACCOUNT_SELF_TEST;                              /* self test */
+            timed_us = SCD4X_ACCOUNT_SELF_TEST_US;                                        /* set self test time */
+            
+            break;
+        }
+        default :
+        {
+            return;                                                                       /* keep the state */
+        }
     }
+    handle->account_end_us = (timed_us != 0) ? (now_us + timed_us) : 0;                  /* set the end time */
 }
+#endif
 
+#if (SCD4X_CONFIG_REG != 0)
 /**
  * @brief      read bytes
  * @param[in]  *handle pointer to an scd4x handle structure
@@ -156,11 +528,16 @@ static uint8_t a_scd4x_iic_read(scd4x_handle_t *handle, uint16_t reg, uint8_t *d
     memset(buf, 0, sizeof(uint8_t) * 2);                                     /* clear the buffer */
     buf[0] = (uint8_t)((reg >> 8) & 0xFF);                                   /* set reg MSB */
     buf[1] = (uint8_t)(reg & 0xFF);                                          /* set reg LSB */
+    a_scd4x_wait_pending(handle);                                            /* wait pending command */
     if (handle->iic_write_cmd(SCD4X_ADDRESS, (uint8_t *)buf, 2) != 0)        /* write command */
     {   
         return 1;                                                            /* return error */
     }
-    handle->delay_ms(delay_ms);                                              /* delay ms */
+#if (SCD4X_CONFIG_ACCOUNTING != 0)
+    a_scd4x_account_command(handle, reg);                                    /* account the command */
+#endif
+    a_scd4x_set_pending(handle, delay_ms);                                   /* set pending time */
+    a_scd4x_wait_pending(handle);                                            /* wait command execution */
     if (handle->iic_read_cmd(SCD4X_ADDRESS, data, len) != 0)                 /* read data */
     {
         return 1;                                                            /* write command */
@@ -170,6 +547,7 @@ static uint8_t a_scd4x_iic_read(scd4x_handle_t *handle, uint16_t reg, uint8_t *d
         return 0;                                                            /* success return 0 */
     }
 }
+#endif
 
 /**
  * @brief     write bytes
@@ -199,14 +577,16 @@ static uint8_t a_scd4x_iic_write(scd4x_handle_t *handle, uint16_t reg, uint8_t *
         buf[2 + i] = data[i];                                                      /* copy write data */
     }
     
+    a_scd4x_wait_pending(handle);                                                  /* wait pending command */
     if (handle->iic_write_cmd(SCD4X_ADDRESS, (uint8_t *)buf, len + 2) != 0)        /* write iic command */
     {
         return 1;                                                                  /* write command */
     }
-    else
-    {
-        return 0;                                                                  /* success return 0 */
-    }
+#if (SCD4X_CONFIG_ACCOUNTING != 0)
+    a_scd4x_account_command(handle, reg);                                          /* account the command */
+#endif
+    
+    return 0;                                                                      /* success return 0 */
 }
 
 /**
@@ -241,294 +621,593 @@ static uint8_t a_scd4x_generate_crc(uint8_t* data, uint8_t count)
     return crc;                                                         /* return crc */
 }
 
+#ifdef SCD4X_BENCH
 /**
- * @brief     set type
- * @param[in] *handle pointer to an scd4x handle structure
- * @param[in] type chip type
- * @return    status code
- *            - 0 success
- *            - 2 handle is NULL
- * @note      none
+ * @brief     generate the crc
+ * @param[in] *data pointer to a data buffer
+ * @param[in] count data length
+ * @return    crc
+ * @note      only the benchmark builds with SCD4X_BENCH have this function
  */
-uint8_t scd4x_set_type(scd4x_handle_t *handle, scd4x_t type)
+uint8_t scd4x_bench_generate_crc(uint8_t *data, uint8_t count)
 {
-    if (handle == NULL)         /* check handle */
-    {
-        return 2;               /* return error */
-    }
-    
-    handle->type = type;        /* set type */
-    
-    return 0;                   /* success return 0 */
+    return a_scd4x_generate_crc(data, count);                           /* return crc */
 }
+#endif
 
+#if (SCD4X_LOG_BINARY != 0)
 /**
- * @brief      get type
- * @param[in]  *handle pointer to an scd4x handle structure
- * @param[out] *type pointer to a chip type buffer
- * @return     status code
- *             - 0 success
- *             - 2 handle is NULL
- * @note       none
+ * @brief     store a log event
+ * @param[in] *handle pointer to an scd4x handle structure
+ * @param[in] level log level
+ * @param[in] id log event id
+ * @param[in] arg log event argument
+ * @note      the oldest event is overwritten when the ring is full
  */
-uint8_t scd4x_get_type(scd4x_handle_t *handle, scd4x_t *type)
+static void a_scd4x_log(scd4x_handle_t *handle, uint8_t level, uint8_t id, uint16_t arg)
 {
-    if (handle == NULL)                     /* check handle */
+    scd4x_log_event_t *event;
+    uint16_t index;
+    
+    if (handle->log_count < SCD4X_CONFIG_LOG_DEPTH)                                  /* check the ring */
     {
-        return 2;                           /* return error */
+        index = (uint16_t)((handle->log_head + handle->log_count) % 
+                           SCD4X_CONFIG_LOG_DEPTH);                                  /* get the free event */
+        handle->log_count++;                                                         /* add the event */
     }
-    
-    *type = (scd4x_t)(handle->type);        /* get type */
-    
-    return 0;                               /* success return 0 */
+    else
+    {
+        index = handle->log_head;                                                    /* overwrite the oldest event */
+        handle->log_head = (uint16_t)((handle->log_head + 1) % 
+                                      SCD4X_CONFIG_LOG_DEPTH);                       /* move the oldest event */
+        if (handle->log_lost != 0xFFFF)                                              /* check the lost counter */
+        {
+            handle->log_lost++;                                                      /* lost one event */
+        }
+    }
+    event = &handle->log[index];                                                     /* get the event */
+    if (handle->get_time_us != NULL)                                                 /* check time source */
+    {
+        event->time_ms = (uint32_t)(handle->get_time_us() / 1000);                   /* set the event time */
+    }
+    else
+    {
+        event->time_ms = 0;                                                          /* no time source */
+    }
+    event->arg = arg;                                                                /* set the argument */
+    event->id = id;                                                                  /* set the id */
+    event->level = level;                                                            /* set the level */
 }
+#endif
 
 /**
- * @brief     start periodic measurement
+ * @brief     check the handle and the chip type of a command
  * @param[in] *handle pointer to an scd4x handle structure
+ * @param[in] cmd command index
  * @return    status code
  *            - 0 success
- *            - 1 start periodic measurement failed
  *            - 2 handle is NULL
  *            - 3 handle is not initialized
+ *            - 4 the chip type has not this command
  * @note      none
  */
-uint8_t scd4x_start_periodic_measurement(scd4x_handle_t *handle)
+static uint8_t a_scd4x_check(scd4x_handle_t *handle, scd4x_cmd_t cmd)
 {
-    uint8_t res;
-    
-    if (handle == NULL)                                                            /* check handle */
+    if (handle == NULL)                                                                                                           /* check handle */
     {
-        return 2;                                                                  /* return error */
+        return 2;                                                                                                                 /* return error */
     }
-    if (handle->inited != 1)                                                       /* check handle initialization */
+    if (handle->inited != 1)                                                                                                      /* check handle initialization */
     {
-        return 3;                                                                  /* return error */
+        return 3;                                                                                                                 /* return error */
     }
-
-    res = a_scd4x_iic_write(handle, SCD4X_COMMAND_START_PERIODIC, NULL, 0);        /* write config */
-    if (res != 0)                                                                  /* check result */
+    if ((gs_scd4x_command[cmd].type_mask & (1U << handle->type)) == 0)                                                            /* check type */
     {
-        handle->debug_print("scd4x: start periodic measurement failed.\n");        /* start periodic measurement failed */
+        SCD4X_LOG_ERROR(handle, SCD4X_LOG_TYPE_INVALID, handle->type, "scd4x: only scd41 and scd43 has this function.\n");        /* only scd41 and scd43 has this function */
        
-        return 1;                                                                  /* return error */
+        return 4;                                                                                                                 /* return error */
     }
     
-    return 0;                                                                      /* success return 0 */
+    return 0;                                                                                                                     /* success return 0 */
 }
 
 /**
- * @brief      read data
- * @param[in]  *handle pointer to an scd4x handle structure
- * @param[out] *co2_raw pointer to a co2 raw buffer
- * @param[out] *co2_ppm pointer to a co2 ppm buffer
- * @param[out] *temperature_raw pointer to a temperature raw buffer
- * @param[out] *temperature_s pointer to a temperature buffer
- * @param[out] *humidity_raw pointer to a humidity raw buffer
- * @param[out] *humidity_s pointer to a humidity buffer
- * @return     status code
- *             - 0 success
- *             - 1 read failed
- *             - 2 handle is NULL
- *             - 3 handle is not initialized
- *             - 4 crc is error
- *             - 5 data is not ready
- * @note       none
+ * @brief     send a command
+ * @param[in] *handle pointer to an scd4x handle structure
+ * @param[in] *command pointer to a command
+ * @param[in] *tx pointer to an argument words buffer
+ * @return    status code
+ *            - 0 success
+ *            - 1 send failed
+ * @note      the command execution time is set as pending
  */
-uint8_t scd4x_read(scd4x_handle_t *handle, uint16_t *co2_raw, uint16_t *co2_ppm,
-                   uint16_t *temperature_raw, float *temperature_s,
-                   uint16_t *humidity_raw, float *humidity_s)
+static uint8_t a_scd4x_send(scd4x_handle_t *handle, const scd4x_command_t *command, const uint16_t *tx)
 {
-    uint8_t res;
     uint8_t buf[9];
-    uint16_t prev;
-    
-    if (handle == NULL)                                                                   /* check handle */
-    {
-        return 2;                                                                         /* return error */
-    }
-    if (handle->inited != 1)                                                              /* check handle initialization */
-    {
-        return 3;                                                                         /* return error */
-    }
+    uint8_t len;
+    uint8_t i;
     
-    res = a_scd4x_iic_read(handle, SCD4X_COMMAND_GET_DATA_READY_STATUS, buf, 3, 1);       /* read config */
-    if (res != 0)                                                                         /* check result */
-    {
-        handle->debug_print("scd4x: get data ready status failed.\n");                    /* get data ready status failed */
-       
-        return 1;                                                                         /* return error */
-    }
-    if (buf[2] != a_scd4x_generate_crc(&buf[0], 2))                                       /* check crc */
+    buf[0] = (uint8_t)((command->command >> 8) & 0xFF);                                                                 /* set command msb */
+    buf[1] = (uint8_t)(command->command & 0xFF);                                                                        /* set command lsb */
+    len = 2;                                                                                                            /* set length */
+    for (i = 0; i < command->tx_words; i++)                                                                             /* set all arguments */
     {
-        handle->debug_print("scd4x: crc is error.\n");                                    /* crc is error */
-       
-        return 4;                                                                         /* return error */
+        buf[len + 0] = (uint8_t)((tx[i] >> 8) & 0xFF);                                                                  /* set msb */
+        buf[len + 1] = (uint8_t)(tx[i] & 0xFF);                                                                         /* set lsb */
+        buf[len + 2] = a_scd4x_generate_crc(&buf[len], 2);                                                              /* set crc */
+        len += 3;                                                                                                       /* next word */
     }
-    prev = (uint16_t)(((uint16_t)buf[0]) << 8) | buf[1];                                  /* set prev */
-    if ((prev & 0x0FFF) == 0)                                                             /* check data */
+    a_scd4x_wait_pending(handle);                                                                                       /* wait pending command */
+    if ((handle->iic_write_cmd(SCD4X_ADDRESS, buf, len) != 0) &&
+        ((command->flags & SCD4X_FLAG_NO_ACK) == 0))                                                                    /* write command */
     {
-        handle->debug_print("scd4x: data is not ready.\n");                               /* data is not ready */
+        SCD4X_LOG_ERROR(handle, SCD4X_LOG_WRITE_FAILED, command->command, "scd4x: %s failed.\n", command->name);        /* command failed */
        
-        return 5;                                                                         /* return error */
+        return 1;                                                                                                       /* return error */
     }
+#if (SCD4X_CONFIG_ACCOUNTING != 0)
+    a_scd4x_account_command(handle, command->command);                                                                  /* account the command */
+#endif
+    a_scd4x_set_pending(handle, command->exec_ms);                                                                      /* set pending time */
     
-    res = a_scd4x_iic_read(handle, SCD4X_COMMAND_READ, buf, 9, 1);                        /* read data */
-    if (res != 0)                                                                         /* check result */
-    {
-        handle->debug_print("scd4x: read failed.\n");                                     /* read failed */
-       
-        return 1;                                                                         /* return error */
-    }
+    return 0;                                                                                                           /* success return 0 */
+}
+
+/**
+ * @brief      receive the response of a command
+ * @param[in]  *handle pointer to an scd4x handle structure
+ * @param[in]  *command pointer to a command
+ * @param[out] *rx pointer to a response words buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 receive failed
+ *             - 4 or 5 crc is error
+ * @note       the response words are set only if all crc are right
+ */
+static uint8_t a_scd4x_receive(scd4x_handle_t *handle, const scd4x_command_t *command, uint16_t *rx)
+{
+    uint8_t buf[9];
+    uint8_t i;
     
-    if (buf[2] != a_scd4x_generate_crc(&buf[0], 2))                                       /* check crc */
+    a_scd4x_wait_pending(handle);                                                                                       /* wait command execution */
+    if (handle->iic_read_cmd(SCD4X_ADDRESS, buf, (uint16_t)(command->rx_words * 3)) != 0)                               /* read response */
     {
-        handle->debug_print("scd4x: crc is error.\n");                                    /* crc is error */
+        SCD4X_LOG_ERROR(handle, SCD4X_LOG_READ_FAILED, command->command, "scd4x: %s failed.\n", command->name);         /* command failed */
        
-        return 4;                                                                         /* return error */
+        return 1;                                                                                                       /* return error */
     }
-    if (buf[5] != a_scd4x_generate_crc(&buf[3], 2))                                       /* check crc */
+    for (i = 0; i < command->rx_words; i++)                                                                             /* check all words */
     {
-        handle->debug_print("scd4x: crc is error.\n");                                    /* crc is error */
-       
-        return 4;                                                                         /* return error */
+        if (buf[i * 3 + 2] != a_scd4x_generate_crc(&buf[i * 3], 2))                                                     /* check crc */
+        {
+            SCD4X_LOG_ERROR(handle, SCD4X_LOG_CRC_ERROR, command->command, "scd4x: crc is error.\n");                   /* crc is error */
+           
+            return command->crc_res;                                                                                    /* return error */
+        }
     }
-    if (buf[8] != a_scd4x_generate_crc(&buf[6], 2))                                       /* check crc */
+    for (i = 0; i < command->rx_words; i++)                                                                             /* set all words */
     {
-        handle->debug_print("scd4x: crc is error.\n");                                    /* crc is error */
-       
-        return 4;                                                                         /* return error */
+        rx[i] = (uint16_t)(((uint16_t)buf[i * 3]) << 8) | buf[i * 3 + 1];                                               /* set word */
     }
     
-    *co2_raw = (uint16_t)(((uint16_t)buf[0]) << 8) | buf[1];                              /* set co2 raw */
-    *temperature_raw = (uint16_t)(((uint16_t)buf[3]) << 8) | buf[4];                      /* set temperature raw */
-    *humidity_raw = (uint16_t)(((uint16_t)buf[6]) << 8) | buf[7];                         /* set humidity raw */
-    *co2_ppm = *co2_raw;                                                                  /* set co2 ppm */
-    *temperature_s = -45.0f + 175.0f * (float)(*temperature_raw) / 65535.0f;              /* set temperature */
-    *humidity_s = 100.0f * (float)(*humidity_raw) / 65535.0f;                             /* set humidity */
-    
-    return 0;                                                                             /* success return 0 */
+    return 0;                                                                                                           /* success return 0 */
 }
 
 /**
- * @brief     stop periodic measurement
- * @param[in] *handle pointer to an scd4x handle structure
- * @return    status code
- *            - 0 success
- *            - 1 stop periodic measurement failed
- *            - 2 handle is NULL
- *            - 3 handle is not initialized
- * @note      none
+ * @brief      run a command
+ * @param[in]  *handle pointer to an scd4x handle structure
+ * @param[in]  cmd command index
+ * @param[in]  *tx pointer to an argument words buffer
+ * @param[out] *rx pointer to a response words buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 run failed
+ *             - 4 or 5 crc is error
+ * @note       the response words are set only if all crc are right
  */
-uint8_t scd4x_stop_periodic_measurement(scd4x_handle_t *handle)
+static uint8_t a_scd4x_run(scd4x_handle_t *handle, scd4x_cmd_t cmd, const uint16_t *tx, uint16_t *rx)
+{
+    const scd4x_command_t *command = &gs_scd4x_command[cmd];
+    
+    if ((command->flags & SCD4X_FLAG_NO_WRITE) == 0)                  /* check write */
+    {
+        if (a_scd4x_send(handle, command, tx) != 0)                   /* send command */
+        {
+            return 1;                                                 /* return error */
+        }
+    }
+    if (command->rx_words == 0)                                       /* check response */
+    {
+        return 0;                                                     /* success return 0 */
+    }
+    
+    return a_scd4x_receive(handle, command, rx);                      /* receive response */
+}
+
+/**
+ * @brief      check and run a command
+ * @param[in]  *handle pointer to an scd4x handle structure
+ * @param[in]  cmd command index
+ * @param[in]  *tx pointer to an argument words buffer
+ * @param[out] *rx pointer to a response words buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 run failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ *             - 4 the chip type has not this command or crc is error
+ *             - 5 crc is error
+ * @note       none
+ */
+static uint8_t a_scd4x_execute(scd4x_handle_t *handle, scd4x_cmd_t cmd, const uint16_t *tx, uint16_t *rx)
 {
     uint8_t res;
     
-    if (handle == NULL)                                                           /* check handle */
+    res = a_scd4x_check(handle, cmd);               /* check handle and type */
+    if (res != 0)                                   /* check result */
     {
-        return 2;                                                                 /* return error */
+        return res;                                 /* return error */
     }
-    if (handle->inited != 1)                                                      /* check handle initialization */
+    
+    return a_scd4x_run(handle, cmd, tx, rx);        /* run the command */
+}
+
+/**
+ * @brief     set type
+ * @param[in] *handle pointer to an scd4x handle structure
+ * @param[in] type chip type
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ * @note      none
+ */
+uint8_t scd4x_set_type(scd4x_handle_t *handle, scd4x_t type)
+{
+    if (handle == NULL)         /* check handle */
     {
-        return 3;                                                                 /* return error */
+        return 2;               /* return error */
     }
+    
+    handle->type = type;        /* set type */
+    
+    return 0;                   /* success return 0 */
+}
 
-    res = a_scd4x_iic_write(handle, SCD4X_COMMAND_STOP_PERIODIC, NULL, 0);        /* write config */
-    if (res != 0)                                                                 /* check result */
+/**
+ * @brief      get type
+ * @param[in]  *handle pointer to an scd4x handle structure
+ * @param[out] *type pointer to a chip type buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ * @note       none
+ */
+uint8_t scd4x_get_type(scd4x_handle_t *handle, scd4x_t *type)
+{
+    if (handle == NULL)                     /* check handle */
     {
-        handle->debug_print("scd4x: stop periodic measurement failed.\n");        /* stop periodic measurement failed */
-       
-        return 1;                                                                 /* return error */
+        return 2;                           /* return error */
     }
-    handle->delay_ms(500);                                                        /* delay 500ms */
     
-    return 0;                                                                     /* success return 0 */
+    *type = (scd4x_t)(handle->type);        /* get type */
+    
+    return 0;                               /* success return 0 */
 }
 
 /**
- * @brief     set temperature offset
+ * @brief     start periodic measurement
  * @param[in] *handle pointer to an scd4x handle structure
- * @param[in] offset temperature offset
  * @return    status code
  *            - 0 success
- *            - 1 set temperature offset failed
+ *            - 1 start periodic measurement failed
  *            - 2 handle is NULL
  *            - 3 handle is not initialized
  * @note      none
  */
-uint8_t scd4x_set_temperature_offset(scd4x_handle_t *handle, uint16_t offset)
+uint8_t scd4x_start_periodic_measurement(scd4x_handle_t *handle)
 {
-    uint8_t res;
-    uint8_t buf[3];
-    
-    if (handle == NULL)                                                                   /* check handle */
+    return a_scd4x_execute(handle, SCD4X_CMD_START_PERIODIC, NULL, NULL);        /* run the command */
+}
+
+/**
+ * @brief      set a sample from the read measurement response
+ * @param[in]  *handle pointer to an scd4x handle structure
+ * @param[in]  res read measurement result
+ * @param[in]  *word pointer to the response words
+ * @param[out] *sample pointer to an scd4x sample structure
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ *             - 4 crc is error
+ * @note       the data ready flag is consumed by every answered read
+ */
+static uint8_t a_scd4x_read_finish(scd4x_handle_t *handle, uint8_t res, const uint16_t *word, scd4x_sample_t *sample)
+{
+    if (res == 1)                                                                                     /* check result */
     {
-        return 2;                                                                         /* return error */
+        return 1;                                                                                     /* return error */
     }
-    if (handle->inited != 1)                                                              /* check handle initialization */
+    sample->ready_time_us = handle->ready_time_us;                                                    /* set ready time */
+    sample->read_time_us = 0;                                                                         /* init 0 */
+    if (handle->get_time_us != NULL)                                                                  /* check time source */
     {
-        return 3;                                                                         /* return error */
+        sample->read_time_us = handle->get_time_us();                                                 /* set read time */
+    }
+    handle->ready_flag = 0;                                                                           /* data is consumed */
+    if (res != 0)                                                                                     /* check crc result */
+    {
+        return res;                                                                                   /* return error */
     }
+    
+    sample->co2_raw = word[0];                                                                        /* set co2 raw */
+    sample->temperature_raw = word[1];                                                                /* set temperature raw */
+    sample->humidity_raw = word[2];                                                                   /* set humidity raw */
+    sample->co2_ppm = sample->co2_raw;                                                                /* set co2 ppm */
+    sample->temperature_s = -45.0f + 175.0f * (float)(sample->temperature_raw) / 65535.0f;            /* set temperature */
+    sample->humidity_s = 100.0f * (float)(sample->humidity_raw) / 65535.0f;                           /* set humidity */
+    
+    return 0;                                                                                         /* success return 0 */
+}
 
-    buf[0] = (offset >> 8) & 0xFF;                                                        /* msb */
-    buf[1] = (offset >> 0) & 0xFF;                                                        /* lsb */
-    buf[2] = a_scd4x_generate_crc(&buf[0], 2);                                            /* set crc */
-    res = a_scd4x_iic_write(handle, SCD4X_COMMAND_SET_TEMPERATURE_OFFSET, buf, 3);        /* write config */
-    if (res != 0)                                                                         /* check result */
+/**
+ * @brief      read the measurement
+ * @param[in]  *handle pointer to an scd4x handle structure
+ * @param[out] *sample pointer to an scd4x sample structure
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ *             - 4 crc is error
+ *             - 5 data is not ready
+ * @note       none
+ */
+static uint8_t a_scd4x_read(scd4x_handle_t *handle, scd4x_sample_t *sample)
+{
+    uint8_t res;
+    uint16_t word[3];
+    
+    res = a_scd4x_run(handle, SCD4X_CMD_GET_DATA_READY_STATUS, NULL, word);                           /* read data ready status */
+    if (res != 0)                                                                                     /* check result */
     {
-        handle->debug_print("scd4x: set temperature offset failed.\n");                   /* set temperature offset failed */
+        return res;                                                                                   /* return error */
+    }
+    if ((word[0] & 0x0FFF) == 0)                                                                      /* check data */
+    {
+        SCD4X_LOG_WARNING(handle, SCD4X_LOG_DATA_NOT_READY, 0, "scd4x: data is not ready.\n");        /* data is not ready */
        
-        return 1;                                                                         /* return error */
+        return 5;                                                                                     /* return error */
     }
-    handle->delay_ms(1);                                                                  /* delay 1ms */
+    a_scd4x_mark_ready(handle);                                                                       /* mark data ready */
+    
+    res = a_scd4x_run(handle, SCD4X_CMD_READ, NULL, word);                                            /* read data */
     
-    return 0;                                                                             /* success return 0 */
+    return a_scd4x_read_finish(handle, res, word, sample);                                            /* set the sample */
 }
 
 /**
- * @brief      get temperature offset
+ * @brief      read data
  * @param[in]  *handle pointer to an scd4x handle structure
- * @param[out] *offset pointer to a temperature offset buffer
+ * @param[out] *co2_raw pointer to a co2 raw buffer
+ * @param[out] *co2_ppm pointer to a co2 ppm buffer
+ * @param[out] *temperature_raw pointer to a temperature raw buffer
+ * @param[out] *temperature_s pointer to a temperature buffer
+ * @param[out] *humidity_raw pointer to a humidity raw buffer
+ * @param[out] *humidity_s pointer to a humidity buffer
  * @return     status code
  *             - 0 success
- *             - 1 get temperature offset failed
+ *             - 1 read failed
  *             - 2 handle is NULL
  *             - 3 handle is not initialized
  *             - 4 crc is error
+ *             - 5 data is not ready
  * @note       none
  */
-uint8_t scd4x_get_temperature_offset(scd4x_handle_t *handle, uint16_t *offset)
+uint8_t scd4x_read(scd4x_handle_t *handle, uint16_t *co2_raw, uint16_t *co2_ppm,
+                   uint16_t *temperature_raw, float *temperature_s,
+                   uint16_t *humidity_raw, float *humidity_s)
 {
     uint8_t res;
-    uint8_t buf[3];
+    scd4x_sample_t sample;
     
-    if (handle == NULL)                                                                     /* check handle */
+    if (handle == NULL)                                 /* check handle */
     {
-        return 2;                                                                           /* return error */
+        return 2;                                       /* return error */
     }
-    if (handle->inited != 1)                                                                /* check handle initialization */
+    if (handle->inited != 1)                            /* check handle initialization */
     {
-        return 3;                                                                           /* return error */
+        return 3;                                       /* return error */
     }
+    
+    res = a_scd4x_read(handle, &sample);                /* read the measurement */
+    if (res != 0)                                       /* check result */
+    {
+        return res;                                     /* return error */
+    }
+    *co2_raw = sample.co2_raw;                          /* set co2 raw */
+    *co2_ppm = sample.co2_ppm;                          /* set co2 ppm */
+    *temperature_raw = sample.temperature_raw;          /* set temperature raw */
+    *temperature_s = sample.temperature_s;              /* set temperature */
+    *humidity_raw = sample.humidity_raw;                /* set humidity raw */
+    *humidity_s = sample.humidity_s;                    /* set humidity */
+    
+    return 0;                                           /* success return 0 */
+}
 
-    res = a_scd4x_iic_read(handle, SCD4X_COMMAND_GET_TEMPERATURE_OFFSET, buf, 3, 1);        /* read config */
-    if (res != 0)                                                                           /* check result */
+/**
+ * @brief      read a timestamped sample
+ * @param[in]  *handle pointer to an scd4x handle structure
+ * @param[out] *sample pointer to an scd4x sample structure
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ *             - 4 crc is error
+ *             - 5 data is not ready
+ * @note       the time stamps are 0 if get_time_us is not linked
+ */
+uint8_t scd4x_read_sample(scd4x_handle_t *handle, scd4x_sample_t *sample)
+{
+    if (handle == NULL)                          /* check handle */
     {
-        handle->debug_print("scd4x: get temperature offset failed.\n");                     /* get temperature offset failed */
-       
-        return 1;                                                                           /* return error */
+        return 2;                                /* return error */
     }
-    if (buf[2] != a_scd4x_generate_crc(&buf[0], 2))                                         /* check crc */
+    if (handle->inited != 1)                     /* check handle initialization */
     {
-        handle->debug_print("scd4x: crc is error.\n");                                      /* crc is error */
-       
-        return 4;                                                                           /* return error */
+        return 3;                                /* return error */
     }
-    *offset = (uint16_t)(((uint16_t)buf[0]) << 8) | buf[1];                                 /* set offset */
     
-    return 0;                                                                               /* success return 0 */
+    return a_scd4x_read(handle, sample);         /* read the measurement */
+}
+
+/**
+ * @brief      poll a timestamped sample without blocking
+ * @param[in]  *handle pointer to an scd4x handle structure
+ * @param[out] *sample pointer to an scd4x sample structure
+ * @param[out] *wait_us pointer to a rest time buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ *             - 4 crc is error
+ *             - 5 data is not ready, call again after wait_us
+ *             - 6 command is in flight, call again after wait_us
+ * @note       each call makes at most one bus transfer and doesn't delay if get_time_us is linked,
+ *             the wait_us after 5 doubles from 10 ms up to the data ready polling max interval,
+ *             the sequence restarts after 0, 5 or an error, don't run other commands of this handle
+ *             while a command is in flight
+ */
+uint8_t scd4x_poll_sample(scd4x_handle_t *handle, scd4x_sample_t *sample, uint32_t *wait_us)
+{
+    uint8_t res;
+    uint16_t word[3];
+    uint64_t rest_us;
+    
+    if (handle == NULL)                                                                                        /* check handle */
+    {
+        return 2;                                                                                              /* return error */
+    }
+    if (handle->inited != 1)                                                                                   /* check handle initialization */
+    {
+        return 3;                                                                                              /* return error */
+    }
+    
+    *wait_us = 0;                                                                                              /* init 0 */
+    if (handle->get_time_us != NULL)                                                                           /* check time source */
+    {
+        rest_us = a_scd4x_pending_us(handle);                                                                  /* get the rest time */
+        if (rest_us != 0)                                                                                      /* check the rest time */
+        {
+            *wait_us = (uint32_t)rest_us;                                                                      /* set the rest time */
+            
+            return 6;                                                                                          /* return busy */
+        }
+    }
+    if (handle->poll_state == SCD4X_POLL_STATUS)                                                               /* status is sent */
+    {
+        handle->poll_state = SCD4X_POLL_IDLE;                                                                  /* restart */
+        res = a_scd4x_receive(handle, &gs_scd4x_command[SCD4X_CMD_GET_DATA_READY_STATUS], word);               /* receive data ready status */
+        if (res != 0)                                                                                          /* check result */
+        {
+            return res;                                                                                        /* return error */
+        }
+        if ((word[0] & 0x0FFF) == 0)                                                                           /* check data */
+        {
+            if (handle->poll_interval_ms < SCD4X_DATA_READY_MIN_INTERVAL)                                      /* check interval */
+            {
+                handle->poll_interval_ms = SCD4X_DATA_READY_MIN_INTERVAL;                                      /* set the first interval */
+            }
+            *wait_us = handle->poll_interval_ms * 1000;                                                        /* set the polling interval */
+            handle->poll_interval_ms *= 2;                                                                     /* double the interval */
+            if (handle->poll_interval_ms > handle->poll_max_ms)                                                /* check max interval */
+            {
+                handle->poll_interval_ms = handle->poll_max_ms;                                                /* set max interval */
+            }
+            
+            return 5;                                                                                          /* data is not ready */
+        }
+        handle->poll_interval_ms = SCD4X_DATA_READY_MIN_INTERVAL;                                              /* restart the backoff */
+        a_scd4x_mark_ready(handle);                                                                            /* mark data ready */
+        if (a_scd4x_send(handle, &gs_scd4x_command[SCD4X_CMD_READ], NULL) != 0)                                 /* send read measurement */
+        {
+            return 1;                                                                                          /* return error */
+        }
+        handle->poll_state = SCD4X_POLL_READ;                                                                  /* read is sent */
+        *wait_us = (uint32_t)gs_scd4x_command[SCD4X_CMD_READ].exec_ms * 1000;                                  /* set the rest time */
+        
+        return 6;                                                                                              /* return busy */
+    }
+    else if (handle->poll_state == SCD4X_POLL_READ)                                                            /* read is sent */
+    {
+        handle->poll_state = SCD4X_POLL_IDLE;                                                                  /* restart */
+        res = a_scd4x_receive(handle, &gs_scd4x_command[SCD4X_CMD_READ], word);                                /* receive measurement */
+        
+        return a_scd4x_read_finish(handle, res, word, sample);                                                 /* set the sample */
+    }
+    else
+    {
+        if (a_scd4x_send(handle, &gs_scd4x_command[SCD4X_CMD_GET_DATA_READY_STATUS], NULL) != 0)               /* send data ready status */
+        {
+            return 1;                                                                                          /* return error */
+        }
+        handle->poll_state = SCD4X_POLL_STATUS;                                                                /* status is sent */
+        *wait_us = (uint32_t)gs_scd4x_command[SCD4X_CMD_GET_DATA_READY_STATUS].exec_ms * 1000;                 /* set the rest time */
+        
+        return 6;                                                                                              /* return busy */
+    }
+}
+
+/**
+ * @brief     stop periodic measurement
+ * @param[in] *handle pointer to an scd4x handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 stop periodic measurement failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      the next bus access waits 500ms
+ */
+uint8_t scd4x_stop_periodic_measurement(scd4x_handle_t *handle)
+{
+    return a_scd4x_execute(handle, SCD4X_CMD_STOP_PERIODIC, NULL, NULL);        /* run the command */
+}
+
+#if (SCD4X_CONFIG_COMPENSATION != 0)
+/**
+ * @brief     set temperature offset
+ * @param[in] *handle pointer to an scd4x handle structure
+ * @param[in] offset temperature offset
+ * @return    status code
+ *            - 0 success
+ *            - 1 set temperature offset failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      none
+ */
+uint8_t scd4x_set_temperature_offset(scd4x_handle_t *handle, uint16_t offset)
+{
+    return a_scd4x_execute(handle, SCD4X_CMD_SET_TEMPERATURE_OFFSET, &offset, NULL);        /* run the command */
+}
+
+/**
+ * @brief      get temperature offset
+ * @param[in]  *handle pointer to an scd4x handle structure
+ * @param[out] *offset pointer to a temperature offset buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 get temperature offset failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ *             - 4 crc is error
+ * @note       none
+ */
+uint8_t scd4x_get_temperature_offset(scd4x_handle_t *handle, uint16_t *offset)
+{
+    return a_scd4x_execute(handle, SCD4X_CMD_GET_TEMPERATURE_OFFSET, NULL, offset);        /* run the command */
 }
+#endif
 
+#if (SCD4X_CONFIG_CONVERT != 0)
 /**
  * @brief      convert the temperature offset to the register raw data
  * @param[in]  *handle pointer to an scd4x handle structure
@@ -582,7 +1261,9 @@ uint8_t scd4x_temperature_offset_convert_to_data(scd4x_handle_t *handle, uint16_
     
     return 0;                                           /* success return 0 */
 }
+#endif
 
+#if (SCD4X_CONFIG_COMPENSATION != 0)
 /**
  * @brief     set sensor altitude
  * @param[in] *handle pointer to an scd4x handle structure
@@ -596,31 +1277,7 @@ uint8_t scd4x_temperature_offset_convert_to_data(scd4x_handle_t *handle, uint16_
  */
 uint8_t scd4x_set_sensor_altitude(scd4x_handle_t *handle, uint16_t altitude)
 {
-    uint8_t res;
-    uint8_t buf[3];
-    
-    if (handle == NULL)                                                                 /* check handle */
-    {
-        return 2;                                                                       /* return error */
-    }
-    if (handle->inited != 1)                                                            /* check handle initialization */
-    {
-        return 3;                                                                       /* return error */
-    }
-
-    buf[0] = (altitude >> 8) & 0xFF;                                                    /* msb */
-    buf[1] = (altitude >> 0) & 0xFF;                                                    /* lsb */
-    buf[2] = a_scd4x_generate_crc(&buf[0], 2);                                          /* set crc */
-    res = a_scd4x_iic_write(handle, SCD4X_COMMAND_SET_SENSOR_ALTITUDE , buf, 3);        /* write config */
-    if (res != 0)                                                                       /* check result */
-    {
-        handle->debug_print("scd4x: set sensor altitude failed.\n");                    /* set sensor altitude failed */
-       
-        return 1;                                                                       /* return error */
-    }
-    handle->delay_ms(1);                                                                /* delay 1ms */
-    
-    return 0;                                                                           /* success return 0 */
+    return a_scd4x_execute(handle, SCD4X_CMD_SET_SENSOR_ALTITUDE, &altitude, NULL);        /* run the command */
 }
 
 /**
@@ -637,36 +1294,11 @@ uint8_t scd4x_set_sensor_altitude(scd4x_handle_t *handle, uint16_t altitude)
  */
 uint8_t scd4x_get_sensor_altitude(scd4x_handle_t *handle, uint16_t *altitude)
 {
-    uint8_t res;
-    uint8_t buf[3];
-    
-    if (handle == NULL)                                                                  /* check handle */
-    {
-        return 2;                                                                        /* return error */
-    }
-    if (handle->inited != 1)                                                             /* check handle initialization */
-    {
-        return 3;                                                                        /* return error */
-    }
-
-    res = a_scd4x_iic_read(handle, SCD4X_COMMAND_GET_SENSOR_ALTITUDE, buf, 3, 1);        /* read config */
-    if (res != 0)                                                                        /* check result */
-    {
-        handle->debug_print("scd4x: get sensor altitude failed.\n");                     /* get sensor altitude failed */
-       
-        return 1;                                                                        /* return error */
-    }
-    if (buf[2] != a_scd4x_generate_crc(&buf[0], 2))                                      /* check crc */
-    {
-        handle->debug_print("scd4x: crc is error.\n");                                   /* crc is error */
-       
-        return 4;                                                                        /* return error */
-    }
-    *altitude = (uint16_t)(((uint16_t)buf[0]) << 8) | buf[1];                            /* set offset */
-    
-    return 0;                                                                            /* success return 0 */
+    return a_scd4x_execute(handle, SCD4X_CMD_GET_SENSOR_ALTITUDE, NULL, altitude);        /* run the command */
 }
+#endif
 
+#if (SCD4X_CONFIG_CONVERT != 0)
 /**
  * @brief      convert the sensor altitude to the register raw data
  * @param[in]  *handle pointer to an scd4x handle structure
@@ -720,7 +1352,9 @@ uint8_t scd4x_sensor_altitude_convert_to_data(scd4x_handle_t *handle, uint16_t r
     
     return 0;                       /* success return 0 */
 }
+#endif
 
+#if (SCD4X_CONFIG_COMPENSATION != 0)
 /**
  * @brief     set ambient pressure
  * @param[in] *handle pointer to an scd4x handle structure
@@ -734,31 +1368,7 @@ uint8_t scd4x_sensor_altitude_convert_to_data(scd4x_handle_t *handle, uint16_t r
  */
 uint8_t scd4x_set_ambient_pressure(scd4x_handle_t *handle, uint16_t pressure)
 {
-    uint8_t res;
-    uint8_t buf[3];
-    
-    if (handle == NULL)                                                                 /* check handle */
-    {
-        return 2;                                                                       /* return error */
-    }
-    if (handle->inited != 1)                                                            /* check handle initialization */
-    {
-        return 3;                                                                       /* return error */
-    }
-
-    buf[0] = (pressure >> 8) & 0xFF;                                                    /* msb */
-    buf[1] = (pressure >> 0) & 0xFF;                                                    /* lsb */
-    buf[2] = a_scd4x_generate_crc(&buf[0], 2);                                          /* set crc */
-    res = a_scd4x_iic_write(handle, SCD4X_COMMAND_SET_AMBIENT_PRESSURE , buf, 3);       /* write config */
-    if (res != 0)                                                                       /* check result */
-    {
-        handle->debug_print("scd4x: set ambient pressure failed.\n");                   /* set ambient pressure failed */
-       
-        return 1;                                                                       /* return error */
-    }
-    handle->delay_ms(1);                                                                /* delay 1ms */
-    
-    return 0;                                                                           /* success return 0 */
+    return a_scd4x_execute(handle, SCD4X_CMD_SET_AMBIENT_PRESSURE, &pressure, NULL);        /* run the command */
 }
 
 /**
@@ -775,36 +1385,11 @@ uint8_t scd4x_set_ambient_pressure(scd4x_handle_t *handle, uint16_t pressure)
  */
 uint8_t scd4x_get_ambient_pressure(scd4x_handle_t *handle, uint16_t *pressure)
 {
-    uint8_t res;
-    uint8_t buf[3];
-    
-    if (handle == NULL)                                                                  /* check handle */
-    {
-        return 2;                                                                        /* return error */
-    }
-    if (handle->inited != 1)                                                             /* check handle initialization */
-    {
-        return 3;                                                                        /* return error */
-    }
-
-    res = a_scd4x_iic_read(handle, SCD4X_COMMAND_GET_AMBIENT_PRESSURE, buf, 3, 1);       /* read config */
-    if (res != 0)                                                                        /* check result */
-    {
-        handle->debug_print("scd4x: get ambient pressure failed.\n");                    /* get ambient pressure failed */
-       
-        return 1;                                                                        /* return error */
-    }
-    if (buf[2] != a_scd4x_generate_crc(&buf[0], 2))                                      /* check crc */
-    {
-        handle->debug_print("scd4x: crc is error.\n");                                   /* crc is error */
-       
-        return 4;                                                                        /* return error */
-    }
-    *pressure = (uint16_t)(((uint16_t)buf[0]) << 8) | buf[1];                            /* set offset */
-    
-    return 0;                                                                            /* success return 0 */
+    return a_scd4x_execute(handle, SCD4X_CMD_GET_AMBIENT_PRESSURE, NULL, pressure);        /* run the command */
 }
+#endif
 
+#if (SCD4X_CONFIG_CONVERT != 0)
 /**
  * @brief      convert the ambient pressure to the register raw data
  * @param[in]  *handle pointer to an scd4x handle structure
@@ -858,7 +1443,9 @@ uint8_t scd4x_ambient_pressure_convert_to_data(scd4x_handle_t *handle, uint16_t
     
     return 0;                           /* success return 0 */
 }
+#endif
 
+#if (SCD4X_CONFIG_FRC != 0)
 /**
  * @brief      perform forced recalibration
  * @param[in]  *handle pointer to an scd4x handle structure
@@ -874,41 +1461,44 @@ uint8_t scd4x_ambient_pressure_convert_to_data(scd4x_handle_t *handle, uint16_t
  */
 uint8_t scd4x_perform_forced_recalibration(scd4x_handle_t *handle, uint16_t co2_raw, uint16_t *frc)
 {
-    uint8_t res;
-    uint8_t in_buf[3];
-    uint8_t out_buf[3];
-    
-    if (handle == NULL)                                                                          /* check handle */
-    {
-        return 2;                                                                                /* return error */
-    }
-    if (handle->inited != 1)                                                                     /* check handle initialization */
-    {
-        return 3;                                                                                /* return error */
-    }
-    
-    in_buf[0] = (co2_raw >> 8) & 0xFF;                                                           /* set msb */
-    in_buf[1] = (co2_raw >> 0) & 0xFF;                                                           /* set lsb */
-    in_buf[2] = a_scd4x_generate_crc(&in_buf[0], 2);                                             /* set crc */
-    res = a_scd4x_iic_read_with_param(handle, SCD4X_COMMAND_PERFORM_FORCED_RECALIBRATION, 
-                                      in_buf, 3, 400, out_buf, 3);                               /* read config */
-    if (res != 0)                                                                                /* check result */
-    {
-        handle->debug_print("scd4x: perform forced recalibration failed.\n");                    /* perform forced recalibration failed */
-       
-        return 1;                                                                                /* return error */
-    }
-    if (out_buf[2] != a_scd4x_generate_crc(&out_buf[0], 2))                                      /* check crc */
-    {
-        handle->debug_print("scd4x: crc is error.\n");                                           /* crc is error */
-       
-        return 4;                                                                                /* return error */
-    }
-    *frc = (uint16_t)(((uint16_t)out_buf[0]) << 8) | out_buf[1];                                 /* set frc */
-    
-    return 0;                                                                                    /* success return 0 */
+    return a_scd4x_execute(handle, SCD4X_CMD_PERFORM_FORCED_RECALIBRATION, &co2_raw, frc);        /* run the command */
 }
 
+/**
+ * @brief     start forced recalibration
+ * @param[in] *handle pointer to an scd4x handle structure
+ * @param[in] co2_raw co2 raw data
+ * @return    status code
+ *            - 0 success
+ *            - 1 start forced recalibration failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      read the result with scd4x_get_forced_recalibration_result after 400ms
+ */
+uint8_t scd4x_start_forced_recalibration(scd4x_handle_t *handle, uint16_t co2_raw)
+{
+    return a_scd4x_execute(handle, SCD4X_CMD_START_FORCED_RECALIBRATION, &co2_raw, NULL);        /* run the command */
+}
+
+/**
+ * @brief      get forced recalibration result
+ * @param[in]  *handle pointer to an scd4x handle structure
+ * @param[out] *frc pointer to a frc buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 get forced recalibration result failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ *             - 4 crc is error
+ * @note       it waits the rest of the 400ms forced recalibration time
+ */
+uint8_t scd4x_get_forced_recalibration_result(scd4x_handle_t *handle, uint16_t *frc)
+{
+    return a_scd4x_execute(handle, SCD4X_CMD_GET_FORCED_RECALIBRATION_RESULT, NULL, frc);        /* run the command */
+}
+#endif
+
+#if (SCD4X_CONFIG_CONVERT != 0)
 /**
  * @brief      convert the co2 to the register raw data
  * @param[in]  *handle pointer to an scd4x handle structure
@@ -962,7 +1552,9 @@ uint8_t scd4x_co2_convert_to_data(scd4x_handle_t *handle, uint16_t reg, float *p
     
     return 0;                       /* success return 0 */
 }
+#endif
 
+#if (SCD4X_CONFIG_ASC != 0)
 /**
  * @brief     enable or disable automatic self calibration 
  * @param[in] *handle pointer to an scd4x handle structure
@@ -976,33 +1568,11 @@ uint8_t scd4x_co2_convert_to_data(scd4x_handle_t *handle, uint16_t reg, float *p
  */
 uint8_t scd4x_set_automatic_self_calibration(scd4x_handle_t *handle, scd4x_bool_t enable)
 {
-    uint8_t res;
-    uint8_t buf[3];
     uint16_t prev;
     
-    if (handle == NULL)                                                                      /* check handle */
-    {
-        return 2;                                                                            /* return error */
-    }
-    if (handle->inited != 1)                                                                 /* check handle initialization */
-    {
-        return 3;                                                                            /* return error */
-    }
-
-    prev = enable;                                                                           /* set bool */
-    buf[0] = (prev >> 8) & 0xFF;                                                             /* msb */
-    buf[1] = (prev >> 0) & 0xFF;                                                             /* lsb */
-    buf[2] = a_scd4x_generate_crc(&buf[0], 2);                                               /* set crc */
-    res = a_scd4x_iic_write(handle, SCD4X_COMMAND_SET_AUTO_SELF_CALIBRATION , buf, 3);       /* write config */
-    if (res != 0)                                                                            /* check result */
-    {
-        handle->debug_print("scd4x: set automatic self calibration failed.\n");              /* set automatic self calibration failed */
-       
-        return 1;                                                                            /* return error */
-    }
-    handle->delay_ms(1);                                                                     /* delay 1ms */
+    prev = (uint16_t)enable;                                                                 /* set bool */
     
-    return 0;                                                                                /* success return 0 */
+    return a_scd4x_execute(handle, SCD4X_CMD_SET_AUTO_SELF_CALIBRATION, &prev, NULL);        /* run the command */
 }
 
 /**
@@ -1020,124 +1590,279 @@ uint8_t scd4x_set_automatic_self_calibration(scd4x_handle_t *handle, scd4x_bool_
 uint8_t scd4x_get_automatic_self_calibration(scd4x_handle_t *handle, scd4x_bool_t *enable)
 {
     uint8_t res;
-    uint8_t buf[3];
     uint16_t prev;
     
-    if (handle == NULL)                                                                       /* check handle */
+    res = a_scd4x_execute(handle, SCD4X_CMD_GET_AUTO_SELF_CALIBRATION, NULL, &prev);        /* run the command */
+    if (res != 0)                                                                           /* check result */
+    {
+        return res;                                                                         /* return error */
+    }
+    *enable = (scd4x_bool_t)((prev >> 0) & 0x01);                                           /* get bool */
+    
+    return 0;                                                                               /* success return 0 */
+}
+#endif
+
+/**
+ * @brief     start low power periodic measurement
+ * @param[in] *handle pointer to an scd4x handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 start low power periodic measurement failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      none
+ */
+uint8_t scd4x_start_low_power_periodic_measurement(scd4x_handle_t *handle)
+{
+    return a_scd4x_execute(handle, SCD4X_CMD_START_LOW_POWER_PERIODIC, NULL, NULL);        /* run the command */
+}
+
+/**
+ * @brief      get data ready status
+ * @param[in]  *handle pointer to an scd4x handle structure
+ * @param[out] *enable pointer to a bool buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 get data ready status failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ *             - 4 crc is error
+ * @note       none
+ */
+uint8_t scd4x_get_data_ready_status(scd4x_handle_t *handle, scd4x_bool_t *enable)
+{
+    uint8_t res;
+    uint16_t prev;
+    
+    res = a_scd4x_execute(handle, SCD4X_CMD_GET_DATA_READY_STATUS, NULL, &prev);        /* run the command */
+    if (res != 0)                                                                       /* check result */
     {
-        return 2;                                                                             /* return error */
+        return res;                                                                     /* return error */
     }
-    if (handle->inited != 1)                                                                  /* check handle initialization */
+    if ((prev & 0x0FFF) != 0)                                                           /* check data */
     {
-        return 3;                                                                             /* return error */
+        a_scd4x_mark_ready(handle);                                                     /* mark data ready */
+        *enable = SCD4X_BOOL_TRUE;                                                      /* ready */
     }
+    else
+    {
+        *enable = SCD4X_BOOL_FALSE;                                                     /* not ready */
+    }
+    
+    return 0;                                                                           /* success return 0 */
+}
 
-    res = a_scd4x_iic_read(handle, SCD4X_COMMAND_GET_AUTO_SELF_CALIBRATION, buf, 3, 1);       /* read config */
-    if (res != 0)                                                                             /* check result */
+/**
+ * @brief     wait until the data is ready
+ * @param[in] *handle pointer to an scd4x handle structure
+ * @param[in] timeout max polling time in ms
+ * @return    status code
+ *            - 0 success
+ *            - 1 get data ready status failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 crc is error
+ *            - 5 timeout
+ * @note      the first probe is sent when the pending command execution time has elapsed,
+ *            then the polling interval doubles up to the max interval,
+ *            the elapsed time is never less than the slept intervals even if the time source stops
+ */
+uint8_t scd4x_wait_data_ready(scd4x_handle_t *handle, uint32_t timeout)
+{
+    uint8_t res;
+    uint16_t prev;
+    uint32_t interval;
+    uint32_t elapsed;
+    uint32_t slept;
+    uint32_t clock;
+    uint64_t start_us;
+    
+    if (handle == NULL)                                                                                                                        /* check handle */
     {
-        handle->debug_print("scd4x: get automatic self calibration failed.\n");               /* get automatic self calibration failed */
-       
-        return 1;                                                                             /* return error */
+        return 2;                                                                                                                              /* return error */
     }
-    if (buf[2] != a_scd4x_generate_crc(&buf[0], 2))                                           /* check crc */
+    if (handle->inited != 1)                                                                                                                   /* check handle initialization */
     {
-        handle->debug_print("scd4x: crc is error.\n");                                        /* crc is error */
-       
-        return 4;                                                                             /* return error */
+        return 3;                                                                                                                              /* return error */
+    }
+    
+    interval = SCD4X_DATA_READY_MIN_INTERVAL;                                                                                                  /* set the first interval */
+    elapsed = 0;                                                                                                                               /* init 0 */
+    slept = 0;                                                                                                                                 /* init 0 */
+    start_us = 0;                                                                                                                              /* init 0 */
+    a_scd4x_wait_pending(handle);                                                                                                              /* wait the pending measurement */
+    if (handle->get_time_us != NULL)                                                                                                           /* check time source */
+    {
+        start_us = handle->get_time_us();                                                                                                      /* save the first probe time */
+    }
+    while (1)                                                                                                                                  /* loop */
+    {
+        res = a_scd4x_run(handle, SCD4X_CMD_GET_DATA_READY_STATUS, NULL, &prev);                                                               /* read data ready status */
+        if (res != 0)                                                                                                                          /* check result */
+        {
+            return res;                                                                                                                        /* return error */
+        }
+        if ((prev & 0x0FFF) != 0)                                                                                                              /* check data */
+        {
+            a_scd4x_mark_ready(handle);                                                                                                        /* mark data ready */
+            
+            return 0;                                                                                                                          /* success return 0 */
+        }
+        if (elapsed >= timeout)                                                                                                                /* check timeout */
+        {
+            SCD4X_LOG_WARNING(handle, SCD4X_LOG_TIMEOUT, (timeout > 0xFFFFU) ? 0xFFFFU : timeout, "scd4x: wait data ready timeout.\n");        /* wait data ready timeout */
+            
+            return 5;                                                                                                                          /* return error */
+        }
+        if (interval > (timeout - elapsed))                                                                                                    /* check the rest time */
+        {
+            interval = timeout - elapsed;                                                                                                      /* limit the interval */
+        }
+        handle->delay_ms(interval);                                                                                                            /* delay interval */
+        slept += interval;                                                                                                                     /* add the interval */
+        elapsed = slept;                                                                                                                       /* the slept time is the lower bound */
+        if (handle->get_time_us != NULL)                                                                                                       /* check time source */
+        {
+            clock = (uint32_t)((handle->get_time_us() - start_us) / 1000);                                                                     /* get elapsed time */
+            if (clock > elapsed)                                                                                                               /* check elapsed time */
+            {
+                elapsed = clock;                                                                                                               /* the bus time counts too */
+            }
+        }
+        interval *= 2;                                                                                                                         /* double the interval */
+        if (interval > handle->poll_max_ms)                                                                                                    /* check max interval */
+        {
+            interval = handle->poll_max_ms;                                                                                                    /* set max interval */
+        }
     }
-    prev = (uint16_t)(((uint16_t)buf[0]) << 8) | buf[1];                                      /* set prev */
-    *enable = (scd4x_bool_t)((prev >> 0) & 0x01);                                             /* get bool */
-    
-    return 0;                                                                                 /* success return 0 */
 }
 
 /**
- * @brief     start low power periodic measurement
+ * @brief     set the data ready polling max interval
  * @param[in] *handle pointer to an scd4x handle structure
+ * @param[in] ms max interval in ms
  * @return    status code
  *            - 0 success
- *            - 1 start low power periodic measurement failed
  *            - 2 handle is NULL
  *            - 3 handle is not initialized
- * @note      none
+ *            - 4 ms is invalid
+ * @note      10 <= ms <= 60000
  */
-uint8_t scd4x_start_low_power_periodic_measurement(scd4x_handle_t *handle)
+uint8_t scd4x_set_data_ready_max_interval(scd4x_handle_t *handle, uint32_t ms)
 {
-    uint8_t res;
-    
-    if (handle == NULL)                                                                      /* check handle */
+    if (handle == NULL)                                                                            /* check handle */
     {
-        return 2;                                                                            /* return error */
+        return 2;                                                                                  /* return error */
     }
-    if (handle->inited != 1)                                                                 /* check handle initialization */
+    if (handle->inited != 1)                                                                       /* check handle initialization */
     {
-        return 3;                                                                            /* return error */
+        return 3;                                                                                  /* return error */
     }
-
-    res = a_scd4x_iic_write(handle, SCD4X_COMMAND_START_LOW_POWER_PERIODIC, NULL, 0);        /* write config */
-    if (res != 0)                                                                            /* check result */
+    if ((ms < SCD4X_DATA_READY_MIN_INTERVAL) || (ms > SCD4X_DATA_READY_MAX_INTERVAL_LIMIT))        /* check ms */
     {
-        handle->debug_print("scd4x: start low power periodic measurement failed.\n");        /* start low power periodic measurement failed */
-       
-        return 1;                                                                            /* return error */
+        SCD4X_LOG_ERROR(handle, SCD4X_LOG_MS_INVALID, ms, "scd4x: ms is invalid.\n");              /* ms is invalid */
+        
+        return 4;                                                                                  /* return error */
     }
     
-    return 0;                                                                                /* success return 0 */
+    handle->poll_max_ms = ms;                                                                      /* set max interval */
+    handle->poll_interval_ms = SCD4X_DATA_READY_MIN_INTERVAL;                                      /* restart the backoff */
+    
+    return 0;                                                                                      /* success return 0 */
 }
 
 /**
- * @brief      get data ready status
+ * @brief      get the data ready polling max interval
  * @param[in]  *handle pointer to an scd4x handle structure
- * @param[out] *enable pointer to a bool buffer
+ * @param[out] *ms pointer to a max interval buffer
  * @return     status code
  *             - 0 success
- *             - 1 get data ready status failed
  *             - 2 handle is NULL
  *             - 3 handle is not initialized
- *             - 4 crc is error
  * @note       none
  */
-uint8_t scd4x_get_data_ready_status(scd4x_handle_t *handle, scd4x_bool_t *enable)
+uint8_t scd4x_get_data_ready_max_interval(scd4x_handle_t *handle, uint32_t *ms)
 {
-    uint8_t res;
-    uint8_t buf[3];
-    uint16_t prev;
-    
-    if (handle == NULL)                                                                   /* check handle */
+    if (handle == NULL)                 /* check handle */
     {
-        return 2;                                                                         /* return error */
+        return 2;                       /* return error */
     }
-    if (handle->inited != 1)                                                              /* check handle initialization */
+    if (handle->inited != 1)            /* check handle initialization */
     {
-        return 3;                                                                         /* return error */
+        return 3;                       /* return error */
     }
+    
+    *ms = handle->poll_max_ms;          /* get max interval */
+    
+    return 0;                           /* success return 0 */
+}
 
-    res = a_scd4x_iic_read(handle, SCD4X_COMMAND_GET_DATA_READY_STATUS, buf, 3, 1);       /* read config */
-    if (res != 0)                                                                         /* check result */
+/**
+ * @brief      get the pending command execution time
+ * @param[in]  *handle pointer to an scd4x handle structure
+ * @param[out] *us pointer to a rest time buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       the next bus access of this handle waits the rest time,
+ *             the whole execution time is returned if get_time_us is not linked
+ */
+uint8_t scd4x_get_pending_time(scd4x_handle_t *handle, uint32_t *us)
+{
+    if (handle == NULL)                                                     /* check handle */
     {
-        handle->debug_print("scd4x: get data ready status failed.\n");                    /* get data ready status failed */
-       
-        return 1;                                                                         /* return error */
+        return 2;                                                           /* return error */
     }
-    if (buf[2] != a_scd4x_generate_crc(&buf[0], 2))                                       /* check crc */
+    if (handle->inited != 1)                                                /* check handle initialization */
     {
-        handle->debug_print("scd4x: crc is error.\n");                                    /* crc is error */
-       
-        return 4;                                                                         /* return error */
+        return 3;                                                           /* return error */
     }
-    prev = (uint16_t)(((uint16_t)buf[0]) << 8) | buf[1];                                  /* set prev */
-    if ((prev & 0x0FFF) != 0)                                                             /* check data */
+    
+    *us = (uint32_t)a_scd4x_pending_us(handle);                             /* set the rest time */
+    
+    return 0;                                                               /* success return 0 */
+}
+
+#if (SCD4X_CONFIG_LOG_BINARY != 0)
+/**
+ * @brief         read and remove the oldest log events
+ * @param[in]     *handle pointer to an scd4x handle structure
+ * @param[out]    *event pointer to a log event buffer
+ * @param[in,out] *len pointer to a buffer length buffer
+ * @param[out]    *lost pointer to an overwritten event number buffer
+ * @return        status code
+ *                - 0 success
+ *                - 2 handle is NULL
+ * @note          the log is kept across scd4x_init, so link failures can be read,
+ *                the lost counter is cleared after reading
+ */
+uint8_t scd4x_read_log(scd4x_handle_t *handle, scd4x_log_event_t *event, uint16_t *len, uint16_t *lost)
+{
+    uint16_t i;
+    
+    if (handle == NULL)                                                          /* check handle */
     {
-        *enable = SCD4X_BOOL_TRUE;                                                        /* ready */
+        return 2;                                                                /* return error */
     }
-    else
+    
+    for (i = 0; (i < *len) && (handle->log_count != 0); i++)                     /* copy the oldest events */
     {
-        *enable = SCD4X_BOOL_FALSE;                                                       /* not ready */
+        event[i] = handle->log[handle->log_head];                                /* copy the event */
+        handle->log_head = (uint16_t)((handle->log_head + 1) % 
+                                      SCD4X_CONFIG_LOG_DEPTH);                   /* move the oldest event */
+        handle->log_count--;                                                     /* remove the event */
     }
+    *len = i;                                                                    /* set the event number */
+    *lost = handle->log_lost;                                                    /* set the lost number */
+    handle->log_lost = 0;                                                        /* clear the lost number */
     
-    return 0;                                                                             /* success return 0 */
+    return 0;                                                                    /* success return 0 */
 }
+#endif
 
+#if (SCD4X_CONFIG_PERSIST != 0)
 /**
  * @brief     persist settings
  * @param[in] *handle pointer to an scd4x handle structure
@@ -1146,32 +1871,13 @@ uint8_t scd4x_get_data_ready_status(scd4x_handle_t *handle, scd4x_bool_t *enable
  *            - 1 persist settings failed
  *            - 2 handle is NULL
  *            - 3 handle is not initialized
- * @note      none
+ * @note      the next bus access waits 800ms
  */
 uint8_t scd4x_persist_settings(scd4x_handle_t *handle)
 {
-    uint8_t res;
-    
-    if (handle == NULL)                                                              /* check handle */
-    {
-        return 2;                                                                    /* return error */
-    }
-    if (handle->inited != 1)                                                         /* check handle initialization */
-    {
-        return 3;                                                                    /* return error */
-    }
-
-    res = a_scd4x_iic_write(handle, SCD4X_COMMAND_PERSIST_SETTINGS, NULL, 0);        /* write config */
-    if (res != 0)                                                                    /* check result */
-    {
-        handle->debug_print("scd4x: persist settings failed.\n");                    /* persist settings failed */
-       
-        return 1;                                                                    /* return error */
-    }
-    handle->delay_ms(800);                                                           /* delay 800ms */
-    
-    return 0;                                                                        /* success return 0 */
+    return a_scd4x_execute(handle, SCD4X_CMD_PERSIST_SETTINGS, NULL, NULL);        /* run the command */
 }
+#endif
 
 /**
  * @brief      get serial number
@@ -1186,51 +1892,63 @@ uint8_t scd4x_persist_settings(scd4x_handle_t *handle)
  * @note       none
  */
 uint8_t scd4x_get_serial_number(scd4x_handle_t *handle, uint16_t number[3])
+{
+    return a_scd4x_execute(handle, SCD4X_CMD_GET_SERIAL_NUMBER, NULL, number);        /* run the command */
+}
+
+/**
+ * @brief      get sensor variant
+ * @param[in]  *handle pointer to an scd4x handle structure
+ * @param[out] *type pointer to a chip type buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 get sensor variant failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ *             - 4 crc is error
+ *             - 5 variant is unknown
+ * @note       the chip type of the handle is not changed
+ */
+uint8_t scd4x_get_sensor_variant(scd4x_handle_t *handle, scd4x_t *type)
 {
     uint8_t res;
-    uint8_t buf[9];
+    uint16_t prev;
     
-    if (handle == NULL)                                                               /* check handle */
-    {
-        return 2;                                                                     /* return error */
-    }
-    if (handle->inited != 1)                                                          /* check handle initialization */
-    {
-        return 3;                                                                     /* return error */
-    }
-
-    res = a_scd4x_iic_read(handle, SCD4X_COMMAND_GET_SERIAL_NUMBER, buf, 9, 1);       /* read config */
-    if (res != 0)                                                                     /* check result */
+    res = a_scd4x_execute(handle, SCD4X_CMD_GET_SENSOR_VARIANT, NULL, &prev);        /* run the command */
+    if (res != 0)                                                                   /* check result */
     {
-        handle->debug_print("scd4x: get serial number failed.\n");                    /* get serial number failed */
-       
-        return 1;                                                                     /* return error */
-    }
-    if (buf[2] != a_scd4x_generate_crc(&buf[0], 2))                                   /* check crc */
-    {
-        handle->debug_print("scd4x: crc is error.\n");                                /* crc is error */
-       
-        return 4;                                                                     /* return error */
+        return res;                                                                 /* return error */
     }
-    if (buf[5] != a_scd4x_generate_crc(&buf[3], 2))                                   /* check crc */
+    switch ((prev >> 12) & 0xF)                                                     /* check variant bits */
     {
-        handle->debug_print("scd4x: crc is error.\n");                                /* crc is error */
-       
-        return 4;                                                                     /* return error */
-    }
-    if (buf[8] != a_scd4x_generate_crc(&buf[6], 2))                                   /* check crc */
-    {
-        handle->debug_print("scd4x: crc is error.\n");                                /* crc is error */
-       
-        return 4;                                                                     /* return error */
+        case 0x0 :
+        {
+            *type = SCD40;                                                          /* scd40 */
+            
+            return 0;                                                               /* success return 0 */
+        }
+        case 0x1 :
+        {
+            *type = SCD41;                                                          /* scd41 */
+            
+            return 0;                                                               /* success return 0 */
+        }
+        case 0x5 :
+        {
+            *type = SCD43;                                                          /* scd43 */
+            
+            return 0;                                                               /* success return 0 */
+        }
+        default :
+        {
+            SCD4X_LOG_ERROR(handle, SCD4X_LOG_VARIANT_UNKNOWN, prev, "scd4x: variant is unknown.\n");        /* variant is unknown */
+            
+            return 5;                                                               /* return error */
+        }
     }
-    number[0] = (uint16_t)(((uint16_t)buf[0]) << 8) | buf[1];                         /* set number0 */
-    number[1] = (uint16_t)(((uint16_t)buf[3]) << 8) | buf[4];                         /* set number1 */
-    number[2] = (uint16_t)(((uint16_t)buf[6]) << 8) | buf[7];                         /* set number2 */
-    
-    return 0;                                                                         /* success return 0 */
 }
 
+#if (SCD4X_CONFIG_SELF_TEST != 0)
 /**
  * @brief      perform self test
  * @param[in]  *handle pointer to an scd4x handle structure
@@ -1246,78 +1964,91 @@ uint8_t scd4x_get_serial_number(scd4x_handle_t *handle, uint16_t number[3])
 uint8_t scd4x_perform_self_test(scd4x_handle_t *handle, scd4x_bool_t *malfunction_detected)
 {
     uint8_t res;
-    uint8_t buf[3];
     uint16_t prev;
     
-    if (handle == NULL)                                                                   /* check handle */
-    {
-        return 2;                                                                         /* return error */
-    }
-    if (handle->inited != 1)                                                              /* check handle initialization */
-    {
-        return 3;                                                                         /* return error */
-    }
-
-    res = a_scd4x_iic_read(handle, SCD4X_COMMAND_PERFORM_SELF_TEST, buf, 3, 10000);       /* read config */
-    if (res != 0)                                                                         /* check result */
-    {
-        handle->debug_print("scd4x: perform self test failed.\n");                        /* perform self test failed */
-       
-        return 1;                                                                         /* return error */
-    }
-    if (buf[2] != a_scd4x_generate_crc(&buf[0], 2))                                       /* check crc */
+    res = a_scd4x_execute(handle, SCD4X_CMD_PERFORM_SELF_TEST, NULL, &prev);        /* run the command */
+    if (res != 0)                                                                   /* check result */
     {
-        handle->debug_print("scd4x: crc is error.\n");                                    /* crc is error */
-       
-        return 4;                                                                         /* return error */
+        return res;                                                                 /* return error */
     }
-    prev = (uint16_t)(((uint16_t)buf[0]) << 8) | buf[1];                                  /* set prev */
-    if (prev != 0)                                                                        /* check data */
+    if (prev != 0)                                                                  /* check data */
     {
-        *malfunction_detected = SCD4X_BOOL_TRUE;                                          /* true */
+        *malfunction_detected = SCD4X_BOOL_TRUE;                                    /* true */
     }
     else
     {
-        *malfunction_detected = SCD4X_BOOL_FALSE;                                         /* false */
+        *malfunction_detected = SCD4X_BOOL_FALSE;                                   /* false */
     }
     
-    return 0;                                                                             /* success return 0 */
+    return 0;                                                                       /* success return 0 */
 }
 
 /**
- * @brief     perform factory reset
+ * @brief     start self test
  * @param[in] *handle pointer to an scd4x handle structure
  * @return    status code
  *            - 0 success
- *            - 1 perform factory reset failed
+ *            - 1 start self test failed
  *            - 2 handle is NULL
  *            - 3 handle is not initialized
- * @note      none
+ * @note      read the result with scd4x_get_self_test_result after 10000ms
  */
-uint8_t scd4x_perform_factory_reset(scd4x_handle_t *handle)
+uint8_t scd4x_start_self_test(scd4x_handle_t *handle)
+{
+    return a_scd4x_execute(handle, SCD4X_CMD_START_SELF_TEST, NULL, NULL);        /* run the command */
+}
+
+/**
+ * @brief      get self test result
+ * @param[in]  *handle pointer to an scd4x handle structure
+ * @param[out] *malfunction_detected pointer to a bool value buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 get self test result failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ *             - 4 crc is error
+ * @note       it waits the rest of the 10000ms self test time
+ */
+uint8_t scd4x_get_self_test_result(scd4x_handle_t *handle, scd4x_bool_t *malfunction_detected)
 {
     uint8_t res;
+    uint16_t prev;
     
-    if (handle == NULL)                                                                   /* check handle */
+    res = a_scd4x_execute(handle, SCD4X_CMD_GET_SELF_TEST_RESULT, NULL, &prev);        /* run the command */
+    if (res != 0)                                                                      /* check result */
     {
-        return 2;                                                                         /* return error */
+        return res;                                                                    /* return error */
     }
-    if (handle->inited != 1)                                                              /* check handle initialization */
+    if (prev != 0)                                                                     /* check data */
     {
-        return 3;                                                                         /* return error */
+        *malfunction_detected = SCD4X_BOOL_TRUE;                                       /* true */
     }
-
-    res = a_scd4x_iic_write(handle, SCD4X_COMMAND_PERFORM_FACTORY_RESET, NULL, 0);        /* write config */
-    if (res != 0)                                                                         /* check result */
+    else
     {
-        handle->debug_print("scd4x: perform factory reset failed.\n");                    /* perform factory reset failed */
-       
-        return 1;                                                                         /* return error */
+        *malfunction_detected = SCD4X_BOOL_FALSE;                                      /* false */
     }
-    handle->delay_ms(1200);                                                               /* delay 1200ms */
     
-    return 0;                                                                             /* success return 0 */
+    return 0;                                                                          /* success return 0 */
+}
+#endif
+
+#if (SCD4X_CONFIG_FACTORY_RESET != 0)
+/**
+ * @brief     perform factory reset
+ * @param[in] *handle pointer to an scd4x handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 perform factory reset failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      the next bus access waits 1200ms
+ */
+uint8_t scd4x_perform_factory_reset(scd4x_handle_t *handle)
+{
+    return a_scd4x_execute(handle, SCD4X_CMD_PERFORM_FACTORY_RESET, NULL, NULL);        /* run the command */
 }
+#endif
 
 /**
  * @brief     reinit
@@ -1327,33 +2058,14 @@ uint8_t scd4x_perform_factory_reset(scd4x_handle_t *handle)
  *            - 1 reinit failed
  *            - 2 handle is NULL
  *            - 3 handle is not initialized
- * @note      none
+ * @note      the next bus access waits 30ms
  */
 uint8_t scd4x_reinit(scd4x_handle_t *handle)
 {
-    uint8_t res;
-    
-    if (handle == NULL)                                                    /* check handle */
-    {
-        return 2;                                                          /* return error */
-    }
-    if (handle->inited != 1)                                               /* check handle initialization */
-    {
-        return 3;                                                          /* return error */
-    }
-
-    res = a_scd4x_iic_write(handle, SCD4X_COMMAND_REINIT, NULL, 0);        /* write config */
-    if (res != 0)                                                          /* check result */
-    {
-        handle->debug_print("scd4x: reinit failed.\n");                    /* reinit failed */
-       
-        return 1;                                                          /* return error */
-    }
-    handle->delay_ms(30);                                                  /* delay 30ms */
-    
-    return 0;                                                              /* success return 0 */
+    return a_scd4x_execute(handle, SCD4X_CMD_REINIT, NULL, NULL);        /* run the command */
 }
 
+#if (SCD4X_CONFIG_SINGLE_SHOT != 0)
 /**
  * @brief     measure single shot
  * @param[in] *handle pointer to an scd4x handle structure
@@ -1363,157 +2075,350 @@ uint8_t scd4x_reinit(scd4x_handle_t *handle)
  *            - 2 handle is NULL
  *            - 3 handle is not initialized
  *            - 4 only scd41 and scd43 has this function
- * @note      none
+ * @note      the next bus access waits until the 5000ms measurement has finished
  */
 uint8_t scd4x_measure_single_shot(scd4x_handle_t *handle)
+{
+    return a_scd4x_execute(handle, SCD4X_CMD_MEASURE_SINGLE_SHOT, NULL, NULL);        /* run the command */
+}
+
+/**
+ * @brief     measure single shot rht only
+ * @param[in] *handle pointer to an scd4x handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 measure single shot rht only failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 only scd41 and scd43 has this function
+ * @note      the next bus access waits until the 50ms measurement has finished
+ */
+uint8_t scd4x_measure_single_shot_rht_only(scd4x_handle_t *handle)
+{
+    return a_scd4x_execute(handle, SCD4X_CMD_MEASURE_SINGLE_SHOT_RHT_ONLY, NULL, NULL);        /* run the command */
+}
+
+/**
+ * @brief     power down
+ * @param[in] *handle pointer to an scd4x handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 power down failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 only scd41 and scd43 has this function
+ * @note      none
+ */
+uint8_t scd4x_power_down(scd4x_handle_t *handle)
+{
+    return a_scd4x_execute(handle, SCD4X_CMD_POWER_DOWN, NULL, NULL);        /* run the command */
+}
+
+/**
+ * @brief     wake up
+ * @param[in] *handle pointer to an scd4x handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 wake up failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 only scd41 and scd43 has this function
+ * @note      the next bus access waits 30ms
+ */
+uint8_t scd4x_wake_up(scd4x_handle_t *handle)
+{
+    return a_scd4x_execute(handle, SCD4X_CMD_WAKE_UP, NULL, NULL);        /* run the command */
+}
+
+/**
+ * @brief     enable or disable the sleepy shot mode
+ * @param[in] *handle pointer to an scd4x handle structure
+ * @param[in] enable bool value
+ * @param[in] first_shot use the first shot after a wake up
+ * @return    status code
+ *            - 0 success
+ *            - 1 power down or wake up failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 only scd41 and scd43 has this function
+ * @note      enabling powers the chip down, disabling wakes it up, the chip must be idle,
+ *            the other commands need the mode disabled, scd4x_deinit disables it
+ */
+uint8_t scd4x_set_sleepy_shot(scd4x_handle_t *handle, scd4x_bool_t enable, scd4x_bool_t first_shot)
 {
     uint8_t res;
     
-    if (handle == NULL)                                                                 /* check handle */
+    res = a_scd4x_check(handle, SCD4X_CMD_POWER_DOWN);                                         /* check handle and type */
+    if (res != 0)                                                                              /* check result */
     {
-        return 2;                                                                       /* return error */
+        return res;                                                                            /* return error */
     }
-    if (handle->inited != 1)                                                            /* check handle initialization */
+    
+    if ((enable != SCD4X_BOOL_FALSE) && ((handle->sleepy & SCD4X_SLEEPY_ENABLE) == 0))         /* enable */
     {
-        return 3;                                                                       /* return error */
+        if (a_scd4x_run(handle, SCD4X_CMD_POWER_DOWN, NULL, NULL) != 0)                        /* power down */
+        {
+            return 1;                                                                          /* return error */
+        }
     }
-    if (handle->type == SCD40)                                                          /* check type */
+    if ((enable == SCD4X_BOOL_FALSE) && ((handle->sleepy & SCD4X_SLEEPY_ENABLE) != 0))         /* disable */
     {
-        handle->debug_print("scd4x: only scd41 and scd43 has this function.\n");        /* only scd41 and scd43 has this function */
-       
-        return 4;                                                                       /* return error */
+        if (a_scd4x_run(handle, SCD4X_CMD_WAKE_UP, NULL, NULL) != 0)                           /* wake up */
+        {
+            return 1;                                                                          /* return error */
+        }
     }
-
-    res = a_scd4x_iic_write(handle, SCD4X_COMMAND_MEASURE_SINGLE_SHOT, NULL, 0);        /* write config */
-    if (res != 0)                                                                       /* check result */
+    handle->sleepy = 0;                                                                        /* clear flags */
+    if (enable != SCD4X_BOOL_FALSE)                                                            /* check enable */
     {
-        handle->debug_print("scd4x: measure single shot failed.\n");                    /* measure single shot failed */
-       
-        return 1;                                                                       /* return error */
+        handle->sleepy = (uint8_t)(SCD4X_SLEEPY_ENABLE | 
+                                   ((first_shot != SCD4X_BOOL_FALSE) ? SCD4X_SLEEPY_FIRST_SHOT : 0));    /* set flags */
     }
-    handle->delay_ms(5000);                                                             /* delay 5000ms */
     
-    return 0;                                                                           /* success return 0 */
+    return 0;                                                                                  /* success return 0 */
 }
 
 /**
- * @brief     measure single shot rht only
- * @param[in] *handle pointer to an scd4x handle structure
- * @return    status code
- *            - 0 success
- *            - 1 measure single shot rht only failed
- *            - 2 handle is NULL
- *            - 3 handle is not initialized
- *            - 4 only scd41 and scd43 has this function
- * @note      none
+ * @brief      wake up, measure single shot, read and power down
+ * @param[in]  *handle pointer to an scd4x handle structure
+ * @param[out] *sample pointer to an scd4x sample structure
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ *             - 4 crc is error
+ *             - 5 data is not ready
+ *             - 6 sleepy shot mode is disabled
+ * @note       the first shot after the wake up is read and dropped as the datasheet requires
+ *             unless first_shot is set, so one reading takes 10 s or 5 s,
+ *             a late data ready is polled with the backoff for up to 1000 ms after each shot,
+ *             the chip is powered down even if a step failed
  */
-uint8_t scd4x_measure_single_shot_rht_only(scd4x_handle_t *handle)
+uint8_t scd4x_read_sleepy_shot(scd4x_handle_t *handle, scd4x_sample_t *sample)
 {
     uint8_t res;
+    uint8_t shots;
+    uint8_t i;
+    uint16_t word[3];
     
-    if (handle == NULL)                                                                          /* check handle */
+    if (handle == NULL)                                                                   /* check handle */
     {
-        return 2;                                                                                /* return error */
+        return 2;                                                                         /* return error */
     }
-    if (handle->inited != 1)                                                                     /* check handle initialization */
+    if (handle->inited != 1)                                                              /* check handle initialization */
     {
-        return 3;                                                                                /* return error */
+        return 3;                                                                         /* return error */
     }
-    if (handle->type == SCD40)                                                                   /* check type */
+    if ((handle->sleepy & SCD4X_SLEEPY_ENABLE) == 0)                                      /* check mode */
     {
-        handle->debug_print("scd4x: only scd41 and scd43 has this function.\n");                 /* only scd41 and scd43 has this function */
-       
-        return 4;                                                                                /* return error */
+        return 6;                                                                         /* return error */
     }
-
-    res = a_scd4x_iic_write(handle, SCD4X_COMMAND_MEASURE_SINGLE_SHOT_RHT_ONLY, NULL, 0);        /* write config */
-    if (res != 0)                                                                                /* check result */
+    
+    shots = ((handle->sleepy & SCD4X_SLEEPY_FIRST_SHOT) != 0) ? 1 : 2;                    /* drop the first shot */
+    res = a_scd4x_run(handle, SCD4X_CMD_WAKE_UP, NULL, NULL);                             /* wake up */
+    for (i = 0; (i < shots) && (res == 0); i++)                                           /* run all shots */
     {
-        handle->debug_print("scd4x: measure single shot rht only failed.\n");                    /* measure single shot rht only failed */
-       
-        return 1;                                                                                /* return error */
+        res = a_scd4x_run(handle, SCD4X_CMD_MEASURE_SINGLE_SHOT, NULL, NULL);             /* measure single shot */
+        if (res == 0)                                                                     /* check result */
+        {
+            res = scd4x_wait_data_ready(handle, SCD4X_SHOT_READY_TIMEOUT);                /* wait the shot with the backoff */
+        }
+        if (res == 0)                                                                     /* check result */
+        {
+            res = a_scd4x_run(handle, SCD4X_CMD_READ, NULL, word);                        /* read the shot */
+            res = a_scd4x_read_finish(handle, res, word, sample);                         /* set the sample */
+        }
+    }
+    if ((a_scd4x_run(handle, SCD4X_CMD_POWER_DOWN, NULL, NULL) != 0) && (res == 0))       /* power down */
+    {
+        res = 1;                                                                          /* power down failed */
     }
-    handle->delay_ms(50);                                                                        /* delay 50ms */
     
-    return 0;                                                                                    /* success return 0 */
+    return res;                                                                           /* return the result */
 }
 
 /**
- * @brief     power down
- * @param[in] *handle pointer to an scd4x handle structure
- * @return    status code
- *            - 0 success
- *            - 1 power down failed
- *            - 2 handle is NULL
- *            - 3 handle is not initialized
- *            - 4 only scd41 and scd43 has this function
- * @note      none
+ * @brief      get the estimated charge of one sleepy shot reading
+ * @param[in]  *handle pointer to an scd4x handle structure
+ * @param[in]  *model pointer to an energy model structure
+ * @param[out] *uc pointer to a charge buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle or model is NULL
+ * @note       the wake up, the shots and the reads are charged from the command execution times,
+ *             add sleep_na for the time between the readings
  */
-uint8_t scd4x_power_down(scd4x_handle_t *handle)
+uint8_t scd4x_get_sleepy_shot_charge(scd4x_handle_t *handle, const scd4x_energy_model_t *model, float *uc)
 {
-    uint8_t res;
+    uint8_t shots;
+    uint32_t wake_ms;
+    uint32_t shot_ms;
+    uint32_t awake_ms;
+    uint64_t charge;
     
-    if (handle == NULL)                                                                 /* check handle */
+    if ((handle == NULL) || (model == NULL))                                                                 /* check handle and model */
     {
-        return 2;                                                                       /* return error */
+        return 2;                                                                                            /* return error */
     }
-    if (handle->inited != 1)                                                            /* check handle initialization */
+    
+    shots = ((handle->sleepy & SCD4X_SLEEPY_FIRST_SHOT) != 0) ? 1 : 2;                                       /* the first shot is dropped */
+    wake_ms = gs_scd4x_command[SCD4X_CMD_WAKE_UP].exec_ms;                                                   /* wake up time */
+    shot_ms = gs_scd4x_command[SCD4X_CMD_MEASURE_SINGLE_SHOT].exec_ms;                                       /* shot time */
+    awake_ms = wake_ms + (shot_ms + gs_scd4x_command[SCD4X_CMD_READ].exec_ms) * shots + 
+               gs_scd4x_command[SCD4X_CMD_POWER_DOWN].exec_ms;                                               /* awake time */
+    charge = (uint64_t)model->wake_up_na * wake_ms + (uint64_t)model->shot_na * shot_ms * shots + 
+             (uint64_t)model->idle_na * (awake_ms - wake_ms - shot_ms * shots);                              /* awake charge */
+    *uc = (float)((double)charge / 1000000.0);                                                               /* na * ms to uc */
+    
+    return 0;                                                                                                /* success return 0 */
+}
+
+/**
+ * @brief      init a hybrid schedule of rht only shots and full shots
+ * @param[in]  *handle pointer to an scd4x handle structure
+ * @param[out] *hybrid pointer to a hybrid schedule structure
+ * @param[in]  rht_interval_ms temperature and humidity interval
+ * @param[in]  co2_interval_ms co2 interval
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ *             - 4 only scd41 and scd43 has this function
+ *             - 5 interval is invalid
+ *             - 6 get_time_us is not linked
+ * @note       the co2 interval is rounded to a multiple of the rht interval, the chip must be idle,
+ *             the first shot is a full shot
+ */
+uint8_t scd4x_hybrid_init(scd4x_handle_t *handle, scd4x_hybrid_t *hybrid, uint32_t rht_interval_ms, uint32_t co2_interval_ms)
+{
+    uint8_t res;
+    
+    res = a_scd4x_check(handle, SCD4X_CMD_MEASURE_SINGLE_SHOT);                                              /* check handle and type */
+    if (res != 0)                                                                                            /* check result */
     {
-        return 3;                                                                       /* return error */
+        return res;                                                                                          /* return error */
     }
-    if (handle->type == SCD40)                                                          /* check type */
+    if ((rht_interval_ms == 0) || (co2_interval_ms < rht_interval_ms))                                       /* check interval */
     {
-        handle->debug_print("scd4x: only scd41 and scd43 has this function.\n");        /* only scd41 and scd43 has this function */
-       
-        return 4;                                                                       /* return error */
+        SCD4X_LOG_ERROR(handle, SCD4X_LOG_MS_INVALID, (rht_interval_ms > 0xFFFFU) ? 0xFFFFU : rht_interval_ms, 
+                        "scd4x: ms is invalid.\n");                                                          /* ms is invalid */
+        
+        return 5;                                                                                            /* return error */
     }
-
-    res = a_scd4x_iic_write(handle, SCD4X_COMMAND_POWER_DOWN, NULL, 0);                 /* write config */
-    if (res != 0)                                                                       /* check result */
+    if (handle->get_time_us == NULL)                                                                         /* check time source */
     {
-        handle->debug_print("scd4x: power down failed.\n");                             /* power down failed */
-       
-        return 1;                                                                       /* return error */
+        SCD4X_LOG_ERROR(handle, SCD4X_LOG_LINK_NULL, 5, "scd4x: get_time_us is null.\n");                    /* get_time_us is null */
+        
+        return 6;                                                                                            /* return error */
     }
-    handle->delay_ms(1);                                                                /* delay 1ms */
     
-    return 0;                                                                           /* success return 0 */
+    hybrid->rht_interval_ms = rht_interval_ms;                                                               /* set interval */
+    hybrid->co2_ratio = (co2_interval_ms + rht_interval_ms / 2) / rht_interval_ms;                           /* round the co2 interval */
+    hybrid->tick = 0;                                                                                        /* start with a full shot */
+    hybrid->shot = SCD4X_HYBRID_NONE;                                                                        /* no shot */
+    hybrid->next_us = handle->get_time_us();                                                                 /* first shot now */
+    hybrid->due_us = hybrid->next_us;                                                                        /* set due time */
+    hybrid->timeout_us = 0;                                                                                  /* no shot */
+    handle->poll_state = SCD4X_POLL_IDLE;                                                                    /* restart the poll */
+    
+    return 0;                                                                                                /* success return 0 */
 }
 
 /**
- * @brief     wake up
- * @param[in] *handle pointer to an scd4x handle structure
- * @return    status code
- *            - 0 success
- *            - 1 wake up failed
- *            - 2 handle is NULL
- *            - 3 handle is not initialized
- *            - 4 only scd41 and scd43 has this function
- * @note      none
+ * @brief      run the hybrid schedule without blocking
+ * @param[in]  *handle pointer to an scd4x handle structure
+ * @param[in]  *hybrid pointer to a hybrid schedule structure
+ * @param[out] *sample pointer to an scd4x sample structure
+ * @param[out] *stream pointer to a stream mask buffer
+ * @param[out] *wait_us pointer to a rest time buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 measure or read failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ *             - 4 crc is error
+ *             - 5 data is not ready 1000 ms after the shot execution time
+ *             - 6 no sample yet, call again after wait_us
+ * @note       each shot is a rht only shot of 50ms, every co2_ratio-th one is a full shot of 5000ms
+ *             whose sample belongs to both streams, the shots missed during a full shot are merged into one after it,
+ *             the co2 of a rht only sample is not valid, a late data ready keeps the shot in flight
+ *             and is polled with the backoff
  */
-uint8_t scd4x_wake_up(scd4x_handle_t *handle)
+uint8_t scd4x_hybrid_poll(scd4x_handle_t *handle, scd4x_hybrid_t *hybrid, scd4x_sample_t *sample,
+                          uint8_t *stream, uint32_t *wait_us)
 {
-    if (handle == NULL)                                                                 /* check handle */
+    uint8_t res;
+    uint8_t full;
+    uint64_t now_us;
+    uint64_t interval_us;
+    uint64_t missed;
+    
+    if (handle == NULL)                                                                                      /* check handle */
     {
-        return 2;                                                                       /* return error */
+        return 2;                                                                                            /* return error */
     }
-    if (handle->inited != 1)                                                            /* check handle initialization */
+    if (handle->inited != 1)                                                                                 /* check handle initialization */
     {
-        return 3;                                                                       /* return error */
+        return 3;                                                                                            /* return error */
     }
-    if (handle->type == SCD40)                                                          /* check type */
+    
+    *stream = 0;                                                                                             /* init 0 */
+    *wait_us = 0;                                                                                            /* init 0 */
+    if (hybrid->shot != SCD4X_HYBRID_NONE)                                                                   /* check the shot in flight */
     {
-        handle->debug_print("scd4x: only scd41 and scd43 has this function.\n");        /* only scd41 and scd43 has this function */
-       
-        return 4;                                                                       /* return error */
+        res = scd4x_poll_sample(handle, sample, wait_us);                                                    /* read the shot */
+        if (res == 6)                                                                                        /* check busy */
+        {
+            return 6;                                                                                        /* return busy */
+        }
+        if (res == 5)                                                                                        /* check data ready */
+        {
+            now_us = handle->get_time_us();                                                                  /* get time */
+            if (now_us < hybrid->timeout_us)                                                                 /* check timeout */
+            {
+                return 6;                                                                                    /* poll again after the backoff */
+            }
+            SCD4X_LOG_WARNING(handle, SCD4X_LOG_TIMEOUT, SCD4X_SHOT_READY_TIMEOUT, 
+                              "scd4x: wait data ready timeout.\n");                                         /* wait data ready timeout */
+        }
+        if (res == 0)                                                                                        /* check result */
+        {
+            *stream = (hybrid->shot == SCD4X_HYBRID_FULL) ? (SCD4X_STREAM_RHT | SCD4X_STREAM_CO2) : 
+                      SCD4X_STREAM_RHT;                                                                      /* set the streams */
+        }
+        hybrid->shot = SCD4X_HYBRID_NONE;                                                                    /* shot is finished */
+        
+        return res;                                                                                          /* return the result */
+    }
+    now_us = handle->get_time_us();                                                                          /* get time */
+    if (now_us < hybrid->next_us)                                                                            /* check the next shot */
+    {
+        *wait_us = (uint32_t)(hybrid->next_us - now_us);                                                     /* set the rest time */
+        
+        return 6;                                                                                            /* return busy */
     }
-
-    (void)a_scd4x_iic_write(handle, SCD4X_COMMAND_WAKE_UP, NULL, 0);                    /* write config */
-    handle->delay_ms(30);                                                               /* delay 30ms */
     
-    return 0;                                                                           /* success return 0 */
+    interval_us = (uint64_t)hybrid->rht_interval_ms * 1000;                                                  /* shot interval */
+    missed = (now_us - hybrid->next_us) / interval_us;                                                       /* missed shots */
+    full = (uint8_t)((hybrid->tick == 0) || (hybrid->tick + missed >= hybrid->co2_ratio));                   /* a missed full shot is kept */
+    hybrid->tick = (uint32_t)((hybrid->tick + missed + 1) % hybrid->co2_ratio);                              /* next shot index */
+    hybrid->due_us = hybrid->next_us;                                                                        /* save the due time */
+    hybrid->next_us += interval_us * (missed + 1);                                                           /* skip the missed shots */
+    if (a_scd4x_send(handle, &gs_scd4x_command[(full != 0) ? SCD4X_CMD_MEASURE_SINGLE_SHOT : 
+                                               SCD4X_CMD_MEASURE_SINGLE_SHOT_RHT_ONLY], NULL) != 0)          /* start the shot */
+    {
+        return 1;                                                                                            /* return error */
+    }
+    hybrid->shot = (full != 0) ? SCD4X_HYBRID_FULL : SCD4X_HYBRID_RHT;                                       /* shot in flight */
+    *wait_us = (uint32_t)a_scd4x_pending_us(handle);                                                         /* wait the shot */
+    hybrid->timeout_us = now_us + *wait_us + (uint64_t)SCD4X_SHOT_READY_TIMEOUT * 1000;                      /* set the data ready timeout */
+    
+    return 6;                                                                                                /* return busy */
 }
+#endif
 
+#if (SCD4X_CONFIG_ASC != 0)
 /**
  * @brief     set automatic self calibration initial period
  * @param[in] *handle pointer to an scd4x handle structure
@@ -1530,42 +2435,20 @@ uint8_t scd4x_wake_up(scd4x_handle_t *handle)
 uint8_t scd4x_set_automatic_self_calibration_initial_period(scd4x_handle_t *handle, uint16_t hour)
 {
     uint8_t res;
-    uint8_t buf[3];
     
-    if (handle == NULL)                                                                                  /* check handle */
+    res = a_scd4x_check(handle, SCD4X_CMD_SET_AUTO_SELF_CALIBRATION_INIT);                                            /* check handle and type */
+    if (res != 0)                                                                                                     /* check result */
     {
-        return 2;                                                                                        /* return error */
-    }
-    if (handle->inited != 1)                                                                             /* check handle initialization */
-    {
-        return 3;                                                                                        /* return error */
-    }
-    if (handle->type == SCD40)                                                                           /* check type */
-    {
-        handle->debug_print("scd4x: only scd41 and scd43 has this function.\n");                         /* only scd41 and scd43 has this function */
-       
-        return 4;                                                                                        /* return error */
-    }
-    if ((hour % 4) != 0)                                                                                 /* check hour */
-    {
-        handle->debug_print("scd4x: hour is not integer multiples of 4.\n");                             /* hour is not integer multiples of 4 */
-       
-        return 5;                                                                                        /* return error */
+        return res;                                                                                                   /* return error */
     }
-    
-    buf[0] = (hour >> 8) & 0xFF;                                                                         /* msb */
-    buf[1] = (hour >> 0) & 0xFF;                                                                         /* lsb */
-    buf[2] = a_scd4x_generate_crc(&buf[0], 2);                                                           /* crc */
-    res = a_scd4x_iic_write(handle, SCD4X_COMMAND_SET_AUTO_SELF_CALIBRATION_INIT_PERIOD, buf, 3);        /* write config */
-    if (res != 0)                                                                                        /* check result */
+    if ((hour % 4) != 0)                                                                                              /* check hour */
     {
-        handle->debug_print("scd4x: set automatic self calibration initial period failed.\n");           /* set automatic self calibration initial period failed */
+        SCD4X_LOG_ERROR(handle, SCD4X_LOG_HOUR_INVALID, hour, "scd4x: hour is not integer multiples of 4.\n");        /* hour is not integer multiples of 4 */
        
-        return 1;                                                                                        /* return error */
+        return 5;                                                                                                     /* return error */
     }
-    handle->delay_ms(1);                                                                                 /* delay 1ms */
     
-    return 0;                                                                                            /* success return 0 */
+    return a_scd4x_run(handle, SCD4X_CMD_SET_AUTO_SELF_CALIBRATION_INIT, &hour, NULL);                                /* run the command */
 }
 
 /**
@@ -1583,40 +2466,7 @@ uint8_t scd4x_set_automatic_self_calibration_initial_period(scd4x_handle_t *hand
  */
 uint8_t scd4x_get_automatic_self_calibration_initial_period(scd4x_handle_t *handle, uint16_t *hour)
 {
-    uint8_t res;
-    uint8_t buf[3];
-    
-    if (handle == NULL)                                                                                    /* check handle */
-    {
-        return 2;                                                                                          /* return error */
-    }
-    if (handle->inited != 1)                                                                               /* check handle initialization */
-    {
-        return 3;                                                                                          /* return error */
-    }
-    if (handle->type == SCD40)                                                                             /* check type */
-    {
-        handle->debug_print("scd4x: only scd41 and scd43 has this function.\n");                           /* only scd41 and scd43 has this function */
-       
-        return 4;                                                                                          /* return error */
-    }
-    
-    res = a_scd4x_iic_read(handle, SCD4X_COMMAND_GET_AUTO_SELF_CALIBRATION_INIT_PERIOD, buf, 3, 1);        /* read config */
-    if (res != 0)                                                                                          /* check result */
-    {
-        handle->debug_print("scd4x: get automatic self calibration initial period failed.\n");             /* get automatic self calibration initial period failed */
-       
-        return 1;                                                                                          /* return error */
-    }
-    if (buf[2] != a_scd4x_generate_crc(&buf[0], 2))                                                        /* check crc */
-    {
-        handle->debug_print("scd4x: crc is error.\n");                                                     /* crc is error */
-       
-        return 5;                                                                                          /* return error */
-    }
-    *hour = (uint16_t)(((uint16_t)buf[0]) << 8) | buf[1];                                                  /* get hour */
-    
-    return 0;                                                                                              /* success return 0 */
+    return a_scd4x_execute(handle, SCD4X_CMD_GET_AUTO_SELF_CALIBRATION_INIT, NULL, hour);        /* run the command */
 }
 
 /**
@@ -1635,42 +2485,20 @@ uint8_t scd4x_get_automatic_self_calibration_initial_period(scd4x_handle_t *hand
 uint8_t scd4x_set_automatic_self_calibration_standard_period(scd4x_handle_t *handle, uint16_t hour)
 {
     uint8_t res;
-    uint8_t buf[3];
     
-    if (handle == NULL)                                                                                  /* check handle */
-    {
-        return 2;                                                                                        /* return error */
-    }
-    if (handle->inited != 1)                                                                             /* check handle initialization */
-    {
-        return 3;                                                                                        /* return error */
-    }
-    if (handle->type == SCD40)                                                                           /* check type */
-    {
-        handle->debug_print("scd4x: only scd41 and scd43 has this function.\n");                         /* only scd41 and scd43 has this function */
-       
-        return 4;                                                                                        /* return error */
-    }
-    if ((hour % 4) != 0)                                                                                 /* check hour */
+    res = a_scd4x_check(handle, SCD4X_CMD_SET_AUTO_SELF_CALIBRATION_STANDARD);                                        /* check handle and type */
+    if (res != 0)                                                                                                     /* check result */
     {
-        handle->debug_print("scd4x: hour is not integer multiples of 4.\n");                             /* hour is not integer multiples of 4 */
-       
-        return 5;                                                                                        /* return error */
+        return res;                                                                                                   /* return error */
     }
-    
-    buf[0] = (hour >> 8) & 0xFF;                                                                         /* msb */
-    buf[1] = (hour >> 0) & 0xFF;                                                                         /* lsb */
-    buf[2] = a_scd4x_generate_crc(&buf[0], 2);                                                           /* crc */
-    res = a_scd4x_iic_write(handle, SCD4X_COMMAND_SET_AUTO_SELF_CALIBRATION_STANDARD_PERIOD, buf, 3);    /* write config */
-    if (res != 0)                                                                                        /* check result */
+    if ((hour % 4) != 0)                                                                                              /* check hour */
     {
-        handle->debug_print("scd4x: set automatic self calibration standard period failed.\n");          /* set automatic self calibration standard period failed */
+        SCD4X_LOG_ERROR(handle, SCD4X_LOG_HOUR_INVALID, hour, "scd4x: hour is not integer multiples of 4.\n");        /* hour is not integer multiples of 4 */
        
-        return 1;                                                                                        /* return error */
+        return 5;                                                                                                     /* return error */
     }
-    handle->delay_ms(1);                                                                                 /* delay 1ms */
     
-    return 0;                                                                                            /* success return 0 */
+    return a_scd4x_run(handle, SCD4X_CMD_SET_AUTO_SELF_CALIBRATION_STANDARD, &hour, NULL);                            /* run the command */
 }
 
 /**
@@ -1688,41 +2516,9 @@ uint8_t scd4x_set_automatic_self_calibration_standard_period(scd4x_handle_t *han
  */
 uint8_t scd4x_get_automatic_self_calibration_standard_period(scd4x_handle_t *handle, uint16_t *hour)
 {
-    uint8_t res;
-    uint8_t buf[3];
-    
-    if (handle == NULL)                                                                                    /* check handle */
-    {
-        return 2;                                                                                          /* return error */
-    }
-    if (handle->inited != 1)                                                                               /* check handle initialization */
-    {
-        return 3;                                                                                          /* return error */
-    }
-    if (handle->type == SCD40)                                                                             /* check type */
-    {
-        handle->debug_print("scd4x: only scd41 and scd43 has this function.\n");                           /* only scd41 and scd43 has this function */
-       
-        return 4;                                                                                          /* return error */
-    }
-    
-    res = a_scd4x_iic_read(handle, SCD4X_COMMAND_GET_AUTO_SELF_CALIBRATION_STANDARD_PERIOD, buf, 3, 1);    /* read config */
-    if (res != 0)                                                                                          /* check result */
-    {
-        handle->debug_print("scd4x: get automatic self calibration standard period failed.\n");            /* get automatic self calibration standard period failed */
-       
-        return 1;                                                                                          /* return error */
-    }
-    if (buf[2] != a_scd4x_generate_crc(&buf[0], 2))                                                        /* check crc */
-    {
-        handle->debug_print("scd4x: crc is error.\n");                                                     /* crc is error */
-       
-        return 5;                                                                                          /* return error */
-    }
-    *hour = (uint16_t)(((uint16_t)buf[0]) << 8) | buf[1];                                                  /* get hour */
-    
-    return 0;                                                                                              /* success return 0 */
+    return a_scd4x_execute(handle, SCD4X_CMD_GET_AUTO_SELF_CALIBRATION_STANDARD, NULL, hour);        /* run the command */
 }
+#endif
 
 /**
  * @brief     initialize the chip
@@ -1732,7 +2528,8 @@ uint8_t scd4x_get_automatic_self_calibration_standard_period(scd4x_handle_t *han
  *            - 1 iic initialization failed
  *            - 2 handle is NULL
  *            - 3 linked functions is NULL
- * @note      none
+ *            - 4 handle config is invalid
+ * @note      the handle must be compiled with the config of the driver
  */
 uint8_t scd4x_init(scd4x_handle_t *handle)
 { 
@@ -1746,41 +2543,63 @@ uint8_t scd4x_init(scd4x_handle_t *handle)
     }
     if (handle->iic_init == NULL)                                            /* check iic_init */
     {
-        handle->debug_print("scd4x: iic_init is null.\n");                   /* iic_init is null */
+        SCD4X_LOG_ERROR(handle, SCD4X_LOG_LINK_NULL, 0, "scd4x: iic_init is null.\n");                   /* iic_init is null */
     
         return 3;                                                            /* return error */
     }
     if (handle->iic_deinit == NULL)                                          /* check iic_deinit */
     {
-        handle->debug_print("scd4x: iic_deinit is null.\n");                 /* iic_deinit is null */
+        SCD4X_LOG_ERROR(handle, SCD4X_LOG_LINK_NULL, 1, "scd4x: iic_deinit is null.\n");                 /* iic_deinit is null */
     
         return 3;                                                            /* return error */
     }
     if (handle->iic_write_cmd == NULL)                                       /* check iic_write_cmd */
     {
-        handle->debug_print("scd4x: iic_write_cmd is null.\n");              /* iic_write_cmd is null */
+        SCD4X_LOG_ERROR(handle, SCD4X_LOG_LINK_NULL, 2, "scd4x: iic_write_cmd is null.\n");              /* iic_write_cmd is null */
     
         return 3;                                                            /* return error */
     }
     if (handle->iic_read_cmd == NULL)                                        /* check iic_read_cmd */
     {
-        handle->debug_print("scd4x: iic_read_cmd is null.\n");               /* iic_read_cmd is null */
+        SCD4X_LOG_ERROR(handle, SCD4X_LOG_LINK_NULL, 3, "scd4x: iic_read_cmd is null.\n");               /* iic_read_cmd is null */
     
         return 3;                                                            /* return error */
     }
     if (handle->delay_ms == NULL)                                            /* check delay_ms */
     {
-        handle->debug_print("scd4x: delay_ms is null.\n");                   /* delay_ms is null */
+        SCD4X_LOG_ERROR(handle, SCD4X_LOG_LINK_NULL, 4, "scd4x: delay_ms is null.\n");                   /* delay_ms is null */
     
         return 3;                                                            /* return error */
     }
+    if (handle->config != SCD4X_CONFIG_SIGNATURE)                            /* check the handle layout */
+    {
+#if (SCD4X_LOG_TEXT != 0)
+        handle->debug_print("scd4x: handle config is invalid.\n");           /* handle config is invalid */
+#endif
+    
+        return 4;                                                            /* return error */
+    }
     
     if (handle->iic_init() != 0)                                             /* iic init */
     {
-        handle->debug_print("scd4x: iic init failed.\n");                    /* iic init failed */
+        SCD4X_LOG_ERROR(handle, SCD4X_LOG_IIC_INIT_FAILED, 0, "scd4x: iic init failed.\n");                    /* iic init failed */
     
         return 1;                                                            /* return error */
     }
+    handle->wait_ms = 0;                                                     /* clear pending time */
+    handle->ready_flag = 0;                                                  /* clear data ready flag */
+    handle->poll_state = SCD4X_POLL_IDLE;                                    /* clear poll state */
+    handle->poll_interval_ms = SCD4X_DATA_READY_MIN_INTERVAL;                /* set the first polling interval */
+#if (SCD4X_CONFIG_SINGLE_SHOT != 0)
+    handle->sleepy = 0;                                                      /* clear sleepy shot flags */
+#endif
+#if (SCD4X_CONFIG_ACCOUNTING != 0)
+    handle->account_enable = SCD4X_ACCOUNT_OFF;                              /* clear accounting */
+#endif
+    if (handle->poll_max_ms == 0)                                            /* check max interval */
+    {
+        handle->poll_max_ms = SCD4X_DATA_READY_MAX_INTERVAL;                 /* set default max interval */
+    }
     handle->inited = 1;                                                      /* flag finish initialization */
   
     return 0;                                                                /* success return 0 */
@@ -1801,33 +2620,265 @@ uint8_t scd4x_deinit(scd4x_handle_t *handle)
 {
     uint8_t res;
     
-    if (handle == NULL)                                                           /* check handle */
+    if (handle == NULL)                                                                                                                    /* check handle */
     {
-        return 2;                                                                 /* return error */
+        return 2;                                                                                                                          /* return error */
     }
-    if (handle->inited != 1)                                                      /* check handle initialization */
+    if (handle->inited != 1)                                                                                                               /* check handle initialization */
     {
-        return 3;                                                                 /* return error */
+        return 3;                                                                                                                          /* return error */
     }    
     
-    res = a_scd4x_iic_write(handle, SCD4X_COMMAND_STOP_PERIODIC, NULL, 0);        /* write config */
-    if (res != 0)                                                                 /* check result */
+#if (SCD4X_CONFIG_SINGLE_SHOT != 0)
+    if ((handle->sleepy & SCD4X_SLEEPY_ENABLE) != 0)                                                                                       /* check sleepy shot */
+    {
+        (void)a_scd4x_run(handle, SCD4X_CMD_WAKE_UP, NULL, NULL);                                                                          /* wake up */
+        handle->sleepy = 0;                                                                                                                /* clear flags */
+    }
+#endif
+    res = a_scd4x_iic_write(handle, SCD4X_COMMAND_STOP_PERIODIC, NULL, 0);                                                                 /* write config */
+    if (res != 0)                                                                                                                          /* check result */
     {
-        handle->debug_print("scd4x: stop periodic measurement failed.\n");        /* stop periodic measurement failed */
+        SCD4X_LOG_ERROR(handle, SCD4X_LOG_WRITE_FAILED, SCD4X_COMMAND_STOP_PERIODIC, "scd4x: stop periodic measurement failed.\n");        /* stop periodic measurement failed */
        
-        return 4;                                                                 /* return error */
+        return 4;                                                                                                                          /* return error */
     }
-    if (handle->iic_deinit() != 0)                                                /* iic deinit */
+    if (handle->iic_deinit() != 0)                                                                                                         /* iic deinit */
     {
-        handle->debug_print("scd4x: iic close failed.\n");                        /* iic close failed */
+        SCD4X_LOG_ERROR(handle, SCD4X_LOG_IIC_DEINIT_FAILED, 0, "scd4x: iic close failed.\n");                                             /* iic close failed */
     
-        return 3;                                                                 /* return error */
+        return 3;                                                                                                                          /* return error */
     }
-    handle->inited = 0;                                                           /* flag close initialization */
+    handle->inited = 0;                                                                                                                    /* flag close initialization */
   
-    return 0;                                                                     /* success return 0 */
+    return 0;                                                                                                                              /* success return 0 */
+}
+
+#if ((SCD4X_CONFIG_SINGLE_SHOT != 0) || (SCD4X_CONFIG_ACCOUNTING != 0))
+/**
+ * @brief default energy model, typical currents of a scd41 at 3.3 v
+ */
+static const scd4x_energy_model_t gs_scd4x_energy_model =
+{
+    500,             /* 0.5 ua power down */
+    200000,          /* 0.2 ma idle */
+    15000000,        /* 15 ma periodic measurement */
+    3200000,         /* 3.2 ma low power periodic measurement */
+    15200000,        /* 15.2 ma single shot, 0.45 ma average with one shot each 5 min */
+    15200000,        /* no datasheet value, the single shot current is used */
+    200000,          /* 0.2 ma wake up */
+    15000000,        /* no datasheet value, the periodic measurement current is used */
+};
+
+/**
+ * @brief      get the default energy model
+ * @param[out] *model pointer to an energy model structure
+ * @return     status code
+ *             - 0 success
+ *             - 2 model is NULL
+ * @note       typical currents of a scd41 at 3.3 v, a board should measure and set its own
+ */
+uint8_t scd4x_energy_default_model(scd4x_energy_model_t *model)
+{
+    if (model == NULL)                        /* check model */
+    {
+        return 2;                             /* return error */
+    }
+    
+    *model = gs_scd4x_energy_model;           /* copy the model */
+    
+    return 0;                                 /* success return 0 */
+}
+
+#endif
+
+#if (SCD4X_CONFIG_ACCOUNTING != 0)
+/**
+ * @brief     start the energy accounting
+ * @param[in] *handle pointer to an scd4x handle structure
+ * @param[in] *model pointer to an energy model structure
+ * @param[in] state current chip state
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle or model is NULL
+ *            - 3 handle is not initialized
+ *            - 4 state is invalid
+ *            - 5 get_time_us is not linked
+ * @note      the counters are cleared, every command sent after this call moves the accounted state,
+ *            the single shots, the wake up and the self test return to idle after their execution time
+ */
+uint8_t scd4x_account_start(scd4x_handle_t *handle, const scd4x_energy_model_t *model, scd4x_account_state_t state)
+{
+    uint8_t i;
+    
+    if ((handle == NULL) || (model == NULL))                                                   /* check handle and model */
+    {
+        return 2;                                                                              /* return error */
+    }
+    if (handle->inited != 1)                                                                   /* check handle initialization */
+    {
+        return 3;                                                                              /* return error */
+    }
+    if (state >= SCD4X_ACCOUNT_MAX)                                                            /* check state */
+    {
+        SCD4X_LOG_ERROR(handle, SCD4X_LOG_PARAM_INVALID, state, "scd4x: state is invalid.\n");        /* state is invalid */
+        
+        return 4;                                                                              /* return error */
+    }
+    if (handle->get_time_us == NULL)                                                           /* check time source */
+    {
+        SCD4X_LOG_ERROR(handle, SCD4X_LOG_LINK_NULL, 5, "scd4x: get_time_us is null.\n");              /* get_time_us is null */
+        
+        return 5;                                                                              /* return error */
+    }
+    
+    handle->account_model = *model;                                                            /* copy the model */
+    handle->account_state = (uint8_t)state;                                                    /* set state */
+    handle->account_commands = 0;                                                              /* clear commands */
+    handle->account_end_us = 0;                                                                /* not timed */
+    for (i = 0; i < SCD4X_ACCOUNT_MAX; i++)                                                    /* clear all states */
+    {
+        handle->account_state_us[i] = 0;                                                       /* clear time */
+    }
+    handle->account_start_us = handle->get_time_us();                                          /* set start time */
+    handle->account_us = handle->account_start_us;                                             /* counted up to now */
+    handle->account_enable = SCD4X_ACCOUNT_RUN;                                                /* start */
+    
+    return 0;                                                                                  /* success return 0 */
+}
+
+/**
+ * @brief     stop the energy accounting
+ * @param[in] *handle pointer to an scd4x handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      the counters are kept and can still be read
+ */
+uint8_t scd4x_account_stop(scd4x_handle_t *handle)
+{
+    if (handle == NULL)                                                    /* check handle */
+    {
+        return 2;                                                          /* return error */
+    }
+    if (handle->inited != 1)                                               /* check handle initialization */
+    {
+        return 3;                                                          /* return error */
+    }
+    
+    if (handle->account_enable == SCD4X_ACCOUNT_RUN)                       /* check accounting */
+    {
+        a_scd4x_account_update(handle, handle->get_time_us());             /* count up to now */
+        handle->account_enable = SCD4X_ACCOUNT_HOLD;                       /* keep the counters */
+    }
+    
+    return 0;                                                              /* success return 0 */
+}
+
+/**
+ * @brief     set the accounted chip state
+ * @param[in] *handle pointer to an scd4x handle structure
+ * @param[in] state chip state
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 state is invalid
+ *            - 5 accounting is not started
+ * @note      for the state changes without a command, e.g. a power cycle of the chip
+ */
+uint8_t scd4x_account_set_state(scd4x_handle_t *handle, scd4x_account_state_t state)
+{
+    if (handle == NULL)                                                                        /* check handle */
+    {
+        return 2;                                                                              /* return error */
+    }
+    if (handle->inited != 1)                                                                   /* check handle initialization */
+    {
+        return 3;                                                                              /* return error */
+    }
+    if (state >= SCD4X_ACCOUNT_MAX)                                                            /* check state */
+    {
+        SCD4X_LOG_ERROR(handle, SCD4X_LOG_PARAM_INVALID, state, "scd4x: state is invalid.\n");        /* state is invalid */
+        
+        return 4;                                                                              /* return error */
+    }
+    if (handle->account_enable != SCD4X_ACCOUNT_RUN)                                           /* check accounting */
+    {
+        return 5;                                                                              /* return error */
+    }
+    
+    a_scd4x_account_update(handle, handle->get_time_us());                                     /* count up to now */
+    handle->account_state = (uint8_t)state;                                                    /* set state */
+    handle->account_end_us = 0;                                                                /* not timed */
+    
+    return 0;                                                                                  /* success return 0 */
+}
+
+/**
+ * @brief      get the energy accounting stats
+ * @param[in]  *handle pointer to an scd4x handle structure
+ * @param[out] *stats pointer to an account stats structure
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle or stats is NULL
+ *             - 3 handle is not initialized
+ *             - 4 accounting is not started
+ * @note       the time is counted up to now if the accounting is running, the commands without
+ *             their own state, e.g. the forced recalibration, are charged at the current of the state they run in
+ */
+uint8_t scd4x_get_account_stats(scd4x_handle_t *handle, scd4x_account_stats_t *stats)
+{
+    uint32_t current[SCD4X_ACCOUNT_MAX];
+    double charge;
+    uint8_t i;
+    
+    if ((handle == NULL) || (stats == NULL))                                                   /* check handle and stats */
+    {
+        return 2;                                                                              /* return error */
+    }
+    if (handle->inited != 1)                                                                   /* check handle initialization */
+    {
+        return 3;                                                                              /* return error */
+    }
+    if (handle->account_enable == SCD4X_ACCOUNT_OFF)                                           /* check accounting */
+    {
+        return 4;                                                                              /* return error */
+    }
+    
+    if (handle->account_enable == SCD4X_ACCOUNT_RUN)                                           /* check running */
+    {
+        a_scd4x_account_update(handle, handle->get_time_us());                                 /* count up to now */
+    }
+    current[SCD4X_ACCOUNT_SLEEP] = handle->account_model.sleep_na;                             /* power down current */
+    current[SCD4X_ACCOUNT_IDLE] = handle->account_model.idle_na;                               /* idle current */
+    current[SCD4X_ACCOUNT_PERIODIC] = handle->account_model.periodic_na;                       /* periodic measurement current */
+    current[SCD4X_ACCOUNT_LOW_POWER] = handle->account_model.low_power_na;                     /* low power periodic measurement current */
+    current[SCD4X_ACCOUNT_SHOT] = handle->account_model.shot_na;                               /* single shot current */
+    current[SCD4X_ACCOUNT_RHT_ONLY] = handle->account_model.rht_only_na;                       /* rht only single shot current */
+    current[SCD4X_ACCOUNT_WAKE_UP] = handle->account_model.wake_up_na;                         /* wake up current */
+    current[SCD4X_ACCOUNT_SELF_TEST] = handle->account_model.self_test_na;                     /* self test current */
+    charge = 0.0;                                                                              /* init 0 */
+    for (i = 0; i < SCD4X_ACCOUNT_MAX; i++)                                                    /* charge all states */
+    {
+        stats->state_us[i] = handle->account_state_us[i];                                      /* copy time */
+        stats->state_uah[i] = (float)((double)current[i] * 
+                                      (double)handle->account_state_us[i] / 3.6e12);           /* na * us to uah */
+        charge += (double)current[i] * (double)handle->account_state_us[i];                    /* sum the charge */
+    }
+    stats->state = handle->account_state;                                                      /* set state */
+    stats->commands = handle->account_commands;                                                /* set commands */
+    stats->elapsed_us = handle->account_us - handle->account_start_us;                         /* set elapsed time */
+    stats->charge_uah = (float)(charge / 3.6e12);                                              /* na * us to uah */
+    stats->average_ua = (stats->elapsed_us != 0) ? 
+                        (float)(charge / (double)stats->elapsed_us / 1000.0) : 0.0f;           /* na * us / us to ua */
+    
+    return 0;                                                                                  /* success return 0 */
 }
+#endif
 
+#if (SCD4X_CONFIG_REG != 0)
 /**
  * @brief     set the chip register
  * @param[in] *handle pointer to an scd4x handle structure
@@ -1882,6 +2933,7 @@ uint8_t scd4x_get_reg(scd4x_handle_t *handle, uint16_t reg, uint8_t *buf, uint16
   
     return a_scd4x_iic_read(handle, reg, buf, len, delay_ms);      /* read data */
 }
+#endif
 
 /**
  * @brief      get chip information
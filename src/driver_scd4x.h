@@ -41,6 +41,129 @@
 #include <stdint.h>
 #include <string.h>
 
+/**
+ * @brief optional project config header, included before the defaults below
+ * @note  e.g. -DSCD4X_CONFIG_FILE=\"scd4x_config.h\"
+ */
+#ifdef SCD4X_CONFIG_FILE
+    #include SCD4X_CONFIG_FILE
+#endif
+
+/**
+ * @brief set 0 to compile out the temperature offset, altitude and ambient pressure commands
+ */
+#ifndef SCD4X_CONFIG_COMPENSATION
+    #define SCD4X_CONFIG_COMPENSATION 1
+#endif
+
+/**
+ * @brief set 0 to compile out the data convert helpers
+ */
+#ifndef SCD4X_CONFIG_CONVERT
+    #define SCD4X_CONFIG_CONVERT 1
+#endif
+
+/**
+ * @brief set 0 to compile out the forced recalibration command
+ */
+#ifndef SCD4X_CONFIG_FRC
+    #define SCD4X_CONFIG_FRC 1
+#endif
+
+/**
+ * @brief set 0 to compile out the automatic self calibration and its period commands
+ */
+#ifndef SCD4X_CONFIG_ASC
+    #define SCD4X_CONFIG_ASC 1
+#endif
+
+/**
+ * @brief set 0 to compile out the persist settings command
+ */
+#ifndef SCD4X_CONFIG_PERSIST
+    #define SCD4X_CONFIG_PERSIST 1
+#endif
+
+/**
+ * @brief set 0 to compile out the self test commands
+ */
+#ifndef SCD4X_CONFIG_SELF_TEST
+    #define SCD4X_CONFIG_SELF_TEST 1
+#endif
+
+/**
+ * @brief set 0 to compile out the factory reset command
+ */
+#ifndef SCD4X_CONFIG_FACTORY_RESET
+    #define SCD4X_CONFIG_FACTORY_RESET 1
+#endif
+
+/**
+ * @brief set 0 to compile out the single shot, power down and wake up commands
+ */
+#ifndef SCD4X_CONFIG_SINGLE_SHOT
+    #define SCD4X_CONFIG_SINGLE_SHOT 1
+#endif
+
+/**
+ * @brief set 0 to compile out the raw register access functions
+ */
+#ifndef SCD4X_CONFIG_REG
+    #define SCD4X_CONFIG_REG 1
+#endif
+
+/**
+ * @brief set 1 to compile in the adaptive sampling controller of driver_scd4x_adaptive.c
+ */
+#ifndef SCD4X_CONFIG_ADAPTIVE
+    #define SCD4X_CONFIG_ADAPTIVE 0
+#endif
+
+/**
+ * @brief set 1 to compile in the per handle energy accounting, it grows the handle and adds a hook to every command
+ */
+#ifndef SCD4X_CONFIG_ACCOUNTING
+    #define SCD4X_CONFIG_ACCOUNTING 0
+#endif
+
+/**
+ * @brief log level definition
+ */
+#define SCD4X_LOG_LEVEL_NONE           0        /**< no log */
+#define SCD4X_LOG_LEVEL_ERROR          1        /**< bus, crc, argument and link errors */
+#define SCD4X_LOG_LEVEL_WARNING        2        /**< errors, data not ready and timeout */
+
+/**
+ * @brief max log level compiled in, the lower level messages are compiled out
+ */
+#ifndef SCD4X_CONFIG_LOG_LEVEL
+    #define SCD4X_CONFIG_LOG_LEVEL SCD4X_LOG_LEVEL_WARNING
+#endif
+
+/**
+ * @brief set 1 to store log events in the handle instead of calling debug_print,
+ *        the driver then carries no format strings
+ */
+#ifndef SCD4X_CONFIG_LOG_BINARY
+    #define SCD4X_CONFIG_LOG_BINARY 0
+#endif
+
+/**
+ * @brief log event ring depth
+ */
+#ifndef SCD4X_CONFIG_LOG_DEPTH
+    #define SCD4X_CONFIG_LOG_DEPTH 16
+#endif
+
+/**
+ * @brief handle layout signature of the config
+ * @note  the single shot, accounting and binary log fields change the handle layout,
+ *        DRIVER_SCD4X_LINK_INIT stores the signature of the caller and scd4x_init checks it against the driver
+ */
+#define SCD4X_CONFIG_SIGNATURE    ((uint32_t)(((SCD4X_CONFIG_SINGLE_SHOT != 0) ? 0x01 : 0) |                  \
+                                              ((SCD4X_CONFIG_ACCOUNTING != 0) ? 0x02 : 0) |                   \
+                                              ((SCD4X_CONFIG_LOG_BINARY != 0) ? (0x04 | (SCD4X_CONFIG_LOG_DEPTH << 8)) : 0)))
+
 #ifdef __cplusplus
 extern "C"{
 #endif
@@ -75,6 +198,87 @@ typedef enum
     SCD4X_BOOL_TRUE  = 0x01,        /**< true */
 } scd4x_bool_t;
 
+/**
+ * @brief scd4x log event id enumeration definition
+ * @note  the ids are stable, new ids are only appended
+ */
+typedef enum
+{
+    SCD4X_LOG_TYPE_INVALID      = 0x01,        /**< only scd41 and scd43 has this function, arg is the chip type */
+    SCD4X_LOG_WRITE_FAILED      = 0x02,        /**< command write failed, arg is the command */
+    SCD4X_LOG_READ_FAILED       = 0x03,        /**< response read failed, arg is the command */
+    SCD4X_LOG_CRC_ERROR         = 0x04,        /**< crc is error, arg is the command */
+    SCD4X_LOG_DATA_NOT_READY    = 0x05,        /**< data is not ready */
+    SCD4X_LOG_TIMEOUT           = 0x06,        /**< wait data ready timeout, arg is the timeout in ms */
+    SCD4X_LOG_MS_INVALID        = 0x07,        /**< ms is invalid, arg is the ms */
+    SCD4X_LOG_HOUR_INVALID      = 0x08,        /**< hour is not integer multiples of 4, arg is the hour */
+    SCD4X_LOG_LINK_NULL         = 0x09,        /**< link function is null, arg is the link index */
+    SCD4X_LOG_IIC_INIT_FAILED   = 0x0A,        /**< iic init failed */
+    SCD4X_LOG_IIC_DEINIT_FAILED = 0x0B,        /**< iic close failed */
+    SCD4X_LOG_VARIANT_UNKNOWN   = 0x0C,        /**< variant is unknown, arg is the raw variant */
+    SCD4X_LOG_PARAM_INVALID     = 0x0D,        /**< param is invalid */
+} scd4x_log_id_t;
+
+/**
+ * @brief scd4x log event structure definition
+ * @note  8 bytes without padding, a little endian dump is decoded by tool/driver_scd4x_log_decode.c
+ */
+typedef struct scd4x_log_event_s
+{
+    uint32_t time_ms;        /**< event time in ms, 0 if get_time_us is not linked */
+    uint16_t arg;            /**< event argument */
+    uint8_t id;              /**< event id */
+    uint8_t level;           /**< event level */
+} scd4x_log_event_t;
+
+/**
+ * @brief scd4x energy model structure definition
+ * @note  the currents are the average supply currents of each state in na
+ */
+typedef struct scd4x_energy_model_s
+{
+    uint32_t sleep_na;            /**< power down */
+    uint32_t idle_na;             /**< idle */
+    uint32_t periodic_na;         /**< periodic measurement */
+    uint32_t low_power_na;        /**< low power periodic measurement */
+    uint32_t shot_na;             /**< single shot */
+    uint32_t rht_only_na;         /**< rht only single shot */
+    uint32_t wake_up_na;          /**< wake up */
+    uint32_t self_test_na;        /**< self test */
+} scd4x_energy_model_t;
+
+#if (SCD4X_CONFIG_ACCOUNTING != 0)
+/**
+ * @brief scd4x account state enumeration definition
+ */
+typedef enum
+{
+    SCD4X_ACCOUNT_SLEEP     = 0x00,        /**< power down */
+    SCD4X_ACCOUNT_IDLE      = 0x01,        /**< idle */
+    SCD4X_ACCOUNT_PERIODIC  = 0x02,        /**< periodic measurement */
+    SCD4X_ACCOUNT_LOW_POWER = 0x03,        /**< low power periodic measurement */
+    SCD4X_ACCOUNT_SHOT      = 0x04,        /**< single shot */
+    SCD4X_ACCOUNT_RHT_ONLY  = 0x05,        /**< rht only single shot */
+    SCD4X_ACCOUNT_WAKE_UP   = 0x06,        /**< wake up */
+    SCD4X_ACCOUNT_SELF_TEST = 0x07,        /**< self test */
+    SCD4X_ACCOUNT_MAX       = 0x08,        /**< state number */
+} scd4x_account_state_t;
+
+/**
+ * @brief scd4x account stats structure definition
+ */
+typedef struct scd4x_account_stats_s
+{
+    uint8_t state;                                 /**< current state */
+    uint32_t commands;                             /**< command number */
+    uint64_t elapsed_us;                           /**< accounted time */
+    uint64_t state_us[SCD4X_ACCOUNT_MAX];          /**< time spent in each state */
+    float state_uah[SCD4X_ACCOUNT_MAX];            /**< charge of each state in uah */
+    float charge_uah;                              /**< total charge in uah */
+    float average_ua;                              /**< average current in ua */
+} scd4x_account_stats_t;
+#endif
+
 /**
  * @brief scd4x handle structure definition
  */
@@ -85,11 +289,54 @@ typedef struct scd4x_handle_s
     uint8_t (*iic_write_cmd)(uint8_t addr, uint8_t *buf, uint16_t len);        /**< point to an iic_write_cmd function address */
     uint8_t (*iic_read_cmd)(uint8_t addr, uint8_t *buf, uint16_t len);         /**< point to an iic_read_cmd function address */
     void (*delay_ms)(uint32_t ms);                                             /**< point to a delay_ms function address */
+    uint64_t (*get_time_us)(void);                                             /**< point to a get_time_us function address */
     void (*debug_print)(const char *const fmt, ...);                           /**< point to a debug_print function address */
     uint8_t inited;                                                            /**< inited flag */
     uint8_t type;                                                              /**< chip type */
+    uint8_t ready_flag;                                                        /**< data ready seen flag */
+    uint8_t poll_state;                                                        /**< non-blocking poll state */
+    uint32_t config;                                                           /**< config signature of the handle layout */
+    uint32_t wait_ms;                                                          /**< pending command execution time */
+    uint32_t poll_max_ms;                                                      /**< data ready polling max interval */
+    uint32_t poll_interval_ms;                                                 /**< next data ready polling interval */
+    uint64_t cmd_time_us;                                                      /**< last command issue time */
+    uint64_t ready_time_us;                                                    /**< data ready seen time */
+#if (SCD4X_CONFIG_SINGLE_SHOT != 0)
+    uint8_t sleepy;                                                            /**< sleepy shot flags */
+#endif
+#if (SCD4X_CONFIG_ACCOUNTING != 0)
+    uint8_t account_enable;                                                    /**< energy accounting flag */
+    uint8_t account_state;                                                     /**< accounted chip state */
+    uint32_t account_commands;                                                 /**< accounted command number */
+    uint64_t account_start_us;                                                 /**< accounting start time */
+    uint64_t account_us;                                                       /**< time accounted up to */
+    uint64_t account_end_us;                                                   /**< end time of a timed state, 0 if not timed */
+    uint64_t account_state_us[SCD4X_ACCOUNT_MAX];                              /**< time spent in each state */
+    scd4x_energy_model_t account_model;                                        /**< current model */
+#endif
+#if (SCD4X_CONFIG_LOG_BINARY != 0)
+    scd4x_log_event_t log[SCD4X_CONFIG_LOG_DEPTH];                             /**< log event ring */
+    uint16_t log_head;                                                         /**< oldest log event */
+    uint16_t log_count;                                                        /**< log event number */
+    uint16_t log_lost;                                                         /**< overwritten log event number */
+#endif
 } scd4x_handle_t;
 
+/**
+ * @brief scd4x sample structure definition
+ */
+typedef struct scd4x_sample_s
+{
+    uint16_t co2_raw;              /**< co2 raw */
+    uint16_t co2_ppm;              /**< co2 ppm */
+    uint16_t temperature_raw;      /**< temperature raw */
+    float temperature_s;           /**< temperature */
+    uint16_t humidity_raw;         /**< humidity raw */
+    float humidity_s;              /**< humidity */
+    uint64_t ready_time_us;        /**< data ready seen time in us */
+    uint64_t read_time_us;         /**< data read time in us */
+} scd4x_sample_t;
+
 /**
  * @brief scd4x information structure definition
  */
@@ -106,6 +353,31 @@ typedef struct scd4x_info_s
     uint32_t driver_version;           /**< driver version */
 } scd4x_info_t;
 
+#if (SCD4X_CONFIG_SINGLE_SHOT != 0)
+/**
+ * @brief scd4x stream enumeration definition
+ */
+typedef enum
+{
+    SCD4X_STREAM_RHT = 0x01,        /**< temperature and humidity stream */
+    SCD4X_STREAM_CO2 = 0x02,        /**< co2 stream */
+} scd4x_stream_t;
+
+/**
+ * @brief scd4x hybrid schedule structure definition
+ */
+typedef struct scd4x_hybrid_s
+{
+    uint32_t rht_interval_ms;        /**< shot interval */
+    uint32_t co2_ratio;              /**< every co2_ratio-th shot is a full shot */
+    uint32_t tick;                   /**< shot index in the co2 interval */
+    uint8_t shot;                    /**< shot in flight */
+    uint64_t next_us;                /**< next shot time */
+    uint64_t due_us;                 /**< scheduled time of the shot in flight or of the last sample */
+    uint64_t timeout_us;             /**< data ready timeout of the shot in flight */
+} scd4x_hybrid_t;
+#endif
+
 /**
  * @}
  */
@@ -121,9 +393,10 @@ typedef struct scd4x_info_s
  * @brief     initialize scd4x_handle_t structure
  * @param[in] HANDLE pointer to an scd4x handle structure
  * @param[in] STRUCTURE scd4x_handle_t
- * @note      none
+ * @note      the handle gets the config signature of the caller
  */
-#define DRIVER_SCD4X_LINK_INIT(HANDLE, STRUCTURE)            memset(HANDLE, 0, sizeof(STRUCTURE))
+#define DRIVER_SCD4X_LINK_INIT(HANDLE, STRUCTURE)            do { memset(HANDLE, 0, sizeof(STRUCTURE));        \
+                                                                  (HANDLE)->config = SCD4X_CONFIG_SIGNATURE; } while (0)
 
 /**
  * @brief     link iic_init function
@@ -165,6 +438,14 @@ typedef struct scd4x_info_s
  */
 #define DRIVER_SCD4X_LINK_DELAY_MS(HANDLE, FUC)              (HANDLE)->delay_ms = FUC
 
+/**
+ * @brief     link get_time_us function
+ * @param[in] HANDLE pointer to an scd4x handle structure
+ * @param[in] FUC pointer to a get_time_us function address
+ * @note      optional, a monotonic time source in us, leave it unlinked if the platform has none
+ */
+#define DRIVER_SCD4X_LINK_GET_TIME_US(HANDLE, FUC)           (HANDLE)->get_time_us = FUC
+
 /**
  * @brief     link debug_print function
  * @param[in] HANDLE pointer to an scd4x handle structure
@@ -275,6 +556,41 @@ uint8_t scd4x_read(scd4x_handle_t *handle, uint16_t *co2_raw, uint16_t *co2_ppm,
                    uint16_t *temperature_raw, float *temperature_s,
                    uint16_t *humidity_raw, float *humidity_s);
 
+/**
+ * @brief      read a timestamped sample
+ * @param[in]  *handle pointer to an scd4x handle structure
+ * @param[out] *sample pointer to an scd4x sample structure
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ *             - 4 crc is error
+ *             - 5 data is not ready
+ * @note       the time stamps are 0 if get_time_us is not linked
+ */
+uint8_t scd4x_read_sample(scd4x_handle_t *handle, scd4x_sample_t *sample);
+
+/**
+ * @brief      poll a timestamped sample without blocking
+ * @param[in]  *handle pointer to an scd4x handle structure
+ * @param[out] *sample pointer to an scd4x sample structure
+ * @param[out] *wait_us pointer to a rest time buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ *             - 4 crc is error
+ *             - 5 data is not ready, call again after wait_us
+ *             - 6 command is in flight, call again after wait_us
+ * @note       each call makes at most one bus transfer and doesn't delay if get_time_us is linked,
+ *             the wait_us after 5 doubles from 10 ms up to the data ready polling max interval,
+ *             the sequence restarts after 0, 5 or an error, don't run other commands of this handle
+ *             while a command is in flight
+ */
+uint8_t scd4x_poll_sample(scd4x_handle_t *handle, scd4x_sample_t *sample, uint32_t *wait_us);
+
 /**
  * @brief     stop periodic measurement
  * @param[in] *handle pointer to an scd4x handle structure
@@ -283,10 +599,11 @@ uint8_t scd4x_read(scd4x_handle_t *handle, uint16_t *co2_raw, uint16_t *co2_ppm,
  *            - 1 stop periodic measurement failed
  *            - 2 handle is NULL
  *            - 3 handle is not initialized
- * @note      none
+ * @note      the next bus access waits 500ms
  */
 uint8_t scd4x_stop_periodic_measurement(scd4x_handle_t *handle);
 
+#if (SCD4X_CONFIG_COMPENSATION != 0)
 /**
  * @brief     set temperature offset
  * @param[in] *handle pointer to an scd4x handle structure
@@ -313,7 +630,9 @@ uint8_t scd4x_set_temperature_offset(scd4x_handle_t *handle, uint16_t offset);
  * @note       none
  */
 uint8_t scd4x_get_temperature_offset(scd4x_handle_t *handle, uint16_t *offset);
+#endif
 
+#if (SCD4X_CONFIG_CONVERT != 0)
 /**
  * @brief      convert the temperature offset to the register raw data
  * @param[in]  *handle pointer to an scd4x handle structure
@@ -339,7 +658,9 @@ uint8_t scd4x_temperature_offset_convert_to_register(scd4x_handle_t *handle, flo
  * @note       none
  */
 uint8_t scd4x_temperature_offset_convert_to_data(scd4x_handle_t *handle, uint16_t reg, float *degrees);
+#endif
 
+#if (SCD4X_CONFIG_COMPENSATION != 0)
 /**
  * @brief     set sensor altitude
  * @param[in] *handle pointer to an scd4x handle structure
@@ -366,7 +687,9 @@ uint8_t scd4x_set_sensor_altitude(scd4x_handle_t *handle, uint16_t altitude);
  * @note       none
  */
 uint8_t scd4x_get_sensor_altitude(scd4x_handle_t *handle, uint16_t *altitude);
+#endif
 
+#if (SCD4X_CONFIG_CONVERT != 0)
 /**
  * @brief      convert the sensor altitude to the register raw data
  * @param[in]  *handle pointer to an scd4x handle structure
@@ -392,7 +715,9 @@ uint8_t scd4x_sensor_altitude_convert_to_register(scd4x_handle_t *handle, float
  * @note       none
  */
 uint8_t scd4x_sensor_altitude_convert_to_data(scd4x_handle_t *handle, uint16_t reg, float *m);
+#endif
 
+#if (SCD4X_CONFIG_COMPENSATION != 0)
 /**
  * @brief     set ambient pressure
  * @param[in] *handle pointer to an scd4x handle structure
@@ -419,7 +744,9 @@ uint8_t scd4x_set_ambient_pressure(scd4x_handle_t *handle, uint16_t pressure);
  * @note       none
  */
 uint8_t scd4x_get_ambient_pressure(scd4x_handle_t *handle, uint16_t *pressure);
+#endif
 
+#if (SCD4X_CONFIG_CONVERT != 0)
 /**
  * @brief      convert the ambient pressure to the register raw data
  * @param[in]  *handle pointer to an scd4x handle structure
@@ -445,7 +772,9 @@ uint8_t scd4x_ambient_pressure_convert_to_register(scd4x_handle_t *handle, float
  * @note       none
  */
 uint8_t scd4x_ambient_pressure_convert_to_data(scd4x_handle_t *handle, uint16_t reg, float *pa);
+#endif
 
+#if (SCD4X_CONFIG_FRC != 0)
 /**
  * @brief      perform forced recalibration
  * @param[in]  *handle pointer to an scd4x handle structure
@@ -461,6 +790,35 @@ uint8_t scd4x_ambient_pressure_convert_to_data(scd4x_handle_t *handle, uint16_t
  */
 uint8_t scd4x_perform_forced_recalibration(scd4x_handle_t *handle, uint16_t co2_raw, uint16_t *frc);
 
+/**
+ * @brief     start forced recalibration
+ * @param[in] *handle pointer to an scd4x handle structure
+ * @param[in] co2_raw co2 raw data
+ * @return    status code
+ *            - 0 success
+ *            - 1 start forced recalibration failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      read the result with scd4x_get_forced_recalibration_result after 400ms
+ */
+uint8_t scd4x_start_forced_recalibration(scd4x_handle_t *handle, uint16_t co2_raw);
+
+/**
+ * @brief      get forced recalibration result
+ * @param[in]  *handle pointer to an scd4x handle structure
+ * @param[out] *frc pointer to a frc buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 get forced recalibration result failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ *             - 4 crc is error
+ * @note       it waits the rest of the 400ms forced recalibration time
+ */
+uint8_t scd4x_get_forced_recalibration_result(scd4x_handle_t *handle, uint16_t *frc);
+#endif
+
+#if (SCD4X_CONFIG_CONVERT != 0)
 /**
  * @brief      convert the co2 to the register raw data
  * @param[in]  *handle pointer to an scd4x handle structure
@@ -486,7 +844,9 @@ uint8_t scd4x_co2_convert_to_register(scd4x_handle_t *handle, float ppm, uint16_
  * @note       none
  */
 uint8_t scd4x_co2_convert_to_data(scd4x_handle_t *handle, uint16_t reg, float *ppm);
+#endif
 
+#if (SCD4X_CONFIG_ASC != 0)
 /**
  * @brief     enable or disable automatic self calibration 
  * @param[in] *handle pointer to an scd4x handle structure
@@ -513,6 +873,7 @@ uint8_t scd4x_set_automatic_self_calibration(scd4x_handle_t *handle, scd4x_bool_
  * @note       none
  */
 uint8_t scd4x_get_automatic_self_calibration(scd4x_handle_t *handle, scd4x_bool_t *enable);
+#endif
 
 /**
  * @brief     start low power periodic measurement
@@ -540,6 +901,78 @@ uint8_t scd4x_start_low_power_periodic_measurement(scd4x_handle_t *handle);
  */
 uint8_t scd4x_get_data_ready_status(scd4x_handle_t *handle, scd4x_bool_t *enable);
 
+/**
+ * @brief     wait until the data is ready
+ * @param[in] *handle pointer to an scd4x handle structure
+ * @param[in] timeout max polling time in ms
+ * @return    status code
+ *            - 0 success
+ *            - 1 get data ready status failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 crc is error
+ *            - 5 timeout
+ * @note      the first probe is sent when the pending command execution time has elapsed,
+ *            then the polling interval doubles up to the max interval,
+ *            the elapsed time is never less than the slept intervals even if the time source stops
+ */
+uint8_t scd4x_wait_data_ready(scd4x_handle_t *handle, uint32_t timeout);
+
+/**
+ * @brief     set the data ready polling max interval
+ * @param[in] *handle pointer to an scd4x handle structure
+ * @param[in] ms max interval in ms
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 ms is invalid
+ * @note      10 <= ms <= 60000
+ */
+uint8_t scd4x_set_data_ready_max_interval(scd4x_handle_t *handle, uint32_t ms);
+
+/**
+ * @brief      get the data ready polling max interval
+ * @param[in]  *handle pointer to an scd4x handle structure
+ * @param[out] *ms pointer to a max interval buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       none
+ */
+uint8_t scd4x_get_data_ready_max_interval(scd4x_handle_t *handle, uint32_t *ms);
+
+/**
+ * @brief      get the pending command execution time
+ * @param[in]  *handle pointer to an scd4x handle structure
+ * @param[out] *us pointer to a rest time buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       the next bus access of this handle waits the rest time,
+ *             the whole execution time is returned if get_time_us is not linked
+ */
+uint8_t scd4x_get_pending_time(scd4x_handle_t *handle, uint32_t *us);
+
+#if (SCD4X_CONFIG_LOG_BINARY != 0)
+/**
+ * @brief         read and remove the oldest log events
+ * @param[in]     *handle pointer to an scd4x handle structure
+ * @param[out]    *event pointer to a log event buffer
+ * @param[in,out] *len pointer to a buffer length buffer
+ * @param[out]    *lost pointer to an overwritten event number buffer
+ * @return        status code
+ *                - 0 success
+ *                - 2 handle is NULL
+ * @note          the log is kept across scd4x_init, so link failures can be read,
+ *                the lost counter is cleared after reading
+ */
+uint8_t scd4x_read_log(scd4x_handle_t *handle, scd4x_log_event_t *event, uint16_t *len, uint16_t *lost);
+#endif
+
+#if (SCD4X_CONFIG_PERSIST != 0)
 /**
  * @brief     persist settings
  * @param[in] *handle pointer to an scd4x handle structure
@@ -548,9 +981,10 @@ uint8_t scd4x_get_data_ready_status(scd4x_handle_t *handle, scd4x_bool_t *enable
  *            - 1 persist settings failed
  *            - 2 handle is NULL
  *            - 3 handle is not initialized
- * @note      none
+ * @note      the next bus access waits 800ms
  */
 uint8_t scd4x_persist_settings(scd4x_handle_t *handle);
+#endif
 
 /**
  * @brief      get serial number
@@ -566,6 +1000,22 @@ uint8_t scd4x_persist_settings(scd4x_handle_t *handle);
  */
 uint8_t scd4x_get_serial_number(scd4x_handle_t *handle, uint16_t number[3]);
 
+/**
+ * @brief      get sensor variant
+ * @param[in]  *handle pointer to an scd4x handle structure
+ * @param[out] *type pointer to a chip type buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 get sensor variant failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ *             - 4 crc is error
+ *             - 5 variant is unknown
+ * @note       the chip type of the handle is not changed
+ */
+uint8_t scd4x_get_sensor_variant(scd4x_handle_t *handle, scd4x_t *type);
+
+#if (SCD4X_CONFIG_SELF_TEST != 0)
 /**
  * @brief      perform self test
  * @param[in]  *handle pointer to an scd4x handle structure
@@ -580,6 +1030,34 @@ uint8_t scd4x_get_serial_number(scd4x_handle_t *handle, uint16_t number[3]);
  */
 uint8_t scd4x_perform_self_test(scd4x_handle_t *handle, scd4x_bool_t *malfunction_detected);
 
+/**
+ * @brief     start self test
+ * @param[in] *handle pointer to an scd4x handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 start self test failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      read the result with scd4x_get_self_test_result after 10000ms
+ */
+uint8_t scd4x_start_self_test(scd4x_handle_t *handle);
+
+/**
+ * @brief      get self test result
+ * @param[in]  *handle pointer to an scd4x handle structure
+ * @param[out] *malfunction_detected pointer to a bool value buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 get self test result failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ *             - 4 crc is error
+ * @note       it waits the rest of the 10000ms self test time
+ */
+uint8_t scd4x_get_self_test_result(scd4x_handle_t *handle, scd4x_bool_t *malfunction_detected);
+#endif
+
+#if (SCD4X_CONFIG_FACTORY_RESET != 0)
 /**
  * @brief     perform factory reset
  * @param[in] *handle pointer to an scd4x handle structure
@@ -588,9 +1066,10 @@ uint8_t scd4x_perform_self_test(scd4x_handle_t *handle, scd4x_bool_t *malfunctio
  *            - 1 perform factory reset failed
  *            - 2 handle is NULL
  *            - 3 handle is not initialized
- * @note      none
+ * @note      the next bus access waits 1200ms
  */
 uint8_t scd4x_perform_factory_reset(scd4x_handle_t *handle);
+#endif
 
 /**
  * @brief     reinit
@@ -600,7 +1079,7 @@ uint8_t scd4x_perform_factory_reset(scd4x_handle_t *handle);
  *            - 1 reinit failed
  *            - 2 handle is NULL
  *            - 3 handle is not initialized
- * @note      none
+ * @note      the next bus access waits 30ms
  */
 uint8_t scd4x_reinit(scd4x_handle_t *handle);
 
@@ -615,6 +1094,7 @@ uint8_t scd4x_reinit(scd4x_handle_t *handle);
  * @{
  */
 
+#if (SCD4X_CONFIG_SINGLE_SHOT != 0)
 /**
  * @brief     measure single shot
  * @param[in] *handle pointer to an scd4x handle structure
@@ -624,7 +1104,7 @@ uint8_t scd4x_reinit(scd4x_handle_t *handle);
  *            - 2 handle is NULL
  *            - 3 handle is not initialized
  *            - 4 only scd41 and scd43 has this function
- * @note      none
+ * @note      the next bus access waits until the 5000ms measurement has finished
  */
 uint8_t scd4x_measure_single_shot(scd4x_handle_t *handle);
 
@@ -637,7 +1117,7 @@ uint8_t scd4x_measure_single_shot(scd4x_handle_t *handle);
  *            - 2 handle is NULL
  *            - 3 handle is not initialized
  *            - 4 only scd41 and scd43 has this function
- * @note      none
+ * @note      the next bus access waits until the 50ms measurement has finished
  */
 uint8_t scd4x_measure_single_shot_rht_only(scd4x_handle_t *handle);
 
@@ -663,10 +1143,101 @@ uint8_t scd4x_power_down(scd4x_handle_t *handle);
  *            - 2 handle is NULL
  *            - 3 handle is not initialized
  *            - 4 only scd41 and scd43 has this function
- * @note      none
+ * @note      the next bus access waits 30ms
  */
 uint8_t scd4x_wake_up(scd4x_handle_t *handle);
 
+/**
+ * @brief     enable or disable the sleepy shot mode
+ * @param[in] *handle pointer to an scd4x handle structure
+ * @param[in] enable bool value
+ * @param[in] first_shot use the first shot after a wake up
+ * @return    status code
+ *            - 0 success
+ *            - 1 power down or wake up failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 only scd41 and scd43 has this function
+ * @note      enabling powers the chip down, disabling wakes it up, the chip must be idle,
+ *            the other commands need the mode disabled, scd4x_deinit disables it
+ */
+uint8_t scd4x_set_sleepy_shot(scd4x_handle_t *handle, scd4x_bool_t enable, scd4x_bool_t first_shot);
+
+/**
+ * @brief      wake up, measure single shot, read and power down
+ * @param[in]  *handle pointer to an scd4x handle structure
+ * @param[out] *sample pointer to an scd4x sample structure
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ *             - 4 crc is error
+ *             - 5 data is not ready
+ *             - 6 sleepy shot mode is disabled
+ * @note       the first shot after the wake up is read and dropped as the datasheet requires
+ *             unless first_shot is set, so one reading takes 10 s or 5 s,
+ *             a late data ready is polled with the backoff for up to 1000 ms after each shot,
+ *             the chip is powered down even if a step failed
+ */
+uint8_t scd4x_read_sleepy_shot(scd4x_handle_t *handle, scd4x_sample_t *sample);
+
+/**
+ * @brief      get the estimated charge of one sleepy shot reading
+ * @param[in]  *handle pointer to an scd4x handle structure
+ * @param[in]  *model pointer to an energy model structure
+ * @param[out] *uc pointer to a charge buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle or model is NULL
+ * @note       the wake up, the shots and the reads are charged from the command execution times,
+ *             add sleep_na for the time between the readings
+ */
+uint8_t scd4x_get_sleepy_shot_charge(scd4x_handle_t *handle, const scd4x_energy_model_t *model, float *uc);
+
+/**
+ * @brief      init a hybrid schedule of rht only shots and full shots
+ * @param[in]  *handle pointer to an scd4x handle structure
+ * @param[out] *hybrid pointer to a hybrid schedule structure
+ * @param[in]  rht_interval_ms temperature and humidity interval
+ * @param[in]  co2_interval_ms co2 interval
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ *             - 4 only scd41 and scd43 has this function
+ *             - 5 interval is invalid
+ *             - 6 get_time_us is not linked
+ * @note       the co2 interval is rounded to a multiple of the rht interval, the chip must be idle,
+ *             the first shot is a full shot
+ */
+uint8_t scd4x_hybrid_init(scd4x_handle_t *handle, scd4x_hybrid_t *hybrid, uint32_t rht_interval_ms, uint32_t co2_interval_ms);
+
+/**
+ * @brief      run the hybrid schedule without blocking
+ * @param[in]  *handle pointer to an scd4x handle structure
+ * @param[in]  *hybrid pointer to a hybrid schedule structure
+ * @param[out] *sample pointer to an scd4x sample structure
+ * @param[out] *stream pointer to a stream mask buffer
+ * @param[out] *wait_us pointer to a rest time buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 measure or read failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ *             - 4 crc is error
+ *             - 5 data is not ready 1000 ms after the shot execution time
+ *             - 6 no sample yet, call again after wait_us
+ * @note       each shot is a rht only shot of 50ms, every co2_ratio-th one is a full shot of 5000ms
+ *             whose sample belongs to both streams, the shots missed during a full shot are merged into one after it,
+ *             the co2 of a rht only sample is not valid, a late data ready keeps the shot in flight
+ *             and is polled with the backoff
+ */
+uint8_t scd4x_hybrid_poll(scd4x_handle_t *handle, scd4x_hybrid_t *hybrid, scd4x_sample_t *sample,
+                          uint8_t *stream, uint32_t *wait_us);
+#endif
+
+#if (SCD4X_CONFIG_ASC != 0)
 /**
  * @brief     set automatic self calibration initial period
  * @param[in] *handle pointer to an scd4x handle structure
@@ -726,10 +1297,102 @@ uint8_t scd4x_set_automatic_self_calibration_standard_period(scd4x_handle_t *han
  * @note       none
  */
 uint8_t scd4x_get_automatic_self_calibration_standard_period(scd4x_handle_t *handle, uint16_t *hour);
+#endif
+
+/**
+ * @}
+ */
+
+#if ((SCD4X_CONFIG_SINGLE_SHOT != 0) || (SCD4X_CONFIG_ACCOUNTING != 0))
+/**
+ * @defgroup scd4x_energy_driver scd4x energy driver function
+ * @brief    scd4x energy driver modules
+ * @ingroup  scd4x_driver
+ * @{
+ */
+
+/**
+ * @brief      get the default energy model
+ * @param[out] *model pointer to an energy model structure
+ * @return     status code
+ *             - 0 success
+ *             - 2 model is NULL
+ * @note       typical currents of a scd41 at 3.3 v, a board should measure and set its own
+ */
+uint8_t scd4x_energy_default_model(scd4x_energy_model_t *model);
+
+/**
+ * @}
+ */
+#endif
+
+#if (SCD4X_CONFIG_ACCOUNTING != 0)
+/**
+ * @defgroup scd4x_account_driver scd4x account driver function
+ * @brief    scd4x account driver modules
+ * @ingroup  scd4x_driver
+ * @{
+ */
+
+/**
+ * @brief     start the energy accounting
+ * @param[in] *handle pointer to an scd4x handle structure
+ * @param[in] *model pointer to an energy model structure
+ * @param[in] state current chip state
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle or model is NULL
+ *            - 3 handle is not initialized
+ *            - 4 state is invalid
+ *            - 5 get_time_us is not linked
+ * @note      the counters are cleared, every command sent after this call moves the accounted state,
+ *            the single shots, the wake up and the self test return to idle after their execution time
+ */
+uint8_t scd4x_account_start(scd4x_handle_t *handle, const scd4x_energy_model_t *model, scd4x_account_state_t state);
+
+/**
+ * @brief     stop the energy accounting
+ * @param[in] *handle pointer to an scd4x handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      the counters are kept and can still be read
+ */
+uint8_t scd4x_account_stop(scd4x_handle_t *handle);
+
+/**
+ * @brief     set the accounted chip state
+ * @param[in] *handle pointer to an scd4x handle structure
+ * @param[in] state chip state
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 state is invalid
+ *            - 5 accounting is not started
+ * @note      for the state changes without a command, e.g. a power cycle of the chip
+ */
+uint8_t scd4x_account_set_state(scd4x_handle_t *handle, scd4x_account_state_t state);
+
+/**
+ * @brief      get the energy accounting stats
+ * @param[in]  *handle pointer to an scd4x handle structure
+ * @param[out] *stats pointer to an account stats structure
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle or stats is NULL
+ *             - 3 handle is not initialized
+ *             - 4 accounting is not started
+ * @note       the time is counted up to now if the accounting is running, the commands without
+ *             their own state, e.g. the forced recalibration, are charged at the current of the state they run in
+ */
+uint8_t scd4x_get_account_stats(scd4x_handle_t *handle, scd4x_account_stats_t *stats);
 
 /**
  * @}
  */
+#endif
 
 /**
  * @defgroup scd4x_extern_driver scd4x extern driver function
@@ -738,6 +1401,7 @@ uint8_t scd4x_get_automatic_self_calibration_standard_period(scd4x_handle_t *han
  * @{
  */
 
+#if (SCD4X_CONFIG_REG != 0)
 /**
  * @brief     set the chip register
  * @param[in] *handle pointer to an scd4x handle structure
@@ -768,6 +1432,18 @@ uint8_t scd4x_set_reg(scd4x_handle_t *handle, uint16_t reg, uint8_t *buf, uint16
  * @note       none
  */
 uint8_t scd4x_get_reg(scd4x_handle_t *handle, uint16_t reg, uint8_t *buf, uint16_t len, uint16_t delay_ms);
+#endif
+
+#ifdef SCD4X_BENCH
+/**
+ * @brief     generate the crc
+ * @param[in] *data pointer to a data buffer
+ * @param[in] count data length
+ * @return    crc
+ * @note      only the benchmark builds with SCD4X_BENCH have this function
+ */
+uint8_t scd4x_bench_generate_crc(uint8_t *data, uint8_t count);
+#endif
 
 /**
  * @}
@@ -0,0 +1,406 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_scd4x_adaptive.c
+ * @brief     driver scd4x adaptive source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "driver_scd4x_adaptive.h"
+
+#if (SCD4X_CONFIG_ADAPTIVE != 0)
+/**
+ * @brief adaptive state definition
+ */
+#define SCD4X_ADAPTIVE_START        0             /**< the mode starts at next_us */
+#define SCD4X_ADAPTIVE_RUN          1             /**< periodic measurement, the sample is read at next_us */
+#define SCD4X_ADAPTIVE_STOP         2             /**< periodic measurement is stopped at next_us */
+#define SCD4X_ADAPTIVE_SHOT_WAIT    3             /**< the shot starts at next_us */
+#define SCD4X_ADAPTIVE_SHOT         4             /**< shot in flight */
+#define SCD4X_ADAPTIVE_RETRY_US     100000        /**< data ready retry time */
+
+/**
+ * @brief adaptive timing definition
+ */
+#define SCD4X_ADAPTIVE_PERIODIC_MS          5000            /**< periodic measurement sample interval */
+#define SCD4X_ADAPTIVE_LOW_POWER_MS         30000           /**< low power periodic measurement sample interval */
+#define SCD4X_ADAPTIVE_SHOT_MS              5000            /**< single shot time */
+#define SCD4X_ADAPTIVE_SHOT_READY_US        1000000ULL      /**< data ready timeout after the single shot time */
+
+/**
+ * @brief default adaptive parameters
+ */
+static const scd4x_adaptive_param_t gs_scd4x_adaptive_param =
+{
+    0,              /* low power periodic measurement in the slow mode */
+    60000,          /* 1 min smoothing */
+    120000,         /* 2 min rate window */
+    300000,         /* 5 min stable before the slow mode */
+    10.0f,          /* 10 ppm/min starts the fast mode */
+    5.0f,           /* 5 ppm/min is stable */
+    40.0f,          /* 40 ppm standard deviation starts the fast mode */
+    20.0f,          /* 20 ppm standard deviation is stable */
+};
+
+/**
+ * @brief         update the statistics with a sample and pick the mode
+ * @param[in,out] *adaptive pointer to an adaptive structure
+ * @param[in]     co2 co2 ppm
+ * @param[in]     now_us sample time
+ * @return        mode of the next samples
+ * @note          the rate is the change of the smoothed co2 over the last window
+ */
+static uint8_t a_scd4x_adaptive_update(scd4x_adaptive_t *adaptive, uint16_t co2, uint64_t now_us)
+{
+    const scd4x_adaptive_param_t *param = &adaptive->param;
+    float dt;
+    float alpha;
+    float diff;
+    float rate;
+    
+    if (adaptive->primed == 0)                                                                         /* first sample */
+    {
+        adaptive->primed = 1;                                                                          /* set primed */
+        adaptive->mean = (float)co2;                                                                   /* init mean */
+        adaptive->var = 0.0f;                                                                          /* init variance */
+        adaptive->rate = 0.0f;                                                                         /* init rate */
+        adaptive->ref_mean = (float)co2;                                                               /* window start */
+        adaptive->ref_us = now_us;                                                                     /* window start time */
+        adaptive->last_us = now_us;                                                                    /* sample time */
+        
+        return adaptive->mode;                                                                         /* keep the mode */
+    }
+    
+    dt = (float)(now_us - adaptive->last_us);                                                          /* sample interval */
+    alpha = dt / (dt + (float)param->tau_ms * 1000.0f);                                                /* smoothing factor */
+    diff = (float)co2 - adaptive->mean;                                                                /* deviation */
+    adaptive->mean += alpha * diff;                                                                    /* smooth the co2 */
+    adaptive->var = (1.0f - alpha) * (adaptive->var + alpha * diff * diff);                            /* smooth the variance */
+    adaptive->last_us = now_us;                                                                        /* save the time */
+    if (now_us - adaptive->ref_us >= (uint64_t)param->window_ms * 1000)                                /* check the window */
+    {
+        adaptive->rate = (adaptive->mean - adaptive->ref_mean) * 60000000.0f / 
+                         (float)(now_us - adaptive->ref_us);                                           /* ppm/min */
+        adaptive->ref_mean = adaptive->mean;                                                           /* next window */
+        adaptive->ref_us = now_us;                                                                     /* next window time */
+    }
+    rate = (adaptive->rate < 0.0f) ? -adaptive->rate : adaptive->rate;                                 /* absolute rate */
+    
+    if (adaptive->mode == SCD4X_ADAPTIVE_SLOW)                                                         /* slow mode */
+    {
+        if ((rate >= param->fast_rate) || (adaptive->var >= param->fast_std * param->fast_std))        /* check the fast thresholds */
+        {
+            return SCD4X_ADAPTIVE_FAST;                                                                /* go fast */
+        }
+        
+        return SCD4X_ADAPTIVE_SLOW;                                                                    /* keep slow */
+    }
+    if ((rate < param->slow_rate) && (adaptive->var < param->slow_std * param->slow_std))              /* check the slow thresholds */
+    {
+        if (adaptive->stable == 0)                                                                     /* check stable */
+        {
+            adaptive->stable = 1;                                                                      /* set stable */
+            adaptive->stable_us = now_us;                                                              /* stable since now */
+        }
+        if (now_us - adaptive->stable_us >= (uint64_t)param->hold_ms * 1000)                           /* check the hold time */
+        {
+            return SCD4X_ADAPTIVE_SLOW;                                                                /* go slow */
+        }
+    }
+    else
+    {
+        adaptive->stable = 0;                                                                          /* not stable */
+    }
+    
+    return SCD4X_ADAPTIVE_FAST;                                                                        /* keep fast */
+}
+
+#if (SCD4X_CONFIG_SINGLE_SHOT != 0)
+/**
+ * @brief      start the next sparse single shot
+ * @param[in]  *handle pointer to an scd4x handle structure
+ * @param[in]  *adaptive pointer to an adaptive structure
+ * @param[in]  now_us current time
+ * @param[out] *wait_us pointer to a rest time buffer
+ * @return     status code
+ *             - 1 measure single shot failed
+ *             - 6 shot is in flight
+ * @note       the missed shots are skipped
+ */
+static uint8_t a_scd4x_adaptive_shot(scd4x_handle_t *handle, scd4x_adaptive_t *adaptive, uint64_t now_us, uint32_t *wait_us)
+{
+    uint64_t interval_us;
+    
+    interval_us = (uint64_t)adaptive->param.shot_interval_ms * 1000;                                         /* shot interval */
+    adaptive->next_us += interval_us * ((now_us - adaptive->next_us) / interval_us + 1);                     /* next shot time */
+    if (scd4x_measure_single_shot(handle) != 0)                                                              /* start the shot */
+    {
+        return 1;                                                                                            /* return error */
+    }
+    adaptive->state = SCD4X_ADAPTIVE_SHOT;                                                                   /* shot in flight */
+    (void)scd4x_get_pending_time(handle, wait_us);                                                           /* wait the shot */
+    adaptive->timeout_us = now_us + *wait_us + SCD4X_ADAPTIVE_SHOT_READY_US;                                 /* set the data ready timeout */
+    
+    return 6;                                                                                                /* return busy */
+}
+#endif
+
+/**
+ * @brief      get the default adaptive parameters
+ * @param[out] *param pointer to an adaptive parameter structure
+ * @return     status code
+ *             - 0 success
+ *             - 2 param is NULL
+ * @note       the slow mode is the low power periodic measurement, the fast mode is held
+ *             for 5 min of stable signal, 600 times the stop periodic measurement time
+ */
+uint8_t scd4x_adaptive_default_param(scd4x_adaptive_param_t *param)
+{
+    if (param == NULL)                          /* check param */
+    {
+        return 2;                               /* return error */
+    }
+    
+    *param = gs_scd4x_adaptive_param;           /* copy the parameters */
+    
+    return 0;                                   /* success return 0 */
+}
+
+/**
+ * @brief      init the adaptive sampling controller
+ * @param[in]  *handle pointer to an scd4x handle structure
+ * @param[out] *adaptive pointer to an adaptive structure
+ * @param[in]  *param pointer to an adaptive parameter structure
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle, adaptive or param is NULL
+ *             - 3 handle is not initialized
+ *             - 4 only scd41 and scd43 has the sparse single shots
+ *             - 5 param is invalid
+ *             - 6 get_time_us is not linked
+ * @note       the chip must be idle and no scd4x_poll_sample may be in flight, the controller starts
+ *             in the slow mode
+ */
+uint8_t scd4x_adaptive_init(scd4x_handle_t *handle, scd4x_adaptive_t *adaptive, const scd4x_adaptive_param_t *param)
+{
+    if (handle == NULL)                                                                                      /* check handle */
+    {
+        return 2;                                                                                            /* return error */
+    }
+    if (handle->inited != 1)                                                                                 /* check handle initialization */
+    {
+        return 3;                                                                                            /* return error */
+    }
+    if ((adaptive == NULL) || (param == NULL))                                                               /* check adaptive and param */
+    {
+        return 2;                                                                                            /* return error */
+    }
+    if (param->shot_interval_ms != 0)                                                                        /* check sparse single shots */
+    {
+#if (SCD4X_CONFIG_SINGLE_SHOT != 0)
+        if (handle->type == SCD40)                                                                           /* check type */
+        {
+            return 4;                                                                                        /* return error */
+        }
+        if (param->shot_interval_ms < SCD4X_ADAPTIVE_SHOT_MS)                                                /* check shot interval */
+        {
+            return 5;                                                                                        /* return error */
+        }
+#else
+        return 4;                                                                                            /* return error */
+#endif
+    }
+    if ((param->tau_ms == 0) || (param->window_ms == 0) || 
+        (param->slow_rate > param->fast_rate) || (param->slow_std > param->fast_std))                        /* check param */
+    {
+        return 5;                                                                                            /* return error */
+    }
+    if (handle->get_time_us == NULL)                                                                         /* check time source */
+    {
+        return 6;                                                                                            /* return error */
+    }
+    
+    memset(adaptive, 0, sizeof(scd4x_adaptive_t));                                                           /* clear the controller */
+    adaptive->param = *param;                                                                                /* set the parameters */
+    adaptive->mode = SCD4X_ADAPTIVE_SLOW;                                                                    /* start slow */
+    adaptive->state = SCD4X_ADAPTIVE_START;                                                                  /* start the mode */
+    adaptive->next_us = handle->get_time_us();                                                               /* start now */
+    
+    return 0;                                                                                                /* success return 0 */
+}
+
+/**
+ * @brief      run the adaptive sampling controller without blocking
+ * @param[in]  *handle pointer to an scd4x handle structure
+ * @param[in]  *adaptive pointer to an adaptive structure
+ * @param[out] *sample pointer to an scd4x sample structure
+ * @param[out] *wait_us pointer to a rest time buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 command or read failed
+ *             - 2 handle, adaptive, sample or wait_us is NULL
+ *             - 3 handle is not initialized
+ *             - 4 crc is error
+ *             - 5 data is not ready 1000 ms after the single shot execution time
+ *             - 6 no sample yet, call again after wait_us
+ * @note       the fast mode starts when the change rate or the standard deviation reaches its fast threshold
+ *             and ends when both stay below the slow thresholds for hold_ms, a switch stops the periodic
+ *             measurement after the sample and the next mode starts 500 ms later, a late sample or single
+ *             shot is polled again every 100 ms, stop the measurement with scd4x_stop_periodic_measurement
+ */
+uint8_t scd4x_adaptive_poll(scd4x_handle_t *handle, scd4x_adaptive_t *adaptive, scd4x_sample_t *sample, uint32_t *wait_us)
+{
+    uint8_t res;
+    uint8_t mode;
+    uint64_t now_us;
+    uint64_t period_us;
+    
+    if (handle == NULL)                                                                                      /* check handle */
+    {
+        return 2;                                                                                            /* return error */
+    }
+    if (handle->inited != 1)                                                                                 /* check handle initialization */
+    {
+        return 3;                                                                                            /* return error */
+    }
+    if ((adaptive == NULL) || (sample == NULL) || (wait_us == NULL))                                         /* check adaptive, sample and wait_us */
+    {
+        return 2;                                                                                            /* return error */
+    }
+    
+    *wait_us = 0;                                                                                            /* init 0 */
+    now_us = handle->get_time_us();                                                                          /* get time */
+    if ((adaptive->state != SCD4X_ADAPTIVE_SHOT) && (now_us < adaptive->next_us))                            /* check the next poll time */
+    {
+        *wait_us = (uint32_t)(adaptive->next_us - now_us);                                                   /* set the rest time */
+        
+        return 6;                                                                                            /* return busy */
+    }
+    if (adaptive->state == SCD4X_ADAPTIVE_STOP)                                                              /* stop the periodic measurement */
+    {
+        if (scd4x_stop_periodic_measurement(handle) != 0)                                                    /* stop periodic measurement */
+        {
+            return 1;                                                                                        /* return error */
+        }
+        adaptive->state = SCD4X_ADAPTIVE_START;                                                              /* start the next mode */
+        (void)scd4x_get_pending_time(handle, wait_us);                                                       /* wait the stop */
+        
+        return 6;                                                                                            /* return busy */
+    }
+    if (adaptive->state == SCD4X_ADAPTIVE_START)                                                             /* start the mode */
+    {
+        (void)scd4x_get_pending_time(handle, wait_us);                                                       /* get the rest time */
+        if (*wait_us != 0)                                                                                   /* check the stop in flight */
+        {
+            return 6;                                                                                        /* return busy */
+        }
+        adaptive->mode_us = now_us;                                                                          /* mode start time */
+#if (SCD4X_CONFIG_SINGLE_SHOT != 0)
+        if ((adaptive->mode == SCD4X_ADAPTIVE_SLOW) && (adaptive->param.shot_interval_ms != 0))              /* sparse single shots */
+        {
+            adaptive->next_us = now_us;                                                                      /* first shot now */
+            
+            return a_scd4x_adaptive_shot(handle, adaptive, now_us, wait_us);                                 /* start the shot */
+        }
+#endif
+        res = (adaptive->mode == SCD4X_ADAPTIVE_FAST) ? scd4x_start_periodic_measurement(handle) : 
+              scd4x_start_low_power_periodic_measurement(handle);                                            /* start the measurement */
+        if (res != 0)                                                                                        /* check result */
+        {
+            return 1;                                                                                        /* return error */
+        }
+        period_us = (uint64_t)((adaptive->mode == SCD4X_ADAPTIVE_FAST) ? SCD4X_ADAPTIVE_PERIODIC_MS : 
+                               SCD4X_ADAPTIVE_LOW_POWER_MS) * 1000;                                          /* sample interval */
+        adaptive->state = SCD4X_ADAPTIVE_RUN;                                                                /* measurement runs */
+        adaptive->next_us = now_us + period_us;                                                              /* first sample */
+        *wait_us = (uint32_t)period_us;                                                                      /* wait the first sample */
+        
+        return 6;                                                                                            /* return busy */
+    }
+#if (SCD4X_CONFIG_SINGLE_SHOT != 0)
+    if (adaptive->state == SCD4X_ADAPTIVE_SHOT_WAIT)                                                         /* next shot is due */
+    {
+        return a_scd4x_adaptive_shot(handle, adaptive, now_us, wait_us);                                     /* start the shot */
+    }
+#endif
+    
+    res = scd4x_poll_sample(handle, sample, wait_us);                                                        /* read the sample */
+    if (res == 6)                                                                                            /* check busy */
+    {
+        return 6;                                                                                            /* return busy */
+    }
+    if (adaptive->state == SCD4X_ADAPTIVE_RUN)                                                               /* periodic measurement */
+    {
+        if (res == 5)                                                                                        /* check data ready */
+        {
+            adaptive->next_us = now_us + SCD4X_ADAPTIVE_RETRY_US;                                            /* try again */
+            *wait_us = SCD4X_ADAPTIVE_RETRY_US;                                                              /* set the rest time */
+            
+            return 6;                                                                                        /* return busy */
+        }
+        period_us = (uint64_t)((adaptive->mode == SCD4X_ADAPTIVE_FAST) ? SCD4X_ADAPTIVE_PERIODIC_MS : 
+                               SCD4X_ADAPTIVE_LOW_POWER_MS) * 1000;                                          /* sample interval */
+        adaptive->next_us = adaptive->mode_us + ((now_us - adaptive->mode_us) / period_us + 1) * period_us;  /* next sample */
+    }
+    else
+    {
+#if (SCD4X_CONFIG_SINGLE_SHOT != 0)
+        if (res == 5)                                                                                        /* check data ready */
+        {
+            if (now_us < adaptive->timeout_us)                                                               /* check timeout */
+            {
+                *wait_us = SCD4X_ADAPTIVE_RETRY_US;                                                          /* set the rest time */
+                
+                return 6;                                                                                    /* keep the shot in flight */
+            }
+        }
+#endif
+        adaptive->state = SCD4X_ADAPTIVE_SHOT_WAIT;                                                          /* wait the next shot */
+    }
+    if (res != 0)                                                                                            /* check result */
+    {
+        return res;                                                                                          /* return error */
+    }
+    
+    mode = a_scd4x_adaptive_update(adaptive, sample->co2_ppm, now_us);                                       /* update the statistics */
+    if (mode != adaptive->mode)                                                                              /* check the mode */
+    {
+        adaptive->state = (adaptive->state == SCD4X_ADAPTIVE_RUN) ? SCD4X_ADAPTIVE_STOP : 
+                          SCD4X_ADAPTIVE_START;                                                              /* stop or start */
+        adaptive->mode = mode;                                                                               /* set the mode */
+        adaptive->stable = 0;                                                                                /* clear stable */
+        adaptive->switches++;                                                                                /* count the switch */
+        adaptive->next_us = now_us;                                                                          /* switch now */
+    }
+    
+    return 0;                                                                                                /* success return 0 */
+}
+#endif
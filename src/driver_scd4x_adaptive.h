@@ -0,0 +1,159 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_scd4x_adaptive.h
+ * @brief     driver scd4x adaptive header file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#ifndef DRIVER_SCD4X_ADAPTIVE_H
+#define DRIVER_SCD4X_ADAPTIVE_H
+
+#include "driver_scd4x.h"
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+#if (SCD4X_CONFIG_ADAPTIVE != 0)
+/**
+ * @defgroup scd4x_adaptive_driver scd4x adaptive driver function
+ * @brief    scd4x adaptive driver modules
+ * @ingroup  scd4x_driver
+ * @{
+ */
+
+/**
+ * @brief scd4x adaptive mode enumeration definition
+ */
+typedef enum
+{
+    SCD4X_ADAPTIVE_SLOW = 0x00,        /**< low power periodic measurement or sparse single shots */
+    SCD4X_ADAPTIVE_FAST = 0x01,        /**< periodic measurement */
+} scd4x_adaptive_mode_t;
+
+/**
+ * @brief scd4x adaptive parameter structure definition
+ */
+typedef struct scd4x_adaptive_param_s
+{
+    uint32_t shot_interval_ms;        /**< slow mode shot interval, 0 means low power periodic measurement */
+    uint32_t tau_ms;                  /**< time constant of the smoothed co2 and variance */
+    uint32_t window_ms;               /**< change rate window */
+    uint32_t hold_ms;                 /**< stable time before the fast mode is left */
+    float fast_rate;                  /**< change rate in ppm/min which starts the fast mode */
+    float slow_rate;                  /**< change rate in ppm/min below which the signal is stable */
+    float fast_std;                   /**< standard deviation in ppm which starts the fast mode */
+    float slow_std;                   /**< standard deviation in ppm below which the signal is stable */
+} scd4x_adaptive_param_t;
+
+/**
+ * @brief scd4x adaptive structure definition
+ */
+typedef struct scd4x_adaptive_s
+{
+    scd4x_adaptive_param_t param;        /**< parameters */
+    uint8_t mode;                        /**< measurement mode */
+    uint8_t state;                       /**< schedule state */
+    uint8_t primed;                      /**< 1 if the statistics have a sample */
+    uint8_t stable;                      /**< 1 if the signal is stable */
+    float mean;                          /**< smoothed co2 */
+    float var;                           /**< smoothed co2 variance */
+    float rate;                          /**< co2 change rate in ppm/min */
+    float ref_mean;                      /**< smoothed co2 at the window start */
+    uint64_t ref_us;                     /**< window start time */
+    uint64_t last_us;                    /**< last sample time */
+    uint64_t stable_us;                  /**< stable since this time */
+    uint64_t mode_us;                    /**< mode start time */
+    uint64_t next_us;                    /**< next poll time */
+    uint64_t timeout_us;                 /**< data ready timeout of the shot in flight */
+    uint32_t switches;                   /**< mode switch number */
+} scd4x_adaptive_t;
+
+/**
+ * @brief      get the default adaptive parameters
+ * @param[out] *param pointer to an adaptive parameter structure
+ * @return     status code
+ *             - 0 success
+ *             - 2 param is NULL
+ * @note       the slow mode is the low power periodic measurement, the fast mode is held
+ *             for 5 min of stable signal, 600 times the stop periodic measurement time
+ */
+uint8_t scd4x_adaptive_default_param(scd4x_adaptive_param_t *param);
+
+/**
+ * @brief      init the adaptive sampling controller
+ * @param[in]  *handle pointer to an scd4x handle structure
+ * @param[out] *adaptive pointer to an adaptive structure
+ * @param[in]  *param pointer to an adaptive parameter structure
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle, adaptive or param is NULL
+ *             - 3 handle is not initialized
+ *             - 4 only scd41 and scd43 has the sparse single shots
+ *             - 5 param is invalid
+ *             - 6 get_time_us is not linked
+ * @note       the chip must be idle and no scd4x_poll_sample may be in flight, the controller starts
+ *             in the slow mode
+ */
+uint8_t scd4x_adaptive_init(scd4x_handle_t *handle, scd4x_adaptive_t *adaptive, const scd4x_adaptive_param_t *param);
+
+/**
+ * @brief      run the adaptive sampling controller without blocking
+ * @param[in]  *handle pointer to an scd4x handle structure
+ * @param[in]  *adaptive pointer to an adaptive structure
+ * @param[out] *sample pointer to an scd4x sample structure
+ * @param[out] *wait_us pointer to a rest time buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 command or read failed
+ *             - 2 handle, adaptive, sample or wait_us is NULL
+ *             - 3 handle is not initialized
+ *             - 4 crc is error
+ *             - 5 data is not ready 1000 ms after the single shot execution time
+ *             - 6 no sample yet, call again after wait_us
+ * @note       the fast mode starts when the change rate or the standard deviation reaches its fast threshold
+ *             and ends when both stay below the slow thresholds for hold_ms, a switch stops the periodic
+ *             measurement after the sample and the next mode starts 500 ms later, a late sample or single
+ *             shot is polled again every 100 ms, stop the measurement with scd4x_stop_periodic_measurement
+ */
+uint8_t scd4x_adaptive_poll(scd4x_handle_t *handle, scd4x_adaptive_t *adaptive, scd4x_sample_t *sample, uint32_t *wait_us);
+
+/**
+ * @}
+ */
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,236 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_scd4x_energy.c
+ * @brief     driver scd4x energy source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "driver_scd4x_energy.h"
+
+/**
+ * @brief plan timing definition
+ * @note  the execution times of the driver commands
+ */
+#define SCD4X_ENERGY_PERIODIC_MS          5000         /**< periodic measurement sample interval */
+#define SCD4X_ENERGY_LOW_POWER_MS         30000        /**< low power periodic measurement sample interval */
+#define SCD4X_ENERGY_READ_MS              1            /**< read measurement time */
+#define SCD4X_ENERGY_SHOT_MS              5000         /**< single shot time */
+#define SCD4X_ENERGY_RHT_ONLY_MS          50           /**< rht only single shot time */
+#define SCD4X_ENERGY_WAKE_UP_MS           30           /**< wake up time */
+#define SCD4X_ENERGY_POWER_DOWN_MS        1            /**< power down time */
+
+/**
+ * @brief         add a plan step
+ * @param[in,out] *plan pointer to a plan structure
+ * @param[in]     offset_ms step time from the interval start
+ * @param[in]     action step action
+ * @note          none
+ */
+static void a_scd4x_plan_add(scd4x_plan_t *plan, uint32_t offset_ms, uint8_t action)
+{
+    plan->step[plan->steps].offset_ms = offset_ms;        /* set offset */
+    plan->step[plan->steps].action = action;              /* set action */
+    plan->steps++;                                        /* next step */
+}
+
+/**
+ * @brief      set the steps of a mode and get the charge of one interval
+ * @param[in]  *model pointer to an energy model structure
+ * @param[in]  mode plan mode
+ * @param[in]  shots single shots of each wake up
+ * @param[in]  interval_ms sample interval
+ * @param[out] *plan pointer to a plan structure
+ * @return     charge of one interval in na * ms
+ * @note       the steps are cleared first, busy_ms is larger than interval_ms if the mode doesn't fit
+ */
+static uint64_t a_scd4x_plan_mode(const scd4x_energy_model_t *model, uint8_t mode, uint8_t shots,
+                                  uint32_t interval_ms, scd4x_plan_t *plan)
+{
+    uint64_t charge;
+    
+    plan->mode = mode;                                                                                                    /* set mode */
+    plan->setup = 0;                                                                                                      /* no setup */
+    plan->steps = 0;                                                                                                      /* no step */
+    if ((mode == SCD4X_PLAN_PERIODIC) || (mode == SCD4X_PLAN_LOW_POWER))                                                  /* periodic modes */
+    {
+        uint32_t period_ms;
+        
+        period_ms = (mode == SCD4X_PLAN_PERIODIC) ? SCD4X_ENERGY_PERIODIC_MS : SCD4X_ENERGY_LOW_POWER_MS;                 /* sample interval */
+        a_scd4x_plan_add(plan, 0, (mode == SCD4X_PLAN_PERIODIC) ? SCD4X_PLAN_ACTION_START_PERIODIC : 
+                         SCD4X_PLAN_ACTION_START_LOW_POWER);                                                              /* start once */
+        plan->setup = 1;                                                                                                  /* 1 setup step */
+        a_scd4x_plan_add(plan, period_ms, SCD4X_PLAN_ACTION_READ);                                                        /* read the latest sample */
+        plan->busy_ms = (interval_ms < period_ms) ? period_ms : interval_ms;                                              /* always measuring */
+        
+        return (uint64_t)((mode == SCD4X_PLAN_PERIODIC) ? model->periodic_na : model->low_power_na) * interval_ms;        /* return the charge */
+    }
+#if (SCD4X_CONFIG_SINGLE_SHOT != 0)
+    {
+        uint32_t read_ms;
+        uint32_t shot_ms;
+        uint32_t shot_na;
+        uint32_t wake_ms;
+        uint32_t t;
+        uint8_t i;
+        
+        read_ms = SCD4X_ENERGY_READ_MS;                                                                                   /* read execution time */
+        if ((mode == SCD4X_PLAN_SHOT_IDLE) || (mode == SCD4X_PLAN_SHOT_SLEEP))                                            /* co2 shot */
+        {
+            shot_ms = SCD4X_ENERGY_SHOT_MS;                                                                               /* shot time */
+            shot_na = model->shot_na;                                                                                     /* shot current */
+        }
+        else
+        {
+            shot_ms = SCD4X_ENERGY_RHT_ONLY_MS;                                                                           /* rht only shot time */
+            shot_na = model->rht_only_na;                                                                                 /* rht only shot current */
+        }
+        if ((mode == SCD4X_PLAN_SHOT_IDLE) || (mode == SCD4X_PLAN_RHT_IDLE))                                              /* idle modes */
+        {
+            a_scd4x_plan_add(plan, 0, (mode == SCD4X_PLAN_SHOT_IDLE) ? SCD4X_PLAN_ACTION_SHOT : 
+                             SCD4X_PLAN_ACTION_RHT_SHOT);                                                                 /* start the shot */
+            a_scd4x_plan_add(plan, shot_ms, SCD4X_PLAN_ACTION_READ);                                                      /* read the shot */
+            plan->busy_ms = shot_ms + read_ms;                                                                            /* set busy time */
+            charge = (uint64_t)shot_na * shot_ms;                                                                         /* shot charge */
+            if (interval_ms > shot_ms)                                                                                    /* check the rest time */
+            {
+                charge += (uint64_t)model->idle_na * (interval_ms - shot_ms);                                             /* idle charge */
+            }
+            
+            return charge;                                                                                                /* return the charge */
+        }
+        
+        wake_ms = SCD4X_ENERGY_WAKE_UP_MS;                                                                                /* wake up time */
+        a_scd4x_plan_add(plan, 0, SCD4X_PLAN_ACTION_POWER_DOWN);                                                          /* sleep before the first interval */
+        plan->setup = 1;                                                                                                  /* 1 setup step */
+        a_scd4x_plan_add(plan, 0, SCD4X_PLAN_ACTION_WAKE_UP);                                                             /* wake up */
+        t = wake_ms;                                                                                                      /* wait the wake up */
+        for (i = 0; i < shots; i++)                                                                                       /* run all shots */
+        {
+            a_scd4x_plan_add(plan, t, (mode == SCD4X_PLAN_SHOT_SLEEP) ? SCD4X_PLAN_ACTION_SHOT : 
+                             SCD4X_PLAN_ACTION_RHT_SHOT);                                                                 /* start the shot */
+            t += shot_ms;                                                                                                 /* wait the shot */
+            a_scd4x_plan_add(plan, t, (i + 1 < shots) ? SCD4X_PLAN_ACTION_DISCARD : SCD4X_PLAN_ACTION_READ);              /* read the shot */
+            t += read_ms;                                                                                                 /* wait the read */
+        }
+        a_scd4x_plan_add(plan, t, SCD4X_PLAN_ACTION_POWER_DOWN);                                                          /* power down */
+        t += SCD4X_ENERGY_POWER_DOWN_MS;                                                                                  /* wait the power down */
+        plan->busy_ms = t;                                                                                                /* set busy time */
+        charge = (uint64_t)model->wake_up_na * wake_ms + (uint64_t)shot_na * shot_ms * shots + 
+                 (uint64_t)model->idle_na * (t - wake_ms - shot_ms * shots);                                              /* awake charge */
+        if (interval_ms > t)                                                                                              /* check the rest time */
+        {
+            charge += (uint64_t)model->sleep_na * (interval_ms - t);                                                      /* sleep charge */
+        }
+        
+        return charge;                                                                                                    /* return the charge */
+    }
+#else
+    (void)shots;                                                                                                          /* not used */
+    plan->busy_ms = 0xFFFFFFFFU;                                                                                          /* never fits */
+    charge = 0;                                                                                                           /* init 0 */
+    
+    return charge;                                                                                                        /* return the charge */
+#endif
+}
+
+/**
+ * @brief      plan the measurement mode with the lowest average current
+ * @param[in]  *model pointer to an energy model structure
+ * @param[in]  type chip type
+ * @param[in]  interval_ms required sample interval
+ * @param[in]  accuracy required accuracy
+ * @param[out] *plan pointer to a plan structure
+ * @return     status code
+ *             - 0 success
+ *             - 2 model or plan is NULL
+ *             - 4 interval or accuracy is invalid
+ *             - 5 no mode fits the interval
+ * @note       the periodic modes give one sample each 5 s or 30 s and the latest one is read,
+ *             the single shot modes need a scd41 or scd43, the average currents are set
+ *             even if no mode fits
+ */
+uint8_t scd4x_energy_plan(const scd4x_energy_model_t *model, scd4x_t type, uint32_t interval_ms,
+                          scd4x_accuracy_t accuracy, scd4x_plan_t *plan)
+{
+    uint64_t charge;
+    uint8_t shots;
+    uint8_t best;
+    uint8_t fit;
+    uint8_t mode;
+    
+    if ((model == NULL) || (plan == NULL))                                                                           /* check model and plan */
+    {
+        return 2;                                                                                                    /* return error */
+    }
+    if ((interval_ms == 0) || (accuracy > SCD4X_ACCURACY_RHT) || (type > SCD43))                                     /* check interval, accuracy and type */
+    {
+        return 4;                                                                                                    /* return error */
+    }
+    
+    shots = (accuracy == SCD4X_ACCURACY_CO2) ? 2 : 1;                                                                /* discard the first shot after a wake up */
+    best = SCD4X_PLAN_MAX;                                                                                           /* no mode */
+    for (mode = 0; mode < SCD4X_PLAN_MAX; mode++)                                                                    /* check all modes */
+    {
+        charge = a_scd4x_plan_mode(model, mode, shots, interval_ms, plan);                                           /* get the charge */
+        fit = (uint8_t)(plan->busy_ms <= interval_ms);                                                               /* check the interval */
+        if ((mode == SCD4X_PLAN_PERIODIC) || (mode == SCD4X_PLAN_LOW_POWER))                                         /* periodic modes */
+        {
+            fit = (uint8_t)(fit && (plan->step[1].offset_ms <= interval_ms));                                        /* one sample each interval */
+        }
+        else
+        {
+            fit = (uint8_t)(fit && (type != SCD40));                                                                 /* scd40 has no single shot */
+        }
+        if ((mode == SCD4X_PLAN_RHT_IDLE) || (mode == SCD4X_PLAN_RHT_SLEEP))                                         /* rht only modes */
+        {
+            fit = (uint8_t)(fit && (accuracy == SCD4X_ACCURACY_RHT));                                                /* no co2 */
+        }
+        plan->average_ua[mode] = (fit != 0) ? (float)((double)charge / (double)interval_ms / 1000.0) : -1.0f;        /* set the average current */
+        if ((fit != 0) && ((best == SCD4X_PLAN_MAX) || (plan->average_ua[mode] < plan->average_ua[best])))           /* check the lowest */
+        {
+            best = mode;                                                                                             /* save the mode */
+        }
+    }
+    plan->interval_ms = interval_ms;                                                                                 /* set interval */
+    if (best == SCD4X_PLAN_MAX)                                                                                      /* check the mode */
+    {
+        plan->steps = 0;                                                                                             /* no step */
+        plan->setup = 0;                                                                                             /* no setup */
+        plan->charge_uc = 0.0f;                                                                                      /* no charge */
+        
+        return 5;                                                                                                    /* return error */
+    }
+    charge = a_scd4x_plan_mode(model, best, shots, interval_ms, plan);                                               /* set the steps of the mode */
+    plan->charge_uc = (float)((double)charge / 1000000.0);                                                           /* na * ms to uc */
+    
+    return 0;                                                                                                        /* success return 0 */
+}
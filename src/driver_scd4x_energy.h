@@ -0,0 +1,148 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_scd4x_energy.h
+ * @brief     driver scd4x energy header file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#ifndef DRIVER_SCD4X_ENERGY_H
+#define DRIVER_SCD4X_ENERGY_H
+
+#include "driver_scd4x.h"
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+/**
+ * @defgroup scd4x_plan_driver scd4x plan driver function
+ * @brief    scd4x plan driver modules
+ * @ingroup  scd4x_driver
+ * @{
+ */
+
+/**
+ * @brief scd4x accuracy enumeration definition
+ */
+typedef enum
+{
+    SCD4X_ACCURACY_CO2            = 0x00,        /**< co2 with the datasheet accuracy, the first shot after a wake up is discarded */
+    SCD4X_ACCURACY_CO2_FIRST_SHOT = 0x01,        /**< co2 of the first shot after a wake up is used */
+    SCD4X_ACCURACY_RHT            = 0x02,        /**< only temperature and humidity */
+} scd4x_accuracy_t;
+
+/**
+ * @brief scd4x plan mode enumeration definition
+ */
+typedef enum
+{
+    SCD4X_PLAN_PERIODIC   = 0x00,        /**< periodic measurement */
+    SCD4X_PLAN_LOW_POWER  = 0x01,        /**< low power periodic measurement */
+    SCD4X_PLAN_SHOT_IDLE  = 0x02,        /**< single shot, idle between the shots */
+    SCD4X_PLAN_SHOT_SLEEP = 0x03,        /**< wake up, single shot and power down */
+    SCD4X_PLAN_RHT_IDLE   = 0x04,        /**< rht only single shot, idle between the shots */
+    SCD4X_PLAN_RHT_SLEEP  = 0x05,        /**< wake up, rht only single shot and power down */
+    SCD4X_PLAN_MAX        = 0x06,        /**< mode number */
+} scd4x_plan_mode_t;
+
+/**
+ * @brief scd4x plan action enumeration definition
+ */
+typedef enum
+{
+    SCD4X_PLAN_ACTION_START_PERIODIC  = 0x00,        /**< scd4x_start_periodic_measurement */
+    SCD4X_PLAN_ACTION_START_LOW_POWER = 0x01,        /**< scd4x_start_low_power_periodic_measurement */
+    SCD4X_PLAN_ACTION_WAKE_UP         = 0x02,        /**< scd4x_wake_up */
+    SCD4X_PLAN_ACTION_SHOT            = 0x03,        /**< scd4x_measure_single_shot */
+    SCD4X_PLAN_ACTION_RHT_SHOT        = 0x04,        /**< scd4x_measure_single_shot_rht_only */
+    SCD4X_PLAN_ACTION_READ            = 0x05,        /**< scd4x_read, the sample is used */
+    SCD4X_PLAN_ACTION_DISCARD         = 0x06,        /**< scd4x_read, the sample is dropped */
+    SCD4X_PLAN_ACTION_POWER_DOWN      = 0x07,        /**< scd4x_power_down */
+} scd4x_plan_action_t;
+
+/**
+ * @brief plan max step number
+ */
+#define SCD4X_PLAN_MAX_STEPS 8
+
+/**
+ * @brief scd4x plan step structure definition
+ */
+typedef struct scd4x_plan_step_s
+{
+    uint32_t offset_ms;        /**< earliest step time from the interval start */
+    uint8_t action;            /**< step action */
+} scd4x_plan_step_t;
+
+/**
+ * @brief scd4x plan structure definition
+ */
+typedef struct scd4x_plan_s
+{
+    uint8_t mode;                                       /**< chosen mode */
+    uint8_t setup;                                      /**< first steps which run once before the first interval */
+    uint8_t steps;                                      /**< step number */
+    uint32_t interval_ms;                               /**< sample interval */
+    uint32_t busy_ms;                                   /**< time of the interval the sensor isn't sleeping or idle */
+    float average_ua[SCD4X_PLAN_MAX];                   /**< average current of each mode, negative if the mode doesn't fit */
+    float charge_uc;                                    /**< charge of one interval of the chosen mode */
+    scd4x_plan_step_t step[SCD4X_PLAN_MAX_STEPS];       /**< steps, the steps after setup repeat every interval */
+} scd4x_plan_t;
+
+/**
+ * @brief      plan the measurement mode with the lowest average current
+ * @param[in]  *model pointer to an energy model structure
+ * @param[in]  type chip type
+ * @param[in]  interval_ms required sample interval
+ * @param[in]  accuracy required accuracy
+ * @param[out] *plan pointer to a plan structure
+ * @return     status code
+ *             - 0 success
+ *             - 2 model or plan is NULL
+ *             - 4 interval or accuracy is invalid
+ *             - 5 no mode fits the interval
+ * @note       the periodic modes give one sample each 5 s or 30 s and the latest one is read,
+ *             the single shot modes need a scd41 or scd43, the average currents are set
+ *             even if no mode fits
+ */
+uint8_t scd4x_energy_plan(const scd4x_energy_model_t *model, scd4x_t type, uint32_t interval_ms,
+                          scd4x_accuracy_t accuracy, scd4x_plan_t *plan);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
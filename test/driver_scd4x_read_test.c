@@ -35,9 +35,20 @@
  */
 
 #include "driver_scd4x_read_test.h"
+#include "driver_scd4x_adaptive.h"
 
 static scd4x_handle_t gs_handle;        /**< scd4x handle */
 
+#if (SCD4X_CONFIG_ACCOUNTING != 0)
+/**
+ * @brief account state names
+ */
+static const char *const gs_account_state[SCD4X_ACCOUNT_MAX] =
+{
+    "sleep", "idle", "periodic", "low power", "single shot", "rht only", "wake up", "self test",
+};
+#endif
+
 /**
  * @brief     read test
  * @param[in] type chip type
@@ -52,6 +63,14 @@ uint8_t scd4x_read_test(scd4x_t type, uint32_t times)
     uint8_t res;
     uint32_t i;
     scd4x_info_t info;
+#if (SCD4X_CONFIG_ADAPTIVE != 0)
+    scd4x_adaptive_param_t param;
+    scd4x_adaptive_t adaptive;
+#endif
+#if (SCD4X_CONFIG_ACCOUNTING != 0)
+    scd4x_energy_model_t model;
+    scd4x_account_stats_t stats;
+#endif
     
     /* link functions */
     DRIVER_SCD4X_LINK_INIT(&gs_handle, scd4x_handle_t);
@@ -60,6 +79,7 @@ uint8_t scd4x_read_test(scd4x_t type, uint32_t times)
     DRIVER_SCD4X_LINK_IIC_WRITE_COMMAND(&gs_handle, scd4x_interface_iic_write_cmd);
     DRIVER_SCD4X_LINK_IIC_READ_COMMAND(&gs_handle, scd4x_interface_iic_read_cmd);
     DRIVER_SCD4X_LINK_DELAY_MS(&gs_handle, scd4x_interface_delay_ms);
+    DRIVER_SCD4X_LINK_GET_TIME_US(&gs_handle, scd4x_interface_get_time_us);
     DRIVER_SCD4X_LINK_DEBUG_PRINT(&gs_handle, scd4x_interface_debug_print);
     
     /* scd4x info */
@@ -105,6 +125,19 @@ uint8_t scd4x_read_test(scd4x_t type, uint32_t times)
         return 1;
     }
     
+#if (SCD4X_CONFIG_ACCOUNTING != 0)
+    /* account the energy of the whole test */
+    (void)scd4x_energy_default_model(&model);
+    res = scd4x_account_start(&gs_handle, &model, SCD4X_ACCOUNT_IDLE);
+    if (res != 0)
+    {
+        scd4x_interface_debug_print("scd4x: account start failed.\n");
+        (void)scd4x_deinit(&gs_handle);
+        
+        return 1;
+    }
+#endif
+    
     /* continuous read test */
     scd4x_interface_debug_print("scd4x: continuous read test.\n");
     
@@ -213,11 +246,64 @@ uint8_t scd4x_read_test(scd4x_t type, uint32_t times)
         return 1;
     }
     
+#if (SCD4X_CONFIG_ADAPTIVE != 0)
+    /* adaptive sampling test */
+    scd4x_interface_debug_print("scd4x: adaptive sampling test.\n");
+    
+    /* default parameters */
+    (void)scd4x_adaptive_default_param(&param);
+    res = scd4x_adaptive_init(&gs_handle, &adaptive, &param);
+    if (res != 0)
+    {
+        scd4x_interface_debug_print("scd4x: adaptive init failed.\n");
+        (void)scd4x_deinit(&gs_handle);
+        
+        return 1;
+    }
+    
+    /* loop */
+    for (i = 0; i < times; )
+    {
+        scd4x_sample_t sample;
+        uint32_t wait_us;
+        
+        /* poll the controller */
+        res = scd4x_adaptive_poll(&gs_handle, &adaptive, &sample, &wait_us);
+        if (res == 6)
+        {
+            scd4x_interface_delay_ms(wait_us / 1000 + 1);
+            
+            continue;
+        }
+        if (res != 0)
+        {
+            scd4x_interface_debug_print("scd4x: adaptive poll failed.\n");
+            (void)scd4x_deinit(&gs_handle);
+            
+            return 1;
+        }
+        
+        /* output */
+        scd4x_interface_debug_print("scd4x: co2 is %02dppm in the %s mode.\n", sample.co2_ppm, 
+                                    (adaptive.mode == SCD4X_ADAPTIVE_FAST) ? "fast" : "slow");
+        i++;
+    }
+    
+    /* stop */
+    res = scd4x_stop_periodic_measurement(&gs_handle);
+    if (res != 0)
+    {
+        scd4x_interface_debug_print("scd4x: stop periodic measurement failed.\n");
+        (void)scd4x_deinit(&gs_handle);
+        
+        return 1;
+    }
+#endif
+    
     /* scd41 && scd43 */
     if (type != SCD40)
     {
-        uint32_t timeout;
-        scd4x_bool_t enable;
+        scd4x_hybrid_t hybrid;
         
         /* measure single shot test */
         scd4x_interface_debug_print("scd4x: measure single shot test.\n");
@@ -235,62 +321,47 @@ uint8_t scd4x_read_test(scd4x_t type, uint32_t times)
                 return 1;
             }
             
-            /* set 30s */
-            timeout = 30;
-            
-            /* check timeout */
-            while (timeout != 0)
+            /* wait data ready in 30s */
+            res = scd4x_wait_data_ready(&gs_handle, 30000);
+            if (res == 5)
             {
-                /* delay 1000ms */
-                scd4x_interface_delay_ms(1000);
+                scd4x_interface_debug_print("scd4x: timeout.\n");
+                (void)scd4x_deinit(&gs_handle);
                 
-                /* timeout-- */
-                timeout--;
+                return 1;
+            }
+            else if (res != 0)
+            {
+                scd4x_interface_debug_print("scd4x: measure single shot failed.\n");
+                (void)scd4x_deinit(&gs_handle);
+                
+                return 1;
+            }
+            else
+            {
+                uint16_t co2_raw;
+                uint16_t co2_ppm;
+                uint16_t temperature_raw;
+                float temperature_s;
+                uint16_t humidity_raw;
+                float humidity_s;
                 
                 /* read data */
-                res = scd4x_get_data_ready_status(&gs_handle, &enable);
+                res = scd4x_read(&gs_handle, &co2_raw, &co2_ppm,
+                                 &temperature_raw, &temperature_s,
+                                 &humidity_raw, &humidity_s);
                 if (res != 0)
                 {
-                    scd4x_interface_debug_print("scd4x: measure single shot failed.\n");
+                    scd4x_interface_debug_print("scd4x: read failed.\n");
                     (void)scd4x_deinit(&gs_handle);
                     
                     return 1;
                 }
-                if (enable == SCD4X_BOOL_TRUE)
-                {
-                    uint16_t co2_raw;
-                    uint16_t co2_ppm;
-                    uint16_t temperature_raw;
-                    float temperature_s;
-                    uint16_t humidity_raw;
-                    float humidity_s;
-                    
-                    /* read data */
-                    res = scd4x_read(&gs_handle, &co2_raw, &co2_ppm,
-                                     &temperature_raw, &temperature_s,
-                                     &humidity_raw, &humidity_s);
-                    if (res != 0)
-                    {
-                        scd4x_interface_debug_print("scd4x: read failed.\n");
-                        (void)scd4x_deinit(&gs_handle);
-                        
-                        return 1;
-                    }
-                    
-                    /* output */
-                    scd4x_interface_debug_print("scd4x: co2 is %02dppm.\n", co2_ppm);
-                    scd4x_interface_debug_print("scd4x: temperature is %0.2fC.\n", temperature_s);
-                    scd4x_interface_debug_print("scd4x: humidity is %0.2f%%.\n", humidity_s);
-                    
-                    break;
-                }
-            }
-            if (timeout == 0)
-            {
-                scd4x_interface_debug_print("scd4x: timeout.\n");
-                (void)scd4x_deinit(&gs_handle);
                 
-                return 1;
+                /* output */
+                scd4x_interface_debug_print("scd4x: co2 is %02dppm.\n", co2_ppm);
+                scd4x_interface_debug_print("scd4x: temperature is %0.2fC.\n", temperature_s);
+                scd4x_interface_debug_print("scd4x: humidity is %0.2f%%.\n", humidity_s);
             }
         }
         
@@ -310,63 +381,170 @@ uint8_t scd4x_read_test(scd4x_t type, uint32_t times)
                 return 1;
             }
             
-            /* set 30s */
-            timeout = 30;
-            
-            /* check timeout */
-            while (timeout != 0)
+            /* wait data ready in 30s */
+            res = scd4x_wait_data_ready(&gs_handle, 30000);
+            if (res == 5)
             {
-                /* delay 1000ms */
-                scd4x_interface_delay_ms(1000);
+                scd4x_interface_debug_print("scd4x: timeout.\n");
+                (void)scd4x_deinit(&gs_handle);
+                
+                return 1;
+            }
+            else if (res != 0)
+            {
+                scd4x_interface_debug_print("scd4x: measure single shot failed.\n");
+                (void)scd4x_deinit(&gs_handle);
                 
-                /* timeout-- */
-                timeout--;
+                return 1;
+            }
+            else
+            {
+                uint16_t co2_raw;
+                uint16_t co2_ppm;
+                uint16_t temperature_raw;
+                float temperature_s;
+                uint16_t humidity_raw;
+                float humidity_s;
                 
                 /* read data */
-                res = scd4x_get_data_ready_status(&gs_handle, &enable);
+                res = scd4x_read(&gs_handle, &co2_raw, &co2_ppm,
+                                 &temperature_raw, &temperature_s,
+                                 &humidity_raw, &humidity_s);
                 if (res != 0)
                 {
-                    scd4x_interface_debug_print("scd4x: measure single shot failed.\n");
+                    scd4x_interface_debug_print("scd4x: read failed.\n");
                     (void)scd4x_deinit(&gs_handle);
                     
                     return 1;
                 }
-                if (enable == SCD4X_BOOL_TRUE)
-                {
-                    uint16_t co2_raw;
-                    uint16_t co2_ppm;
-                    uint16_t temperature_raw;
-                    float temperature_s;
-                    uint16_t humidity_raw;
-                    float humidity_s;
-                    
-                    /* read data */
-                    res = scd4x_read(&gs_handle, &co2_raw, &co2_ppm,
-                                     &temperature_raw, &temperature_s,
-                                     &humidity_raw, &humidity_s);
-                    if (res != 0)
-                    {
-                        scd4x_interface_debug_print("scd4x: read failed.\n");
-                        (void)scd4x_deinit(&gs_handle);
-                        
-                        return 1;
-                    }
-                    
-                    /* output */
-                    scd4x_interface_debug_print("scd4x: humidity is %0.2f%%.\n", humidity_s);
-                    
-                    break;
-                }
+                
+                /* output */
+                scd4x_interface_debug_print("scd4x: humidity is %0.2f%%.\n", humidity_s);
             }
-            if (timeout == 0)
+        }
+        
+        /* sleepy shot test */
+        scd4x_interface_debug_print("scd4x: sleepy shot test.\n");
+        
+        /* enable sleepy shot */
+        res = scd4x_set_sleepy_shot(&gs_handle, SCD4X_BOOL_TRUE, SCD4X_BOOL_FALSE);
+        if (res != 0)
+        {
+            scd4x_interface_debug_print("scd4x: set sleepy shot failed.\n");
+            (void)scd4x_deinit(&gs_handle);
+            
+            return 1;
+        }
+        
+        /* loop */
+        for (i = 0; i < times; i++)
+        {
+            scd4x_sample_t sample;
+            
+            /* wake up, measure, read and power down */
+            res = scd4x_read_sleepy_shot(&gs_handle, &sample);
+            if (res != 0)
             {
-                scd4x_interface_debug_print("scd4x: timeout.\n");
+                scd4x_interface_debug_print("scd4x: read sleepy shot failed.\n");
                 (void)scd4x_deinit(&gs_handle);
                 
                 return 1;
             }
+            
+            /* output */
+            scd4x_interface_debug_print("scd4x: co2 is %02dppm.\n", sample.co2_ppm);
+            scd4x_interface_debug_print("scd4x: temperature is %0.2fC.\n", sample.temperature_s);
+            scd4x_interface_debug_print("scd4x: humidity is %0.2f%%.\n", sample.humidity_s);
         }
+        
+        /* disable sleepy shot */
+        res = scd4x_set_sleepy_shot(&gs_handle, SCD4X_BOOL_FALSE, SCD4X_BOOL_FALSE);
+        if (res != 0)
+        {
+            scd4x_interface_debug_print("scd4x: set sleepy shot failed.\n");
+            (void)scd4x_deinit(&gs_handle);
+            
+            return 1;
+        }
+        
+        /* hybrid schedule test */
+        scd4x_interface_debug_print("scd4x: hybrid schedule test.\n");
+        
+        /* rht each 1s and co2 each 10s */
+        res = scd4x_hybrid_init(&gs_handle, &hybrid, 1000, 10000);
+        if (res != 0)
+        {
+            scd4x_interface_debug_print("scd4x: hybrid init failed.\n");
+            (void)scd4x_deinit(&gs_handle);
+            
+            return 1;
+        }
+        
+        /* loop */
+        for (i = 0; i < times; )
+        {
+            scd4x_sample_t sample;
+            uint32_t wait_us;
+            uint8_t stream;
+            
+            /* poll the schedule */
+            res = scd4x_hybrid_poll(&gs_handle, &hybrid, &sample, &stream, &wait_us);
+            if (res == 6)
+            {
+                scd4x_interface_delay_ms(wait_us / 1000 + 1);
+                
+                continue;
+            }
+            if (res != 0)
+            {
+                scd4x_interface_debug_print("scd4x: hybrid poll failed.\n");
+                (void)scd4x_deinit(&gs_handle);
+                
+                return 1;
+            }
+            
+            /* output */
+            if ((stream & SCD4X_STREAM_CO2) != 0)
+            {
+                scd4x_interface_debug_print("scd4x: co2 is %02dppm.\n", sample.co2_ppm);
+                i++;
+            }
+            scd4x_interface_debug_print("scd4x: temperature is %0.2fC.\n", sample.temperature_s);
+            scd4x_interface_debug_print("scd4x: humidity is %0.2f%%.\n", sample.humidity_s);
+        }
+    }
+    
+#if (SCD4X_CONFIG_ACCOUNTING != 0)
+    /* energy accounting test */
+    scd4x_interface_debug_print("scd4x: energy accounting test.\n");
+    
+    /* get account stats */
+    res = scd4x_get_account_stats(&gs_handle, &stats);
+    if (res != 0)
+    {
+        scd4x_interface_debug_print("scd4x: get account stats failed.\n");
+        (void)scd4x_deinit(&gs_handle);
+        
+        return 1;
+    }
+    for (i = 0; i < SCD4X_ACCOUNT_MAX; i++)
+    {
+        scd4x_interface_debug_print("scd4x: %s is %0.1fs and %0.3fuAh.\n", gs_account_state[i], 
+                                    (double)stats.state_us[i] / 1000000.0, stats.state_uah[i]);
+    }
+    scd4x_interface_debug_print("scd4x: %d commands, energy is %0.3fuAh, average current is %0.1fuA.\n", 
+                                stats.commands, stats.charge_uah, stats.average_ua);
+    
+    /* check the charge */
+    if ((stats.commands == 0) || (stats.charge_uah <= 0.0f))
+    {
+        scd4x_interface_debug_print("scd4x: check energy accounting error.\n");
+        (void)scd4x_deinit(&gs_handle);
+        
+        return 1;
     }
+    scd4x_interface_debug_print("scd4x: check energy accounting ok.\n");
+#endif
     
     /* finish read test */
     scd4x_interface_debug_print("scd4x: finish read test.\n");
@@ -66,6 +66,7 @@ uint8_t scd4x_register_test(scd4x_t type)
     DRIVER_SCD4X_LINK_IIC_WRITE_COMMAND(&gs_handle, scd4x_interface_iic_write_cmd);
     DRIVER_SCD4X_LINK_IIC_READ_COMMAND(&gs_handle, scd4x_interface_iic_read_cmd);
     DRIVER_SCD4X_LINK_DELAY_MS(&gs_handle, scd4x_interface_delay_ms);
+    DRIVER_SCD4X_LINK_GET_TIME_US(&gs_handle, scd4x_interface_get_time_us);
     DRIVER_SCD4X_LINK_DEBUG_PRINT(&gs_handle, scd4x_interface_debug_print);
     
     /* scd4x info */
@@ -382,6 +383,20 @@ uint8_t scd4x_register_test(scd4x_t type)
     }
     scd4x_interface_debug_print("scd4x: serial number is 0x%04X%04X%04X.\n", number[0], number[1], number[2]);
     
+    /* scd4x_get_sensor_variant test */
+    scd4x_interface_debug_print("scd4x: scd4x_get_sensor_variant test.\n");
+    
+    /* get sensor variant */
+    res = scd4x_get_sensor_variant(&gs_handle, &type_check);
+    if (res != 0)
+    {
+        scd4x_interface_debug_print("scd4x: get sensor variant failed.\n");
+        (void)scd4x_deinit(&gs_handle);
+        
+        return 1;
+    }
+    scd4x_interface_debug_print("scd4x: check sensor variant %s.\n", type_check == type ? "ok" : "error");
+    
     /* scd4x_perform_self_test test */
     scd4x_interface_debug_print("scd4x: scd4x_perform_self_test test.\n");
     
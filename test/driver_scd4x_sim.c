@@ -0,0 +1,651 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_scd4x_sim.c
+ * @brief     driver scd4x sim source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "driver_scd4x_sim.h"
+
+/**
+ * @brief sim address definition
+ */
+#define SCD4X_SIM_ADDRESS        (0x62 << 1)        /**< iic device address */
+
+/**
+ * @brief sim command definition
+ */
+#define SCD4X_SIM_START_PERIODIC                 0x21B1U        /**< start periodic measurement */
+#define SCD4X_SIM_READ                           0xEC05U        /**< read measurement */
+#define SCD4X_SIM_STOP_PERIODIC                  0x3F86U        /**< stop periodic measurement */
+#define SCD4X_SIM_SET_TEMPERATURE_OFFSET         0x241DU        /**< set temperature offset */
+#define SCD4X_SIM_GET_TEMPERATURE_OFFSET         0x2318U        /**< get temperature offset */
+#define SCD4X_SIM_SET_SENSOR_ALTITUDE            0x2427U        /**< set sensor altitude */
+#define SCD4X_SIM_GET_SENSOR_ALTITUDE            0x2322U        /**< get sensor altitude */
+#define SCD4X_SIM_AMBIENT_PRESSURE               0xE000U        /**< set or get ambient pressure */
+#define SCD4X_SIM_PERFORM_FORCED_RECALIBRATION   0x362FU        /**< perform forced recalibration */
+#define SCD4X_SIM_SET_ASC                        0x2416U        /**< set automatic self calibration enabled */
+#define SCD4X_SIM_GET_ASC                        0x2313U        /**< get automatic self calibration enabled */
+#define SCD4X_SIM_START_LOW_POWER_PERIODIC       0x21ACU        /**< start low power periodic measurement */
+#define SCD4X_SIM_GET_DATA_READY_STATUS          0xE4B8U        /**< get data ready status */
+#define SCD4X_SIM_PERSIST_SETTINGS               0x3615U        /**< persist settings */
+#define SCD4X_SIM_GET_SERIAL_NUMBER              0x3682U        /**< get serial number */
+#define SCD4X_SIM_GET_SENSOR_VARIANT             0x202FU        /**< get sensor variant */
+#define SCD4X_SIM_PERFORM_SELF_TEST              0x3639U        /**< perform self test */
+#define SCD4X_SIM_PERFORM_FACTORY_RESET          0x3632U        /**< perform factory reset */
+#define SCD4X_SIM_REINIT                         0x3646U        /**< reinit */
+#define SCD4X_SIM_MEASURE_SINGLE_SHOT            0x219DU        /**< measure single shot */
+#define SCD4X_SIM_MEASURE_SINGLE_SHOT_RHT_ONLY   0x2196U        /**< measure single shot rht only */
+#define SCD4X_SIM_POWER_DOWN                     0x36E0U        /**< power down */
+#define SCD4X_SIM_WAKE_UP                        0x36F6U        /**< wake up */
+#define SCD4X_SIM_SET_ASC_INITIAL_PERIOD         0x2445U        /**< set automatic self calibration initial period */
+#define SCD4X_SIM_GET_ASC_INITIAL_PERIOD         0x2340U        /**< get automatic self calibration initial period */
+#define SCD4X_SIM_SET_ASC_STANDARD_PERIOD        0x244EU        /**< set automatic self calibration standard period */
+#define SCD4X_SIM_GET_ASC_STANDARD_PERIOD        0x234BU        /**< get automatic self calibration standard period */
+
+/**
+ * @brief sim execution result definition
+ */
+#define SCD4X_SIM_NAK        (-1)        /**< not acknowledged */
+
+static scd4x_sim_t *gs_sim = NULL;        /**< attached sim */
+
+/**
+ * @brief factory settings
+ */
+static const scd4x_sim_settings_t gs_factory =
+{
+    1498,        /* 4 degrees temperature offset */
+    0,           /* 0 m altitude */
+    1013,        /* 101300 pa pressure */
+    1,           /* asc enabled */
+    44,          /* 44 hours initial period */
+    156,         /* 156 hours standard period */
+};
+
+/**
+ * @brief     generate the crc
+ * @param[in] *data pointer to a data buffer
+ * @return    crc
+ * @note      none
+ */
+static uint8_t a_scd4x_sim_crc(const uint8_t *data)
+{
+    uint8_t crc = 0xFF;
+    uint8_t i;
+    uint8_t bit;
+    
+    for (i = 0; i < 2; i++)                                              /* 2 bytes */
+    {
+        crc ^= data[i];                                                  /* xor data */
+        for (bit = 0; bit < 8; bit++)                                    /* 8 bit */
+        {
+            crc = ((crc & 0x80) != 0) ? 
+                  (uint8_t)((crc << 1) ^ 0x31) : (uint8_t)(crc << 1);    /* polynomial 0x31 */
+        }
+    }
+    
+    return crc;                                                          /* return crc */
+}
+
+/**
+ * @brief     set the response
+ * @param[in] *sim pointer to an scd4x sim structure
+ * @param[in] *word pointer to a word buffer
+ * @param[in] num word number
+ * @note      none
+ */
+static void a_scd4x_sim_respond(scd4x_sim_t *sim, const uint16_t *word, uint8_t num)
+{
+    uint8_t i;
+    
+    for (i = 0; i < num; i++)                                                  /* set all words */
+    {
+        sim->response[i * 3 + 0] = (uint8_t)((word[i] >> 8) & 0xFF);           /* set msb */
+        sim->response[i * 3 + 1] = (uint8_t)(word[i] & 0xFF);                  /* set lsb */
+        sim->response[i * 3 + 2] = a_scd4x_sim_crc(&sim->response[i * 3]);     /* set crc */
+    }
+    sim->response_len = (uint8_t)(num * 3);                                    /* set length */
+}
+
+/**
+ * @brief     update the measurement state with the virtual time
+ * @param[in] *sim pointer to an scd4x sim structure
+ * @note      none
+ */
+static void a_scd4x_sim_update(scd4x_sim_t *sim)
+{
+    if ((sim->sample_us == 0) || (sim->now_us < sim->sample_us))                          /* check sample time */
+    {
+        return;                                                                           /* no new sample */
+    }
+    
+    sim->ready = 1;                                                                       /* new sample */
+    if (sim->period_ms != 0)                                                              /* periodic */
+    {
+        while (sim->sample_us <= sim->now_us)                                             /* skip the missed samples */
+        {
+            sim->sample_us += (uint64_t)sim->period_ms * 1000;                            /* next sample */
+        }
+    }
+    else
+    {
+        sim->sample_us = 0;                                                               /* single shot finished */
+    }
+}
+
+/**
+ * @brief     count the state times and end a timed state
+ * @param[in] *sim pointer to an scd4x sim structure
+ * @note      none
+ */
+static void a_scd4x_sim_account(scd4x_sim_t *sim)
+{
+    if (sim->now_us <= sim->account_us)                                                   /* check time */
+    {
+        return;                                                                           /* nothing to count */
+    }
+    if ((sim->state_end_us != 0) && (sim->now_us >= sim->state_end_us))                   /* check the timed state */
+    {
+        if (sim->state_end_us > sim->account_us)                                          /* check the rest time */
+        {
+            sim->state_us[sim->state] += sim->state_end_us - sim->account_us;             /* count the rest time */
+            sim->account_us = sim->state_end_us;                                          /* move the count time */
+        }
+        sim->state = SCD4X_SIM_STATE_IDLE;                                                /* back to idle */
+        sim->state_end_us = 0;                                                            /* no end */
+    }
+    sim->state_us[sim->state] += sim->now_us - sim->account_us;                           /* count the time */
+    sim->account_us = sim->now_us;                                                        /* move the count time */
+}
+
+/**
+ * @brief     set the power state
+ * @param[in] *sim pointer to an scd4x sim structure
+ * @param[in] state power state
+ * @param[in] ms state time, 0 if it lasts
+ * @note      none
+ */
+static void a_scd4x_sim_state(scd4x_sim_t *sim, uint8_t state, uint32_t ms)
+{
+    sim->state = state;                                                                   /* set state */
+    sim->state_end_us = (ms != 0) ? (sim->now_us + (uint64_t)ms * 1000) : 0;              /* set end time */
+}
+
+/**
+ * @brief     check if a command is allowed during periodic measurement
+ * @param[in] command command code
+ * @return    1 if allowed
+ * @note      none
+ */
+static uint8_t a_scd4x_sim_periodic_allowed(uint16_t command)
+{
+    return (uint8_t)((command == SCD4X_SIM_READ) || 
+                     (command == SCD4X_SIM_STOP_PERIODIC) || 
+                     (command == SCD4X_SIM_GET_DATA_READY_STATUS) || 
+                     (command == SCD4X_SIM_AMBIENT_PRESSURE));
+}
+
+/**
+ * @brief     execute a command
+ * @param[in] *sim pointer to an scd4x sim structure
+ * @param[in] command command code
+ * @param[in] has_arg 1 if the command has an argument
+ * @param[in] arg command argument
+ * @return    execution time in ms or SCD4X_SIM_NAK
+ * @note      none
+ */
+static int32_t a_scd4x_sim_execute(scd4x_sim_t *sim, uint16_t command, uint8_t has_arg, uint16_t arg)
+{
+    uint16_t word[3];
+    uint8_t shot;
+    
+    shot = (uint8_t)(sim->type != SCD40);                                                    /* scd41 and scd43 commands */
+    switch (command)
+    {
+        case SCD4X_SIM_START_PERIODIC :
+        case SCD4X_SIM_START_LOW_POWER_PERIODIC :
+        {
+            sim->period_ms = (command == SCD4X_SIM_START_PERIODIC) ? 5000 : 30000;           /* set period */
+            sim->sample_us = sim->now_us + (uint64_t)sim->period_ms * 1000;                  /* first sample */
+            sim->ready = 0;                                                                  /* clear ready */
+            a_scd4x_sim_state(sim, (command == SCD4X_SIM_START_PERIODIC) ? SCD4X_SIM_STATE_PERIODIC : 
+                              SCD4X_SIM_STATE_LOW_POWER, 0);                                 /* measuring */
+            
+            return 0;                                                                        /* no execution time */
+        }
+        case SCD4X_SIM_READ :
+        {
+            if ((sim->ready == 0) && (sim->instant == 0))                                    /* check ready */
+            {
+                return SCD4X_SIM_NAK;                                                        /* no new sample */
+            }
+            word[0] = sim->co2;                                                              /* set co2 */
+            word[1] = sim->temperature;                                                      /* set temperature */
+            word[2] = sim->humidity;                                                         /* set humidity */
+            a_scd4x_sim_respond(sim, word, 3);                                               /* set response */
+            sim->ready = 0;                                                                  /* clear ready */
+            
+            return 1;                                                                        /* 1 ms */
+        }
+        case SCD4X_SIM_STOP_PERIODIC :
+        {
+            sim->period_ms = 0;                                                              /* idle */
+            sim->sample_us = 0;                                                              /* no sample */
+            sim->ready = 0;                                                                  /* clear ready */
+            a_scd4x_sim_state(sim, SCD4X_SIM_STATE_IDLE, 0);                                 /* idle */
+            
+            return 500;                                                                      /* 500 ms */
+        }
+        case SCD4X_SIM_SET_TEMPERATURE_OFFSET :
+        {
+            sim->settings.temperature_offset = arg;                                          /* set offset */
+            
+            return 1;                                                                        /* 1 ms */
+        }
+        case SCD4X_SIM_GET_TEMPERATURE_OFFSET :
+        {
+            a_scd4x_sim_respond(sim, &sim->settings.temperature_offset, 1);                  /* set response */
+            
+            return 1;                                                                        /* 1 ms */
+        }
+        case SCD4X_SIM_SET_SENSOR_ALTITUDE :
+        {
+            sim->settings.altitude = arg;                                                    /* set altitude */
+            
+            return 1;                                                                        /* 1 ms */
+        }
+        case SCD4X_SIM_GET_SENSOR_ALTITUDE :
+        {
+            a_scd4x_sim_respond(sim, &sim->settings.altitude, 1);                            /* set response */
+            
+            return 1;                                                                        /* 1 ms */
+        }
+        case SCD4X_SIM_AMBIENT_PRESSURE :
+        {
+            if (has_arg != 0)                                                                /* set */
+            {
+                sim->settings.pressure = arg;                                                /* set pressure */
+            }
+            else
+            {
+                a_scd4x_sim_respond(sim, &sim->settings.pressure, 1);                        /* set response */
+            }
+            
+            return 1;                                                                        /* 1 ms */
+        }
+        case SCD4X_SIM_PERFORM_FORCED_RECALIBRATION :
+        {
+            word[0] = (uint16_t)(0x8000 + (int32_t)arg - (int32_t)sim->co2);                 /* set correction */
+            a_scd4x_sim_respond(sim, word, 1);                                               /* set response */
+            
+            return 400;                                                                      /* 400 ms */
+        }
+        case SCD4X_SIM_SET_ASC :
+        {
+            sim->settings.asc = arg;                                                         /* set asc */
+            
+            return 1;                                                                        /* 1 ms */
+        }
+        case SCD4X_SIM_GET_ASC :
+        {
+            a_scd4x_sim_respond(sim, &sim->settings.asc, 1);                                 /* set response */
+            
+            return 1;                                                                        /* 1 ms */
+        }
+        case SCD4X_SIM_GET_DATA_READY_STATUS :
+        {
+            word[0] = ((sim->ready != 0) || (sim->instant != 0)) ? 0x8006U : 0x8000U;        /* set status */
+            a_scd4x_sim_respond(sim, word, 1);                                               /* set response */
+            
+            return 1;                                                                        /* 1 ms */
+        }
+        case SCD4X_SIM_PERSIST_SETTINGS :
+        {
+            sim->eeprom = sim->settings;                                                     /* save settings */
+            
+            return 800;                                                                      /* 800 ms */
+        }
+        case SCD4X_SIM_GET_SERIAL_NUMBER :
+        {
+            a_scd4x_sim_respond(sim, sim->serial, 3);                                        /* set response */
+            
+            return 1;                                                                        /* 1 ms */
+        }
+        case SCD4X_SIM_GET_SENSOR_VARIANT :
+        {
+            word[0] = (sim->type == SCD40) ? 0x0000U : ((sim->type == SCD41) ? 0x1000U : 0x5000U);        /* set variant */
+            a_scd4x_sim_respond(sim, word, 1);                                               /* set response */
+            
+            return 1;                                                                        /* 1 ms */
+        }
+        case SCD4X_SIM_PERFORM_SELF_TEST :
+        {
+            word[0] = 0;                                                                     /* no malfunction */
+            a_scd4x_sim_respond(sim, word, 1);                                               /* set response */
+            
+            return 10000;                                                                    /* 10000 ms */
+        }
+        case SCD4X_SIM_PERFORM_FACTORY_RESET :
+        {
+            sim->settings = gs_factory;                                                      /* reset settings */
+            sim->eeprom = gs_factory;                                                        /* reset eeprom */
+            
+            return 1200;                                                                     /* 1200 ms */
+        }
+        case SCD4X_SIM_REINIT :
+        {
+            sim->settings = sim->eeprom;                                                     /* reload settings */
+            
+            return 30;                                                                       /* 30 ms */
+        }
+        case SCD4X_SIM_MEASURE_SINGLE_SHOT :
+        case SCD4X_SIM_MEASURE_SINGLE_SHOT_RHT_ONLY :
+        {
+            uint32_t ms;
+            
+            if (shot == 0)                                                                   /* check type */
+            {
+                return SCD4X_SIM_NAK;                                                        /* scd40 has no this command */
+            }
+            ms = (command == SCD4X_SIM_MEASURE_SINGLE_SHOT) ? 5000 : 50;                     /* set measurement time */
+            sim->sample_us = sim->now_us + (uint64_t)ms * 1000;                              /* sample time */
+            sim->ready = 0;                                                                  /* clear ready */
+            a_scd4x_sim_state(sim, (command == SCD4X_SIM_MEASURE_SINGLE_SHOT) ? SCD4X_SIM_STATE_SHOT : 
+                              SCD4X_SIM_STATE_RHT_ONLY, ms);                                 /* measuring */
+            
+            return (int32_t)ms;                                                              /* measurement time */
+        }
+        case SCD4X_SIM_POWER_DOWN :
+        {
+            if (shot == 0)                                                                   /* check type */
+            {
+                return SCD4X_SIM_NAK;                                                        /* scd40 has no this command */
+            }
+            sim->sleeping = 1;                                                               /* sleep */
+            a_scd4x_sim_state(sim, SCD4X_SIM_STATE_SLEEP, 0);                                /* power down */
+            
+            return 1;                                                                        /* 1 ms */
+        }
+        case SCD4X_SIM_SET_ASC_INITIAL_PERIOD :
+        case SCD4X_SIM_SET_ASC_STANDARD_PERIOD :
+        {
+            if (shot == 0)                                                                   /* check type */
+            {
+                return SCD4X_SIM_NAK;                                                        /* scd40 has no this command */
+            }
+            if (command == SCD4X_SIM_SET_ASC_INITIAL_PERIOD)                                 /* initial period */
+            {
+                sim->settings.asc_initial = arg;                                             /* set period */
+            }
+            else
+            {
+                sim->settings.asc_standard = arg;                                            /* set period */
+            }
+            
+            return 1;                                                                        /* 1 ms */
+        }
+        case SCD4X_SIM_GET_ASC_INITIAL_PERIOD :
+        case SCD4X_SIM_GET_ASC_STANDARD_PERIOD :
+        {
+            if (shot == 0)                                                                   /* check type */
+            {
+                return SCD4X_SIM_NAK;                                                        /* scd40 has no this command */
+            }
+            a_scd4x_sim_respond(sim, (command == SCD4X_SIM_GET_ASC_INITIAL_PERIOD) ? 
+                                &sim->settings.asc_initial : &sim->settings.asc_standard, 1);    /* set response */
+            
+            return 1;                                                                        /* 1 ms */
+        }
+        default :
+        {
+            return SCD4X_SIM_NAK;                                                            /* unknown command */
+        }
+    }
+}
+
+/**
+ * @brief     count a not acknowledged transfer
+ * @param[in] *sim pointer to an scd4x sim structure
+ * @return    1
+ * @note      none
+ */
+static uint8_t a_scd4x_sim_nak(scd4x_sim_t *sim)
+{
+    sim->naks++;        /* count nak */
+    
+    return 1;           /* return error */
+}
+
+/**
+ * @brief     init a sim with the power on state
+ * @param[in] *sim pointer to an scd4x sim structure
+ * @param[in] type chip type
+ * @note      none
+ */
+void scd4x_sim_init(scd4x_sim_t *sim, scd4x_t type)
+{
+    memset(sim, 0, sizeof(scd4x_sim_t));                /* clear the sim */
+    sim->type = type;                                   /* set type */
+    sim->co2 = 600;                                     /* 600 ppm */
+    sim->temperature = 26214;                           /* 25 degrees */
+    sim->humidity = 32768;                              /* 50 % */
+    sim->serial[0] = 0x1234;                            /* set serial number */
+    sim->serial[1] = 0x5678;                            /* set serial number */
+    sim->serial[2] = 0x9ABC;                            /* set serial number */
+    sim->settings = gs_factory;                         /* set factory settings */
+    sim->eeprom = gs_factory;                           /* set factory eeprom */
+    sim->busy_until_us = 30000;                         /* 30 ms power up time */
+    sim->state = SCD4X_SIM_STATE_WAKE_UP;               /* power up */
+    sim->state_end_us = 30000;                          /* 30 ms power up time */
+}
+
+/**
+ * @brief     set the sim used by the link functions
+ * @param[in] *sim pointer to an scd4x sim structure
+ * @note      none
+ */
+void scd4x_sim_attach(scd4x_sim_t *sim)
+{
+    gs_sim = sim;        /* set the sim */
+}
+
+/**
+ * @brief     count the state times up to the virtual time
+ * @param[in] *sim pointer to an scd4x sim structure
+ * @note      the sim counts them on each write, call it before reading state_us
+ */
+void scd4x_sim_account(scd4x_sim_t *sim)
+{
+    a_scd4x_sim_account(sim);        /* count the state times */
+}
+
+/**
+ * @brief     set the next sample
+ * @param[in] *sim pointer to an scd4x sim structure
+ * @param[in] co2 co2 register
+ * @param[in] temperature temperature register
+ * @param[in] humidity humidity register
+ * @note      none
+ */
+void scd4x_sim_set_sample(scd4x_sim_t *sim, uint16_t co2, uint16_t temperature, uint16_t humidity)
+{
+    sim->co2 = co2;                        /* set co2 */
+    sim->temperature = temperature;        /* set temperature */
+    sim->humidity = humidity;              /* set humidity */
+}
+
+/**
+ * @brief  sim iic init
+ * @return status code
+ *         - 0 success
+ * @note   none
+ */
+uint8_t scd4x_sim_iic_init(void)
+{
+    return 0;        /* success return 0 */
+}
+
+/**
+ * @brief  sim iic deinit
+ * @return status code
+ *         - 0 success
+ * @note   none
+ */
+uint8_t scd4x_sim_iic_deinit(void)
+{
+    return 0;        /* success return 0 */
+}
+
+/**
+ * @brief     sim iic write command
+ * @param[in] addr iic device write address
+ * @param[in] *buf pointer to a data buffer
+ * @param[in] len length of the data buffer
+ * @return    status code
+ *            - 0 success
+ *            - 1 not acknowledged
+ * @note      the sim doesn't acknowledge a busy, sleeping or wrong state access like the chip
+ */
+uint8_t scd4x_sim_iic_write_cmd(uint8_t addr, uint8_t *buf, uint16_t len)
+{
+    scd4x_sim_t *sim = gs_sim;
+    uint16_t command;
+    uint16_t arg;
+    int32_t ms;
+    
+    sim->writes++;                                                                         /* count the transfer */
+    a_scd4x_sim_account(sim);                                                              /* count the state times */
+    a_scd4x_sim_update(sim);                                                               /* update the state */
+    if ((addr != SCD4X_SIM_ADDRESS) || ((len != 2) && (len != 5)))                         /* check the frame */
+    {
+        return a_scd4x_sim_nak(sim);                                                       /* not acknowledged */
+    }
+    command = (uint16_t)(((uint16_t)buf[0] << 8) | buf[1]);                                /* get command */
+    if (sim->sleeping != 0)                                                                /* check sleeping */
+    {
+        if (command == SCD4X_SIM_WAKE_UP)                                                  /* wake up */
+        {
+            sim->sleeping = 0;                                                             /* awake */
+            sim->busy_until_us = sim->now_us + 30000;                                      /* 30 ms wake up time */
+            a_scd4x_sim_state(sim, SCD4X_SIM_STATE_WAKE_UP, 30);                           /* waking up */
+        }
+        
+        return a_scd4x_sim_nak(sim);                                                       /* wake up is not acknowledged */
+    }
+    if ((sim->instant == 0) && (sim->now_us < sim->busy_until_us))                         /* check busy */
+    {
+        return a_scd4x_sim_nak(sim);                                                       /* not acknowledged */
+    }
+    arg = 0;                                                                               /* init 0 */
+    if (len == 5)                                                                          /* check the argument */
+    {
+        if (a_scd4x_sim_crc(&buf[2]) != buf[4])                                            /* check crc */
+        {
+            return a_scd4x_sim_nak(sim);                                                   /* not acknowledged */
+        }
+        arg = (uint16_t)(((uint16_t)buf[2] << 8) | buf[3]);                                /* get argument */
+    }
+    if ((sim->period_ms != 0) && (a_scd4x_sim_periodic_allowed(command) == 0))             /* check periodic */
+    {
+        return a_scd4x_sim_nak(sim);                                                       /* not acknowledged */
+    }
+    
+    sim->response_len = 0;                                                                 /* drop the old response */
+    ms = a_scd4x_sim_execute(sim, command, (uint8_t)(len == 5), arg);                      /* execute */
+    if (ms == SCD4X_SIM_NAK)                                                               /* check result */
+    {
+        return a_scd4x_sim_nak(sim);                                                       /* not acknowledged */
+    }
+    sim->busy_until_us = sim->now_us + (uint64_t)ms * 1000;                                /* set execution time */
+    
+    return 0;                                                                              /* success return 0 */
+}
+
+/**
+ * @brief      sim iic read command
+ * @param[in]  addr iic device write address
+ * @param[out] *buf pointer to a data buffer
+ * @param[in]  len length of the data buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 not acknowledged
+ * @note       none
+ */
+uint8_t scd4x_sim_iic_read_cmd(uint8_t addr, uint8_t *buf, uint16_t len)
+{
+    scd4x_sim_t *sim = gs_sim;
+    
+    sim->reads++;                                                                     /* count the transfer */
+    if ((addr != SCD4X_SIM_ADDRESS) || (sim->sleeping != 0) ||                        /* check address and state */
+        ((sim->instant == 0) && (sim->now_us < sim->busy_until_us)) ||                /* check busy */
+        (len == 0) || (len > sim->response_len))                                      /* check response */
+    {
+        return a_scd4x_sim_nak(sim);                                                  /* not acknowledged */
+    }
+    memcpy(buf, sim->response, len);                                                  /* copy response */
+    sim->response_len = 0;                                                            /* response is read */
+    
+    return 0;                                                                         /* success return 0 */
+}
+
+/**
+ * @brief     sim delay, only the virtual time is moved
+ * @param[in] ms time
+ * @note      none
+ */
+void scd4x_sim_delay_ms(uint32_t ms)
+{
+    gs_sim->now_us += (uint64_t)ms * 1000;        /* move the virtual time */
+}
+
+/**
+ * @brief  sim get time
+ * @return virtual time in us
+ * @note   none
+ */
+uint64_t scd4x_sim_get_time_us(void)
+{
+    return gs_sim->now_us;        /* return the virtual time */
+}
+
+/**
+ * @brief     sim debug print, the message is counted and dropped
+ * @param[in] fmt format data
+ * @note      none
+ */
+void scd4x_sim_debug_print(const char *const fmt, ...)
+{
+    (void)fmt;
+    
+    gs_sim->prints++;        /* count the message */
+}
@@ -0,0 +1,228 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_scd4x_sim.h
+ * @brief     driver scd4x sim header file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#ifndef DRIVER_SCD4X_SIM_H
+#define DRIVER_SCD4X_SIM_H
+
+#include "driver_scd4x.h"
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+/**
+ * @addtogroup scd4x_test_driver
+ * @{
+ */
+
+/**
+ * @brief scd4x sim settings structure definition
+ */
+typedef struct scd4x_sim_settings_s
+{
+    uint16_t temperature_offset;        /**< temperature offset register */
+    uint16_t altitude;                  /**< sensor altitude register */
+    uint16_t pressure;                  /**< ambient pressure register */
+    uint16_t asc;                       /**< automatic self calibration enabled */
+    uint16_t asc_initial;               /**< automatic self calibration initial period */
+    uint16_t asc_standard;              /**< automatic self calibration standard period */
+} scd4x_sim_settings_t;
+
+/**
+ * @brief scd4x sim state enumeration definition
+ */
+typedef enum
+{
+    SCD4X_SIM_STATE_SLEEP     = 0x00,        /**< power down */
+    SCD4X_SIM_STATE_IDLE      = 0x01,        /**< idle */
+    SCD4X_SIM_STATE_PERIODIC  = 0x02,        /**< periodic measurement */
+    SCD4X_SIM_STATE_LOW_POWER = 0x03,        /**< low power periodic measurement */
+    SCD4X_SIM_STATE_SHOT      = 0x04,        /**< single shot */
+    SCD4X_SIM_STATE_RHT_ONLY  = 0x05,        /**< rht only single shot */
+    SCD4X_SIM_STATE_WAKE_UP   = 0x06,        /**< power up or wake up */
+    SCD4X_SIM_STATE_MAX       = 0x07,        /**< state number */
+} scd4x_sim_state_t;
+
+/**
+ * @brief scd4x sim structure definition
+ */
+typedef struct scd4x_sim_s
+{
+    scd4x_t type;                        /**< simulated chip type */
+    uint8_t instant;                     /**< 1 means no execution time and data is always ready */
+    uint8_t sleeping;                    /**< power down flag */
+    uint8_t ready;                       /**< new sample flag */
+    uint32_t period_ms;                  /**< measurement period, 0 means idle */
+    uint64_t now_us;                     /**< virtual time */
+    uint64_t busy_until_us;              /**< command execution end time */
+    uint64_t sample_us;                  /**< next sample time */
+    uint8_t response[9];                 /**< pending response */
+    uint8_t response_len;                /**< pending response length */
+    uint16_t co2;                        /**< co2 register */
+    uint16_t temperature;                /**< temperature register */
+    uint16_t humidity;                   /**< humidity register */
+    uint16_t serial[3];                  /**< serial number */
+    scd4x_sim_settings_t settings;       /**< ram settings */
+    scd4x_sim_settings_t eeprom;         /**< persisted settings */
+    uint32_t writes;                     /**< write transfer number */
+    uint32_t reads;                      /**< read transfer number */
+    uint32_t naks;                       /**< not acknowledged transfer number */
+    uint32_t prints;                     /**< debug print number */
+    uint8_t state;                       /**< power state */
+    uint64_t state_end_us;               /**< end time of a timed state, 0 if it lasts */
+    uint64_t account_us;                 /**< state times are counted up to this time */
+    uint64_t state_us[SCD4X_SIM_STATE_MAX];        /**< time in each state */
+} scd4x_sim_t;
+
+/**
+ * @brief     link all sim functions to a handle
+ * @param[in] HANDLE pointer to an scd4x handle structure
+ * @note      none
+ */
+#define DRIVER_SCD4X_LINK_SIM(HANDLE)                                     \
+do                                                                        \
+{                                                                         \
+    DRIVER_SCD4X_LINK_IIC_INIT(HANDLE, scd4x_sim_iic_init);               \
+    DRIVER_SCD4X_LINK_IIC_DEINIT(HANDLE, scd4x_sim_iic_deinit);           \
+    DRIVER_SCD4X_LINK_IIC_WRITE_COMMAND(HANDLE, scd4x_sim_iic_write_cmd); \
+    DRIVER_SCD4X_LINK_IIC_READ_COMMAND(HANDLE, scd4x_sim_iic_read_cmd);   \
+    DRIVER_SCD4X_LINK_DELAY_MS(HANDLE, scd4x_sim_delay_ms);               \
+    DRIVER_SCD4X_LINK_GET_TIME_US(HANDLE, scd4x_sim_get_time_us);         \
+    DRIVER_SCD4X_LINK_DEBUG_PRINT(HANDLE, scd4x_sim_debug_print);         \
+} while (0)
+
+/**
+ * @brief     init a sim with the power on state
+ * @param[in] *sim pointer to an scd4x sim structure
+ * @param[in] type chip type
+ * @note      none
+ */
+void scd4x_sim_init(scd4x_sim_t *sim, scd4x_t type);
+
+/**
+ * @brief     set the sim used by the link functions
+ * @param[in] *sim pointer to an scd4x sim structure
+ * @note      none
+ */
+void scd4x_sim_attach(scd4x_sim_t *sim);
+
+/**
+ * @brief     count the state times up to the virtual time
+ * @param[in] *sim pointer to an scd4x sim structure
+ * @note      the sim counts them on each write, call it before reading state_us
+ */
+void scd4x_sim_account(scd4x_sim_t *sim);
+
+/**
+ * @brief     set the next sample
+ * @param[in] *sim pointer to an scd4x sim structure
+ * @param[in] co2 co2 register
+ * @param[in] temperature temperature register
+ * @param[in] humidity humidity register
+ * @note      none
+ */
+void scd4x_sim_set_sample(scd4x_sim_t *sim, uint16_t co2, uint16_t temperature, uint16_t humidity);
+
+/**
+ * @brief  sim iic init
+ * @return status code
+ *         - 0 success
+ * @note   none
+ */
+uint8_t scd4x_sim_iic_init(void);
+
+/**
+ * @brief  sim iic deinit
+ * @return status code
+ *         - 0 success
+ * @note   none
+ */
+uint8_t scd4x_sim_iic_deinit(void);
+
+/**
+ * @brief     sim iic write command
+ * @param[in] addr iic device write address
+ * @param[in] *buf pointer to a data buffer
+ * @param[in] len length of the data buffer
+ * @return    status code
+ *            - 0 success
+ *            - 1 not acknowledged
+ * @note      the sim doesn't acknowledge a busy, sleeping or wrong state access like the chip
+ */
+uint8_t scd4x_sim_iic_write_cmd(uint8_t addr, uint8_t *buf, uint16_t len);
+
+/**
+ * @brief      sim iic read command
+ * @param[in]  addr iic device write address
+ * @param[out] *buf pointer to a data buffer
+ * @param[in]  len length of the data buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 not acknowledged
+ * @note       none
+ */
+uint8_t scd4x_sim_iic_read_cmd(uint8_t addr, uint8_t *buf, uint16_t len);
+
+/**
+ * @brief     sim delay, only the virtual time is moved
+ * @param[in] ms time
+ * @note      none
+ */
+void scd4x_sim_delay_ms(uint32_t ms);
+
+/**
+ * @brief  sim get time
+ * @return virtual time in us
+ * @note   none
+ */
+uint64_t scd4x_sim_get_time_us(void);
+
+/**
+ * @brief     sim debug print, the message is counted and dropped
+ * @param[in] fmt format data
+ * @note      none
+ */
+void scd4x_sim_debug_print(const char *const fmt, ...);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,252 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_scd4x_sim_bus.c
+ * @brief     driver scd4x sim bus source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "driver_scd4x_sim_bus.h"
+
+/**
+ * @brief sim bus definition
+ */
+#define SCD4X_SIM_BUS_MUX_ADDRESS        (0x70 << 1)        /**< mux address */
+
+static scd4x_sim_bus_t *gs_bus = NULL;        /**< attached bus */
+
+/**
+ * @brief     get the bus free time between a stop and a start
+ * @param[in] freq_hz scl frequency
+ * @return    time in ns
+ * @note      tBUF of the standard, fast and fast plus mode
+ */
+static uint32_t a_scd4x_sim_bus_free_ns(uint32_t freq_hz)
+{
+    if (freq_hz <= 100000)            /* standard mode */
+    {
+        return 4700;                  /* 4.7 us */
+    }
+    else if (freq_hz <= 400000)       /* fast mode */
+    {
+        return 1300;                  /* 1.3 us */
+    }
+    else                              /* fast mode plus */
+    {
+        return 500;                   /* 0.5 us */
+    }
+}
+
+/**
+ * @brief     charge a transfer to the bus
+ * @param[in] *bus pointer to an scd4x sim bus structure
+ * @param[in] bytes data bytes after the address
+ * @note      none
+ */
+static void a_scd4x_sim_bus_charge(scd4x_sim_bus_t *bus, uint16_t bytes)
+{
+    uint64_t ns;
+    
+    ns = scd4x_sim_bus_transfer_ns(bus, bytes);        /* get the wire time */
+    bus->now_ns += ns;                                 /* move the time */
+    bus->busy_ns += ns;                                /* bus is busy */
+    bus->transfers++;                                  /* count the transfer */
+    bus->bytes += (uint32_t)bytes + 1;                 /* count the bytes */
+}
+
+/**
+ * @brief  get the selected sensor and sync its time
+ * @return pointer to the selected sensor
+ * @note   none
+ */
+static scd4x_sim_t *a_scd4x_sim_bus_sensor(void)
+{
+    scd4x_sim_t *sim = gs_bus->sensor[gs_bus->channel];
+    
+    sim->now_us = gs_bus->now_ns / 1000;        /* sync the time */
+    scd4x_sim_attach(sim);                      /* route the sim functions */
+    
+    return sim;                                 /* return the sensor */
+}
+
+/**
+ * @brief     init a sim bus
+ * @param[in] *bus pointer to an scd4x sim bus structure
+ * @param[in] freq_hz scl frequency
+ * @param[in] **sensor pointer to a sensor list
+ * @param[in] num sensor number
+ * @return    status code
+ *            - 0 success
+ *            - 1 init failed
+ * @note      more than one sensor needs a mux, all scd4x use the same address
+ */
+uint8_t scd4x_sim_bus_init(scd4x_sim_bus_t *bus, uint32_t freq_hz, scd4x_sim_t **sensor, uint8_t num)
+{
+    uint8_t i;
+    
+    if ((freq_hz == 0) || (num == 0) || (num > SCD4X_SIM_BUS_MAX_CHANNEL))        /* check the params */
+    {
+        return 1;                                                                 /* return error */
+    }
+    
+    memset(bus, 0, sizeof(scd4x_sim_bus_t));                                      /* clear the bus */
+    bus->freq_hz = freq_hz;                                                       /* set frequency */
+    bus->num = num;                                                               /* set number */
+    bus->mux = (uint8_t)(num > 1);                                                /* mux is needed */
+    for (i = 0; i < num; i++)                                                     /* set all sensors */
+    {
+        bus->sensor[i] = sensor[i];                                               /* set sensor */
+        if (sensor[i]->now_us * 1000 > bus->now_ns)                               /* check the sensor time */
+        {
+            bus->now_ns = sensor[i]->now_us * 1000;                               /* start from the latest time */
+        }
+    }
+    
+    return 0;                                                                     /* success return 0 */
+}
+
+/**
+ * @brief     set the bus used by the link functions
+ * @param[in] *bus pointer to an scd4x sim bus structure
+ * @note      none
+ */
+void scd4x_sim_bus_attach(scd4x_sim_bus_t *bus)
+{
+    gs_bus = bus;        /* set the bus */
+}
+
+/**
+ * @brief     select a mux channel
+ * @param[in] *bus pointer to an scd4x sim bus structure
+ * @param[in] channel mux channel
+ * @note      the mux write is charged only when the channel changes
+ */
+void scd4x_sim_bus_select(scd4x_sim_bus_t *bus, uint8_t channel)
+{
+    if ((bus->mux == 0) || (channel == bus->channel) || (channel >= bus->num))        /* check the channel */
+    {
+        return;                                                                       /* nothing to do */
+    }
+    
+    a_scd4x_sim_bus_charge(bus, 1);                                                   /* write the channel mask */
+    bus->channel = channel;                                                           /* set the channel */
+    bus->switches++;                                                                  /* count the switch */
+}
+
+/**
+ * @brief     get the wire time of a transfer
+ * @param[in] *bus pointer to an scd4x sim bus structure
+ * @param[in] bytes data bytes after the address
+ * @return    time in ns
+ * @note      start, address, ack of each byte, stop, bus free time and clock stretching are included
+ */
+uint64_t scd4x_sim_bus_transfer_ns(scd4x_sim_bus_t *bus, uint16_t bytes)
+{
+    uint64_t bits;
+    
+    bits = 1 + 9 * ((uint64_t)bytes + 1) + 1;                                     /* start, 9 bits per byte and stop */
+    
+    return bits * 1000000000ULL / bus->freq_hz + 
+           a_scd4x_sim_bus_free_ns(bus->freq_hz) + bus->stretch_ns;              /* wire, free and stretching time */
+}
+
+/**
+ * @brief     sim bus iic write command
+ * @param[in] addr iic device write address
+ * @param[in] *buf pointer to a data buffer
+ * @param[in] len length of the data buffer
+ * @return    status code
+ *            - 0 success
+ *            - 1 not acknowledged
+ * @note      none
+ */
+uint8_t scd4x_sim_bus_iic_write_cmd(uint8_t addr, uint8_t *buf, uint16_t len)
+{
+    scd4x_sim_t *sim = a_scd4x_sim_bus_sensor();
+    uint8_t awake;
+    uint8_t res;
+    
+    awake = (uint8_t)((sim->sleeping == 0) && 
+                      ((sim->instant != 0) || (sim->now_us >= sim->busy_until_us)));     /* address is acknowledged */
+    res = scd4x_sim_iic_write_cmd(addr, buf, len);                                       /* write */
+    a_scd4x_sim_bus_charge(gs_bus, (awake != 0) ? len : 0);                              /* charge the wire time */
+    if (res != 0)                                                                        /* check result */
+    {
+        gs_bus->naks++;                                                                  /* count nak */
+    }
+    
+    return res;                                                                          /* return the result */
+}
+
+/**
+ * @brief      sim bus iic read command
+ * @param[in]  addr iic device write address
+ * @param[out] *buf pointer to a data buffer
+ * @param[in]  len length of the data buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 not acknowledged
+ * @note       none
+ */
+uint8_t scd4x_sim_bus_iic_read_cmd(uint8_t addr, uint8_t *buf, uint16_t len)
+{
+    uint8_t res;
+    
+    (void)a_scd4x_sim_bus_sensor();                                                      /* sync the sensor */
+    res = scd4x_sim_iic_read_cmd(addr, buf, len);                                        /* read */
+    a_scd4x_sim_bus_charge(gs_bus, (res == 0) ? len : 0);                                /* charge the wire time */
+    if (res != 0)                                                                        /* check result */
+    {
+        gs_bus->naks++;                                                                  /* count nak */
+    }
+    
+    return res;                                                                          /* return the result */
+}
+
+/**
+ * @brief     sim bus delay, only the virtual time is moved and the bus is idle
+ * @param[in] ms time
+ * @note      none
+ */
+void scd4x_sim_bus_delay_ms(uint32_t ms)
+{
+    gs_bus->now_ns += (uint64_t)ms * 1000000;        /* move the virtual time */
+}
+
+/**
+ * @brief  sim bus get time
+ * @return virtual time in us
+ * @note   none
+ */
+uint64_t scd4x_sim_bus_get_time_us(void)
+{
+    return gs_bus->now_ns / 1000;        /* return the virtual time */
+}
@@ -0,0 +1,175 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_scd4x_sim_bus.h
+ * @brief     driver scd4x sim bus header file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#ifndef DRIVER_SCD4X_SIM_BUS_H
+#define DRIVER_SCD4X_SIM_BUS_H
+
+#include "driver_scd4x_sim.h"
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+/**
+ * @addtogroup scd4x_test_driver
+ * @{
+ */
+
+/**
+ * @brief sim bus max channel definition
+ */
+#define SCD4X_SIM_BUS_MAX_CHANNEL        8        /**< 8 channels of a tca9548a like mux */
+
+/**
+ * @brief scd4x sim bus structure definition
+ */
+typedef struct scd4x_sim_bus_s
+{
+    uint32_t freq_hz;                                    /**< scl frequency */
+    uint32_t stretch_ns;                                 /**< clock stretching of each transfer */
+    uint64_t now_ns;                                     /**< virtual time */
+    uint64_t busy_ns;                                    /**< bus busy time */
+    uint32_t transfers;                                  /**< transfer number */
+    uint32_t bytes;                                      /**< byte number on the wire, address included */
+    uint32_t naks;                                       /**< not acknowledged transfer number */
+    uint32_t switches;                                   /**< mux switch number */
+    uint8_t mux;                                         /**< 1 if the sensors are behind a mux */
+    uint8_t channel;                                     /**< selected channel */
+    uint8_t num;                                         /**< sensor number */
+    scd4x_sim_t *sensor[SCD4X_SIM_BUS_MAX_CHANNEL];      /**< sensor of each channel */
+} scd4x_sim_bus_t;
+
+/**
+ * @brief     link all sim bus functions to a handle
+ * @param[in] HANDLE pointer to an scd4x handle structure
+ * @note      none
+ */
+#define DRIVER_SCD4X_LINK_SIM_BUS(HANDLE)                                     \
+do                                                                            \
+{                                                                             \
+    DRIVER_SCD4X_LINK_IIC_INIT(HANDLE, scd4x_sim_iic_init);                   \
+    DRIVER_SCD4X_LINK_IIC_DEINIT(HANDLE, scd4x_sim_iic_deinit);               \
+    DRIVER_SCD4X_LINK_IIC_WRITE_COMMAND(HANDLE, scd4x_sim_bus_iic_write_cmd); \
+    DRIVER_SCD4X_LINK_IIC_READ_COMMAND(HANDLE, scd4x_sim_bus_iic_read_cmd);   \
+    DRIVER_SCD4X_LINK_DELAY_MS(HANDLE, scd4x_sim_bus_delay_ms);               \
+    DRIVER_SCD4X_LINK_GET_TIME_US(HANDLE, scd4x_sim_bus_get_time_us);         \
+    DRIVER_SCD4X_LINK_DEBUG_PRINT(HANDLE, scd4x_sim_debug_print);             \
+} while (0)
+
+/**
+ * @brief     init a sim bus
+ * @param[in] *bus pointer to an scd4x sim bus structure
+ * @param[in] freq_hz scl frequency
+ * @param[in] **sensor pointer to a sensor list
+ * @param[in] num sensor number
+ * @return    status code
+ *            - 0 success
+ *            - 1 init failed
+ * @note      more than one sensor needs a mux, all scd4x use the same address
+ */
+uint8_t scd4x_sim_bus_init(scd4x_sim_bus_t *bus, uint32_t freq_hz, scd4x_sim_t **sensor, uint8_t num);
+
+/**
+ * @brief     set the bus used by the link functions
+ * @param[in] *bus pointer to an scd4x sim bus structure
+ * @note      none
+ */
+void scd4x_sim_bus_attach(scd4x_sim_bus_t *bus);
+
+/**
+ * @brief     select a mux channel
+ * @param[in] *bus pointer to an scd4x sim bus structure
+ * @param[in] channel mux channel
+ * @note      the mux write is charged only when the channel changes
+ */
+void scd4x_sim_bus_select(scd4x_sim_bus_t *bus, uint8_t channel);
+
+/**
+ * @brief     get the wire time of a transfer
+ * @param[in] *bus pointer to an scd4x sim bus structure
+ * @param[in] bytes data bytes after the address
+ * @return    time in ns
+ * @note      start, address, ack of each byte, stop, bus free time and clock stretching are included
+ */
+uint64_t scd4x_sim_bus_transfer_ns(scd4x_sim_bus_t *bus, uint16_t bytes);
+
+/**
+ * @brief     sim bus iic write command
+ * @param[in] addr iic device write address
+ * @param[in] *buf pointer to a data buffer
+ * @param[in] len length of the data buffer
+ * @return    status code
+ *            - 0 success
+ *            - 1 not acknowledged
+ * @note      none
+ */
+uint8_t scd4x_sim_bus_iic_write_cmd(uint8_t addr, uint8_t *buf, uint16_t len);
+
+/**
+ * @brief      sim bus iic read command
+ * @param[in]  addr iic device write address
+ * @param[out] *buf pointer to a data buffer
+ * @param[in]  len length of the data buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 not acknowledged
+ * @note       none
+ */
+uint8_t scd4x_sim_bus_iic_read_cmd(uint8_t addr, uint8_t *buf, uint16_t len);
+
+/**
+ * @brief     sim bus delay, only the virtual time is moved and the bus is idle
+ * @param[in] ms time
+ * @note      none
+ */
+void scd4x_sim_bus_delay_ms(uint32_t ms);
+
+/**
+ * @brief  sim bus get time
+ * @return virtual time in us
+ * @note   none
+ */
+uint64_t scd4x_sim_bus_get_time_us(void);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
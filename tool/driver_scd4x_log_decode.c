@@ -0,0 +1,250 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_scd4x_log_decode.c
+ * @brief     driver scd4x log decode source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2026-10-19
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2026/10/19  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+
+/**
+ * @brief log definition
+ */
+#define SCD4X_LOG_EVENT_SIZE        8        /**< 8 bytes per event */
+
+/**
+ * @brief log text structure definition
+ */
+typedef struct scd4x_log_text_s
+{
+    uint8_t id;              /**< event id */
+    const char *text;        /**< event text */
+    uint8_t arg;             /**< 0 no arg, 1 decimal arg, 2 command arg, 3 link arg */
+} scd4x_log_text_t;
+
+/**
+ * @brief command name structure definition
+ */
+typedef struct scd4x_log_command_s
+{
+    uint16_t command;        /**< command code */
+    const char *name;        /**< command name */
+} scd4x_log_command_t;
+
+/**
+ * @brief log text table, keep the ids same as scd4x_log_id_t
+ */
+static const scd4x_log_text_t gs_text[] =
+{
+    {0x01, "only scd41 and scd43 has this function, chip type",         1},
+    {0x02, "command write failed",                                      2},
+    {0x03, "response read failed",                                      2},
+    {0x04, "crc is error",                                              2},
+    {0x05, "data is not ready",                                         0},
+    {0x06, "wait data ready timeout, ms",                               1},
+    {0x07, "ms is invalid",                                             1},
+    {0x08, "hour is not integer multiples of 4",                        1},
+    {0x09, "link function is null",                                     3},
+    {0x0A, "iic init failed",                                           0},
+    {0x0B, "iic close failed",                                          0},
+    {0x0C, "variant is unknown, raw",                                   1},
+    {0x0D, "param is invalid",                                          0},
+};
+
+/**
+ * @brief command name table
+ */
+static const scd4x_log_command_t gs_command[] =
+{
+    {0x21B1U, "start periodic measurement"},
+    {0xEC05U, "read"},
+    {0x3F86U, "stop periodic measurement"},
+    {0x241DU, "set temperature offset"},
+    {0x2318U, "get temperature offset"},
+    {0x2427U, "set sensor altitude"},
+    {0x2322U, "get sensor altitude"},
+    {0xE000U, "set/get ambient pressure"},
+    {0x362FU, "perform forced recalibration"},
+    {0x2416U, "set automatic self calibration"},
+    {0x2313U, "get automatic self calibration"},
+    {0x21ACU, "start low power periodic measurement"},
+    {0xE4B8U, "get data ready status"},
+    {0x3615U, "persist settings"},
+    {0x3682U, "get serial number"},
+    {0x202FU, "get sensor variant"},
+    {0x3639U, "perform self test"},
+    {0x3632U, "perform factory reset"},
+    {0x3646U, "reinit"},
+    {0x219DU, "measure single shot"},
+    {0x2196U, "measure single shot rht only"},
+    {0x36E0U, "power down"},
+    {0x36F6U, "wake up"},
+    {0x2445U, "set automatic self calibration initial period"},
+    {0x2340U, "get automatic self calibration initial period"},
+    {0x244EU, "set automatic self calibration standard period"},
+    {0x234BU, "get automatic self calibration standard period"},
+};
+
+/**
+ * @brief link function name table, keep the index same as scd4x_init
+ */
+static const char *const gs_link[] =
+{
+    "iic_init", "iic_deinit", "iic_write_cmd", "iic_read_cmd", "delay_ms", "get_time_us",
+};
+
+/**
+ * @brief     print one log event
+ * @param[in] *buf pointer to an 8 bytes little endian event
+ * @note      none
+ */
+static void a_scd4x_log_print(const uint8_t *buf)
+{
+    uint32_t time_ms;
+    uint16_t arg;
+    uint8_t id;
+    uint8_t level;
+    const scd4x_log_text_t *text;
+    const char *name;
+    size_t i;
+    
+    time_ms = (uint32_t)buf[0] | ((uint32_t)buf[1] << 8) | 
+              ((uint32_t)buf[2] << 16) | ((uint32_t)buf[3] << 24);             /* get time */
+    arg = (uint16_t)(buf[4] | (buf[5] << 8));                                  /* get arg */
+    id = buf[6];                                                               /* get id */
+    level = buf[7];                                                            /* get level */
+    
+    text = NULL;                                                               /* init NULL */
+    for (i = 0; i < sizeof(gs_text) / sizeof(gs_text[0]); i++)                 /* find the text */
+    {
+        if (gs_text[i].id == id)                                               /* check id */
+        {
+            text = &gs_text[i];                                                /* set text */
+            
+            break;                                                             /* break */
+        }
+    }
+    
+    printf("%10u.%03u %-7s ", (unsigned int)(time_ms / 1000), 
+           (unsigned int)(time_ms % 1000), 
+           (level == 1) ? "error" : ((level == 2) ? "warning" : "unknown"));   /* print time and level */
+    if (text == NULL)                                                          /* unknown id */
+    {
+        printf("unknown event 0x%02X, arg 0x%04X.\n", id, arg);                /* print raw */
+        
+        return;                                                                /* return */
+    }
+    if (text->arg == 0)                                                        /* no arg */
+    {
+        printf("%s.\n", text->text);                                           /* print text */
+    }
+    else if (text->arg == 1)                                                   /* decimal arg */
+    {
+        printf("%s %u.\n", text->text, arg);                                   /* print text */
+    }
+    else if (text->arg == 2)                                                   /* command arg */
+    {
+        name = "unknown";                                                      /* init unknown */
+        for (i = 0; i < sizeof(gs_command) / sizeof(gs_command[0]); i++)       /* find the command */
+        {
+            if (gs_command[i].command == arg)                                  /* check command */
+            {
+                name = gs_command[i].name;                                     /* set name */
+                
+                break;                                                         /* break */
+            }
+        }
+        printf("%s, %s (0x%04X).\n", text->text, name, arg);                   /* print text */
+    }
+    else                                                                       /* link arg */
+    {
+        printf("%s, %s.\n", text->text, 
+               (arg < sizeof(gs_link) / sizeof(gs_link[0])) ? 
+               gs_link[arg] : "unknown");                                      /* print text */
+    }
+}
+
+/**
+ * @brief     decode main function
+ * @param[in] argc arg numbers
+ * @param[in] **argv arg address
+ * @return    status code
+ *            - 0 success
+ *            - 1 run failed
+ * @note      the input is a dump of scd4x_log_event_t from scd4x_read_log on a little endian target,
+ *            read from the file or stdin when no file is given
+ */
+int main(int argc, char **argv)
+{
+    FILE *file;
+    uint8_t buf[SCD4X_LOG_EVENT_SIZE];
+    size_t len;
+    
+    if ((argc > 2) || ((argc == 2) && (strcmp(argv[1], "-h") == 0)))          /* check args */
+    {
+        printf("usage: %s [dump file]\n", argv[0]);                            /* print usage */
+        
+        return (argc == 2) ? 0 : 1;                                            /* return */
+    }
+    if (argc == 2)                                                             /* file input */
+    {
+        file = fopen(argv[1], "rb");                                           /* open file */
+        if (file == NULL)                                                      /* check result */
+        {
+            printf("scd4x: open %s failed.\n", argv[1]);                       /* open failed */
+            
+            return 1;                                                          /* return error */
+        }
+    }
+    else
+    {
+        file = stdin;                                                          /* stdin input */
+    }
+    
+    while ((len = fread(buf, 1, SCD4X_LOG_EVENT_SIZE, file)) == 
+           SCD4X_LOG_EVENT_SIZE)                                               /* read one event */
+    {
+        a_scd4x_log_print(buf);                                                /* print the event */
+    }
+    if (len != 0)                                                              /* check the rest */
+    {
+        printf("scd4x: %u trailing bytes are ignored.\n", (unsigned int)len);  /* print the rest */
+    }
+    if (file != stdin)                                                         /* check file */
+    {
+        (void)fclose(file);                                                    /* close file */
+    }
+    
+    return 0;                                                                  /* success return 0 */
+}